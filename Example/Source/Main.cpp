@@ -18,6 +18,7 @@ int main()
     const Core::ConfigVariableArray configVars =
     {
         { "engine.maxUpdateDelta", "1.0f" },
+        { "logger.asyncMode", "true" },
     };
 
     if(auto engine = Engine::Root::Create(configVars).UnwrapOr(nullptr))
@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 /*
     Build
@@ -16,10 +18,21 @@
     Set of information is split between engine and game directories.
     Information such as version control commit details are retrieved from
     respective engine library or game executable project directories.
+
+    Build system can also embed engine data files into executable, which
+    are then provided as list of paths and contents. File system mounts
+    them as fallback for when engine directory is not deployed along.
 */
 
 namespace Build
 {
+    struct EmbeddedFile
+    {
+        const char* path;
+        const uint8_t* data;
+        std::size_t size;
+    };
+
     void Initialize();
     void PrintInfo();
 
@@ -35,4 +48,6 @@ namespace Build
     std::string GetGameChangeHash();
     std::string GetGameChangeDate();
     std::string GetGameBranchName();
+
+    const std::vector<EmbeddedFile>& GetEmbeddedFiles();
 }
@@ -0,0 +1,230 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "Common/Debug.hpp"
+
+/*
+    Bit Stream
+
+    Writer and reader of tightly packed bit sequences, used where every byte
+    counts (e.g. replication of world state). Bits are written from least
+    significant one, so stream can be read back in same order it was written.
+
+    Integers can be written as variable length sequences of 4 bit groups, each
+    followed by continuation bit. Signed integers are zigzag encoded first, so
+    small differences between values take only few bits regardless of sign.
+
+    Reads fail once there are not enough bits left and all subsequent reads
+    fail as well, so only the final state of reader has to be checked.
+*/
+
+namespace Common
+{
+    class BitWriter
+    {
+    public:
+        void WriteBits(uint64_t value, uint32_t count)
+        {
+            ASSERT(count <= 64, "Cannot write more than 64 bits at once!");
+
+            while(count != 0)
+            {
+                uint32_t bitOffset = m_bitCount % 8;
+                if(bitOffset == 0)
+                {
+                    m_data.push_back(0);
+                }
+
+                uint32_t chunk = std::min(8 - bitOffset, count);
+                uint64_t mask = (uint64_t(1) << chunk) - 1;
+                m_data.back() |= static_cast<uint8_t>((value & mask) << bitOffset);
+
+                value = chunk < 64 ? value >> chunk : 0;
+                count -= chunk;
+                m_bitCount += chunk;
+            }
+        }
+
+        void WriteBool(bool value)
+        {
+            WriteBits(value ? 1 : 0, 1);
+        }
+
+        void WriteVarint(uint64_t value)
+        {
+            do
+            {
+                WriteBits(value & 0xF, 4);
+                value >>= 4;
+                WriteBool(value != 0);
+            }
+            while(value != 0);
+        }
+
+        void WriteSigned(int64_t value)
+        {
+            WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void WriteBytes(const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            if(m_bitCount % 8 == 0)
+            {
+                m_data.insert(m_data.end(), bytes, bytes + size);
+                m_bitCount += size * 8;
+                return;
+            }
+
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                WriteBits(bytes[i], 8);
+            }
+        }
+
+        void Reset()
+        {
+            m_data.clear();
+            m_bitCount = 0;
+        }
+
+        const std::vector<uint8_t>& GetData() const
+        {
+            return m_data;
+        }
+
+        std::size_t GetBitCount() const
+        {
+            return m_bitCount;
+        }
+
+    private:
+        std::vector<uint8_t> m_data;
+        std::size_t m_bitCount = 0;
+    };
+
+    class BitReader
+    {
+    public:
+        BitReader(const uint8_t* data, std::size_t size) :
+            m_data(data), m_bitSize(size * 8)
+        {
+            ASSERT(data != nullptr || size == 0, "Invalid bit stream data!");
+        }
+
+        BitReader(const std::vector<uint8_t>& data) :
+            BitReader(data.data(), data.size())
+        {
+        }
+
+        uint64_t ReadBits(uint32_t count)
+        {
+            ASSERT(count <= 64, "Cannot read more than 64 bits at once!");
+
+            if(!m_valid || count > m_bitSize - m_bitOffset)
+            {
+                m_valid = false;
+                return 0;
+            }
+
+            uint64_t value = 0;
+            uint32_t valueOffset = 0;
+
+            while(valueOffset != count)
+            {
+                uint32_t bitOffset = m_bitOffset % 8;
+                uint32_t chunk = std::min(8 - bitOffset, count - valueOffset);
+                uint64_t mask = (uint64_t(1) << chunk) - 1;
+                value |= ((m_data[m_bitOffset / 8] >> bitOffset) & mask) << valueOffset;
+
+                valueOffset += chunk;
+                m_bitOffset += chunk;
+            }
+
+            return value;
+        }
+
+        bool ReadBool()
+        {
+            return ReadBits(1) != 0;
+        }
+
+        uint64_t ReadVarint()
+        {
+            uint64_t value = 0;
+            uint32_t shift = 0;
+
+            do
+            {
+                if(shift >= 64)
+                {
+                    m_valid = false;
+                    return 0;
+                }
+
+                value |= ReadBits(4) << shift;
+                shift += 4;
+            }
+            while(ReadBool());
+
+            return value;
+        }
+
+        int64_t ReadSigned()
+        {
+            uint64_t value = ReadVarint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        bool ReadBytes(void* data, std::size_t size)
+        {
+            if(!m_valid || size > (m_bitSize - m_bitOffset) / 8)
+            {
+                m_valid = false;
+                return false;
+            }
+
+            auto* bytes = static_cast<uint8_t*>(data);
+            if(m_bitOffset % 8 == 0)
+            {
+                if(size != 0)
+                {
+                    std::memcpy(bytes, m_data + m_bitOffset / 8, size);
+                    m_bitOffset += size * 8;
+                }
+
+                return true;
+            }
+
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                bytes[i] = static_cast<uint8_t>(ReadBits(8));
+            }
+
+            return m_valid;
+        }
+
+        bool IsValid() const
+        {
+            return m_valid;
+        }
+
+        std::size_t GetRemainingBitCount() const
+        {
+            return m_bitSize - m_bitOffset;
+        }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        std::size_t m_bitSize = 0;
+        std::size_t m_bitOffset = 0;
+        bool m_valid = true;
+    };
+}
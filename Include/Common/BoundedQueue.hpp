@@ -0,0 +1,168 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include "Common/Debug.hpp"
+#include "Common/NonCopyable.hpp"
+
+/*
+    Bounded Queue
+
+    Lock-free queue of fixed capacity that supports multiple producers and
+    multiple consumers. Elements are moved into preallocated cells, so pushing
+    and popping never allocates. Push fails when queue is full and pop fails
+    when queue is empty, leaving it up to caller to decide how to back off.
+    Capacity is rounded up to the next power of two.
+
+    Each cell keeps a sequence number that tells whether it is ready to be
+    written to or read from for current position of enqueue/dequeue cursor.
+
+    Implementation based on:
+    - https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+
+    void ExampleBoundedQueue()
+    {
+        Common::BoundedQueue<int> queue(64);
+        queue.TryPush(4);
+
+        int value = 0;
+        queue.TryPop(value);
+    }
+*/
+
+namespace Common
+{
+    template<typename Type>
+    class BoundedQueue : private NonCopyable
+    {
+    public:
+        static constexpr std::size_t CacheLineSize = 64;
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            alignas(Type) unsigned char storage[sizeof(Type)];
+
+            Type* GetValue()
+            {
+                return std::launder(reinterpret_cast<Type*>(storage));
+            }
+        };
+
+    public:
+        BoundedQueue(std::size_t capacity)
+        {
+            std::size_t roundedCapacity = 2;
+            while(roundedCapacity < capacity)
+            {
+                roundedCapacity *= 2;
+            }
+
+            m_mask = roundedCapacity - 1;
+            m_cells = std::make_unique<Cell[]>(roundedCapacity);
+
+            for(std::size_t i = 0; i < roundedCapacity; ++i)
+            {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~BoundedQueue()
+        {
+            Type value;
+            while(TryPop(value))
+            {
+            }
+        }
+
+        template<typename... Arguments>
+        bool TryPush(Arguments&&... arguments)
+        {
+            Cell* cell = nullptr;
+            std::size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+            while(true)
+            {
+                cell = &m_cells[position & m_mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t difference = static_cast<std::intptr_t>(sequence) -
+                    static_cast<std::intptr_t>(position);
+
+                if(difference == 0)
+                {
+                    if(m_enqueuePosition.compare_exchange_weak(position, position + 1,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                        break;
+                }
+                else if(difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (cell->storage) Type(std::forward<Arguments>(arguments)...);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(Type& value)
+        {
+            Cell* cell = nullptr;
+            std::size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+            while(true)
+            {
+                cell = &m_cells[position & m_mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t difference = static_cast<std::intptr_t>(sequence) -
+                    static_cast<std::intptr_t>(position + 1);
+
+                if(difference == 0)
+                {
+                    if(m_dequeuePosition.compare_exchange_weak(position, position + 1,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                        break;
+                }
+                else if(difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            Type* storedValue = cell->GetValue();
+            value = std::move(*storedValue);
+            storedValue->~Type();
+
+            cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::size_t GetCapacity() const
+        {
+            return m_mask + 1;
+        }
+
+    private:
+        std::unique_ptr<Cell[]> m_cells;
+        std::size_t m_mask = 0;
+
+        // Keep cursors on separate cache lines to avoid false sharing.
+        alignas(CacheLineSize) std::atomic<std::size_t> m_enqueuePosition = 0;
+        alignas(CacheLineSize) std::atomic<std::size_t> m_dequeuePosition = 0;
+    };
+}
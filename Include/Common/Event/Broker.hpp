@@ -11,12 +11,18 @@
 #include "Common/Result.hpp"
 #include "Common/Event/EventBase.hpp"
 #include "Common/Event/Dispatcher.hpp"
+#include "Common/Event/Queue.hpp"
+#include "Common/Event/ConcurrentQueue.hpp"
 
 /*
     Event Broker
 
     Shared point where multiple receiver and dispatcher
     can be stored and signaled for different event types.
+
+    Events stored in event queues can be dispatched in order of insertion,
+    in which case results returned by receivers are discarded. Type erased
+    dispatch function is kept next to each registered dispatcher for this.
 */
 
 namespace Event
@@ -54,7 +60,15 @@ namespace Event
 
         template<typename ResultType, typename EventType>
         using DispatcherType = Dispatcher<ResultType(const EventType&)>;
-        using DispatcherMap = std::unordered_map<Reflection::TypeIdentifier, std::any>;
+        using ErasedDispatchFunction = void(*)(std::any& storage, const void* event);
+
+        struct DispatcherEntry
+        {
+            std::any storage;
+            ErasedDispatchFunction erasedDispatch = nullptr;
+        };
+
+        using DispatcherMap = std::unordered_map<Reflection::TypeIdentifier, DispatcherEntry>;
 
         template<typename ResultType, typename EventType>
         struct DispatcherStorage
@@ -94,9 +108,20 @@ namespace Event
             auto it = m_dispatcherMap.find(eventType);
             if(it == m_dispatcherMap.end())
             {
-                auto dispatcher = std::make_any<
+                DispatcherEntry entry;
+                entry.storage = std::make_any<
                     DispatcherStorage<ResultType, EventType>>(std::move(collector));
-                auto result = m_dispatcherMap.emplace(eventType, std::move(dispatcher));;
+                entry.erasedDispatch = [](std::any& storage, const void* event)
+                {
+                    auto* dispatcherStorage = std::any_cast<
+                        DispatcherStorage<ResultType, EventType>>(&storage);
+                    ASSERT(dispatcherStorage != nullptr);
+
+                    dispatcherStorage->dispatcher->Dispatch(
+                        *static_cast<const EventType*>(event));
+                };
+
+                auto result = m_dispatcherMap.emplace(eventType, std::move(entry));
             }
 
             return Common::Success();
@@ -118,7 +143,7 @@ namespace Event
                 return Common::Failure(SubscriptionErrors::UnregisteredEventType);
 
             DispatcherStorage<ResultType, EventType>* storage = nullptr;
-            storage = std::any_cast<DispatcherStorage<ResultType, EventType>>(&it->second);
+            storage = std::any_cast<DispatcherStorage<ResultType, EventType>>(&it->second.storage);
             if(storage == nullptr)
                 return Common::Failure(SubscriptionErrors::IncorrectResultType);
 
@@ -137,7 +162,7 @@ namespace Event
                 return Common::Failure(DispatchErrors::UnregisteredEventType);
 
             DispatcherStorage<ResultType, EventType>* storage = nullptr;
-            storage = std::any_cast<DispatcherStorage<ResultType, EventType>>(&it->second);
+            storage = std::any_cast<DispatcherStorage<ResultType, EventType>>(&it->second.storage);
             if(storage == nullptr)
                 return Common::Failure(DispatchErrors::IncorrectResultType);
 
@@ -152,7 +177,47 @@ namespace Event
             }
         }
 
+        DispatchResult<void> Dispatch(Queue& queue)
+        {
+            return DispatchQueue(queue);
+        }
+
+        DispatchResult<void> Dispatch(ConcurrentQueue& queue)
+        {
+            return DispatchQueue(queue);
+        }
+
     private:
+        template<typename QueueType>
+        DispatchResult<void> DispatchQueue(QueueType& queue)
+        {
+            /*
+                Events of unregistered types are still consumed,
+                but failure is reported after queue is drained.
+            */
+
+            bool unregisteredEventType = false;
+
+            queue.Drain([this, &unregisteredEventType](
+                Reflection::TypeIdentifier eventType, const void* event)
+            {
+                auto it = m_dispatcherMap.find(eventType);
+                if(it == m_dispatcherMap.end())
+                {
+                    unregisteredEventType = true;
+                    return;
+                }
+
+                ASSERT(it->second.erasedDispatch != nullptr);
+                it->second.erasedDispatch(it->second.storage, event);
+            });
+
+            if(unregisteredEventType)
+                return Common::Failure(DispatchErrors::UnregisteredEventType);
+
+            return Common::Success();
+        }
+
         DispatcherMap m_dispatcherMap;
         bool m_finalized = false;
     };
@@ -0,0 +1,238 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <Reflection/Reflection.hpp>
+#include "Common/Debug.hpp"
+#include "Common/Utility.hpp"
+#include "Common/NonCopyable.hpp"
+
+/*
+    Concurrent Event Queue
+
+    Bounded variant of event queue that allows multiple threads to push events
+    without locks, while single consumer thread drains them via event broker.
+    Intended for worker threads publishing events that main thread handles.
+
+    Events are constructed in place inside ring buffer of fixed capacity that is
+    divided into granules. Producers reserve contiguous granules by advancing
+    write cursor with compare and swap, construct their event and then publish
+    it by setting commit value for first granule of the record. Consumer reads
+    records in reservation order and stops at the first one not yet published.
+    Record that does not fit at the end of ring buffer is preceded by padding.
+
+    Pushing fails when there is not enough free space, as queue never grows.
+
+    void ExampleConcurrentEventQueue(Event::Broker& broker)
+    {
+        Event::ConcurrentQueue queue(64 * 1024);
+
+        std::thread worker([&queue]()
+        {
+            queue.Push(EventInteger{ 4 });
+        });
+
+        worker.join();
+        broker.Dispatch(queue);
+    }
+*/
+
+namespace Event
+{
+    class ConcurrentQueue : private Common::NonCopyable
+    {
+    public:
+        using DestructFunction = void(*)(void*);
+
+        struct EventHeader
+        {
+            Reflection::TypeIdentifier type = Reflection::InvalidIdentifier;
+            DestructFunction destruct = nullptr;
+        };
+
+        static constexpr std::size_t GranuleSize = alignof(std::max_align_t);
+        static constexpr std::size_t HeaderGranules =
+            (sizeof(EventHeader) + GranuleSize - 1) / GranuleSize;
+        static constexpr uint32_t PaddingFlag = 0x80000000;
+        static constexpr std::size_t CacheLineSize = 64;
+        static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+        template<typename EventType>
+        static constexpr std::size_t RecordGranules()
+        {
+            return HeaderGranules + (sizeof(EventType) + GranuleSize - 1) / GranuleSize;
+        }
+
+    private:
+        struct alignas(GranuleSize) Granule
+        {
+            uint8_t bytes[GranuleSize];
+        };
+
+    public:
+        ConcurrentQueue(std::size_t capacity = DefaultCapacity) :
+            m_granuleCount(std::max<std::size_t>(capacity / GranuleSize, 1)),
+            m_granules(std::make_unique<Granule[]>(m_granuleCount)),
+            m_commits(std::make_unique<std::atomic<uint32_t>[]>(m_granuleCount))
+        {
+            for(std::size_t i = 0; i < m_granuleCount; ++i)
+            {
+                m_commits[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        ~ConcurrentQueue()
+        {
+            Clear();
+        }
+
+        template<typename EventType>
+        bool Push(EventType&& event)
+        {
+            return Emplace<std::decay_t<EventType>>(std::forward<EventType>(event));
+        }
+
+        template<typename EventType, typename... Arguments>
+        bool Emplace(Arguments&&... arguments)
+        {
+            static_assert(Reflection::IsReflected<EventType>(),
+                "Queued event type must be reflected!");
+            static_assert(alignof(EventType) <= GranuleSize,
+                "Queued event type cannot be over aligned!");
+
+            constexpr std::size_t recordGranules = RecordGranules<EventType>();
+            if(recordGranules > m_granuleCount)
+                return false;
+
+            /*
+                Reserve granules for our record. If record would not fit in
+                contiguous space left at the end of ring buffer, remaining
+                granules are reserved as well and published as padding.
+            */
+
+            uint64_t reserveStart = m_writeCursor.load(std::memory_order_relaxed);
+            std::size_t paddingGranules = 0;
+
+            while(true)
+            {
+                std::size_t position = reserveStart % m_granuleCount;
+                std::size_t tailGranules = m_granuleCount - position;
+                paddingGranules = tailGranules < recordGranules ? tailGranules : 0;
+
+                uint64_t reserveEnd = reserveStart + paddingGranules + recordGranules;
+                uint64_t readCursor = m_readCursor.load(std::memory_order_acquire);
+                if(reserveEnd - readCursor > m_granuleCount)
+                    return false;
+
+                if(m_writeCursor.compare_exchange_weak(reserveStart, reserveEnd,
+                    std::memory_order_relaxed, std::memory_order_relaxed))
+                    break;
+            }
+
+            if(paddingGranules != 0)
+            {
+                std::size_t paddingPosition = reserveStart % m_granuleCount;
+                m_commits[paddingPosition].store(Common::NumericalCast<uint32_t>(
+                    paddingGranules) | PaddingFlag, std::memory_order_release);
+            }
+
+            std::size_t position = (reserveStart + paddingGranules) % m_granuleCount;
+            uint8_t* record = m_granules[position].bytes;
+
+            new (record + HeaderGranules * GranuleSize)
+                EventType(std::forward<Arguments>(arguments)...);
+
+            EventHeader* header = new (record) EventHeader();
+            header->type = Reflection::GetIdentifier<EventType>();
+
+            if constexpr(!std::is_trivially_destructible<EventType>::value)
+            {
+                header->destruct = [](void* event)
+                {
+                    static_cast<EventType*>(event)->~EventType();
+                };
+            }
+
+            m_commits[position].store(Common::NumericalCast<uint32_t>(
+                recordGranules), std::memory_order_release);
+
+            return true;
+        }
+
+        template<typename Function>
+        void Drain(Function&& function)
+        {
+            /*
+                Must be called only from single consumer thread. Commit value is
+                cleared before read cursor advances past the record, so producers
+                cannot reuse granules that consumer has not finished with.
+            */
+
+            uint64_t readCursor = m_readCursor.load(std::memory_order_relaxed);
+
+            while(true)
+            {
+                std::size_t position = readCursor % m_granuleCount;
+                uint32_t commit = m_commits[position].load(std::memory_order_acquire);
+                if(commit == 0)
+                    break;
+
+                if(commit & PaddingFlag)
+                {
+                    m_commits[position].store(0, std::memory_order_relaxed);
+                    readCursor += commit & ~PaddingFlag;
+                    m_readCursor.store(readCursor, std::memory_order_release);
+                    continue;
+                }
+
+                uint8_t* record = m_granules[position].bytes;
+                uint8_t* event = record + HeaderGranules * GranuleSize;
+                EventHeader* header = reinterpret_cast<EventHeader*>(record);
+
+                function(header->type, static_cast<const void*>(event));
+
+                if(header->destruct)
+                {
+                    header->destruct(event);
+                }
+
+                header->~EventHeader();
+
+                m_commits[position].store(0, std::memory_order_relaxed);
+                readCursor += commit;
+                m_readCursor.store(readCursor, std::memory_order_release);
+            }
+        }
+
+        void Clear()
+        {
+            Drain([](Reflection::TypeIdentifier, const void*) {});
+        }
+
+        std::size_t GetCapacity() const
+        {
+            return m_granuleCount * GranuleSize;
+        }
+
+        bool IsEmpty() const
+        {
+            return m_readCursor.load(std::memory_order_acquire) ==
+                m_writeCursor.load(std::memory_order_acquire);
+        }
+
+    private:
+        const std::size_t m_granuleCount;
+        std::unique_ptr<Granule[]> m_granules;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_commits;
+
+        // Keep cursors on separate cache lines to avoid false sharing.
+        alignas(CacheLineSize) std::atomic<uint64_t> m_writeCursor = 0;
+        alignas(CacheLineSize) std::atomic<uint64_t> m_readCursor = 0;
+    };
+}
@@ -27,9 +27,11 @@ namespace Event
     template<typename ReturnType, typename... Arguments>
     class Delegate<ReturnType(Arguments...)>
     {
-    private:
+    public:
         using ErasedPtr = void*;
         using InvokerPtr = ReturnType(*)(ErasedPtr, Arguments&&...);
+
+    private:
         using CopierPtr = void*(*)(void*);
         using DeleterPtr = void(*)(void*);
 
@@ -82,6 +84,8 @@ namespace Event
             m_invoker = other.m_invoker;
             m_copier = other.m_copier;
             m_deleter = other.m_deleter;
+
+            OnBindingChanged();
             return *this;
         }
 
@@ -99,6 +103,9 @@ namespace Event
             std::swap(m_invoker, other.m_invoker);
             std::swap(m_copier, other.m_copier);
             std::swap(m_deleter, other.m_deleter);
+
+            OnBindingChanged();
+            other.OnBindingChanged();
             return *this;
         }
 
@@ -111,6 +118,7 @@ namespace Event
         void Bind(std::nullptr_t)
         {
             ClearBinding();
+            OnBindingChanged();
         }
 
         template<ReturnType(*Function)(Arguments...)>
@@ -120,6 +128,8 @@ namespace Event
 
             m_erased = nullptr;
             m_invoker = &FunctionStub<Function>;
+
+            OnBindingChanged();
         }
 
         template<class FunctionType>
@@ -135,6 +145,8 @@ namespace Event
                 m_erased = function;
                 m_invoker = &FunctorStub<FunctionType>;
             }
+
+            OnBindingChanged();
         }
 
         template<class InstanceType, ReturnType(InstanceType::*Method)(Arguments...)>
@@ -147,6 +159,8 @@ namespace Event
                 m_erased = instance;
                 m_invoker = &MethodStub<InstanceType, Method>;
             }
+
+            OnBindingChanged();
         }
 
         template<typename FunctionType>
@@ -192,6 +206,8 @@ namespace Event
                     delete static_cast<FunctionType*>(closure);
                 };
             }
+
+            OnBindingChanged();
         }
 
         auto Invoke(Arguments... arguments)
@@ -209,6 +225,23 @@ namespace Event
             return m_invoker != nullptr;
         }
 
+    protected:
+        // Called after binding changes, so derived types can
+        // update copies of erased pointer and invoker they keep.
+        virtual void OnBindingChanged()
+        {
+        }
+
+        ErasedPtr GetErased() const
+        {
+            return m_erased;
+        }
+
+        InvokerPtr GetInvoker() const
+        {
+            return m_invoker;
+        }
+
     private:
         void ClearBinding()
         {
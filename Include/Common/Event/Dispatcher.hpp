@@ -6,7 +6,8 @@
 #pragma once
 
 #include <functional>
-#include "Common/LinkedList.hpp"
+#include <vector>
+#include "Common/NonCopyable.hpp"
 #include "Common/Event/Collector.hpp"
 #include "Common/Event/Receiver.hpp"
 #include "Common/Event/Policies.hpp"
@@ -30,51 +31,23 @@ namespace Event
     DispatcherBase type does not allow dispatching/invoking receivers,
     enabling dispatcher instance to be safely passed as a reference
     for subscription only purposes.
+
+    Receivers are stored in contiguous arrays along with copies of their
+    bound erased pointers and invokers, so dispatching does not need to
+    dereference receivers at all. Receivers subscribed with front priority
+    are kept in separate array that is iterated in reverse, which allows
+    both insertion policies to only ever append. Unsubscribed receivers
+    leave tombstones behind so indices stay stable during dispatch, which
+    are compacted away once dispatcher is no longer dispatching.
+
+    Changing subscriptions during dispatch follows these rules:
+    - Receivers unsubscribed before being reached are not invoked.
+    - Receivers subscribed at the back are invoked in the same dispatch.
+    - Receivers subscribed at the front are not invoked until next dispatch.
 */
 
 namespace Event
 {
-    template<typename Type>
-    class ReceiverInvoker;
-
-    template<typename ReturnType, typename... Arguments>
-    class ReceiverInvoker<ReturnType(Arguments...)>
-    {
-    protected:
-        ReturnType Dispatch(Receiver<ReturnType(Arguments...)>& receiver, Arguments&&... arguments)
-        {
-            return receiver.Receive(std::forward<Arguments>(arguments)...);
-        }
-    };
-
-    template<typename Type>
-    class CollectorDispatcher;
-
-    template<typename ReturnType, typename... Arguments>
-    class CollectorDispatcher<ReturnType(Arguments...)>
-        : public ReceiverInvoker<ReturnType(Arguments...)>
-    {
-    public:
-        void operator()(Collector<ReturnType>& collector,
-            Receiver<ReturnType(Arguments...)>& receiver, Arguments&&... arguments)
-        {
-            collector.ConsumeResult(this->Dispatch(
-                receiver, std::forward<Arguments>(arguments)...));
-        }
-    };
-
-    template<typename... Arguments>
-    class CollectorDispatcher<void(Arguments...)>
-        : public ReceiverInvoker<void(Arguments...)>
-    {
-    public:
-        void operator()(Collector<void>& collector,
-            Receiver<void(Arguments...)>& receiver, Arguments&&... arguments)
-        {
-            this->Dispatch(receiver, std::forward<Arguments>(arguments)...);
-        }
-    };
-
     template<typename Type>
     class DispatcherBase;
 
@@ -83,8 +56,18 @@ namespace Event
     {
     public:
         using ReceiverType = Receiver<ReturnType(Arguments...)>;
-        using ReceiverListNode = Common::ListNode<ReceiverType>;
         using ReceiverReturnType = ReturnType;
+        using ErasedPtr = typename ReceiverType::ErasedPtr;
+        using InvokerPtr = typename ReceiverType::InvokerPtr;
+
+        struct ReceiverEntry
+        {
+            ReceiverType* receiver = nullptr;
+            ErasedPtr erased = nullptr;
+            InvokerPtr invoker = nullptr;
+        };
+
+        using ReceiverList = std::vector<ReceiverEntry>;
 
         bool Subscribe(ReceiverType& receiver,
             SubscriptionPolicy subscriptionPolicy = SubscriptionPolicy::RetainSubscription,
@@ -101,16 +84,24 @@ namespace Event
                 receiver.Unsubscribe();
             }
 
-            if(priorityPolicy == PriorityPolicy::InsertFront)
+            if(m_dispatchDepth == 0 && m_tombstoneCount > m_subscriberCount)
             {
-                receiver.m_listNode.InsertBefore(m_receiverList.GetNext());
-            }
-            else
-            {
-                receiver.m_listNode.InsertAfter(m_receiverList.GetPrevious());
+                CompactReceivers();
             }
 
+            bool insertFront = priorityPolicy == PriorityPolicy::InsertFront;
+            ReceiverList& receivers = insertFront ? m_frontReceivers : m_backReceivers;
+
             receiver.m_dispatcher = this;
+            receiver.m_receiverIndex = receivers.size();
+            receiver.m_receiverFront = insertFront;
+
+            ReceiverEntry& entry = receivers.emplace_back();
+            entry.receiver = &receiver;
+            entry.erased = receiver.GetErased();
+            entry.invoker = receiver.GetInvoker();
+
+            ++m_subscriberCount;
             return true;
         }
 
@@ -119,31 +110,48 @@ namespace Event
             if(receiver.m_dispatcher != this)
                 return false;
 
-            receiver.m_listNode.Remove();
+            ReceiverEntry& entry = GetReceiverEntry(receiver);
+            ASSERT(entry.receiver == &receiver);
+            entry = ReceiverEntry();
+
             receiver.m_dispatcher = nullptr;
+            receiver.m_receiverIndex = 0;
+            receiver.m_receiverFront = false;
+
+            ASSERT(m_subscriberCount > 0);
+            --m_subscriberCount;
+            ++m_tombstoneCount;
 
             return true;
         }
 
         void UnsubscribeAll()
         {
-            ReceiverListNode* iterator = m_receiverList.GetNext();
-            while(iterator != &m_receiverList)
+            for(ReceiverList* receivers : { &m_frontReceivers, &m_backReceivers })
             {
-                ReceiverType* receiver = iterator->GetReference();
-                ASSERT(receiver != nullptr);
+                for(std::size_t i = 0; i < receivers->size(); ++i)
+                {
+                    if(ReceiverType* receiver = (*receivers)[i].receiver)
+                    {
+                        receiver->Unsubscribe();
+                    }
+                }
+            }
 
-                iterator = iterator->GetNext();
-                receiver->Unsubscribe();
+            if(m_dispatchDepth == 0)
+            {
+                CompactReceivers();
             }
         }
 
         bool HasSubscribers() const
         {
-            return !m_receiverList.IsFree();
+            return m_subscriberCount != 0;
         }
 
     protected:
+        friend ReceiverType;
+
         DispatcherBase() = default;
 
         virtual ~DispatcherBase()
@@ -159,57 +167,134 @@ namespace Event
 
         DispatcherBase& operator=(DispatcherBase&& other)
         {
-            std::swap(m_receiverList, other.m_receiverList);
+            ASSERT(m_dispatchDepth == 0 && other.m_dispatchDepth == 0,
+                "Cannot move dispatcher while it is dispatching!");
 
-            ReceiverListNode* iterator = m_receiverList.GetNext();
-            while(iterator != &m_receiverList)
+            std::swap(m_frontReceivers, other.m_frontReceivers);
+            std::swap(m_backReceivers, other.m_backReceivers);
+            std::swap(m_subscriberCount, other.m_subscriberCount);
+            std::swap(m_tombstoneCount, other.m_tombstoneCount);
+
+            SetReceiversDispatcher(this);
+            other.SetReceiversDispatcher(&other);
+
+            return *this;
+        }
+
+        void Dispatch(Collector<ReturnType>& collector, Arguments&&... arguments)
+        {
+            /*
+                Front receivers are iterated in reverse and back receivers in order.
+                Sizes and entries are read again on every iteration as invoked
+                receivers may subscribe others, which can reallocate arrays.
+                Entry is copied before invocation for the same reason.
+            */
+
+            if(m_dispatchDepth == 0 && m_tombstoneCount != 0)
+            {
+                CompactReceivers();
+            }
+
+            ++m_dispatchDepth;
+
+            for(std::size_t i = m_frontReceivers.size(); i-- > 0;)
             {
-                ReceiverType* receiver = iterator->GetReference();
-                ASSERT(receiver != nullptr);
+                if(!collector.ShouldContinue())
+                    break;
 
-                receiver->m_dispatcher = this;
-                iterator = iterator->GetNext();
+                ReceiverEntry entry = m_frontReceivers[i];
+                Invoke(collector, entry, std::forward<Arguments>(arguments)...);
             }
 
-            ReceiverListNode* otherIterator = other.m_receiverList.GetNext();
-            while(otherIterator != &other.m_receiverList)
+            for(std::size_t i = 0; i < m_backReceivers.size(); ++i)
             {
-                ReceiverType* receiver = otherIterator->GetReference();
-                ASSERT(receiver != nullptr);
+                if(!collector.ShouldContinue())
+                    break;
 
-                receiver->m_dispatcher = &other;
-                otherIterator = otherIterator->GetNext();
+                ReceiverEntry entry = m_backReceivers[i];
+                Invoke(collector, entry, std::forward<Arguments>(arguments)...);
             }
 
-            return *this;
+            --m_dispatchDepth;
         }
 
-        void Dispatch(Collector<ReturnType>& collector, Arguments&&... arguments)
+    private:
+        void Invoke(Collector<ReturnType>& collector,
+            const ReceiverEntry& entry, Arguments&&... arguments)
+        {
+            if(entry.invoker == nullptr)
+                return;
+
+            if constexpr(std::is_void<ReturnType>::value)
+            {
+                entry.invoker(entry.erased, std::forward<Arguments>(arguments)...);
+            }
+            else
+            {
+                collector.ConsumeResult(entry.invoker(
+                    entry.erased, std::forward<Arguments>(arguments)...));
+            }
+        }
+
+        ReceiverEntry& GetReceiverEntry(ReceiverType& receiver)
+        {
+            ReceiverList& receivers = receiver.m_receiverFront ? m_frontReceivers : m_backReceivers;
+            ASSERT(receiver.m_receiverIndex < receivers.size());
+            return receivers[receiver.m_receiverIndex];
+        }
+
+        void RefreshReceiver(ReceiverType& receiver)
         {
-            m_receiverList.ForEach(
-                [&collector](ReceiverListNode& node, Arguments&&... arguments)
+            ASSERT(receiver.m_dispatcher == this);
+
+            ReceiverEntry& entry = GetReceiverEntry(receiver);
+            entry.receiver = &receiver;
+            entry.erased = receiver.GetErased();
+            entry.invoker = receiver.GetInvoker();
+        }
+
+        void SetReceiversDispatcher(DispatcherBase* dispatcher)
+        {
+            for(ReceiverList* receivers : { &m_frontReceivers, &m_backReceivers })
+            {
+                for(ReceiverEntry& entry : *receivers)
                 {
-                    if(collector.ShouldContinue())
+                    if(entry.receiver)
                     {
-                        ReceiverType* receiver = node.GetReference();
-                        ASSERT(receiver != nullptr);
+                        entry.receiver->m_dispatcher = dispatcher;
+                    }
+                }
+            }
+        }
 
-                        if(receiver->IsBound())
-                        {
-                            CollectorDispatcher<ReturnType(Arguments...)> invocation;
-                            invocation(collector, *receiver, std::forward<Arguments>(arguments)...);
-                        }
+        void CompactReceivers()
+        {
+            ASSERT(m_dispatchDepth == 0, "Cannot compact receivers while dispatching!");
 
-                        return true;
-                    }
+            for(ReceiverList* receivers : { &m_frontReceivers, &m_backReceivers })
+            {
+                std::size_t compactedSize = 0;
+                for(std::size_t i = 0; i < receivers->size(); ++i)
+                {
+                    ReceiverEntry& entry = (*receivers)[i];
+                    if(entry.receiver == nullptr)
+                        continue;
 
-                    return false;
-                },
-                std::forward<Arguments>(arguments)...
-            );
+                    entry.receiver->m_receiverIndex = compactedSize;
+                    (*receivers)[compactedSize++] = entry;
+                }
+
+                receivers->resize(compactedSize);
+            }
+
+            m_tombstoneCount = 0;
         }
 
-        ReceiverListNode m_receiverList;
+        ReceiverList m_frontReceivers;
+        ReceiverList m_backReceivers;
+        std::size_t m_subscriberCount = 0;
+        std::size_t m_tombstoneCount = 0;
+        uint32_t m_dispatchDepth = 0;
     };
 
     template<typename Type>
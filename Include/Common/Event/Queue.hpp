@@ -5,15 +5,36 @@
 
 #pragma once
 
-#include <any>
-#include <queue>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <Reflection/Reflection.hpp>
+#include "Common/Debug.hpp"
+#include "Common/Utility.hpp"
+#include "Common/NonCopyable.hpp"
 
 /*
     Event Queue
 
     Sequence of different types of events that can be later passed to event
     broker to be sent via appropriate dispatcher that match their type.
-    Note that events are stored in std::any which can trigger allocations.
+
+    Events are constructed in place inside blocks of memory that are kept
+    around after queue is drained, so steady state pushing and draining does
+    not perform any allocations. Each event is prefixed with small header that
+    describes its type, size of the record and how it should be destructed.
+    Event type must be reflected, as its identifier is used to find dispatcher.
+
+    Events pushed while queue is being drained will be processed in the same
+    drain call, after all events that have been pushed before them.
+
+    void ExampleEventQueue(Event::Broker& broker)
+    {
+        Event::Queue queue;
+        queue.Push(EventInteger{ 4 });
+        queue.Emplace<EventString>("Jelly");
+        broker.Dispatch(queue);
+    }
 */
 
 namespace Event
@@ -21,10 +42,46 @@ namespace Event
     class Queue : private Common::NonCopyable
     {
     public:
-        using EventList = std::queue<std::any>;
+        using DestructFunction = void(*)(void*);
+
+        struct EventHeader
+        {
+            Reflection::TypeIdentifier type = Reflection::InvalidIdentifier;
+            uint32_t size = 0;
+            DestructFunction destruct = nullptr;
+        };
+
+        static constexpr std::size_t RecordAlignment = alignof(std::max_align_t);
+        static constexpr std::size_t HeaderSize =
+            (sizeof(EventHeader) + RecordAlignment - 1) & ~(RecordAlignment - 1);
+        static constexpr std::size_t DefaultBlockSize = 4096;
+
+        template<typename EventType>
+        static constexpr std::size_t RecordSize()
+        {
+            return HeaderSize + ((sizeof(EventType) + RecordAlignment - 1) & ~(RecordAlignment - 1));
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<uint8_t[]> memory;
+            std::size_t capacity = 0;
+            std::size_t used = 0;
+        };
+
+        using BlockList = std::vector<Block>;
+
+    public:
+        Queue(std::size_t blockSize = DefaultBlockSize) :
+            m_blockSize(blockSize)
+        {
+        }
 
-        Queue() = default;
-        ~Queue() = default;
+        ~Queue()
+        {
+            Clear();
+        }
 
         Queue(Queue&& other)
         {
@@ -33,32 +90,149 @@ namespace Event
 
         Queue& operator=(Queue&& other)
         {
-            std::swap(m_eventList, other.m_eventList);
+            std::swap(m_blocks, other.m_blocks);
+            std::swap(m_blockSize, other.m_blockSize);
+            std::swap(m_currentBlock, other.m_currentBlock);
+            std::swap(m_eventCount, other.m_eventCount);
             return *this;
         }
 
-        template<typename Type>
-        void Push(const Type& event)
+        template<typename EventType>
+        void Push(EventType&& event)
         {
-            m_eventList.push(event);
+            Emplace<std::decay_t<EventType>>(std::forward<EventType>(event));
         }
 
-        std::any Pop()
+        template<typename EventType, typename... Arguments>
+        EventType& Emplace(Arguments&&... arguments)
         {
-            if(m_eventList.empty())
-                return std::any();
+            static_assert(Reflection::IsReflected<EventType>(),
+                "Queued event type must be reflected!");
+            static_assert(alignof(EventType) <= RecordAlignment,
+                "Queued event type cannot be over aligned!");
 
-            std::any event = m_eventList.front();
-            m_eventList.pop();
-            return event;
+            constexpr std::size_t recordSize = RecordSize<EventType>();
+            uint8_t* record = AllocateRecord(recordSize);
+
+            EventType* event = new (record + HeaderSize)
+                EventType(std::forward<Arguments>(arguments)...);
+
+            EventHeader* header = new (record) EventHeader();
+            header->type = Reflection::GetIdentifier<EventType>();
+            header->size = Common::NumericalCast<uint32_t>(recordSize);
+
+            if constexpr(!std::is_trivially_destructible<EventType>::value)
+            {
+                header->destruct = [](void* event)
+                {
+                    static_cast<EventType*>(event)->~EventType();
+                };
+            }
+
+            ++m_eventCount;
+            return *event;
+        }
+
+        template<typename Function>
+        void Drain(Function&& function)
+        {
+            /*
+                Iterate over blocks and their records in order of insertion.
+                Block count and block usage are read again on every iteration
+                as function may push new events while we are draining. Memory
+                of existing blocks never moves, so records remain valid.
+            */
+
+            for(std::size_t blockIndex = 0; blockIndex <= m_currentBlock; ++blockIndex)
+            {
+                if(blockIndex >= m_blocks.size())
+                    break;
+
+                std::size_t offset = 0;
+                while(offset < m_blocks[blockIndex].used)
+                {
+                    uint8_t* record = m_blocks[blockIndex].memory.get() + offset;
+                    EventHeader* header = reinterpret_cast<EventHeader*>(record);
+                    offset += header->size;
+
+                    function(header->type, static_cast<const void*>(record + HeaderSize));
+
+                    if(header->destruct)
+                    {
+                        header->destruct(record + HeaderSize);
+                    }
+
+                    header->~EventHeader();
+                }
+            }
+
+            ResetBlocks();
+        }
+
+        void Clear()
+        {
+            Drain([](Reflection::TypeIdentifier, const void*) {});
+        }
+
+        std::size_t GetEventCount() const
+        {
+            return m_eventCount;
         }
 
         bool IsEmpty() const
         {
-            return m_eventList.empty();
+            return m_eventCount == 0;
         }
 
     private:
-        EventList m_eventList;
+        uint8_t* AllocateRecord(std::size_t recordSize)
+        {
+            while(m_currentBlock < m_blocks.size())
+            {
+                Block& block = m_blocks[m_currentBlock];
+                if(block.capacity - block.used >= recordSize)
+                {
+                    uint8_t* record = block.memory.get() + block.used;
+                    block.used += recordSize;
+                    return record;
+                }
+
+                if(block.used == 0 && m_currentBlock + 1 == m_blocks.size())
+                {
+                    // Replace empty trailing block that is too small.
+                    m_blocks.pop_back();
+                    break;
+                }
+
+                ++m_currentBlock;
+            }
+
+            Block& block = m_blocks.emplace_back();
+            block.capacity = std::max(m_blockSize, recordSize);
+            block.memory.reset(new uint8_t[block.capacity]);
+            block.used = recordSize;
+            m_currentBlock = m_blocks.size() - 1;
+
+            ASSERT(reinterpret_cast<std::uintptr_t>(block.memory.get()) % RecordAlignment == 0,
+                "Allocated event block is not aligned!");
+
+            return block.memory.get();
+        }
+
+        void ResetBlocks()
+        {
+            for(Block& block : m_blocks)
+            {
+                block.used = 0;
+            }
+
+            m_currentBlock = 0;
+            m_eventCount = 0;
+        }
+
+        BlockList m_blocks;
+        std::size_t m_blockSize = DefaultBlockSize;
+        std::size_t m_currentBlock = 0;
+        std::size_t m_eventCount = 0;
     };
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Common/Debug.hpp"
+#include "Common/NonCopyable.hpp"
 #include "Common/Event/Dispatcher.hpp"
 #include "Common/Event/Delegate.hpp"
 #include "Common/Event/Policies.hpp"
@@ -14,9 +15,6 @@ namespace Event
 {
     template<typename Type>
     class DispatcherBase;
-
-    template<typename Type>
-    class ReceiverInvoker;
 }
 
 /*
@@ -38,15 +36,10 @@ namespace Event
     {
     public:
         friend DispatcherBase<ReturnType(Arguments...)>;
-        friend ReceiverInvoker<ReturnType(Arguments...)>;
 
         using DispatcherType = DispatcherBase<ReturnType(Arguments...)>;
-        using ReceiverListNode = typename DispatcherType::ReceiverListNode;
 
-        Receiver() :
-            m_listNode(this)
-        {
-        }
+        Receiver() = default;
 
         virtual ~Receiver()
         {
@@ -63,11 +56,24 @@ namespace Event
         {
             /*
                 Swap only subscription and not bound function in base Delegate.
-                Swapping list nodes does not require references to be reset.
+                Dispatcher entries need to be refreshed as they point at
+                receivers and keep copies of their current bindings.
             */
 
-            std::swap(m_listNode, other.m_listNode);
             std::swap(m_dispatcher, other.m_dispatcher);
+            std::swap(m_receiverIndex, other.m_receiverIndex);
+            std::swap(m_receiverFront, other.m_receiverFront);
+
+            if(m_dispatcher)
+            {
+                m_dispatcher->RefreshReceiver(*this);
+            }
+
+            if(other.m_dispatcher)
+            {
+                other.m_dispatcher->RefreshReceiver(other);
+            }
+
             return *this;
         }
 
@@ -88,30 +94,26 @@ namespace Event
             }
 
             ASSERT(m_dispatcher == nullptr, "Invalid state after unsubcribing!");
-            ASSERT(m_listNode.IsFree(), "Invalid state after unsubcribing!");
 
             return unsubcribed;
         }
 
         bool IsSubscribed() const
         {
-            return !m_listNode.IsFree();
+            return m_dispatcher != nullptr;
         }
 
     private:
-        ReturnType Receive(Arguments&&... arguments)
+        void OnBindingChanged() override
         {
-            ASSERT(m_dispatcher, "Invoked receiver without it being subscribed!");
-            return Invoke(std::forward<Arguments>(arguments)...);
-        }
-
-        ReturnType Invoke(Arguments&&... arguments)
-        {
-            return Delegate<ReturnType(Arguments...)>
-                ::Invoke(std::forward<Arguments>(arguments)...);
+            if(m_dispatcher)
+            {
+                m_dispatcher->RefreshReceiver(*this);
+            }
         }
 
-        ReceiverListNode m_listNode;
         DispatcherType* m_dispatcher = nullptr;
+        std::size_t m_receiverIndex = 0;
+        bool m_receiverFront = false;
     };
 }
@@ -27,19 +27,11 @@ namespace Common
         static constexpr ValueType InvalidIdentifier = 0;
         static constexpr ValueType StartingVersion = 0;
 
+        // Trivially copyable, so structures holding
+        // handles can be copied in bulk (e.g. snapshots).
         Handle() = default;
-        Handle(const Handle& other)
-        {
-            *this = other;
-        }
-
-        Handle& operator=(const Handle& other)
-        {
-            ASSERT(&other != this);
-            m_identifier = other.m_identifier;
-            m_version = other.m_version;
-            return *this;
-        }
+        Handle(const Handle& other) = default;
+        Handle& operator=(const Handle& other) = default;
 
         ValueType GetIdentifier() const
         {
@@ -339,6 +339,103 @@ namespace Common
             return Common::NumericalCast<HandleValueType>(m_retiredHandles);
         }
 
+        template<typename WriterType>
+        void Serialize(WriterType& writer) const
+        {
+            /*
+                Write exact state of handle map, including free list order,
+                so deserialized map hands out same handles in same order.
+                Storage is written as is and has to be trivially copyable.
+                Writer is expected to provide Write() for trivial types.
+            */
+
+            static_assert(std::is_trivially_copyable<StorageType>::value,
+                "Storage type for serialized handle map must be trivially copyable!");
+
+            writer.Write(static_cast<uint64_t>(m_handles.size()));
+            for(const HandleEntry& handleEntry : m_handles)
+            {
+                writer.Write(handleEntry.handle);
+                writer.Write(handleEntry.storage);
+                writer.Write(handleEntry.valid);
+            }
+
+            writer.Write(static_cast<uint64_t>(m_freeList.size()));
+            for(const HandleValueType& freeIndex : m_freeList)
+            {
+                writer.Write(freeIndex);
+            }
+
+            writer.Write(static_cast<uint64_t>(m_retiredHandles));
+        }
+
+        template<typename ReaderType>
+        bool Deserialize(ReaderType& reader)
+        {
+            /*
+                Replace current state with one written by Serialize().
+                Existing handle entries are reused, so restoring maps of
+                similar size does not allocate. Reader is expected to
+                provide Read() for trivial types that returns false
+                when it runs out of data. Map is left empty on failure.
+            */
+
+            static_assert(std::is_trivially_copyable<StorageType>::value,
+                "Storage type for serialized handle map must be trivially copyable!");
+
+            auto failure = [this]()
+            {
+                m_handles.clear();
+                m_freeList.clear();
+                m_retiredHandles = 0;
+                return false;
+            };
+
+            uint64_t handleCount = 0;
+            if(!reader.Read(handleCount) || handleCount > HandleType::MaximumIdentifier)
+                return failure();
+
+            if(m_handles.size() > handleCount)
+            {
+                m_handles.erase(m_handles.begin() + handleCount, m_handles.end());
+            }
+
+            while(m_handles.size() < handleCount)
+            {
+                m_handles.emplace_back(HandleType());
+            }
+
+            for(std::size_t index = 0; index < handleCount; ++index)
+            {
+                HandleEntry& handleEntry = m_handles[index];
+                if(!reader.Read(handleEntry.handle) ||
+                    !reader.Read(handleEntry.storage) ||
+                    !reader.Read(handleEntry.valid))
+                    return failure();
+
+                if(handleEntry.handle.GetIdentifier() != index + 1)
+                    return failure();
+            }
+
+            uint64_t freeCount = 0;
+            if(!reader.Read(freeCount) || freeCount > handleCount)
+                return failure();
+
+            m_freeList.resize(freeCount);
+            for(HandleValueType& freeIndex : m_freeList)
+            {
+                if(!reader.Read(freeIndex) || freeIndex >= handleCount)
+                    return failure();
+            }
+
+            uint64_t retiredHandles = 0;
+            if(!reader.Read(retiredHandles) || retiredHandles > handleCount - freeCount)
+                return failure();
+
+            m_retiredHandles = static_cast<std::size_t>(retiredHandles);
+            return true;
+        }
+
         HandleIterator<false> begin()
         {
             return HandleIterator<false>(m_handles.begin(), m_handles.end());
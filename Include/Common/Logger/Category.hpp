@@ -0,0 +1,104 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string_view>
+#include <vector>
+#include "Common/NonCopyable.hpp"
+#include "Common/Logger/Message.hpp"
+
+/*
+    Minimum Severity
+
+    Log messages below minimum severity are removed at compile time, along with
+    their formatting. Can be overridden by defining LOG_MINIMUM_SEVERITY before
+    logger is included (e.g. as Logger::Severity::Warning via compiler flags).
+    Debug messages are always removed when not in debug configuration.
+*/
+
+#ifndef LOG_MINIMUM_SEVERITY
+    #define LOG_MINIMUM_SEVERITY Logger::Severity::Trace
+#endif
+
+namespace Logger
+{
+    constexpr bool IsSeverityCompiled(Severity::Type severity)
+    {
+#ifdef NDEBUG
+        if(severity == Severity::Debug)
+            return false;
+#endif
+
+        return severity >= LOG_MINIMUM_SEVERITY;
+    }
+
+    Severity::Type ParseSeverity(std::string_view text);
+}
+
+/*
+    Category
+
+    Groups log messages that can be filtered together at runtime. Messages
+    with severity below minimum severity of their category are discarded
+    before message is created and formatted. Categories register themselves
+    on construction, so their minimum severity can be set by name. Should be
+    defined as global variables, as their names are not copied.
+
+    inline Logger::Category LogExample("Example");
+
+    void ExampleLoggerCategory()
+    {
+        LogExample.SetMinimumSeverity(Logger::Severity::Warning);
+        LOG_CATEGORY_INFO(LogExample, "Discarded without formatting.");
+        LOG_CATEGORY_WARNING(LogExample, "Written.");
+    }
+*/
+
+namespace Logger
+{
+    class Category : private Common::NonCopyable
+    {
+    public:
+        Category(const char* name, Severity::Type minimumSeverity = Severity::Trace);
+        ~Category();
+
+        void SetMinimumSeverity(Severity::Type severity)
+        {
+            m_minimumSeverity.store(severity, std::memory_order_relaxed);
+        }
+
+        Severity::Type GetMinimumSeverity() const
+        {
+            return m_minimumSeverity.load(std::memory_order_relaxed);
+        }
+
+        bool IsEnabled(Severity::Type severity) const
+        {
+            return severity >= m_minimumSeverity.load(std::memory_order_relaxed);
+        }
+
+        const char* GetName() const
+        {
+            return m_name;
+        }
+
+    private:
+        friend std::vector<Category*> GetCategories();
+
+        const char* m_name = nullptr;
+        std::atomic<Severity::Type> m_minimumSeverity;
+        Category* m_next = nullptr;
+    };
+
+    using CategoryList = std::vector<Category*>;
+    CategoryList GetCategories();
+    Category* FindCategory(std::string_view name);
+    void SetMinimumSeverity(Severity::Type severity);
+
+    // Category used by log macros that do not specify one.
+    inline Category DefaultCategory("Default");
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <string>
 
 /*
@@ -28,8 +29,8 @@ namespace Logger
     class DefaultFormat
     {
     public:
-        static std::string ComposeSessionStart();
+        static std::string ComposeSessionStart(std::time_t time = std::time(nullptr));
         static std::string ComposeMessage(const Message& message, const SinkContext& context);
-        static std::string ComposeSessionEnd();
+        static std::string ComposeSessionEnd(std::time_t time = std::time(nullptr));
     };
 }
@@ -6,11 +6,16 @@
 #pragma once
 
 #include <deque>
+#include <mutex>
 #include "Common/Logger/Output.hpp"
 #include "Common/Logger/Message.hpp"
 
 /*
     Logger History
+
+    Keeps a limited number of recently written messages, for example to be
+    displayed in editor console. Messages may be written from logger thread
+    while being read, so a copy of the history is returned when requested.
 */
 
 namespace Logger
@@ -30,10 +35,12 @@ namespace Logger
         History();
         ~History();
 
-        void Write(const Logger::Message& message, const Logger::SinkContext& context) override;
-        const MessageList& GetMessages() const;
+        void Write(const Logger::Message& message, const Logger::SinkContext& context,
+            const std::string& text) override;
+        MessageList GetMessages() const;
 
     private:
+        mutable std::mutex m_lock;
         MessageList m_messages;
     };
 }
@@ -7,6 +7,7 @@
 
 #include <fmt/core.h>
 #include "Common/Logger/Message.hpp"
+#include "Common/Logger/Category.hpp"
 
 /*
     Logger
@@ -17,6 +18,7 @@
     - Output:  Message output streams (e.g. file writer, console output).
     - Format:  Defines how log messages are formatted before being written.
     - Sink:    Collects messages and sends them to registered outputs.
+    - Category: Filters messages by their minimum severity before they are formatted.
     
     void ExampleLogger()
     {
@@ -36,6 +38,9 @@
         LOG_ERROR("Writing error message.");
         LOG_FATAL("Writing fatal message.");
 
+        // Write log message in specific category.
+        LOG_CATEGORY_INFO(Logger::DefaultCategory, "Writing categorized message.");
+
         // Create an indent until the end of the current scope.
         {
             LOG_SCOPED_INDENT();
@@ -53,6 +58,7 @@ namespace Logger
 
     void Initialize();
     void Write(const Message& message);
+    bool OpenBinaryOutput(std::string filename);
     int AdvanceFrameReference();
 
     Sink& GetGlobalSink();
@@ -69,16 +75,30 @@ namespace Logger
 #define LOG_SCOPED_INDENT() Logger::ScopedIndent LOG_SCOPED_INDENT_NAME(__LINE__)(Logger::GetGlobalSink())
 
 #ifndef NDEBUG
-    #define LOG_SCOPED_MESSAGE() Logger::ScopedMessage(Logger::GetGlobalSink()).SetSource(__FILE__).SetLine(__LINE__)
+    #define LOG_SCOPED_MESSAGE(severity) Logger::ScopedMessage(Logger::GetGlobalSink()).SetSeverity(severity).SetSource(__FILE__).SetLine(__LINE__)
 #else
-    #define LOG_SCOPED_MESSAGE() Logger::ScopedMessage(Logger::GetGlobalSink())
+    #define LOG_SCOPED_MESSAGE(severity) Logger::ScopedMessage(Logger::GetGlobalSink()).SetSeverity(severity)
 #endif
 
-#define LOG(format, ...)         LOG_SCOPED_MESSAGE().Format(format, ## __VA_ARGS__)
-#define LOG_TRACE(format, ...)   LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Trace)
-#define LOG_DEBUG(format, ...)   LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Debug)
-#define LOG_INFO(format, ...)    LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Info)
-#define LOG_SUCCESS(format, ...) LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Success)
-#define LOG_WARNING(format, ...) LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Warning)
-#define LOG_ERROR(format, ...)   LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Error)
-#define LOG_FATAL(format, ...)   LOG(format, ## __VA_ARGS__).SetSeverity(Logger::Severity::Fatal)
+// Message is not created and its arguments are not formatted when filtered out.
+#define LOG_CATEGORY(category, severity, format, ...) \
+    if constexpr(!Logger::IsSeverityCompiled(severity)) {} \
+    else if(!(category).IsEnabled(severity)) {} \
+    else LOG_SCOPED_MESSAGE(severity).Format(format, ## __VA_ARGS__)
+
+#define LOG_CATEGORY_TRACE(category, format, ...)   LOG_CATEGORY(category, Logger::Severity::Trace, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_DEBUG(category, format, ...)   LOG_CATEGORY(category, Logger::Severity::Debug, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_INFO(category, format, ...)    LOG_CATEGORY(category, Logger::Severity::Info, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_SUCCESS(category, format, ...) LOG_CATEGORY(category, Logger::Severity::Success, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_WARNING(category, format, ...) LOG_CATEGORY(category, Logger::Severity::Warning, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_ERROR(category, format, ...)   LOG_CATEGORY(category, Logger::Severity::Error, format, ## __VA_ARGS__)
+#define LOG_CATEGORY_FATAL(category, format, ...)   LOG_CATEGORY(category, Logger::Severity::Fatal, format, ## __VA_ARGS__)
+
+#define LOG(format, ...)         LOG_CATEGORY_INFO(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_TRACE(format, ...)   LOG_CATEGORY_TRACE(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_DEBUG(format, ...)   LOG_CATEGORY_DEBUG(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_INFO(format, ...)    LOG_CATEGORY_INFO(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_SUCCESS(format, ...) LOG_CATEGORY_SUCCESS(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_WARNING(format, ...) LOG_CATEGORY_WARNING(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_ERROR(format, ...)   LOG_CATEGORY_ERROR(Logger::DefaultCategory, format, ## __VA_ARGS__)
+#define LOG_FATAL(format, ...)   LOG_CATEGORY_FATAL(Logger::DefaultCategory, format, ## __VA_ARGS__)
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <string>
 #include "Common/Logger/Sink.hpp"
 
@@ -53,6 +54,7 @@ namespace Logger
     public:
         Message() = default;
         Message(Message&& other);
+        Message& operator=(Message&& other);
 
         // Destructor left intentionally without virtual dispatch
         // to save on vtable lookup when ScopeMessage gets destroyed.
@@ -61,16 +63,25 @@ namespace Logger
         Message(const Message&) = delete;
         Message& operator=(const Message&) = delete;
 
+        // Format string is kept by pointer like source file, so it has to
+        // outlive message (log macros pass string literals or static strings).
         template<typename... Args>
         Message& Format(const char* format, Args&&... arguments)
         {
+            m_format = format;
             m_text = fmt::format(format, arguments...);
             return *this;
         }
 
+        Message& SetFormat(const char* format)
+        {
+            m_format = format;
+            return *this;
+        }
+
         Message& SetText(std::string text)
         {
-            m_text = text;
+            m_text = std::move(text);
             return *this;
         }
 
@@ -92,11 +103,22 @@ namespace Logger
             return *this;
         }
 
+        Message& SetTime(std::time_t time)
+        {
+            m_time = time;
+            return *this;
+        }
+
         const std::string& GetText() const
         {
             return m_text;
         }
 
+        const char* GetFormat() const
+        {
+            return m_format;
+        }
+
         Severity::Type GetSeverity() const
         {
             return m_severity;
@@ -112,6 +134,11 @@ namespace Logger
             return m_line;
         }
 
+        std::time_t GetTime() const
+        {
+            return m_time;
+        }
+
         bool IsEmpty() const
         {
             return m_text.empty();
@@ -119,9 +146,14 @@ namespace Logger
 
     private:
         std::string m_text;
+        const char* m_format = nullptr;
         Severity::Type m_severity = Severity::Info;
         const char* m_source = nullptr;
         unsigned int m_line = 0;
+
+        // Time is captured when message is created, so it stays
+        // accurate even if message is written to outputs later.
+        std::time_t m_time = std::time(nullptr);
     };
 }
 
@@ -146,7 +178,7 @@ namespace Logger
 
         ~ScopedMessage()
         {
-            m_sink.Write(*this);
+            m_sink.Write(std::move(*this));
         }
 
     private:
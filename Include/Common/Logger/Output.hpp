@@ -5,12 +5,25 @@
 
 #pragma once
 
+#include <ctime>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "Common/Result.hpp"
 
 /*
     Base Output
     
     Interface for output implementations that are added to logger sinks.
+    Sink composes message text once and passes it to every output, along with
+    original message and context. Outputs that do not write composed text
+    (e.g. binary output) report it, and when no text outputs are added, sink
+    skips composing and passes empty text. Outputs may buffer written text
+    until sink asks them to flush, which happens after every message in
+    synchronous mode and in batches when sink is writing asynchronously.
 */
 
 namespace Logger
@@ -21,7 +34,20 @@ namespace Logger
     class Output
     {
     public:
-        virtual void Write(const Logger::Message& message, const Logger::SinkContext& context) = 0;
+        virtual ~Output() = default;
+
+        virtual void Write(const Logger::Message& message,
+            const Logger::SinkContext& context, const std::string& text) = 0;
+
+        virtual void Flush()
+        {
+        }
+
+        // Must not change while output is added to sink.
+        virtual bool IsTextOutput() const
+        {
+            return true;
+        }
     };
 }
 
@@ -53,7 +79,9 @@ namespace Logger
         ~FileOutput();
 
         bool Open(std::string filename);
-        void Write(const Message& message, const SinkContext& context) override;
+        void Write(const Message& message, const SinkContext& context,
+            const std::string& text) override;
+        void Flush() override;
 
     private:
         std::ofstream m_file;
@@ -86,7 +114,9 @@ namespace Logger
         ConsoleOutput();
         ~ConsoleOutput();
 
-        void Write(const Message& message, const SinkContext& context) override;
+        void Write(const Message& message, const SinkContext& context,
+            const std::string& text) override;
+        void Flush() override;
     };
 }
 
@@ -116,6 +146,108 @@ namespace Logger
         DebuggerOutput();
         ~DebuggerOutput();
 
-        void Write(const Message& message, const SinkContext& context) override;
+        void Write(const Message& message, const SinkContext& context,
+            const std::string& text) override;
+    };
+}
+
+/*
+    Binary Output
+
+    Writes compact binary log records to a memory mapped file, which is much
+    cheaper than writing composed text and keeps records written before crash.
+    Each record stores time, frame reference, indent, severity, identifiers of
+    source and format strings, source line and message text. String identifiers
+    are name hashes of interned strings, written to file once on first use and
+    cached by string address, so each static string is hashed only once.
+    Message arguments are formatted at log site, so message text is stored
+    as it is, unless it matches format string and can be rebuilt from it.
+    Decode() reads records back, which LogDecoder tool uses to produce text
+    log in default format.
+
+    void ExampleLoggerBinaryOutput()
+    {
+        // Create logger sink.
+        Logger::Sink sink;
+
+        // Open binary output.
+        Logger::BinaryOutput binaryOutput;
+        binaryOutput.Open("Log.bin");
+
+        // Add output to the sink.
+        sink.AddOutput(&binaryOutput);
+    }
+*/
+
+namespace Logger
+{
+    class BinaryOutput : public Output
+    {
+    public:
+        static constexpr char Magic[4] = { 'L', 'O', 'G', 'B' };
+        static constexpr uint32_t Version = 3;
+        static constexpr std::size_t MappingGranularity = 1024 * 1024;
+
+        enum class RecordType : uint8_t
+        {
+            End,
+            String,
+            Message,
+        };
+
+        enum class DecodeErrors
+        {
+            InvalidHeader,
+            UnsupportedVersion,
+            TruncatedRecord,
+            UnknownRecord,
+            UnknownString,
+        };
+
+        using DecodeCallback = std::function<void(const Message&, const SinkContext&)>;
+        using DecodeResult = Common::Result<std::time_t, DecodeErrors>;
+
+        // Decodes all messages and returns session start time.
+        static DecodeResult Decode(const uint8_t* data, std::size_t size, const DecodeCallback& callback);
+
+    public:
+        BinaryOutput();
+        ~BinaryOutput();
+
+        bool Open(std::string filename);
+        void Close();
+        void Write(const Message& message, const SinkContext& context,
+            const std::string& text) override;
+        void Flush() override;
+        bool IsTextOutput() const override;
+
+        bool IsOpen() const;
+        std::size_t GetWrittenSize() const;
+
+    private:
+        uint32_t InternString(const char* string);
+        uint8_t* Reserve(std::size_t size);
+        bool MapFile(std::size_t size);
+        void UnmapFile();
+
+        template<typename Type>
+        uint8_t* WriteValue(uint8_t* destination, const Type& value)
+        {
+            std::memcpy(destination, &value, sizeof(Type));
+            return destination + sizeof(Type);
+        }
+
+        uint8_t* m_mappedData = nullptr;
+        std::size_t m_mappedSize = 0;
+        std::size_t m_writtenSize = 0;
+        std::unordered_map<const char*, uint32_t> m_internedStrings;
+        std::unordered_set<uint32_t> m_writtenStrings;
+
+#ifdef WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#else
+        int m_fileDescriptor = -1;
+#endif
     };
 }
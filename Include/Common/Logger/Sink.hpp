@@ -5,14 +5,32 @@
 
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 /*
     Sink
 
     Writes log messages to multiple logging outputs.
 
+    By default messages are written synchronously, with outputs flushed after
+    every message. Sink can also be switched to asynchronous mode, in which
+    writing threads only push messages into bounded lock-free queue and return.
+    Background thread then composes each message text once (only if any output
+    writes text), passes it to all outputs and flushes them in batches, either when flush interval elapses,
+    when fatal message is written, when flush is explicitly requested or when
+    asynchronous mode is disabled. Writing thread yields while queue is full.
+    Asynchronous mode should be enabled and disabled from single thread, while
+    no other threads are writing messages. Message indent is tracked separately
+    for each thread, so scoped indents of threads writing messages at the same
+    time do not affect each other.
+
     void ExampleLoggerSink()
     {
         // Create logging sink.
@@ -25,13 +43,25 @@
         // Add output to the sink.
         sink.AddOutput(&fileOutput);
 
+        // Write messages from background thread.
+        sink.EnableAsync();
+
         // Write log message.
         Logger::Message message;
         message.Format("Hello {}!", "world");
-        sink.Write(message);
+        sink.Write(std::move(message));
+
+        // Wait until message is written.
+        sink.Flush();
     }
 */
 
+namespace Common
+{
+    template<typename Type>
+    class BoundedQueue;
+}
+
 namespace Logger
 {
     class Output;
@@ -50,6 +80,9 @@ namespace Logger
     public:
         using OutputList = std::vector<Logger::Output*>;
 
+        static constexpr std::size_t DefaultAsyncCapacity = 4096;
+        static constexpr std::chrono::milliseconds DefaultFlushInterval{ 200 };
+
         Sink();
         ~Sink();
 
@@ -60,16 +93,50 @@ namespace Logger
         void AddOutput(Logger::Output* output);
         void RemoveOutput(Logger::Output* output);
         void Write(const Logger::Message& message);
+        void Write(Logger::Message&& message);
+        void Flush();
         int AdvanceFrameReference();
         void IncreaseIndent();
         void DecreaseIndent();
 
-        const SinkContext& GetContext() const;
+        void EnableAsync(std::size_t capacity = DefaultAsyncCapacity,
+            std::chrono::milliseconds flushInterval = DefaultFlushInterval);
+        void DisableAsync();
+        bool IsAsync() const;
+
+        SinkContext GetContext() const;
 
     private:
-        std::mutex m_lock;
+        struct AsyncRecord;
+        using AsyncQueue = Common::BoundedQueue<AsyncRecord>;
+
+        bool IsMessageFiltered(const Logger::Message& message) const;
+        void WriteOutputs(const Logger::Message& message, int referenceFrame, int messageIndent);
+        void FlushOutputs();
+        void PushAsync(Logger::Message&& message);
+        void AsyncWorker();
+
+        mutable std::mutex m_lock;
         SinkContext m_context;
         OutputList m_outputs;
+        bool m_textOutputs = false;
+
+        std::atomic<int> m_referenceFrame = 0;
+        std::atomic<bool> m_messageWritten = false;
+
+        std::unique_ptr<AsyncQueue> m_asyncQueue;
+        std::atomic<bool> m_asyncEnabled = false;
+        std::atomic<int64_t> m_asyncPending = 0;
+        std::atomic<bool> m_asyncSleeping = false;
+        std::chrono::milliseconds m_flushInterval = DefaultFlushInterval;
+
+        std::thread m_asyncThread;
+        std::mutex m_asyncLock;
+        std::condition_variable m_asyncCondition;
+        std::condition_variable m_flushCondition;
+        uint64_t m_flushRequested = 0;
+        uint64_t m_flushCompleted = 0;
+        bool m_asyncStopping = false;
     };
 }
 
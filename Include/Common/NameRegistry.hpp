@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 #include "Common/NonCopyable.hpp"
 
@@ -16,7 +17,8 @@
     Name Registry
 
     Registry of names for looking them up by hash identifier.
-    This should generally be disabled in shipped game.
+    This should generally be disabled in shipped game. Names can be
+    registered and looked up from multiple threads (e.g. logger thread).
 */
 
 namespace Common
@@ -44,6 +46,8 @@ namespace Common
         friend Name;
 
         void Register(const Name& name, std::string_view string);
+
+        std::mutex m_lock;
         std::unordered_map<HashType, std::string> m_registry;
 #endif
     };
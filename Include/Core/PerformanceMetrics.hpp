@@ -12,6 +12,10 @@
 
     Utility subsystem for tracking important performance events and their
     timings, such as frame start/end times used to calculate framerate.
+    Input latency is measured poll-to-present, from previous poll of window
+    events (earliest time input seen by following poll could have arrived)
+    until frame that could reflect it has been presented (submitted for
+    display). It excludes time before event reached window event queue.
 */
 
 namespace Core
@@ -26,9 +30,12 @@ namespace Core
 
         void MarkFrameStart();
         void MarkFrameEnd();
+        void MarkInputPresented(std::chrono::steady_clock::time_point inputTime);
 
         float GetFrameTime() const;
         float GetFrameRate() const;
+        float GetInputLatency() const;
+        float GetMaxInputLatency() const;
 
     private:
         std::chrono::steady_clock::time_point m_frameStart;
@@ -38,6 +45,12 @@ namespace Core
         float m_frameTimeAverage = 0.0f;
         float m_frameTimeAccumulated = 0.0f;
         int m_frameTimeAccumulations = 0;
+
+        float m_inputLatencyAverage = 0.0f;
+        float m_inputLatencyMaximum = 0.0f;
+        float m_inputLatencyAccumulated = 0.0f;
+        float m_inputLatencyAccumulatedMaximum = 0.0f;
+        int m_inputLatencyAccumulations = 0;
     };
 }
 
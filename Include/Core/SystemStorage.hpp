@@ -16,6 +16,9 @@
 
 namespace Core
 {
+    // Log category for system storage messages.
+    inline Logger::Category LogSystemStorage("Core.SystemStorage");
+
     template<typename SystemBase>
     class SystemStorage final
     {
@@ -74,7 +77,7 @@ namespace Core
             }
             else
             {
-                LOG_ERROR("Failed to create \"{}\" in \"{}\" system storage!",
+                LOG_CATEGORY_ERROR(LogSystemStorage, "Failed to create \"{}\" in \"{}\" system storage!",
                     Reflection::GetName(systemType).GetString(),
                     Reflection::GetName<SystemBase>().GetString());
                 return false;
@@ -88,14 +91,14 @@ namespace Core
     template<typename SystemBase>
     bool SystemStorage<SystemBase>::Attach(std::unique_ptr<SystemBase>&& system)
     {
-        LOG_INFO("System storage \"{}\" is attaching \"{}\"...",
+        LOG_CATEGORY_INFO(LogSystemStorage, "System storage \"{}\" is attaching \"{}\"...",
             Reflection::GetName<SystemBase>().GetString(),
             Reflection::GetName(system).GetString());
 
         // Check if system is valid for attachment.
         if(system == nullptr)
         {
-            LOG_WARNING("Attempted to provide null system to \"{}\" system storage!",
+            LOG_CATEGORY_WARNING(LogSystemStorage, "Attempted to provide null system to \"{}\" system storage!",
                 Reflection::GetName<SystemBase>().GetString());
             return false;
         }
@@ -103,7 +106,7 @@ namespace Core
         const Reflection::TypeIdentifier systemType = Reflection::GetIdentifier(system);
         if(const auto it = m_systemMap.find(systemType); it != m_systemMap.end())
         {
-            LOG_ERROR("Attempted to provide \"{}\" instance that already exists in "
+            LOG_CATEGORY_ERROR(LogSystemStorage, "Attempted to provide \"{}\" instance that already exists in "
                 "\"{}\" system storage!", Reflection::GetName(systemType).GetString(),
                 Reflection::GetName<SystemBase>().GetString());
             return false;
@@ -113,7 +116,7 @@ namespace Core
         auto* systemInterface = static_cast<SystemInterface<SystemBase>*>(system.get());
         if(!systemInterface->OnAttach(*this))
         {
-            LOG_ERROR("Failed to attach \"{}\" to \"{}\" system storage!",
+            LOG_CATEGORY_ERROR(LogSystemStorage, "Failed to attach \"{}\" to \"{}\" system storage!",
                 Reflection::GetName(systemType).GetString(),
                 Reflection::GetName<SystemBase>().GetString());
             return false;
@@ -52,6 +52,7 @@ namespace Editor
         bool m_tickTimeHistogramPaused = false;
 
         float m_tickRateSlider = 0.0f;
+        int m_maxFrameTicksSlider = 0;
         float m_updateDelaySlider = 0.0f;
         float m_updateDelayValue = 0.0f;
         float m_updateNoiseSlider = 0.0f;
@@ -9,11 +9,21 @@
 #include <Core/SystemStorage.hpp>
 #include <Core/EngineSystem.hpp>
 #include <Core/ConfigTypes.hpp>
+#include <System/FramePacer.hpp>
 
 /*
     Engine Root
 
     Main class that encapsulated all engine subsystems.
+
+    Engine can be created headless with "engine.headless" config variable,
+    which creates only systems needed for simulation without window, input,
+    rendering or editor (e.g. for dedicated servers and soak tests on machines
+    without display or GPU).
+
+    Main loop is paced to target frame rate from "engine.frameRateLimit" config
+    variable ("engine.headlessFrameRate" for headless engine), or runs frames
+    as fast as possible (or as vsync allows) without it.
 */
 
 namespace Engine
@@ -40,6 +50,11 @@ namespace Engine
 
         ErrorCode Run();
 
+        bool IsHeadless() const
+        {
+            return m_headless;
+        }
+
         const Core::EngineSystemStorage& GetSystems() const
         {
             return m_engineSystems;
@@ -55,6 +70,8 @@ namespace Engine
 
     private:
         Core::EngineSystemStorage m_engineSystems;
+        System::FramePacer m_framePacer;
         float m_maxUpdateDelta = 1.0f;
+        bool m_headless = false;
     };
 }
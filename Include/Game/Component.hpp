@@ -10,7 +10,11 @@
 /*
     Component
 
-    Base class for component types.
+    Base class for component types. Components are not polymorphic, as they
+    are always stored and accessed through pools of their concrete types.
+    Methods such as OnInitialize() are hidden by component types and called
+    by pools directly, which keeps components without virtual tables, so
+    trivially copyable ones can be saved in snapshots with single copy.
 */
 
 namespace Game
@@ -21,10 +25,10 @@ namespace Game
     {
     protected:
         Component() = default;
-        virtual ~Component() = default;
+        ~Component() = default;
 
     public:
-        virtual bool OnInitialize(ComponentSystem* componentSystem, const EntityHandle& entitySelf)
+        bool OnInitialize(ComponentSystem* componentSystem, const EntityHandle& entitySelf)
         {
             return true;
         }
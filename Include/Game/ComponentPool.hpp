@@ -5,23 +5,64 @@
 
 #pragma once
 
-#include <queue>
+#include <deque>
 #include <vector>
 #include <unordered_map>
 #include "Game/EntityHandle.hpp"
 #include "Game/Component.hpp"
+#include "Game/Snapshot.hpp"
+#include "Game/SnapshotDelta.hpp"
 
 /*
     Component Pool
 
     Manages a pool for a single type of a component.
     See ComponentSystem for more context.
+
+    Pools are saved in snapshots with their exact layout, so restored pool
+    hands out same slots in same order. Trivially copyable components made
+    entirely of reflected fields (without pointers or padding) are copied
+    in bulk together with their entries. Other components have their
+    reflected fields saved one by one, and fields that cannot be saved (e.g.
+    resource references) keep values of component that belonged to the same
+    entity before restoring.
+
+    Snapshot deltas encode only entries that changed since baseline and only
+    their reflected fields that changed. Component that now belongs to other
+    entity than in baseline is encoded against default constructed one.
+    Deltas are restored on top of pool restored from the same baseline.
 */
 
 namespace Game
 {
     class ComponentSystem;
 
+    namespace Detail
+    {
+        // Checks whether reflected fields cover whole component, which means it
+        // has no unreflected members (e.g. pointers resolved on initialization)
+        // or padding that would make identical components differ in bytes.
+        template<typename ComponentType, std::size_t... Indices>
+        constexpr bool IsCoveredByReflectedFields(std::index_sequence<Indices...>)
+        {
+            constexpr auto Members = Reflection::StaticType<ComponentType>().Members;
+
+            constexpr bool HasPointerFields = (false || ... ||
+                std::is_pointer<typename std::decay_t<decltype(Members.template Get<Indices>())>::Type>::value);
+            constexpr std::size_t FieldSize = (std::size_t(0) + ... +
+                sizeof(typename std::decay_t<decltype(Members.template Get<Indices>())>::Type));
+
+            return !HasPointerFields && FieldSize == sizeof(ComponentType);
+        }
+
+        template<typename ComponentType>
+        constexpr bool IsCoveredByReflectedFields()
+        {
+            constexpr auto Members = Reflection::StaticType<ComponentType>().Members;
+            return IsCoveredByReflectedFields<ComponentType>(std::make_index_sequence<Members.Count>());
+        }
+    }
+
     class ComponentPoolInterface
     {
     protected:
@@ -36,6 +77,14 @@ namespace Game
 
         virtual bool InitializeComponent(EntityHandle handle) = 0;
         virtual bool DestroyComponent(EntityHandle handle) = 0;
+
+        virtual Reflection::TypeIdentifier GetTypeIdentifier() const = 0;
+        virtual void SaveSnapshot(SnapshotWriter& writer) const = 0;
+        virtual bool RestoreSnapshot(SnapshotReader& reader) = 0;
+        virtual void SaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const = 0;
+        virtual bool RestoreSnapshotDelta(Common::BitReader& reader) = 0;
+        virtual bool InitializeRestoredComponents() = 0;
+        virtual void ClearComponents() = 0;
     };
 
     template<typename ComponentType>
@@ -43,6 +92,7 @@ namespace Game
     {
     public:
         static_assert(std::is_base_of<Component, ComponentType>::value, "Not a component type.");
+        static_assert(Reflection::IsReflected<ComponentType>(), "Component type must be reflected.");
 
         struct ComponentFlags
         {
@@ -65,7 +115,7 @@ namespace Game
 
         using ComponentIndex = std::size_t;
         using ComponentList = std::vector<ComponentEntry>;
-        using ComponentFreeList = std::queue<ComponentIndex>;
+        using ComponentFreeList = std::deque<ComponentIndex>;
         using ComponentLookup = std::unordered_map<EntityHandle, ComponentIndex>;
 
         class ComponentIterator
@@ -109,9 +159,38 @@ namespace Game
         // Returns true if component was found and destroyed.
         bool DestroyComponent(EntityHandle entity) override;
 
+        // Snapshot restoration replaces all components without
+        // initializing them, which is done in separate step once
+        // all pools are restored, as components can reference others.
+        Reflection::TypeIdentifier GetTypeIdentifier() const override;
+        void SaveSnapshot(SnapshotWriter& writer) const override;
+        bool RestoreSnapshot(SnapshotReader& reader) override;
+        void SaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const override;
+        bool RestoreSnapshotDelta(Common::BitReader& reader) override;
+        bool InitializeRestoredComponents() override;
+        void ClearComponents() override;
+
         ComponentIterator Begin();
         ComponentIterator End();
 
+    private:
+        // Entries are copied in bulk only when all their bytes are meaningful.
+        static constexpr bool IsBulkCopyable = std::is_trivially_copyable<ComponentEntry>::value &&
+            Detail::IsCoveredByReflectedFields<ComponentType>() && sizeof(ComponentEntry) ==
+            sizeof(typename ComponentFlags::Type) + sizeof(EntityHandle) + sizeof(ComponentType);
+
+        static bool ReadSnapshotEntries(SnapshotReader& reader, ComponentList& entries,
+            ComponentFreeList& freeList, ComponentList& previousEntries, const ComponentLookup& previousLookup);
+        static void SaveComponentFields(SnapshotWriter& writer, const ComponentType& component);
+        static bool RestoreComponentFields(SnapshotReader& reader, ComponentType& component);
+        static bool IsComponentChanged(const ComponentType& component, const ComponentType& baseline);
+        static void SaveComponentDelta(Common::BitWriter& writer,
+            const ComponentType& component, const ComponentType& baseline);
+        static bool RestoreComponentDelta(Common::BitReader& reader, ComponentType& component);
+
+        // Returns false if multiple components belong to same entity.
+        bool UpdateLookup();
+
     private:
         ComponentSystem* m_componentSystem;
         ComponentList m_entries;
@@ -206,12 +285,12 @@ namespace Game
             m_entries.emplace_back();
 
             // Add a new entry to the free list queue.
-            m_freeList.emplace(m_entries.size() - 1);
+            m_freeList.emplace_back(m_entries.size() - 1);
         }
 
         // Retrieve an unused component index.
         ComponentIndex componentIndex = m_freeList.front();
-        m_freeList.pop();
+        m_freeList.pop_front();
 
         // Add newly created component to the lookup dictionary.
         auto result = m_lookup.emplace(entity, componentIndex);
@@ -223,6 +302,7 @@ namespace Game
         // Mark component as existing.
         ASSERT(componentEntry.flags == ComponentFlags::Unused);
         componentEntry.flags = ComponentFlags::Exists;
+        componentEntry.entity = entity;
 
         // Return newly created component
         return &componentEntry.component;
@@ -266,12 +346,9 @@ namespace Game
         ASSERT(componentEntry.flags & ComponentFlags::Exists);
         ASSERT(!(componentEntry.flags & ComponentFlags::Initialized));
 
-        // Get base component interface.
-        Component& componentInterface = componentEntry.component;
-
         // Initialize component and return result.
         ASSERT(m_componentSystem != nullptr, "Component system cannot be null!");
-        if(!componentInterface.OnInitialize(m_componentSystem, entity))
+        if(!componentEntry.component.OnInitialize(m_componentSystem, entity))
             return false;
 
         // Mark component as initialized.
@@ -296,6 +373,7 @@ namespace Game
         // Mark component as unused.
         ASSERT(componentEntry.flags & ComponentFlags::Exists);
         componentEntry.flags = ComponentFlags::Unused;
+        componentEntry.entity = EntityHandle();
 
         // Recreate component instance to trigger a destructor and create a new element.
         ComponentType* component = &componentEntry.component;
@@ -304,7 +382,7 @@ namespace Game
         new (component) ComponentType();
 
         // Add an unused component index to the free list.
-        m_freeList.emplace(componentIndex);
+        m_freeList.emplace_back(componentIndex);
 
         // Remove component entry from the dictionary.
         m_lookup.erase(it);
@@ -312,6 +390,442 @@ namespace Game
         return true;
     }
 
+    template<typename ComponentType>
+    Reflection::TypeIdentifier ComponentPool<ComponentType>::GetTypeIdentifier() const
+    {
+        return Reflection::GetIdentifier<ComponentType>();
+    }
+
+    template<typename ComponentType>
+    void ComponentPool<ComponentType>::SaveSnapshot(SnapshotWriter& writer) const
+    {
+        // Write free list in its order, so same slots are reused after restoring.
+        writer.Write(static_cast<uint64_t>(m_entries.size()));
+        writer.Write(static_cast<uint64_t>(m_freeList.size()));
+
+        for(ComponentIndex freeIndex : m_freeList)
+        {
+            writer.Write(static_cast<uint64_t>(freeIndex));
+        }
+
+        // Write component entries with their flags and entity handles.
+        if constexpr(IsBulkCopyable)
+        {
+            writer.Write(static_cast<uint32_t>(sizeof(ComponentEntry)));
+            writer.WriteBytes(m_entries.data(), m_entries.size() * sizeof(ComponentEntry));
+        }
+        else
+        {
+            for(const ComponentEntry& componentEntry : m_entries)
+            {
+                writer.Write(componentEntry.flags);
+                writer.Write(componentEntry.entity);
+
+                if(componentEntry.flags & ComponentFlags::Exists)
+                {
+                    SaveComponentFields(writer, componentEntry.component);
+                }
+            }
+        }
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::RestoreSnapshot(SnapshotReader& reader)
+    {
+        // Move current components out first, so they can be moved to their
+        // new slots and fields that are not saved in snapshot are kept.
+        ComponentList previousEntries;
+        if constexpr(!IsBulkCopyable)
+        {
+            previousEntries.swap(m_entries);
+        }
+
+        if(!ReadSnapshotEntries(reader, m_entries, m_freeList, previousEntries, m_lookup) || !UpdateLookup())
+        {
+            ClearComponents();
+            return false;
+        }
+
+        return true;
+    }
+
+    template<typename ComponentType>
+    void ComponentPool<ComponentType>::SaveSnapshotDelta(
+        const SnapshotReader& baseline, Common::BitWriter& writer) const
+    {
+        // Pool that is missing from baseline is compared against empty one.
+        ComponentList baselineEntries;
+        ComponentFreeList baselineFreeList;
+
+        if(baseline.GetSize() != 0)
+        {
+            SnapshotReader baselineReader = baseline;
+            ComponentList previousEntries;
+            bool baselineRead = ReadSnapshotEntries(baselineReader,
+                baselineEntries, baselineFreeList, previousEntries, ComponentLookup());
+            ASSERT(baselineRead, "Could not read component pool baseline!");
+        }
+
+        writer.WriteVarint(m_entries.size());
+
+        // Free list changes only when components are created or destroyed.
+        bool freeListChanged = m_freeList != baselineFreeList;
+        writer.WriteBool(freeListChanged);
+
+        if(freeListChanged)
+        {
+            writer.WriteVarint(m_freeList.size());
+            for(ComponentIndex freeIndex : m_freeList)
+            {
+                writer.WriteVarint(freeIndex);
+            }
+        }
+
+        // Write single bit for every entry that has not changed.
+        const ComponentEntry unusedEntry{};
+
+        for(ComponentIndex componentIndex = 0; componentIndex < m_entries.size(); ++componentIndex)
+        {
+            const ComponentEntry& componentEntry = m_entries[componentIndex];
+            const ComponentEntry& baselineEntry = componentIndex < baselineEntries.size() ?
+                baselineEntries[componentIndex] : unusedEntry;
+
+            const ComponentType& baselineComponent = componentEntry.entity == baselineEntry.entity ?
+                baselineEntry.component : unusedEntry.component;
+
+            bool headerChanged = componentEntry.flags != baselineEntry.flags ||
+                componentEntry.entity != baselineEntry.entity;
+            bool componentChanged = (componentEntry.flags & ComponentFlags::Exists) &&
+                IsComponentChanged(componentEntry.component, baselineComponent);
+
+            writer.WriteBool(headerChanged || componentChanged);
+            if(!headerChanged && !componentChanged)
+                continue;
+
+            writer.WriteBool(headerChanged);
+            if(headerChanged)
+            {
+                writer.WriteVarint(componentEntry.flags);
+                writer.WriteBytes(&componentEntry.entity, sizeof(EntityHandle));
+            }
+
+            if(componentEntry.flags & ComponentFlags::Exists)
+            {
+                SaveComponentDelta(writer, componentEntry.component, baselineComponent);
+            }
+        }
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::RestoreSnapshotDelta(Common::BitReader& reader)
+    {
+        auto failure = [this]()
+        {
+            ClearComponents();
+            return false;
+        };
+
+        // Every entry takes at least one bit, which limits their count.
+        uint64_t entryCount = reader.ReadVarint();
+        if(!reader.IsValid() || entryCount > m_entries.size() + reader.GetRemainingBitCount())
+            return failure();
+
+        m_entries.resize(static_cast<std::size_t>(entryCount));
+
+        if(reader.ReadBool())
+        {
+            uint64_t freeCount = reader.ReadVarint();
+            if(!reader.IsValid() || freeCount > entryCount)
+                return failure();
+
+            m_freeList.resize(static_cast<std::size_t>(freeCount));
+            for(ComponentIndex& freeIndex : m_freeList)
+            {
+                uint64_t index = reader.ReadVarint();
+                if(!reader.IsValid() || index >= entryCount)
+                    return failure();
+
+                freeIndex = static_cast<ComponentIndex>(index);
+            }
+        }
+
+        for(ComponentEntry& componentEntry : m_entries)
+        {
+            if(!reader.ReadBool())
+                continue;
+
+            if(reader.ReadBool())
+            {
+                EntityHandle previousEntity = componentEntry.entity;
+                componentEntry.flags = static_cast<typename ComponentFlags::Type>(reader.ReadVarint());
+                if(!reader.ReadBytes(&componentEntry.entity, sizeof(EntityHandle)))
+                    return failure();
+
+                if(componentEntry.entity != previousEntity)
+                {
+                    componentEntry.component = ComponentType();
+                }
+            }
+
+            if(componentEntry.flags & ComponentFlags::Exists)
+            {
+                if(!RestoreComponentDelta(reader, componentEntry.component))
+                    return failure();
+            }
+        }
+
+        for(ComponentIndex freeIndex : m_freeList)
+        {
+            if(freeIndex >= m_entries.size())
+                return failure();
+        }
+
+        if(!reader.IsValid() || !UpdateLookup())
+            return failure();
+
+        return true;
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::InitializeRestoredComponents()
+    {
+        // Components that were initialized when snapshot was saved
+        // have their references to other components resolved again.
+        ASSERT(m_componentSystem != nullptr, "Component system cannot be null!");
+
+        for(ComponentEntry& componentEntry : m_entries)
+        {
+            if(componentEntry.flags & ComponentFlags::Initialized)
+            {
+                if(!componentEntry.component.OnInitialize(m_componentSystem, componentEntry.entity))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename ComponentType>
+    void ComponentPool<ComponentType>::ClearComponents()
+    {
+        m_entries.clear();
+        m_lookup.clear();
+        m_freeList.clear();
+    }
+
+    template<typename ComponentType>
+    void ComponentPool<ComponentType>::SaveComponentFields(
+        SnapshotWriter& writer, const ComponentType& component)
+    {
+        Reflection::ForEach(Reflection::StaticType<ComponentType>().Members,
+            [&writer, &component](const auto& member)
+        {
+            using MemberType = typename std::decay_t<decltype(member)>::Type;
+            static_assert(!std::is_pointer<MemberType>::value,
+                "Pointers are not valid across snapshots, reflect stable index or hash instead!");
+            const MemberType& field = component.*(member.Pointer);
+
+            if constexpr(std::is_same<MemberType, std::string>::value)
+            {
+                writer.WriteString(field);
+            }
+            else if constexpr(std::is_trivially_copyable<MemberType>::value)
+            {
+                writer.Write(field);
+            }
+        });
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::RestoreComponentFields(
+        SnapshotReader& reader, ComponentType& component)
+    {
+        Reflection::ForEach(Reflection::StaticType<ComponentType>().Members,
+            [&reader, &component](const auto& member)
+        {
+            using MemberType = typename std::decay_t<decltype(member)>::Type;
+            static_assert(!std::is_pointer<MemberType>::value,
+                "Pointers are not valid across snapshots, reflect stable index or hash instead!");
+            MemberType& field = component.*(member.Pointer);
+
+            if constexpr(std::is_same<MemberType, std::string>::value)
+            {
+                reader.ReadString(field);
+            }
+            else if constexpr(std::is_trivially_copyable<MemberType>::value)
+            {
+                reader.Read(field);
+            }
+        });
+
+        return reader.IsValid();
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::ReadSnapshotEntries(SnapshotReader& reader, ComponentList& entries,
+        ComponentFreeList& freeList, ComponentList& previousEntries, const ComponentLookup& previousLookup)
+    {
+        // Read free list that is reused without reallocating.
+        uint64_t entryCount = 0;
+        uint64_t freeCount = 0;
+        if(!reader.Read(entryCount) || !reader.Read(freeCount) || freeCount > entryCount)
+            return false;
+
+        freeList.resize(static_cast<std::size_t>(freeCount));
+        for(ComponentIndex& freeIndex : freeList)
+        {
+            uint64_t index = 0;
+            if(!reader.Read(index) || index >= entryCount)
+                return false;
+
+            freeIndex = static_cast<ComponentIndex>(index);
+        }
+
+        // Read component entries.
+        if constexpr(IsBulkCopyable)
+        {
+            uint32_t entrySize = 0;
+            if(!reader.Read(entrySize) || entrySize != sizeof(ComponentEntry))
+                return false;
+
+            entries.resize(static_cast<std::size_t>(entryCount));
+            return reader.ReadBytes(entries.data(), entries.size() * sizeof(ComponentEntry));
+        }
+        else
+        {
+            entries.resize(static_cast<std::size_t>(entryCount));
+
+            for(ComponentEntry& componentEntry : entries)
+            {
+                if(!reader.Read(componentEntry.flags) || !reader.Read(componentEntry.entity))
+                    return false;
+
+                if(componentEntry.flags & ComponentFlags::Exists)
+                {
+                    auto previousIt = previousLookup.find(componentEntry.entity);
+                    if(previousIt != previousLookup.end() && previousIt->second < previousEntries.size())
+                    {
+                        componentEntry.component = std::move(previousEntries[previousIt->second].component);
+                    }
+
+                    if(!RestoreComponentFields(reader, componentEntry.component))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::UpdateLookup()
+    {
+        // Keep lookup dictionary if components have not moved since
+        // snapshot was saved, which is common when rolling back few
+        // ticks, as rebuilding it is the most expensive part of restore.
+        std::size_t existingCount = 0;
+        bool lookupValid = true;
+
+        for(ComponentIndex componentIndex = 0; componentIndex < m_entries.size(); ++componentIndex)
+        {
+            const ComponentEntry& componentEntry = m_entries[componentIndex];
+            if(componentEntry.flags & ComponentFlags::Exists)
+            {
+                auto it = m_lookup.find(componentEntry.entity);
+                if(it == m_lookup.end() || it->second != componentIndex)
+                {
+                    lookupValid = false;
+                    break;
+                }
+
+                ++existingCount;
+            }
+        }
+
+        if(lookupValid && existingCount == m_lookup.size())
+            return true;
+
+        // Rebuild lookup dictionary from existing components.
+        m_lookup.clear();
+
+        for(ComponentIndex componentIndex = 0; componentIndex < m_entries.size(); ++componentIndex)
+        {
+            const ComponentEntry& componentEntry = m_entries[componentIndex];
+            if(componentEntry.flags & ComponentFlags::Exists)
+            {
+                if(!m_lookup.emplace(componentEntry.entity, componentIndex).second)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::IsComponentChanged(
+        const ComponentType& component, const ComponentType& baseline)
+    {
+        bool changed = false;
+        Reflection::ForEach(Reflection::StaticType<ComponentType>().Members,
+            [&component, &baseline, &changed](const auto& member)
+        {
+            if(!changed)
+            {
+                changed = SnapshotDelta::IsFieldChanged(component.*(member.Pointer), baseline.*(member.Pointer),
+                    SnapshotDelta::GetQuantizePrecision(member));
+            }
+        });
+
+        return changed;
+    }
+
+    template<typename ComponentType>
+    void ComponentPool<ComponentType>::SaveComponentDelta(Common::BitWriter& writer,
+        const ComponentType& component, const ComponentType& baseline)
+    {
+        Reflection::ForEach(Reflection::StaticType<ComponentType>().Members,
+            [&writer, &component, &baseline](const auto& member)
+        {
+            using MemberType = typename std::decay_t<decltype(member)>::Type;
+            if constexpr(SnapshotDelta::IsFieldSupported<MemberType>())
+            {
+                const MemberType& field = component.*(member.Pointer);
+                const MemberType& baselineField = baseline.*(member.Pointer);
+                const float precision = SnapshotDelta::GetQuantizePrecision(member);
+
+                bool changed = SnapshotDelta::IsFieldChanged(field, baselineField, precision);
+                writer.WriteBool(changed);
+
+                if(changed)
+                {
+                    SnapshotDelta::WriteField(writer, field, baselineField, precision);
+                }
+            }
+        });
+    }
+
+    template<typename ComponentType>
+    bool ComponentPool<ComponentType>::RestoreComponentDelta(
+        Common::BitReader& reader, ComponentType& component)
+    {
+        bool restored = true;
+        Reflection::ForEach(Reflection::StaticType<ComponentType>().Members,
+            [&reader, &component, &restored](const auto& member)
+        {
+            using MemberType = typename std::decay_t<decltype(member)>::Type;
+            if constexpr(SnapshotDelta::IsFieldSupported<MemberType>())
+            {
+                if(restored && reader.ReadBool())
+                {
+                    restored = SnapshotDelta::ReadField(reader, component.*(member.Pointer),
+                        SnapshotDelta::GetQuantizePrecision(member));
+                }
+            }
+        });
+
+        return restored && reader.IsValid();
+    }
+
     template<typename ComponentType>
     typename ComponentPool<ComponentType>::ComponentIterator ComponentPool<ComponentType>::Begin()
     {
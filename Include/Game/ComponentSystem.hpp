@@ -14,6 +14,10 @@
     Component System
 
     Manages component types and their instances.
+
+    Component types have to be registered to have their pools created when
+    restoring snapshots that contain them. Types are registered when their
+    pools are created, while built-in components are registered by default.
 */
 
 namespace Game
@@ -29,6 +33,8 @@ namespace Game
         using ComponentPoolPtr = std::unique_ptr<ComponentPoolInterface>;
         using ComponentPoolList = std::unordered_map<std::type_index, ComponentPoolPtr>;
         using ComponentPoolPair = ComponentPoolList::value_type;
+        using ComponentPoolFactory = ComponentPoolInterface* (*)(ComponentSystem&);
+        using ComponentPoolFactoryList = std::unordered_map<Reflection::TypeIdentifier, ComponentPoolFactory>;
 
     public:
         ComponentSystem();
@@ -49,10 +55,17 @@ namespace Game
         template<typename ComponentType>
         typename ComponentPool<ComponentType>::ComponentIterator End();
 
+        template<typename ComponentType>
+        void RegisterComponentType();
+
         EntitySystem* GetEntitySystem() const;
 
     private:
         bool OnAttach(const GameSystemStorage& gameSystems) override;
+        void OnSaveSnapshot(SnapshotWriter& writer) const override;
+        bool OnRestoreSnapshot(SnapshotReader& reader) override;
+        void OnSaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const override;
+        bool OnRestoreSnapshotDelta(const SnapshotReader& baseline, Common::BitReader& reader) override;
 
         const EntityEntry* GetEntityEntry(EntityHandle handle) const;
 
@@ -62,6 +75,14 @@ namespace Game
         template<typename ComponentType>
         ComponentPool<ComponentType>* CreatePool();
 
+        template<typename ComponentType>
+        static ComponentPoolInterface* CreatePoolFromFactory(ComponentSystem& componentSystem);
+
+        ComponentPoolInterface* FindPool(Reflection::TypeIdentifier identifier) const;
+        ComponentPoolInterface* FindOrCreatePool(Reflection::TypeIdentifier identifier);
+        std::vector<const ComponentPoolInterface*> GetSortedPools() const;
+        bool FinishRestoringPools(const std::vector<ComponentPoolInterface*>& restoredPools);
+
         Event::Receiver<bool(EntityHandle)> m_entityCreate;
         Event::Receiver<void(EntityHandle)> m_entityDestroy;
 
@@ -71,6 +92,7 @@ namespace Game
     private:
         EntitySystem* m_entitySystem = nullptr;
         ComponentPoolList m_pools;
+        ComponentPoolFactoryList m_poolFactories;
     };
 
     template<typename ComponentType>
@@ -178,10 +200,33 @@ namespace Game
 
         ASSERT(result.second == true, "Failed to insert new component pool type!");
 
+        // Register type so its pool can be recreated from snapshots.
+        this->RegisterComponentType<ComponentType>();
+
         // Return created pool.
         return reinterpret_cast<ComponentPool<ComponentType>*>(result.first->second.get());
     }
 
+    template<typename ComponentType>
+    ComponentPoolInterface* ComponentSystem::CreatePoolFromFactory(ComponentSystem& componentSystem)
+    {
+        return componentSystem.CreatePool<ComponentType>();
+    }
+
+    template<typename ComponentType>
+    void ComponentSystem::RegisterComponentType()
+    {
+        // Validate component type.
+        static_assert(std::is_base_of<Component, ComponentType>::value, "Not a component type.");
+
+        // Add pool factory for component type identifier.
+        auto result = m_poolFactories.emplace(Reflection::GetIdentifier<ComponentType>(),
+            &ComponentSystem::CreatePoolFromFactory<ComponentType>);
+
+        ASSERT(result.second || result.first->second == &ComponentSystem::CreatePoolFromFactory<ComponentType>,
+            "Component type identifier collides with another registered component type!");
+    }
+
     template<typename ComponentType>
     typename ComponentPool<ComponentType>::ComponentIterator ComponentSystem::Begin()
     {
@@ -19,6 +19,8 @@ namespace Game
 
     class CameraComponent final : public Component
     {
+        REFLECTION_FRIEND(CameraComponent)
+
     public:
         struct ProjectionTypes
         {
@@ -31,8 +33,11 @@ namespace Game
             using Type = unsigned int;
         };
 
-        CameraComponent();
-        ~CameraComponent();
+        CameraComponent() = default;
+        ~CameraComponent() = default;
+
+        bool OnInitialize(ComponentSystem* componentSystem,
+            const EntityHandle& entitySelf);
 
         void SetupOrthogonal(const glm::vec2& viewSize, float nearPlane, float farPlane);
         void SetupPerspective(float fov, float nearPlane, float farPlane);
@@ -41,9 +46,6 @@ namespace Game
         TransformComponent* GetTransformComponent();
 
     private:
-        bool OnInitialize(ComponentSystem* componentSystem,
-            const EntityHandle& entitySelf) override;
-
         TransformComponent* m_transform = nullptr;
         ProjectionTypes::Type m_projection = ProjectionTypes::Perspective;
         glm::vec2 m_viewSize = glm::vec2(2.0f, 2.0f);
@@ -52,3 +54,11 @@ namespace Game
         float m_fov = 90.0f;
     };
 }
+
+REFLECTION_STATIC_TYPE_BEGIN(Game::CameraComponent)
+    REFLECTION_FIELD(m_projection)
+    REFLECTION_FIELD(m_viewSize)
+    REFLECTION_FIELD(m_nearPlane)
+    REFLECTION_FIELD(m_farPlane)
+    REFLECTION_FIELD(m_fov)
+REFLECTION_TYPE_END
@@ -11,7 +11,9 @@
 /*
     Sprite Animation Component
 
-    Playback control for animated sequence of sprites.
+    Playback control for animated sequence of sprites. Playing animation is
+    referenced by its name hash and looked up in animation list when needed,
+    so it remains valid when animation list is reloaded.
 */
 
 namespace Game
@@ -20,6 +22,8 @@ namespace Game
 
     class SpriteAnimationComponent final : public Component
     {
+        REFLECTION_FRIEND(SpriteAnimationComponent)
+
     public:
         struct PlaybackFlags
         {
@@ -39,6 +43,9 @@ namespace Game
         SpriteAnimationComponent();
         ~SpriteAnimationComponent();
 
+        bool OnInitialize(ComponentSystem* componentSystem,
+            const EntityHandle& entitySelf);
+
         void SetSpriteAnimationList(SpriteAnimationListPtr spriteAnimationList);
         void ResetInterpolation();
         void Tick(float timeDelta);
@@ -56,14 +63,19 @@ namespace Game
         const SpriteAnimation* GetSpriteAnimation() const;
 
     private:
-        bool OnInitialize(ComponentSystem* componentSystem,
-            const EntityHandle& entitySelf) override;
-
         SpriteComponent* m_spriteComponent = nullptr;
         SpriteAnimationListPtr m_spriteAnimationList = nullptr;
-        const SpriteAnimation* m_playingSpriteAnimation = nullptr;
+        uint64_t m_playingAnimationHash = 0;
         PlaybackFlags::Type m_playbackInfo = PlaybackFlags::None;
         float m_currentAnimationTime = 0.0f;
         float m_previousAnimationTime = 0.0f;
     };
 }
+
+REFLECTION_STATIC_TYPE_BEGIN(Game::SpriteAnimationComponent)
+    REFLECTION_FIELD(m_spriteAnimationList)
+    REFLECTION_FIELD(m_playingAnimationHash)
+    REFLECTION_FIELD(m_playbackInfo)
+    REFLECTION_FIELD(m_currentAnimationTime)
+    REFLECTION_FIELD(m_previousAnimationTime)
+REFLECTION_TYPE_END
@@ -21,10 +21,15 @@ namespace Game
 
     class SpriteComponent final : public Component
     {
+        REFLECTION_FRIEND(SpriteComponent)
+
     public:
         SpriteComponent();
         ~SpriteComponent();
 
+        bool OnInitialize(ComponentSystem* componentSystem,
+            const EntityHandle& entitySelf);
+
         void SetTextureView(Graphics::TextureView texture);
         void SetRectangle(const glm::vec4& rectangle);
         void SetColor(const glm::vec4& color);
@@ -39,9 +44,6 @@ namespace Game
         bool IsFiltered() const;
 
     private:
-        bool OnInitialize(ComponentSystem* componentSystem,
-            const EntityHandle& entitySelf) override;
-
         TransformComponent* m_transformComponent = nullptr;
         Graphics::TextureView m_textureView;
         glm::vec4 m_rectangle = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
@@ -50,3 +52,11 @@ namespace Game
         bool m_filtered = true;
     };
 }
+
+REFLECTION_STATIC_TYPE_BEGIN(Game::SpriteComponent)
+    REFLECTION_FIELD(m_textureView)
+    REFLECTION_FIELD(m_rectangle)
+    REFLECTION_FIELD(m_color)
+    REFLECTION_FIELD(m_transparent)
+    REFLECTION_FIELD(m_filtered)
+REFLECTION_TYPE_END
@@ -6,21 +6,26 @@
 #pragma once
 
 #include "Game/Component.hpp"
+#include "Game/SnapshotDelta.hpp"
 
 /*
     Transform Component
 
     Interpolated transform that represents
     position, rotation and scale in the world.
+    Quantized in snapshot deltas to 1/1024 of unit
+    and 1/16384 for rotation quaternion components.
 */
 
 namespace Game
 {
     class TransformComponent final : public Component
     {
+        REFLECTION_FRIEND(TransformComponent)
+
     public:
-        TransformComponent();
-        ~TransformComponent();
+        TransformComponent() = default;
+        ~TransformComponent() = default;
 
         void ResetInterpolation();
         void SetPosition(const glm::vec3& position);
@@ -42,3 +47,12 @@ namespace Game
         glm::vec3 m_previousScale = glm::vec3(1.0f, 1.0f, 1.0f);
     };
 }
+
+REFLECTION_STATIC_TYPE_BEGIN(Game::TransformComponent)
+    REFLECTION_FIELD(m_currentRotation, Game::QuantizeAttribute(1.0f / 16384.0f))
+    REFLECTION_FIELD(m_previousRotation, Game::QuantizeAttribute(1.0f / 16384.0f))
+    REFLECTION_FIELD(m_currentPosition, Game::QuantizeAttribute(1.0f / 1024.0f))
+    REFLECTION_FIELD(m_previousPosition, Game::QuantizeAttribute(1.0f / 1024.0f))
+    REFLECTION_FIELD(m_currentScale, Game::QuantizeAttribute(1.0f / 1024.0f))
+    REFLECTION_FIELD(m_previousScale, Game::QuantizeAttribute(1.0f / 1024.0f))
+REFLECTION_TYPE_END
@@ -72,6 +72,8 @@ namespace Game
 
     private:
         void OnTick(float timeDelta) override;
+        void OnSaveSnapshot(SnapshotWriter& writer) const override;
+        bool OnRestoreSnapshot(SnapshotReader& reader) override;
 
         CommandList m_commands;
         EntityList m_entities;
@@ -28,6 +28,7 @@ namespace Renderer
 namespace Game
 {
     class GameState;
+    class GameInstanceHost;
 
     class GameFramework final : public Core::EngineSystem
     {
@@ -56,6 +57,10 @@ namespace Game
         ProcessGameStateResults ProcessGameState(float timeDelta);
         bool HasGameState() const;
 
+        // Hosted game instances are ticked in parallel every frame,
+        // independently from game instance of current game state.
+        GameInstanceHost& GetInstanceHost();
+
         struct Events
         {
             // Called whether game state changes.
@@ -81,6 +86,7 @@ namespace Game
     private:
         System::Timer* m_timer = nullptr;
         Common::StateMachine<GameState> m_stateMachine;
+        std::unique_ptr<GameInstanceHost> m_instanceHost;
     };
 }
 
@@ -10,10 +10,31 @@
 
 /*
     Game Instance
+
+    World state of game instance can be saved in snapshot and restored later
+    (see Snapshot). Restoring replaces state of all systems without dispatching
+    any events, which makes it fast enough for rollback and level restarts.
+    State of systems is undefined after failed restore and instance should
+    be recreated then.
+
+    World state can also be replicated to other instances as snapshot deltas
+    (see SnapshotDelta), encoded against baseline snapshot that both sides
+    have. Sender keeps snapshots it saved for ticks that observers may still
+    acknowledge, while observers keep snapshots of state they restored.
+    Empty baseline stands for state of newly created instance.
 */
 
+namespace Common
+{
+    class BitWriter;
+    class BitReader;
+}
+
 namespace Game
 {
+    class SnapshotWriter;
+    class SnapshotReader;
+
     class GameInstance final : private Common::NonCopyable
     {
     public:
@@ -25,11 +46,30 @@ namespace Game
         using CreateResult = Common::Result<std::unique_ptr<GameInstance>, CreateErrors>;
         static CreateResult Create();
 
+        enum class RestoreSnapshotErrors
+        {
+            InvalidHeader,
+            UnsupportedVersion,
+            InvalidSection,
+            FailedSystemRestore,
+        };
+
+        using RestoreSnapshotResult = Common::Result<void, RestoreSnapshotErrors>;
+
     public:
         ~GameInstance();
 
         void Tick(float timeDelta);
 
+        void SaveSnapshot(SnapshotWriter& writer);
+        RestoreSnapshotResult RestoreSnapshot(SnapshotReader& reader);
+
+        // Baseline has to be snapshot saved by this instance.
+        void SaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer);
+
+        // Restores baseline snapshot saved by this instance and applies delta on top of it.
+        RestoreSnapshotResult RestoreSnapshotDelta(const SnapshotReader& baseline, Common::BitReader& reader);
+
         const GameSystemStorage& GetSystems() const
         {
             return m_gameSystems;
@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace System
+{
+    class Timer;
+}
+
+/*
+    Game Instance Host
+
+    Hosts many independent game instances (e.g. matches or shards of dedicated
+    server) and ticks them in parallel, each with its own tick timer. Instances
+    are processed by worker threads together with calling thread, which waits
+    until all of them are ticked, so hosted instances can be safely accessed
+    between advances from thread that owns host.
+
+    Instances do not share any state and all logic that changes their world
+    state has to run in their game systems. Global systems used during ticks
+    (logger, name registry and reflection registry) are safe to use from
+    multiple threads, as long as reflection is initialized beforehand.
+*/
+
+namespace Game
+{
+    class GameInstance;
+    class TickTimer;
+
+    class GameInstanceHost final : private Common::NonCopyable
+    {
+    public:
+        struct CreateFromParams
+        {
+            // Maximum number of worker threads helping calling thread.
+            // Workers are started as instances are hosted, one less than
+            // number of instances as calling thread also ticks them.
+            // Without any, instances are ticked on calling thread.
+            uint32_t workerThreads = 0;
+        };
+
+        using CreateResult = Common::Result<std::unique_ptr<GameInstanceHost>, void>;
+        static CreateResult Create(const CreateFromParams& params);
+
+        enum class HostErrors
+        {
+            InvalidArgument,
+            FailedTickTimerCreation,
+        };
+
+        using HostResult = Common::Result<void, HostErrors>;
+
+    public:
+        ~GameInstanceHost();
+
+        // Tick timer with default tick time is created if none is given.
+        HostResult Host(std::unique_ptr<GameInstance> gameInstance,
+            std::unique_ptr<TickTimer> tickTimer = nullptr);
+
+        // Returns hosted game instance or null if it is not hosted.
+        std::unique_ptr<GameInstance> Release(GameInstance* gameInstance);
+
+        // Ticks all hosted instances in parallel using time of given timer.
+        void Advance(const System::Timer& timer);
+
+        GameInstance* GetInstance(std::size_t index) const;
+        TickTimer* GetTickTimer(std::size_t index) const;
+        std::size_t GetInstanceCount() const;
+        std::size_t GetWorkerThreadCount() const;
+
+    private:
+        GameInstanceHost();
+
+        void StartWorkerThreads();
+        void RunWorkerThread(uint64_t workGeneration);
+        void ProcessInstances();
+
+    private:
+        struct HostedInstance
+        {
+            std::unique_ptr<GameInstance> gameInstance;
+            std::unique_ptr<TickTimer> tickTimer;
+        };
+
+        std::vector<HostedInstance> m_instances;
+        std::atomic<std::size_t> m_nextInstance = 0;
+
+        std::vector<std::thread> m_workerThreads;
+        std::size_t m_maxWorkerThreads = 0;
+        std::mutex m_workLock;
+        std::condition_variable m_workCondition;
+        std::condition_variable m_doneCondition;
+        uint64_t m_workGeneration = 0;
+        std::size_t m_pendingWorkers = 0;
+        bool m_workStopped = false;
+    };
+}
@@ -10,6 +10,7 @@
 namespace Game
 {
     class TickTimer;
+    class TickSimulation;
     class GameInstance;
 }
 
@@ -35,6 +36,14 @@ namespace Game
             return nullptr;
         }
 
+        // Override if game state wants its game instance ticked deterministically.
+        // Game instance is then ticked by simulation with its fixed tick time,
+        // while tick timer only decides when ticks are due.
+        virtual TickSimulation* GetTickSimulation() const
+        {
+            return nullptr;
+        }
+
         // Override if game state provides game instance.
         // Game framework will then automatically process game instance for this state.
         virtual GameInstance* GetGameInstance() const
@@ -11,10 +11,25 @@
     Game System
 
     Base class for game systems to be used with system storage.
+    Systems that hold world state save it in snapshots, which are
+    restored without dispatching any events (see GameInstance).
+
+    Snapshot deltas are encoded by default as bytes that changed in
+    snapshot section of system since baseline. Systems with state that
+    changes often should override them with more compact encoding.
 */
 
+namespace Common
+{
+    class BitWriter;
+    class BitReader;
+}
+
 namespace Game
 {
+    class SnapshotWriter;
+    class SnapshotReader;
+
     class GameSystem : public Core::SystemInterface<GameSystem>
     {
         REFLECTION_ENABLE(GameSystem)
@@ -26,6 +41,20 @@ namespace Game
         {
         }
 
+        virtual void OnSaveSnapshot(SnapshotWriter& writer) const
+        {
+        }
+
+        virtual bool OnRestoreSnapshot(SnapshotReader& reader)
+        {
+            return true;
+        }
+
+        // Baseline is snapshot section of this system. Delta is
+        // restored on top of state that has been restored from it.
+        virtual void OnSaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const;
+        virtual bool OnRestoreSnapshotDelta(const SnapshotReader& baseline, Common::BitReader& reader);
+
     protected:
         GameSystem() = default;
 
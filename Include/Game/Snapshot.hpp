@@ -0,0 +1,133 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <vector>
+
+/*
+    Snapshot
+
+    Binary streams for saving and restoring world state of game instance
+    (see GameInstance::SaveSnapshot). Values are stored in native byte order,
+    as snapshots are meant for restoring within same process (e.g. rollback
+    or instant level restart) and not as persistent save files.
+
+    Snapshot is a sequence of sections, one per game system, identified by
+    type identifier and prefixed with their byte size. Sections that are not
+    recognized when restoring are skipped, which allows systems to be added
+    without invalidating snapshots. Format version is bumped on every change
+    to existing sections.
+
+    [Header]            Magic and format version.
+    [Section...]        Type identifier, byte size and contents of section.
+*/
+
+namespace Game
+{
+    namespace SnapshotFormat
+    {
+        constexpr uint32_t Magic = 0x50414E53; // "SNAP"
+        constexpr uint32_t Version = 1;
+
+        struct Header
+        {
+            uint32_t magic = Magic;
+            uint32_t version = Version;
+        };
+
+        static_assert(sizeof(Header) == 8);
+    }
+
+    class SnapshotWriter final
+    {
+    public:
+        SnapshotWriter();
+        ~SnapshotWriter();
+
+        template<typename Type>
+        void Write(const Type& value);
+        void WriteBytes(const void* data, std::size_t size);
+        void WriteString(const std::string& text);
+
+        // Returns offset to be passed when section ends.
+        std::size_t BeginSection(Reflection::TypeIdentifier identifier);
+        void EndSection(std::size_t sectionOffset);
+
+        // Clears written data while keeping allocated memory.
+        void Reset();
+
+        const std::vector<uint8_t>& GetData() const
+        {
+            return m_data;
+        }
+
+    private:
+        std::vector<uint8_t> m_data;
+    };
+
+    class SnapshotReader final
+    {
+    public:
+        SnapshotReader(const uint8_t* data, std::size_t size);
+        SnapshotReader(const std::vector<uint8_t>& data);
+        ~SnapshotReader();
+
+        // Reads fail once there is not enough data left and
+        // all subsequent reads fail as well after that.
+        template<typename Type>
+        bool Read(Type& value);
+        bool ReadBytes(void* data, std::size_t size);
+        bool ReadString(std::string& text);
+
+        // Returns reader limited to contents of next section.
+        bool ReadSection(Reflection::TypeIdentifier& identifier, SnapshotReader& section);
+
+        bool IsValid() const
+        {
+            return m_valid;
+        }
+
+        bool IsEnd() const
+        {
+            return m_offset == m_size;
+        }
+
+        // Returns all data viewed by reader, regardless of read offset.
+        const uint8_t* GetData() const
+        {
+            return m_data;
+        }
+
+        std::size_t GetSize() const
+        {
+            return m_size;
+        }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_offset = 0;
+        bool m_valid = true;
+    };
+
+    template<typename Type>
+    void SnapshotWriter::Write(const Type& value)
+    {
+        static_assert(std::is_trivially_copyable<Type>::value,
+            "Only trivially copyable types can be written as bytes!");
+
+        WriteBytes(&value, sizeof(Type));
+    }
+
+    template<typename Type>
+    bool SnapshotReader::Read(Type& value)
+    {
+        static_assert(std::is_trivially_copyable<Type>::value,
+            "Only trivially copyable types can be read as bytes!");
+
+        return ReadBytes(&value, sizeof(Type));
+    }
+}
@@ -0,0 +1,222 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <Common/BitStream.hpp>
+
+/*
+    Snapshot Delta
+
+    Bit packed difference between current world state and baseline snapshot
+    (see GameInstance::SaveSnapshotDelta), used for replicating world state
+    to observers that acknowledged receiving baseline earlier.
+
+    Component fields marked with quantize attribute are sent as difference
+    of their values rounded to given precision, which takes only few bits
+    for small changes. Precision should be a power of two, so quantized
+    values received by observers round back to the same integers.
+
+    Receiving side keeps quantized values, so its own snapshots do not match
+    ones saved by sending side byte for byte. Both sides agree on quantized
+    state, which is what deltas are encoded against.
+*/
+
+namespace Game
+{
+    class QuantizeAttribute : public Reflection::FieldAttribute
+    {
+        REFLECTION_ENABLE(QuantizeAttribute, Reflection::FieldAttribute)
+
+    public:
+        constexpr QuantizeAttribute(const float precision) :
+            precision(precision)
+        {
+        }
+
+        const float precision = 0.0f;
+    };
+
+    namespace SnapshotDelta
+    {
+        // Fields of these types can be quantized.
+        template<typename Type>
+        struct QuantizedComponents
+        {
+            static constexpr glm::length_t Count = 0;
+        };
+
+        template<>
+        struct QuantizedComponents<float>
+        {
+            static constexpr glm::length_t Count = 1;
+        };
+
+        template<glm::length_t Length, glm::qualifier Qualifier>
+        struct QuantizedComponents<glm::vec<Length, float, Qualifier>>
+        {
+            static constexpr glm::length_t Count = Length;
+        };
+
+        template<glm::qualifier Qualifier>
+        struct QuantizedComponents<glm::qua<float, Qualifier>>
+        {
+            static constexpr glm::length_t Count = 4;
+        };
+
+        inline int64_t Quantize(float value, float precision)
+        {
+            return static_cast<int64_t>(std::llround(value / precision));
+        }
+
+        template<typename MemberDescription>
+        float GetQuantizePrecision(const MemberDescription& member)
+        {
+            float precision = 0.0f;
+            Reflection::ForEach(member.Attributes, [&precision](const auto& attribute)
+            {
+                using AttributeType = typename std::decay_t<decltype(attribute)>::Type;
+                if constexpr(std::is_same<AttributeType, QuantizeAttribute>::value)
+                {
+                    precision = attribute.Instance.precision;
+                }
+            });
+
+            return precision;
+        }
+
+        // Fields that are not supported are never sent. Pointers have no meaning
+        // on receiving side, so stable index or hash should be replicated instead.
+        template<typename Type>
+        constexpr bool IsFieldSupported()
+        {
+            return std::is_same<Type, std::string>::value ||
+                (std::is_trivially_copyable<Type>::value && !std::is_pointer<Type>::value);
+        }
+
+        template<typename Type>
+        bool IsFieldChanged(const Type& current, const Type& baseline, float precision)
+        {
+            if constexpr(std::is_same<Type, std::string>::value)
+            {
+                return current != baseline;
+            }
+            else if constexpr(IsFieldSupported<Type>())
+            {
+                constexpr glm::length_t Count = QuantizedComponents<Type>::Count;
+                if constexpr(Count != 0)
+                {
+                    if(precision > 0.0f)
+                    {
+                        float currentValues[Count];
+                        float baselineValues[Count];
+                        std::memcpy(currentValues, &current, sizeof(currentValues));
+                        std::memcpy(baselineValues, &baseline, sizeof(baselineValues));
+
+                        for(glm::length_t i = 0; i < Count; ++i)
+                        {
+                            if(Quantize(currentValues[i], precision) != Quantize(baselineValues[i], precision))
+                                return true;
+                        }
+
+                        return false;
+                    }
+                }
+
+                return std::memcmp(&current, &baseline, sizeof(Type)) != 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template<typename Type>
+        void WriteField(Common::BitWriter& writer, const Type& current, const Type& baseline, float precision)
+        {
+            static_assert(IsFieldSupported<Type>(), "Unsupported field type!");
+
+            if constexpr(std::is_same<Type, std::string>::value)
+            {
+                writer.WriteVarint(current.size());
+                writer.WriteBytes(current.data(), current.size());
+            }
+            else
+            {
+                constexpr glm::length_t Count = QuantizedComponents<Type>::Count;
+                if constexpr(Count != 0)
+                {
+                    if(precision > 0.0f)
+                    {
+                        float currentValues[Count];
+                        float baselineValues[Count];
+                        std::memcpy(currentValues, &current, sizeof(currentValues));
+                        std::memcpy(baselineValues, &baseline, sizeof(baselineValues));
+
+                        for(glm::length_t i = 0; i < Count; ++i)
+                        {
+                            writer.WriteSigned(Quantize(currentValues[i], precision) -
+                                Quantize(baselineValues[i], precision));
+                        }
+
+                        return;
+                    }
+                }
+
+                writer.WriteBytes(&current, sizeof(Type));
+            }
+        }
+
+        // Field has to hold baseline value before reading.
+        template<typename Type>
+        bool ReadField(Common::BitReader& reader, Type& field, float precision)
+        {
+            static_assert(IsFieldSupported<Type>(), "Unsupported field type!");
+
+            if constexpr(std::is_same<Type, std::string>::value)
+            {
+                uint64_t length = reader.ReadVarint();
+                if(!reader.IsValid() || length > reader.GetRemainingBitCount() / 8)
+                    return false;
+
+                field.resize(static_cast<std::size_t>(length));
+                return reader.ReadBytes(field.data(), field.size());
+            }
+            else
+            {
+                constexpr glm::length_t Count = QuantizedComponents<Type>::Count;
+                if constexpr(Count != 0)
+                {
+                    if(precision > 0.0f)
+                    {
+                        float values[Count];
+                        std::memcpy(values, &field, sizeof(values));
+
+                        for(glm::length_t i = 0; i < Count; ++i)
+                        {
+                            int64_t quantized = Quantize(values[i], precision) + reader.ReadSigned();
+                            values[i] = static_cast<float>(quantized) * precision;
+                        }
+
+                        std::memcpy(&field, values, sizeof(values));
+                        return reader.IsValid();
+                    }
+                }
+
+                return reader.ReadBytes(&field, sizeof(Type));
+            }
+        }
+
+        // Encodes runs of bytes that differ from baseline, used for
+        // state that is not worth dedicated encoding (e.g. entity handles).
+        void WriteBytesDelta(Common::BitWriter& writer, const uint8_t* baseline,
+            std::size_t baselineSize, const std::vector<uint8_t>& current);
+        bool ReadBytesDelta(Common::BitReader& reader, const uint8_t* baseline,
+            std::size_t baselineSize, std::vector<uint8_t>& current);
+    }
+}
+
+REFLECTION_TYPE(Game::QuantizeAttribute, Reflection::FieldAttribute)
@@ -82,6 +82,8 @@ namespace Game
 
     private:
         bool OnAttach(const GameSystemStorage& gameSystems) override;
+        void OnSaveSnapshot(SnapshotWriter& writer) const override;
+        bool OnRestoreSnapshot(SnapshotReader& reader) override;
         void OnEntityDestroyed(EntityHandle entity);
 
         void RegisterNamedEntity(const EntityHandle& entity, const std::string& name);
@@ -0,0 +1,128 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <deque>
+#include <Common/Event/Dispatcher.hpp>
+#include "Game/Snapshot.hpp"
+
+/*
+    Tick Simulation
+
+    Deterministic fixed step simulation of game instance for lockstep and
+    rollback. Ticks are counted with integers and all of them use the same
+    tick time, so simulating the same inputs from the same snapshot always
+    results in the same world state.
+
+    Inputs are recorded per tick as opaque bytes and applied by handlers of
+    input event right before game instance is ticked. Input recorded for tick
+    that has already been simulated (e.g. late input of remote player) marks
+    it for rollback, which restores world state from latest snapshot before
+    that tick and simulates following ticks again in a tight loop without
+    drawing anything. All logic that changes world state has to run in game
+    systems or input handlers to be simulated again.
+
+    Snapshots are saved every few ticks into buffers that are reused, and
+    only ticks within history length can be simulated again.
+*/
+
+namespace Game
+{
+    class GameInstance;
+
+    class TickSimulation final : private Common::NonCopyable
+    {
+    public:
+        using TickIndex = uint64_t;
+        using TickInput = std::vector<uint8_t>;
+
+        struct CreateFromParams
+        {
+            GameInstance* gameInstance = nullptr;
+            float tickSeconds = 1.0f / 60.0f;
+            uint32_t historyLength = 64;
+            uint32_t snapshotInterval = 1;
+        };
+
+        enum class CreateErrors
+        {
+            InvalidArgument,
+        };
+
+        using CreateResult = Common::Result<std::unique_ptr<TickSimulation>, CreateErrors>;
+        static CreateResult Create(const CreateFromParams& params);
+
+        enum class RecordInputErrors
+        {
+            TooOld,
+            TooFarAhead,
+        };
+
+        using RecordInputResult = Common::Result<void, RecordInputErrors>;
+
+        enum class ResimulateErrors
+        {
+            TooOld,
+            FailedRestore,
+        };
+
+        // Returns number of ticks that were simulated again.
+        using ResimulateResult = Common::Result<uint32_t, ResimulateErrors>;
+
+    public:
+        ~TickSimulation();
+
+        RecordInputResult RecordInput(TickIndex tick, TickInput input);
+
+        // Simulates current tick and moves to the next one.
+        void Advance();
+
+        // Restores world state from before given tick and simulates ticks up to current one again.
+        ResimulateResult Resimulate(TickIndex tick);
+
+        // Simulates again from earliest tick that received input after it has been simulated.
+        ResimulateResult ResimulatePending();
+
+        TickIndex GetCurrentTick() const;
+        TickIndex GetOldestResimulatedTick() const;
+        float GetTickSeconds() const;
+        bool HasPendingResimulation() const;
+
+        struct Events
+        {
+            // Called before game instance is ticked, also for ticks that are simulated again.
+            // Input is empty if it has not been recorded yet and handlers should predict it.
+            Event::Dispatcher<void(GameInstance&, TickIndex, const TickInput&)> applyInput;
+        } events;
+
+    private:
+        TickSimulation();
+
+        void SimulateTick(bool saveSnapshot);
+        const TickInput& GetInput(TickIndex tick) const;
+
+    private:
+        struct TickSnapshot
+        {
+            TickIndex tick = 0;
+            bool valid = false;
+            SnapshotWriter writer;
+        };
+
+        GameInstance* m_gameInstance = nullptr;
+        float m_tickSeconds = 0.0f;
+        uint32_t m_historyLength = 0;
+        uint32_t m_snapshotInterval = 0;
+
+        TickIndex m_currentTick = 0;
+        TickIndex m_pendingTick = 0;
+        bool m_pendingResimulation = false;
+
+        std::deque<TickInput> m_inputs;
+        TickIndex m_inputsBeginTick = 0;
+        std::vector<TickSnapshot> m_snapshots;
+    };
+}
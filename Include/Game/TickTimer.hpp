@@ -9,6 +9,19 @@
 
 /*
     Tick Timer
+
+    Produces fixed time ticks from time advanced every frame. After a stall
+    many ticks can become due at once, and processing all of them makes frame
+    even longer, which can cause the simulation to spiral behind. Number of
+    ticks per frame can be limited, with catch up policy deciding what happens
+    to ticks that exceed the limit:
+    - Delay: ticks are processed in following frames, so simulation catches
+      up with real time once load drops.
+    - Skip: ticks are dropped and their time is never simulated, which
+      dilates simulation time relative to real time.
+    - Stretch: last tick of frame is stretched to cover all remaining due
+      ticks, adapting tick time instead (not suitable for deterministic
+      simulation that requires constant tick time).
 */
 
 namespace Game
@@ -20,11 +33,43 @@ namespace Game
         using CreateResult = Common::Result<std::unique_ptr<TickTimer>, void>;
         static CreateResult Create();
 
+        enum class CatchUpPolicy
+        {
+            Delay,
+            Skip,
+            Stretch,
+        };
+
+        struct Metrics
+        {
+            // Number of processed ticks, including stretched ones.
+            uint64_t processedTicks = 0;
+
+            // Number of times due ticks were delayed to next frame.
+            uint64_t delayedTicks = 0;
+
+            // Number of ticks that were skipped and never processed.
+            uint64_t skippedTicks = 0;
+
+            // Number of ticks merged into stretched ticks.
+            uint64_t stretchedTicks = 0;
+
+            // Number of frames that reached tick limit with ticks still due.
+            uint64_t throttledFrames = 0;
+
+            // Highest number of ticks processed in single frame.
+            uint32_t maxFrameTicks = 0;
+        };
+
     public:
         ~TickTimer();
 
         void SetTickSeconds(float tickTime);
 
+        // Zero means no limit of ticks per frame.
+        void SetMaxFrameTicks(uint32_t maxFrameTicks);
+        void SetCatchUpPolicy(CatchUpPolicy policy);
+
         void Advance(const System::Timer& timer);
         bool Tick();
         void Reset();
@@ -33,15 +78,30 @@ namespace Game
         float GetAlphaSeconds() const;
         float GetLastTickSeconds() const;
         double GetTotalTickSeconds() const;
+        uint32_t GetMaxFrameTicks() const;
+        CatchUpPolicy GetCatchUpPolicy() const;
+
+        const Metrics& GetMetrics() const;
+        void ResetMetrics();
 
     private:
         TickTimer();
 
+        uint64_t GetDueTicks(TimeUnit tickUnits) const;
+
+    private:
         std::unique_ptr<System::Timer> m_timer;
 
         float m_tickSeconds = 1.0f / 10.0f;
         TimeUnit m_forwardTickTimeUnits = 0;
         TimeUnit m_totalTickTimeUnits = 0;
         float m_lastTickSeconds = 0.0f;
+        TimeUnit m_delayedTickTimeUnits = 0;
+
+        uint32_t m_maxFrameTicks = 0;
+        uint32_t m_frameTicks = 0;
+        bool m_frameThrottled = false;
+        CatchUpPolicy m_catchUpPolicy = CatchUpPolicy::Delay;
+        Metrics m_metrics;
     };
 }
@@ -0,0 +1,104 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/*
+    Cooked Format
+
+    Binary layouts of graphics resources that are cooked offline by AssetCooker
+    tool from their script sources. Cooked files keep their source file paths
+    and are recognized by magic at their beginning, so loaders can read both
+    cooked and script files (e.g. for hot reloading during development).
+    All values are stored in little-endian byte order.
+
+    Names are stored only as their hashes and arrays are laid out exactly as
+    runtime structures that hold them, so they are copied in single read:
+
+    [AtlasHeader]       Header of cooked texture atlas.
+    [Region...]         Regions sorted by name hash (see TextureAtlas::Region).
+    [Texture path]      Texture path relative to atlas file.
+
+    [AnimationHeader]   Header of cooked sprite animation list.
+    [Animation...]      Animations sorted by name hash, with their frame ranges.
+    [Frame...]          Frames of all animations (see SpriteAnimationList).
+    [Atlas path]        Texture atlas path relative to animation list file.
+
+    [TextureHeader]     Header of cooked texture, similar to KTX2 container.
+    [TextureLevel...]   Offsets and sizes of mip levels, from largest to smallest.
+    [Level data...]     Pixels or compressed blocks of each mip level.
+*/
+
+namespace Graphics::CookedFormat
+{
+    constexpr uint32_t AtlasMagic = 0x534C5441; // "ATLS"
+    constexpr uint32_t AnimationMagic = 0x4D494E41; // "ANIM"
+    constexpr uint32_t TextureMagic = 0x52545854; // "TXTR"
+    constexpr uint32_t Version = 1;
+
+    struct AtlasHeader
+    {
+        uint32_t magic = AtlasMagic;
+        uint32_t version = Version;
+        uint32_t regionCount = 0;
+        uint32_t texturePathLength = 0;
+    };
+
+    static_assert(sizeof(AtlasHeader) == 16);
+
+    struct AnimationHeader
+    {
+        uint32_t magic = AnimationMagic;
+        uint32_t version = Version;
+        uint32_t animationCount = 0;
+        uint32_t frameCount = 0;
+        uint32_t textureAtlasPathLength = 0;
+        uint32_t reserved = 0;
+    };
+
+    static_assert(sizeof(AnimationHeader) == 24);
+
+    enum class TextureFormat : uint32_t
+    {
+        Unknown,
+        R8,
+        RG8,
+        RGB8,
+        RGBA8,
+        BC1,
+        BC3,
+        ETC2RGB8,
+        ETC2RGBA8,
+        ASTC4x4,
+    };
+
+    struct TextureHeader
+    {
+        uint32_t magic = TextureMagic;
+        uint32_t version = Version;
+        TextureFormat format = TextureFormat::Unknown;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t levelCount = 0;
+    };
+
+    static_assert(sizeof(TextureHeader) == 24);
+
+    struct TextureLevel
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    static_assert(sizeof(TextureLevel) == 16);
+
+    constexpr uint64_t HashName(std::string_view name)
+    {
+        return Common::StringHash<uint64_t>(name);
+    }
+}
@@ -60,6 +60,7 @@ namespace Graphics
         GLint GetAttributeIndex(std::string name) const;
         GLint GetUniformIndex(std::string name) const;
         GLuint GetHandle() const;
+        void Swap(Shader& other);
 
     private:
         Shader();
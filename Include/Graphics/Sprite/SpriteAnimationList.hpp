@@ -6,15 +6,28 @@
 #pragma once
 
 #include <Core/EngineSystem.hpp>
+#include <System/ResourceMemoryUsage.hpp>
 #include "Graphics/TextureView.hpp"
+#include "Graphics/CookedFormat.hpp"
 
 namespace System
 {
     class FileHandle;
+    class ResourceDependencies;
 }
 
 /*
     Animation List
+
+    Resource file is parsed in preparation step, which can be done on any thread,
+    after which texture atlas that it references is acquired as its dependency.
+
+    Prepared animations refer to ranges in single array of frames and all names
+    are stored as hashes, which is also how they are laid out in cooked resource
+    files (see CookedFormat). Script files can still be loaded during development.
+
+    Reloaded list swaps its contents in place, which invalidates pointers to its
+    animations. Animations should be referenced by name hash and looked up again.
 */
 
 namespace Graphics
@@ -36,10 +49,41 @@ namespace Graphics
             InvalidResourceContents,
         };
 
+        struct PreparedFrame
+        {
+            uint64_t regionHash = 0;
+            float duration = 0.0f;
+            uint32_t reserved = 0;
+        };
+
+        static_assert(sizeof(PreparedFrame) == 16);
+
+        struct PreparedAnimation
+        {
+            uint64_t nameHash = 0;
+            uint32_t firstFrame = 0;
+            uint32_t frameCount = 0;
+        };
+
+        static_assert(sizeof(PreparedAnimation) == 16);
+
+        struct PreparedData
+        {
+            fs::path textureAtlasPath;
+            std::vector<PreparedAnimation> animations;
+            std::vector<PreparedFrame> frames;
+        };
+
         using CreateResult = Common::Result<std::unique_ptr<SpriteAnimationList>, CreateErrors>;
+        using PrepareResult = Common::Result<PreparedData, CreateErrors>;
 
         static CreateResult Create();
         static CreateResult Create(System::FileHandle& file, const LoadFromFile& params);
+        static CreateResult Create(PreparedData&& prepared, const LoadFromFile& params);
+        static PrepareResult Prepare(System::FileHandle& file, const LoadFromFile& params);
+        static void AcquireDependencies(System::ResourceDependencies& dependencies,
+            const PreparedData& prepared, const LoadFromFile& params);
+        static std::vector<uint8_t> Cook(const PreparedData& prepared, const fs::path& filePath);
 
         struct Frame
         {
@@ -59,18 +103,25 @@ namespace Graphics
         };
 
         using AnimationList = std::vector<Animation>;
-        using AnimationMap = std::unordered_map<std::string, std::uint32_t>;
+        using AnimationMap = std::unordered_map<uint64_t, std::uint32_t>;
 
         using AnimationIndexResult = Common::Result<uint32_t, void>;
 
         ~SpriteAnimationList();
 
-        AnimationIndexResult GetAnimationIndex(std::string animationName) const;
+        bool AddAnimation(std::string_view animationName, Animation&& animation);
+        AnimationIndexResult GetAnimationIndex(std::string_view animationName) const;
         const Animation* GetAnimationByIndex(std::size_t animationIndex) const;
+        const Animation* GetAnimationByHash(uint64_t nameHash) const;
+        void Swap(SpriteAnimationList& other);
+        System::ResourceMemoryUsage GetMemoryUsage() const;
 
     private:
         SpriteAnimationList();
 
+        static PrepareResult PrepareCooked(System::FileHandle& file);
+        static PrepareResult PrepareScript(System::FileHandle& file, const LoadFromFile& params);
+
         AnimationList m_animationList;
         AnimationMap m_animationMap;
     };
@@ -6,7 +6,10 @@
 #pragma once
 
 #include <Core/EngineSystem.hpp>
+#include <System/Image.hpp>
+#include <System/ResourceMemoryUsage.hpp>
 #include "Graphics/RenderState.hpp"
+#include "Graphics/CookedFormat.hpp"
 
 namespace System
 {
@@ -16,7 +19,15 @@ namespace System
 /*
     Texture
     
-    Encapsulates an OpenGL texture object which can be loaded from PNG file.
+    Encapsulates an OpenGL texture object which can be loaded from image file.
+    Loading from file is split into preparation that decodes image and can be
+    done on any thread, and creation that uploads it on main thread.
+
+    Textures cooked with Cook() (see CookedFormat) store all mip levels, which
+    are uploaded as they are instead of being generated at runtime. Cooked
+    levels can be block compressed with BC1/BC3 formats, which are decompressed
+    on CPU when device does not support S3TC. ETC2 and ASTC blocks produced by
+    external encoders are uploaded when supported, but are not cooked here.
 */
 
 namespace Graphics
@@ -26,6 +37,14 @@ namespace Graphics
     class Texture final : private Common::NonCopyable
     {
     public:
+        struct MipLevel
+        {
+            const void* data = nullptr;
+            std::size_t size = 0;
+        };
+
+        using MipLevelList = std::vector<MipLevel>;
+
         struct CreateFromParams
         {
             RenderContext* renderContext = nullptr;
@@ -34,6 +53,7 @@ namespace Graphics
             int height = 0;
             bool mipmaps = true;
             const void* data = nullptr;
+            MipLevelList levels;
         };
 
         struct LoadFromFile
@@ -48,29 +68,59 @@ namespace Graphics
             UnsupportedImageFormat,
             FailedTextureCreation,
             FailedImageLoad,
+            InvalidResourceContents,
+        };
+
+        struct PreparedData
+        {
+            std::unique_ptr<System::Image> image;
+
+            CookedFormat::TextureFormat format = CookedFormat::TextureFormat::Unknown;
+            int width = 0;
+            int height = 0;
+            std::vector<uint8_t> cookedData;
+            std::vector<CookedFormat::TextureLevel> levels;
+        };
+
+        struct CookParams
+        {
+            CookedFormat::TextureFormat format = CookedFormat::TextureFormat::Unknown;
+            bool mipmaps = true;
         };
 
         using CreateResult = Common::Result<std::unique_ptr<Texture>, CreateErrors>;
+        using PrepareResult = Common::Result<PreparedData, CreateErrors>;
+        using CookResult = Common::Result<std::vector<uint8_t>, CreateErrors>;
+
         static CreateResult Create(const CreateFromParams& params);
         static CreateResult Create(System::FileHandle& file, const LoadFromFile& params);
+        static CreateResult Create(PreparedData&& prepared, const LoadFromFile& params);
+        static PrepareResult Prepare(System::FileHandle& file, const LoadFromFile& params);
+        static CookResult Cook(const System::Image& image, const CookParams& params);
 
     public:
         ~Texture();
         void Update(const void* data);
+        void Swap(Texture& other);
 
         GLuint GetHandle() const;
         int GetWidth() const;
         int GetHeight() const;
+        System::ResourceMemoryUsage GetMemoryUsage() const;
 
     private:
         Texture();
 
+        static PrepareResult PrepareCooked(System::FileHandle& file);
+        static CreateResult CreateCooked(PreparedData&& prepared, const LoadFromFile& params);
+
     private:
         RenderContext* m_renderContext = nullptr;
         GLuint m_handle = OpenGL::InvalidHandle;
         GLenum m_format = OpenGL::InvalidEnum;
         int m_width = 0;
         int m_height = 0;
+        std::size_t m_gpuBytes = 0;
     };
     
     using TexturePtr = std::shared_ptr<Texture>;
@@ -6,16 +6,25 @@
 #pragma once
 
 #include <Core/EngineSystem.hpp>
+#include <System/ResourceMemoryUsage.hpp>
+#include "Graphics/CookedFormat.hpp"
 
 namespace System
 {
     class FileHandle;
+    class ResourceDependencies;
 }
 
 /*
     Texture Atlas
 
     Stores multiple images that can be referenced by name in a single texture.
+    Resource file is parsed in preparation step, which can be done on any thread,
+    after which texture that it references is acquired as its dependency.
+
+    Regions are kept in array sorted by hashes of their names, which is also
+    how they are stored in cooked resource files (see CookedFormat). Resource
+    file can be either cooked or script, which is used during development.
 */
 
 namespace Graphics
@@ -39,25 +48,51 @@ namespace Graphics
             InvalidResourceContents,
         };
 
+        struct Region
+        {
+            uint64_t nameHash = 0;
+            glm::ivec4 pixelCoords = glm::ivec4(0);
+        };
+
+        static_assert(sizeof(Region) == 24);
+
+        using ConstTexturePtr = std::shared_ptr<const Texture>;
+        using RegionList = std::vector<Region>;
+
+        struct PreparedData
+        {
+            fs::path texturePath;
+            RegionList regions;
+        };
+
         using CreateResult = Common::Result<std::unique_ptr<TextureAtlas>, CreateErrors>;
+        using PrepareResult = Common::Result<PreparedData, CreateErrors>;
 
         static CreateResult Create();
         static CreateResult Create(System::FileHandle& file, const LoadFromFile& params);
-
-        using ConstTexturePtr = std::shared_ptr<const Texture>;
-        using RegionMap = std::unordered_map<std::string, glm::ivec4>;
+        static CreateResult Create(PreparedData&& prepared, const LoadFromFile& params);
+        static PrepareResult Prepare(System::FileHandle& file, const LoadFromFile& params);
+        static void AcquireDependencies(System::ResourceDependencies& dependencies,
+            const PreparedData& prepared, const LoadFromFile& params);
+        static std::vector<uint8_t> Cook(const PreparedData& prepared, const fs::path& filePath);
 
     public:
         ~TextureAtlas();
 
-        bool AddRegion(std::string name, glm::ivec4 pixelCoords);
-        TextureView GetRegion(std::string name);
+        bool AddRegion(std::string_view name, glm::ivec4 pixelCoords);
+        TextureView GetRegion(std::string_view name) const;
+        TextureView GetRegion(uint64_t nameHash) const;
+        void Swap(TextureAtlas& other);
+        System::ResourceMemoryUsage GetMemoryUsage() const;
 
     private:
         TextureAtlas();
 
+        static PrepareResult PrepareCooked(System::FileHandle& file);
+        static PrepareResult PrepareScript(System::FileHandle& file, const LoadFromFile& params);
+
     private:
         ConstTexturePtr m_texture;
-        RegionMap m_regions;
+        RegionList m_regions;
     };
 };
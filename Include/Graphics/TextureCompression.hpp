@@ -0,0 +1,37 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include "Graphics/CookedFormat.hpp"
+
+/*
+    Texture Compression
+
+    CPU side utilities for cooking textures, which do not require any GPU
+    context. Generates mip levels with box filter and encodes RGBA8 pixels
+    into BC1 (opaque) and BC3 (with alpha) blocks of 4x4 pixels. Blocks at
+    right and bottom edges are padded by repeating last row and column.
+
+    Decompression is used when graphics device does not support S3TC formats
+    (e.g. mobile GPUs) and lets tests validate cooked textures without GPU.
+*/
+
+namespace Graphics::TextureCompression
+{
+    using TextureFormat = CookedFormat::TextureFormat;
+
+    bool IsBlockCompressed(TextureFormat format);
+    int GetChannelCount(TextureFormat format);
+    std::size_t GetLevelSize(TextureFormat format, int width, int height);
+    int GetMaxLevelCount(int width, int height);
+
+    std::vector<uint8_t> GenerateMipLevel(const uint8_t* pixels, int width, int height, int channels);
+
+    std::vector<uint8_t> CompressBC1(const uint8_t* pixels, int width, int height);
+    std::vector<uint8_t> CompressBC3(const uint8_t* pixels, int width, int height);
+    std::vector<uint8_t> DecompressBC1(const uint8_t* blocks, int width, int height);
+    std::vector<uint8_t> DecompressBC3(const uint8_t* blocks, int width, int height);
+}
@@ -37,6 +37,9 @@
         REFLECTION_TYPE_STORAGE \
         REFLECTION_TYPE_INFO
 
+#define REFLECTION_FRIEND(ReflectedType) \
+    friend struct Reflection::Detail::TypeInfo<ReflectedType>;
+
 #define REFLECTION_CHECK_TYPE(ReflectedType) \
     static_assert(std::is_class<ReflectedType>::value || \
         std::is_fundamental<ReflectedType>::value, \
@@ -100,6 +103,11 @@
     REFLECTION_EXPAND(REFLECTION_TYPE_BEGIN_CHOOSER(__VA_ARGS__)(__VA_ARGS__))
 #define REFLECTION_TYPE_END REFLECTION_TYPE_INFO_END
 
+// Static only reflection that is not registered by reflection generator,
+// for types that cannot have virtual table added by REFLECTION_ENABLE().
+#define REFLECTION_STATIC_TYPE_BEGIN(ReflectedType) \
+    REFLECTION_TYPE_INFO_BEGIN(ReflectedType, Reflection::NullType)
+
 #define REFLECTION_TYPE_BASE(ReflectedType) \
     REFLECTION_TYPE_INFO_BEGIN(ReflectedType, Reflection::NullType) \
     REFLECTION_TYPE_INFO_END
@@ -15,6 +15,9 @@
 
 namespace Reflection
 {
+    // Log category for reflection registry messages.
+    inline Logger::Category LogRegistry("Reflection.Registry");
+
     class Registry final : public Detail::ReflectionRegistry
     {
     public:
@@ -55,7 +58,7 @@ namespace Reflection
         {
             if(!StaticType.GetBaseType().IsNullType())
             {
-                LOG_WARNING("Attempted to register type \"{}\" ({}) with unregistered "
+                LOG_CATEGORY_WARNING(LogRegistry, "Attempted to register type \"{}\" ({}) with unregistered "
                     "base type \"{}\" ({})!", StaticType.Name, StaticType.Identifier, 
                     StaticType.GetBaseType().Name, StaticType.GetBaseType().Identifier);
                 return false;
@@ -83,7 +86,7 @@ namespace Reflection
 
             if(dynamicType.IsRegistered())
             {
-                LOG_WARNING("Attempted to register type \"{}\" ({}) twice!",
+                LOG_CATEGORY_WARNING(LogRegistry, "Attempted to register type \"{}\" ({}) twice!",
                     StaticType.Name, dynamicType.GetIdentifier());
             }
             else
@@ -105,7 +108,7 @@ namespace Reflection
         }
 
         dynamicType.Register(NAME_CONSTEXPR(StaticType.Name), constructFunction, baseType);
-        LOG_INFO("Registered type: \"{}\" ({})", StaticType.Name, dynamicType.GetIdentifier());
+        LOG_CATEGORY_INFO(LogRegistry, "Registered type: \"{}\" ({})", StaticType.Name, dynamicType.GetIdentifier());
 
         return true;
     }
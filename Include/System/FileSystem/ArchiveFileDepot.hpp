@@ -5,6 +5,69 @@
 
 #pragma once
 
+#include "System/FileSystem/FileDepot.hpp"
+#include "System/FileSystem/ArchiveFormat.hpp"
+#include "System/FileSystem/ArchiveFileHandle.hpp"
+#include "System/FileSystem/MappedFileHandle.hpp"
+
 /*
     Archive File Depot
+
+    Collection of files packed into single archive file (see ArchiveFormat)
+    that can be mounted under specified path using file system. Archive file
+    is opened once and its table of contents is read into memory, so files
+    are then located by binary search over their path hashes and read at
+    their offsets without going through native file system for each of them.
+
+    Archive file is also mapped into memory where supported, in which case
+    uncompressed entries are opened as views into mapping without any copies.
+    Otherwise they are read at their offsets through ArchiveFileHandle.
+    Compressed entries are decompressed into memory when opened. Archives
+    are created with ArchivePacker tool or ArchiveFilePacker class.
+
+    void ExampleMountArchive(System::FileSystem& fileSystem)
+    {
+        auto archiveDepot = System::ArchiveFileDepot::Create("Data.pak").Unwrap();
+        fileSystem.MountDepot("./", std::move(archiveDepot));
+    }
 */
+
+namespace System
+{
+    class ArchiveFileDepot final : public FileDepot
+    {
+    public:
+        enum class CreateErrors
+        {
+            EmptyArchivePathArgument,
+            FileOpeningFailed,
+            InvalidArchiveHeader,
+            UnsupportedArchiveVersion,
+            CorruptedTableOfContents,
+        };
+
+        using CreateResult = Common::Result<std::unique_ptr<ArchiveFileDepot>, CreateErrors>;
+        static CreateResult Create(fs::path archivePath);
+
+        ~ArchiveFileDepot();
+
+        OpenFileResult OpenFile(const fs::path& depotPath, const fs::path& requestedPath,
+            FileHandle::OpenFlags::Type openFlags) override;
+
+        std::size_t GetEntryCount() const;
+
+    private:
+        ArchiveFileDepot();
+
+        const ArchiveFormat::Entry* FindEntry(std::string_view path) const;
+        std::string_view GetEntryPath(const ArchiveFormat::Entry& entry) const;
+
+        using EntryList = std::vector<ArchiveFormat::Entry>;
+
+        fs::path m_archivePath;
+        ArchiveFileHandle::ArchiveStreamPtr m_archive;
+        MappedFileHandle::MappingPtr m_mapping;
+        EntryList m_entries;
+        std::string m_paths;
+    };
+}
@@ -5,6 +5,52 @@
 
 #pragma once
 
+#include <mutex>
+#include "System/FileSystem/FileHandle.hpp"
+#include "System/FileSystem/FileDepot.hpp"
+
 /*
     Archive File Handle
+
+    Read only handle to uncompressed entry within packed archive. Reads are
+    made at entry offset directly from archive file that is opened once and
+    shared by all handles of its depot, which can be used from multiple threads.
 */
+
+namespace System
+{
+    class ArchiveFileHandle final : public FileHandle
+    {
+    public:
+        struct ArchiveStream
+        {
+            std::mutex lock;
+            std::ifstream stream;
+        };
+
+        using ArchiveStreamPtr = std::shared_ptr<ArchiveStream>;
+        using OpenFileErrors = FileDepot::OpenFileErrors;
+
+        static FileDepot::OpenFileResult Create(ArchiveStreamPtr archive, uint64_t offset,
+            uint64_t size, const fs::path& requestedPath, OpenFlags::Type openFlags);
+
+        ~ArchiveFileHandle();
+
+        uint64_t Tell() override;
+        uint64_t Seek(uint64_t offset, SeekMode mode) override;
+        uint64_t Read(uint8_t* data, uint64_t bytes) override;
+        uint64_t Write(const uint8_t* data, uint64_t bytes) override;
+
+        bool IsGood() const override;
+        uint64_t GetSize() const override;
+
+    private:
+        ArchiveFileHandle(const fs::path& path, OpenFlags::Type flags);
+
+        ArchiveStreamPtr m_archive;
+        uint64_t m_offset = 0;
+        uint64_t m_size = 0;
+        uint64_t m_position = 0;
+        bool m_good = true;
+    };
+}
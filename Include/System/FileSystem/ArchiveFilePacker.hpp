@@ -0,0 +1,68 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <unordered_set>
+#include "System/FileSystem/ArchiveFormat.hpp"
+
+/*
+    Archive File Packer
+
+    Packs files into archive that can be mounted using ArchiveFileDepot.
+    Files are added with paths relative to mount path of archive and are
+    held in memory until archive is written. Compressed files are stored
+    uncompressed instead if compression does not reduce their size.
+*/
+
+namespace System
+{
+    class ArchiveFilePacker : private Common::NonCopyable
+    {
+    public:
+        enum class AddFileErrors
+        {
+            EmptyArchivePathArgument,
+            InvalidArchivePathArgument,
+            DuplicateArchivePath,
+            CompressionFailed,
+        };
+
+        enum class WriteErrors
+        {
+            EmptyOutputPathArgument,
+            FileOpeningFailed,
+            FileWritingFailed,
+        };
+
+        using AddFileResult = Common::Result<void, AddFileErrors>;
+        using WriteResult = Common::Result<void, WriteErrors>;
+
+    public:
+        ArchiveFilePacker();
+        ~ArchiveFilePacker();
+
+        AddFileResult AddFile(fs::path archivePath, std::vector<uint8_t> data,
+            ArchiveFormat::Compression compression = ArchiveFormat::Compression::None);
+        WriteResult Write(const fs::path& outputPath) const;
+
+        std::size_t GetFileCount() const;
+
+    private:
+        struct PackedFile
+        {
+            std::string path;
+            ArchiveFormat::Entry entry;
+            std::vector<uint8_t> data;
+        };
+
+        using PackedFileList = std::vector<PackedFile>;
+        using FilePathSet = std::unordered_set<std::string>;
+
+    private:
+        PackedFileList m_files;
+        FilePathSet m_filePaths;
+    };
+}
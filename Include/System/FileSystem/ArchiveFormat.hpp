@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/*
+    Archive Format
+
+    Binary layout of packed archive files read by ArchiveFileDepot and written
+    by ArchiveFilePacker. All values are stored in little-endian byte order.
+
+    [Header]          Fixed size header at the beginning of archive file.
+    [Entry data...]   File contents, each starting at offset aligned to 4K.
+    [Entry table]     Entries sorted by path hash, for binary search lookup.
+    [Path strings]    Paths of entries referenced by their path offsets.
+
+    Entry table and path strings together form table of contents that is
+    read whole when archive is opened and checked against its CRC. Entries
+    can be compressed with zlib, in which case their CRC of uncompressed
+    data is verified when entry is decompressed on opening.
+*/
+
+namespace System::ArchiveFormat
+{
+    constexpr uint32_t Magic = 0x4B434150; // "PACK"
+    constexpr uint32_t Version = 1;
+    constexpr uint64_t Alignment = 4096;
+
+    enum class Compression : uint16_t
+    {
+        None,
+        Zlib,
+    };
+
+    struct Header
+    {
+        uint32_t magic = Magic;
+        uint32_t version = Version;
+        uint32_t entryCount = 0;
+        uint32_t tableCrc = 0;
+        uint64_t tableOffset = 0;
+        uint64_t tableSize = 0;
+    };
+
+    static_assert(sizeof(Header) == 32);
+
+    struct Entry
+    {
+        uint64_t pathHash = 0;
+        uint64_t offset = 0;
+        uint64_t storedSize = 0;
+        uint64_t size = 0;
+        uint32_t crc = 0;
+        uint32_t pathOffset = 0;
+        uint16_t pathLength = 0;
+        Compression compression = Compression::None;
+        uint32_t reserved = 0;
+    };
+
+    static_assert(sizeof(Entry) == 48);
+
+    constexpr uint64_t HashPath(std::string_view path)
+    {
+        // Path is expected to be normalized generic relative path.
+        return Common::StringHash<uint64_t>(path);
+    }
+
+    inline uint32_t CalculateCrc(const uint8_t* data, uint64_t size)
+    {
+        return static_cast<uint32_t>(crc32_z(0, data, static_cast<z_size_t>(size)));
+    }
+
+    constexpr uint64_t AlignOffset(uint64_t offset)
+    {
+        return (offset + Alignment - 1) & ~(Alignment - 1);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "System/FileSystem/FileHandle.hpp"
+
+/*
+    Async File Reader
+
+    Reads ranges of opened files into caller provided memory without blocking
+    caller, with many reads in flight at the same time. Completion callback is
+    invoked from one of reader threads once read is done.
+
+    Files that expose native file descriptor (see FileHandle::GetNative) are
+    read through io_uring submission queue on Linux, which lets operating
+    system keep deep queue of requests to storage device. Remaining files
+    (e.g. compressed or memory files) and platforms without io_uring support
+    are read with Read() calls on pool of worker threads. Without any worker
+    threads, such reads are done synchronously on calling thread.
+
+    Used by file system to implement ReadAsync() calls, see FileSystem.
+*/
+
+namespace System
+{
+    class AsyncFileReader final : private Common::NonCopyable
+    {
+    public:
+        enum class ReadErrors
+        {
+            InvalidRangeArgument,
+            InvalidDestinationArgument,
+            FileNotFound,
+            FileOpeningFailed,
+            FileReadingFailed,
+        };
+
+        using ReadResult = Common::Result<uint64_t, ReadErrors>;
+        using CompletionCallback = std::function<void(ReadResult)>;
+        using FileHandlePtr = std::unique_ptr<FileHandle>;
+
+        struct CreateFromParams
+        {
+            uint32_t queueDepth = 64;
+            uint32_t workerThreads = 2;
+        };
+
+        using CreateResult = Common::Result<std::unique_ptr<AsyncFileReader>, void>;
+        static CreateResult Create(const CreateFromParams& params);
+
+    public:
+        ~AsyncFileReader();
+
+        void Read(FileHandlePtr file, uint64_t offset, uint64_t size,
+            uint8_t* destination, CompletionCallback callback);
+
+        bool IsUsingNativeQueue() const;
+
+    private:
+        AsyncFileReader();
+
+        struct ReadRequest
+        {
+            FileHandlePtr file;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint8_t* destination = nullptr;
+            CompletionCallback callback;
+        };
+
+        class NativeQueue;
+        using RequestQueue = std::queue<ReadRequest>;
+        using WorkerThreadList = std::vector<std::thread>;
+
+        void RunWorkerThread();
+        static void ProcessRequest(ReadRequest& request);
+
+    private:
+        std::unique_ptr<NativeQueue> m_nativeQueue;
+
+        std::mutex m_requestLock;
+        std::condition_variable m_requestCondition;
+        RequestQueue m_requests;
+        WorkerThreadList m_workerThreads;
+        bool m_stopping = false;
+    };
+}
@@ -11,6 +11,8 @@
     File Depot
 
     Interface for file depot implementations that are mounted in file system.
+    Depots backed by files that can change on disk can also report changed
+    files once watching is started, with paths relative to depot root.
 */
 
 namespace System
@@ -28,6 +30,7 @@ namespace System
             AccessDenied,
             TooManyHandles,
             FileTooLarge,
+            CorruptedFile,
         };
 
         using OpenFileResult = Common::Result<std::unique_ptr<FileHandle>, OpenFileErrors>;
@@ -36,5 +39,14 @@ namespace System
         virtual ~FileDepot() = default;
         virtual OpenFileResult OpenFile(const fs::path& depotPath,
             const fs::path& requestedPath, FileHandle::OpenFlags::Type openFlags) = 0;
+
+        virtual bool StartWatching()
+        {
+            return false;
+        }
+
+        virtual void CollectChangedFiles(std::vector<fs::path>& depotPaths)
+        {
+        }
     };
 }
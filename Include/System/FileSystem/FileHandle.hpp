@@ -10,6 +10,14 @@
 
     Base for implementations of files opened by file system through file depots
     that are ready for reading and writing if returned.
+
+    Handles that keep entire file contents in memory (e.g. memory mapped files)
+    can expose them through Map() without any reads or copies. Returned bytes
+    stay valid for lifetime of handle, or until it is written to.
+
+    Handles backed by native file descriptor can also expose it through
+    GetNative(), which allows their contents to be read asynchronously by
+    operating system (see AsyncFileReader) instead of through Read() calls.
 */
 
 namespace System
@@ -41,6 +49,28 @@ namespace System
             using Type = uint8_t;
         };
 
+        struct MappedView
+        {
+            const uint8_t* data = nullptr;
+            uint64_t size = 0;
+
+            std::string_view AsString() const
+            {
+                return std::string_view(reinterpret_cast<const char*>(data), size);
+            }
+        };
+
+        using MapResult = Common::Result<MappedView, void>;
+
+        struct NativeView
+        {
+            int fileDescriptor = -1;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+
+        using NativeResult = Common::Result<NativeView, void>;
+
         virtual ~FileHandle();
 
         virtual uint64_t Tell() = 0;
@@ -50,6 +80,8 @@ namespace System
 
         virtual bool IsGood() const = 0;
         virtual uint64_t GetSize() const = 0;
+        virtual MapResult Map();
+        virtual NativeResult GetNative();
 
         const fs::path& GetPath() const;
         OpenFlags::Type GetFlags() const;
@@ -57,17 +89,18 @@ namespace System
 
         std::vector<uint8_t> ReadAsBinaryArray();
         std::string ReadAsTextString();
+        MappedView MapOrRead(std::vector<uint8_t>& buffer);
 
         template<typename Type>
         bool Read(Type& value)
         {
-            return Read(&value, sizeof(Type)) == sizeof(Type);
+            return Read(reinterpret_cast<uint8_t*>(&value), sizeof(Type)) == sizeof(Type);
         }
 
         template<typename Type>
         bool Write(const Type& value)
         {
-            return Write(&value, sizeof(Type)) == sizeof(Type);
+            return Write(reinterpret_cast<const uint8_t*>(&value), sizeof(Type)) == sizeof(Type);
         }
 
     protected:
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <mutex>
+#include <future>
 #include <Core/EngineSystem.hpp>
 #include "System/FileSystem/FileDepot.hpp"
+#include "System/FileSystem/AsyncFileReader.hpp"
 
 /*
     File System
@@ -17,6 +20,30 @@
     This is not limited to mounting directories, as zipped archives and
     memory regions can be used as mounted virtual file systems as well.
 
+    Depot that provided file when it was opened for reading is remembered,
+    so following opens of same path go straight to that depot instead of
+    probing each mounted depot in order (which for native depots means failed
+    system calls). Resolved paths are invalidated when depot is mounted, when
+    file is opened for writing or when it is no longer found in its depot.
+    They can also be invalidated explicitly when files change on disk.
+
+    Once watching is started, depots that support it (e.g. native depots)
+    report files that changed on disk, which are collected under paths they
+    are opened with and have their resolved paths invalidated. This is used
+    to reload resources while application is running (see ResourceManager).
+
+    Files can also be read asynchronously with ReadAsync(), either whole or
+    in ranges, into returned or caller provided memory. Files are still opened
+    on calling thread, but reads are queued (see AsyncFileReader) with many of
+    them in flight at once, which is needed to keep storage devices busy.
+    Reader and its threads are created on first asynchronous read.
+
+    void ExampleReadAsync(System::FileSystem& fileSystem)
+    {
+        auto future = fileSystem.ReadAsync("Data/Level.bin", { 4096, 1024 });
+        std::vector<uint8_t> bytes = future.get().Unwrap();
+    }
+
     Implementation of separate native/memory/archive depots was roughly
     inspired by: https://github.com/yevgeniy-logachev/vfspp
 */
@@ -40,6 +67,18 @@ namespace System
 
         using MountDepotResult = Common::Result<void, MountDepotErrors>;
 
+        struct ReadRange
+        {
+            static constexpr uint64_t WholeFile = std::numeric_limits<uint64_t>::max();
+
+            uint64_t offset = 0;
+            uint64_t size = WholeFile;
+        };
+
+        using ReadErrors = AsyncFileReader::ReadErrors;
+        using ReadAsyncResult = Common::Result<std::vector<uint8_t>, ReadErrors>;
+        using ReadIntoResult = AsyncFileReader::ReadResult;
+
     public:
         FileSystem();
         ~FileSystem() override;
@@ -48,19 +87,50 @@ namespace System
         FileDepot::OpenFileResult OpenFile(fs::path filePath,
             OpenFlags::Type openFlags = OpenFlags::Read);
 
+        std::future<ReadAsyncResult> ReadAsync(fs::path filePath);
+        std::future<ReadAsyncResult> ReadAsync(fs::path filePath, ReadRange range);
+        std::future<ReadIntoResult> ReadAsync(fs::path filePath, ReadRange range, uint8_t* destination);
+
+        void InvalidateResolvedPaths();
+        void InvalidateResolvedPath(fs::path filePath);
+
+        bool StartWatching();
+        std::vector<fs::path> CollectChangedFiles();
+        bool IsWatching() const;
+
     private:
         bool OnAttach(const Core::EngineSystemStorage& engineSystems) override;
 
+        Common::Result<std::unique_ptr<FileHandle>, ReadErrors>
+            OpenFileRange(const fs::path& filePath, ReadRange& range);
+        AsyncFileReader* GetAsyncReader();
+
         struct MountedDepotEntry
         {
             fs::path mountPath;
             FileDepotPtr fileDepot;
         };
 
+        struct ResolvedPath
+        {
+            std::size_t depotIndex;
+            fs::path depotPath;
+        };
+
         using MountedDepotList = std::vector<MountedDepotEntry>;
+        using ResolvedPathMap = std::unordered_map<std::string, ResolvedPath>;
 
     private:
         MountedDepotList m_mountedDepots;
+        bool m_watching = false;
+
+        std::mutex m_resolvedPathLock;
+        ResolvedPathMap m_resolvedPaths;
+
+        std::mutex m_asyncReaderLock;
+        std::unique_ptr<AsyncFileReader> m_asyncReader;
+        uint32_t m_asyncReadThreads = 0;
+        bool m_asyncReaderFailed = false;
     };
 }
 
@@ -0,0 +1,53 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+
+/*
+    File Watcher
+
+    Watches native directories for files that have been modified on disk, so
+    they can be reloaded while application is running (see ResourceManager).
+    Files are reported only once they are closed after writing or moved into
+    watched directory, so partially written files are never picked up (most
+    editors save by writing temporary file and moving it over original one).
+
+    Directories are not watched recursively, each one has to be added on its
+    own, which lets native depots watch only directories of opened files.
+    Changes are queued by operating system and collected without blocking.
+    Implemented with inotify on Linux, other platforms are not supported.
+*/
+
+namespace System
+{
+    class FileWatcher final : private Common::NonCopyable
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<FileWatcher>, void>;
+        static CreateResult Create();
+        static bool IsSupported();
+
+    public:
+        ~FileWatcher();
+
+        bool WatchDirectory(const fs::path& directory);
+        void CollectChanges(std::vector<fs::path>& changedFiles);
+
+    private:
+        FileWatcher();
+
+        using WatchedDirectoryMap = std::unordered_map<int, fs::path>;
+        using WatchedPathSet = std::unordered_set<std::string>;
+
+    private:
+        std::mutex m_lock;
+        int m_descriptor = -1;
+        WatchedDirectoryMap m_watchedDirectories;
+        WatchedPathSet m_watchedPaths;
+    };
+}
@@ -0,0 +1,79 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include "System/FileSystem/FileHandle.hpp"
+#include "System/FileSystem/FileDepot.hpp"
+
+/*
+    Mapped File Handle
+
+    Read only handle to native file that is mapped into memory, so its contents
+    are read straight from page cache and can be exposed through Map() without
+    copies. Handle can also cover part of mapping that is shared with others,
+    which is how archive entries are opened. Memory mapping is supported only
+    on POSIX platforms, elsewhere creation fails and native handles are used.
+    File descriptor is kept open along with mapping, so it can be used for
+    asynchronous reads that do not block on page faults.
+*/
+
+namespace System
+{
+    class MappedFileHandle final : public FileHandle
+    {
+    public:
+        class Mapping : private Common::NonCopyable
+        {
+        public:
+            using CreateResult = Common::Result<std::shared_ptr<const Mapping>, FileDepot::OpenFileErrors>;
+            static CreateResult Create(const fs::path& filePath);
+
+            ~Mapping();
+
+            const uint8_t* GetData() const;
+            uint64_t GetSize() const;
+            int GetFileDescriptor() const;
+
+        private:
+            Mapping();
+
+            int m_fileDescriptor = -1;
+            void* m_address = nullptr;
+            uint64_t m_size = 0;
+        };
+
+        using MappingPtr = std::shared_ptr<const Mapping>;
+        using OpenFileErrors = FileDepot::OpenFileErrors;
+
+        static bool IsSupported();
+
+        static FileDepot::OpenFileResult Create(const fs::path& filePath,
+            const fs::path& requestedPath, OpenFlags::Type openFlags);
+        static FileDepot::OpenFileResult Create(MappingPtr mapping, uint64_t offset,
+            uint64_t size, const fs::path& requestedPath, OpenFlags::Type openFlags);
+
+        ~MappedFileHandle();
+
+        uint64_t Tell() override;
+        uint64_t Seek(uint64_t offset, SeekMode mode) override;
+        uint64_t Read(uint8_t* data, uint64_t bytes) override;
+        uint64_t Write(const uint8_t* data, uint64_t bytes) override;
+
+        bool IsGood() const override;
+        uint64_t GetSize() const override;
+        MapResult Map() override;
+        NativeResult GetNative() override;
+
+    private:
+        MappedFileHandle(const fs::path& path, OpenFlags::Type flags);
+
+        MappingPtr m_mapping;
+        const uint8_t* m_data = nullptr;
+        uint64_t m_offset = 0;
+        uint64_t m_size = 0;
+        uint64_t m_position = 0;
+    };
+}
@@ -5,6 +5,76 @@
 
 #pragma once
 
+#include <mutex>
+#include "System/FileSystem/FileDepot.hpp"
+#include "System/FileSystem/MemoryFileHandle.hpp"
+
 /*
     Memory File Depot
+
+    Collection of files held in memory that can be mounted under specified
+    path using file system. Useful for tests that should not touch disk, for
+    data that is generated at runtime and for assets embedded in executable.
+
+    Files can be added either with owned buffers that are shared with opened
+    handles (and can be written to), or with borrowed memory that is only read
+    and must outlive depot (e.g. static arrays). Opening missing file for
+    writing creates new owned file in depot.
+
+    void ExampleMountMemory(System::FileSystem& fileSystem)
+    {
+        static const uint8_t data[] = { 'H', 'e', 'l', 'l', 'o' };
+
+        auto memoryDepot = System::MemoryFileDepot::Create().Unwrap();
+        memoryDepot->AddFile("Data/Hello.txt", data, sizeof(data));
+        fileSystem.MountDepot("./", std::move(memoryDepot));
+    }
 */
+
+namespace System
+{
+    class MemoryFileDepot final : public FileDepot
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<MemoryFileDepot>, void>;
+        static CreateResult Create();
+
+        enum class AddFileErrors
+        {
+            EmptyFilePathArgument,
+            InvalidFilePathArgument,
+            InvalidBufferArgument,
+        };
+
+        using AddFileResult = Common::Result<void, AddFileErrors>;
+
+    public:
+        ~MemoryFileDepot();
+
+        AddFileResult AddFile(const fs::path& path, MemoryFileHandle::BufferPtr buffer);
+        AddFileResult AddFile(const fs::path& path, const uint8_t* data, std::size_t size);
+        bool RemoveFile(const fs::path& path);
+
+        OpenFileResult OpenFile(const fs::path& depotPath, const fs::path& requestedPath,
+            FileHandle::OpenFlags::Type openFlags) override;
+
+        std::size_t GetFileCount() const;
+
+    private:
+        MemoryFileDepot();
+
+        struct MemoryFile
+        {
+            MemoryFileHandle::BufferPtr buffer;
+            const uint8_t* data = nullptr;
+            std::size_t size = 0;
+        };
+
+        using FileMap = std::unordered_map<std::string, MemoryFile>;
+
+        AddFileResult AddFile(const fs::path& path, MemoryFile file);
+
+        mutable std::mutex m_fileLock;
+        FileMap m_files;
+    };
+}
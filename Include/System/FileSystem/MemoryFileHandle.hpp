@@ -5,6 +5,55 @@
 
 #pragma once
 
+#include "System/FileSystem/FileHandle.hpp"
+#include "System/FileSystem/FileDepot.hpp"
+
 /*
     Memory File Handle
+
+    File handle that reads from and writes to memory buffer instead of native
+    file. Buffer is shared, so data written through one handle is visible to
+    handles opened afterwards. Used to hold contents of files that have already
+    been read, for example by asynchronous resource loading.
+
+    Handle can also read from borrowed memory that it does not own (e.g. data
+    embedded in executable), in which case it is read only and memory must
+    outlive the handle.
 */
+
+namespace System
+{
+    class MemoryFileHandle final : public FileHandle
+    {
+    public:
+        using Buffer = std::vector<uint8_t>;
+        using BufferPtr = std::shared_ptr<Buffer>;
+        using OpenFileErrors = FileDepot::OpenFileErrors;
+
+        static FileDepot::OpenFileResult Create(BufferPtr buffer,
+            const fs::path& requestedPath, OpenFlags::Type openFlags);
+        static FileDepot::OpenFileResult Create(const uint8_t* data, uint64_t size,
+            const fs::path& requestedPath, OpenFlags::Type openFlags);
+
+        ~MemoryFileHandle();
+
+        uint64_t Tell() override;
+        uint64_t Seek(uint64_t offset, SeekMode mode) override;
+        uint64_t Read(uint8_t* data, uint64_t bytes) override;
+        uint64_t Write(const uint8_t* data, uint64_t bytes) override;
+
+        bool IsGood() const override;
+        uint64_t GetSize() const override;
+        MapResult Map() override;
+
+    private:
+        MemoryFileHandle(const fs::path& path, OpenFlags::Type flags);
+
+        const uint8_t* GetData() const;
+
+        BufferPtr m_buffer;
+        const uint8_t* m_borrowedData = nullptr;
+        uint64_t m_borrowedSize = 0;
+        uint64_t m_position = 0;
+    };
+}
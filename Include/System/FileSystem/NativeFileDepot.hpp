@@ -6,12 +6,17 @@
 #pragma once
 
 #include "System/FileSystem/FileDepot.hpp"
+#include "System/FileSystem/FileWatcher.hpp"
 
 /*
     Native File Depot
 
     Collection of loose files present in native directory that can be mounted
     under different path using file system.
+
+    When watching is started, directories of files that are opened for reading
+    are watched for changes, so only directories that loaded resources come
+    from are watched instead of entire depot directory tree.
 */
 
 namespace System
@@ -33,9 +38,13 @@ namespace System
         OpenFileResult OpenFile(const fs::path& depotPath, const fs::path& requestedPath,
             FileHandle::OpenFlags::Type openFlags) override;
 
+        bool StartWatching() override;
+        void CollectChangedFiles(std::vector<fs::path>& depotPaths) override;
+
     private:
         NativeFileDepot();
 
         fs::path m_fileDirectory;
+        std::unique_ptr<FileWatcher> m_fileWatcher;
     };
 }
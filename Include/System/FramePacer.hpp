@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <chrono>
+
+/*
+    Frame Pacer
+
+    Paces main loop to target frame rate for consistent frame times. Sleeping
+    alone wakes up late by scheduler granularity, while spinning alone burns
+    whole core, so pacer sleeps until shortly before next frame and then spins
+    for the remaining time. Frames that finished late are not caught up,
+    pacing continues from current time instead.
+
+    void ExampleFramePacer()
+    {
+        System::FramePacer framePacer;
+        framePacer.SetTargetFrameRate(60.0f);
+        framePacer.Reset();
+
+        while(true)
+        {
+            ProcessFrame();
+            framePacer.WaitForNextFrame();
+        }
+    }
+*/
+
+namespace System
+{
+    class FramePacer final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr float DefaultSpinSeconds = 0.002f;
+
+    public:
+        FramePacer();
+        ~FramePacer();
+
+        // Zero target frame rate disables pacing.
+        void SetTargetFrameRate(float frameRate);
+        void SetSpinSeconds(float spinSeconds);
+
+        void Reset();
+        void WaitForNextFrame();
+
+        float GetTargetFrameRate() const;
+        float GetSpinSeconds() const;
+        float GetLastWaitSeconds() const;
+        float GetLastWakeErrorSeconds() const;
+        uint64_t GetMissedFrameCount() const;
+
+    private:
+        float m_targetFrameRate = 0.0f;
+        Clock::duration m_frameDuration = Clock::duration::zero();
+        Clock::duration m_spinDuration = Clock::duration::zero();
+        Clock::time_point m_nextFrameTime;
+
+        float m_lastWaitSeconds = 0.0f;
+        float m_lastWakeErrorSeconds = 0.0f;
+        uint64_t m_missedFrameCount = 0;
+    };
+}
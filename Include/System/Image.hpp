@@ -8,7 +8,16 @@
 /*
     Image
 
-    Loads image data from arbitrary formats.
+    Loads image data from arbitrary formats. Files are decoded straight from
+    memory when their handles can be mapped, otherwise they are read whole
+    into buffer first. Decoding does not share any state, so images can be
+    decoded on multiple threads in parallel (e.g. resource loading threads).
+
+    Supported formats are PNG for source assets and QOI for cooked builds,
+    which is lossless as well, but decodes several times faster than PNG.
+    Images can be encoded to QOI format with EncodeQOI().
+
+    Image rows are stored bottom to top, matching OpenGL texture coordinates.
 */
 
 namespace System
@@ -18,35 +27,67 @@ namespace System
     class Image final
     {
     public:
+        enum class Format
+        {
+            Unknown,
+            PNG,
+            QOI,
+        };
+
+        using Data = std::vector<uint8_t>;
+
+        struct CreateFromParams
+        {
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            Data data;
+        };
+
         struct LoadFromFile
         {
         };
 
+        struct LoadFromMemory
+        {
+            const uint8_t* data = nullptr;
+            std::size_t size = 0;
+            Format format = Format::Unknown;
+        };
+
         enum class CreateErrors
         {
             InvalidArgument,
             UnknownExtension,
             FailedFileRead,
             FailedPngLoad,
+            FailedQoiLoad,
         };
 
         using CreateResult = Common::Result<std::unique_ptr<Image>, CreateErrors>;
+        static CreateResult Create(const CreateFromParams& params);
         static CreateResult Create(FileHandle& file, const LoadFromFile& params);
+        static CreateResult Create(const LoadFromMemory& params);
 
-        using Data = std::vector<uint8_t>;
+        static Format GetFormatFromExtension(const fs::path& path);
+
+        using EncodeResult = Common::Result<Data, void>;
 
     public:
         ~Image();
 
+        EncodeResult EncodeQOI() const;
+
         const uint8_t* GetData() const;
         int GetWidth() const;
         int GetHeight() const;
         int GetChannels() const;
-        
+
     private:
         Image();
 
-        Common::FailureResult<CreateErrors> LoadPNG(FileHandle& file);
+        Common::FailureResult<CreateErrors> LoadPNG(const uint8_t* data, std::size_t size);
+        Common::FailureResult<CreateErrors> LoadQOI(const uint8_t* data, std::size_t size);
 
         Data m_data;
         int m_width = 0;
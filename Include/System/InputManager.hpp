@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <Core/EngineSystem.hpp>
 #include "System/InputState.hpp"
 #include "System/WindowEvents.hpp"
@@ -13,6 +15,9 @@
     Input Manager
 
     Listens to all input related events from window and propagates them to current input state.
+    Time of earliest input received since it was last taken is kept for measuring input latency.
+    Window events carry no timestamps, so input is stamped with time of previous event poll,
+    which is the earliest time input reported by current poll could have been queued at.
 */
 
 namespace System
@@ -32,9 +37,17 @@ namespace System
 
         InputState& GetInputState();
 
+        // Called once window events have been polled.
+        void MarkEventsPolled();
+
+        using InputTime = std::chrono::steady_clock::time_point;
+        std::optional<InputTime> TakeEarliestInputTime();
+
     private:
         bool OnAttach(const Core::EngineSystemStorage& engineSystems) override;
 
+        void MarkInputReceived();
+
         static InputManager* GetInputManagerFromUserData(GLFWwindow* handle);
         static void TextInputCallback(GLFWwindow* handle, unsigned int character);
         static void KeyboardKeyCallback(GLFWwindow* handle, int key, int scancode, int action, int mods);
@@ -46,6 +59,8 @@ namespace System
     private:
         WindowContext* m_windowContext = nullptr;
         InputState m_inputState;
+        std::optional<InputTime> m_earliestInputTime;
+        std::optional<InputTime> m_lastPollTime;
     };
 }
 
@@ -0,0 +1,402 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <tuple>
+#include <typeindex>
+#include "System/ResourcePool.hpp"
+#include "System/FileSystem/FileSystem.hpp"
+#include "System/FileSystem/MemoryFileHandle.hpp"
+
+/*
+    Resource Loading
+
+    Asynchronous resource loading is split into two steps. Prepare step runs on
+    loading thread where resource file is opened and processed without touching
+    any state owned by main thread (e.g. image is decoded). Finalize step then
+    runs on main thread where resource is created from prepared data (e.g. image
+    is uploaded to GPU texture) and added to its resource pool.
+
+    Resource type can do its own work in prepare step by declaring PrepareResult
+    type that is returned from Prepare() and then consumed by Create() methods:
+
+        static PrepareResult Prepare(FileHandle& file, const Params& params);
+        static CreateResult Create(PreparedType&& prepared, const Params& params);
+
+    Otherwise only file contents are read into memory in prepare step, and
+    resource is created in finalize step from memory file via regular Create().
+
+    Prepared resource can also declare other resources that it depends on,
+    which are then queued for loading in parallel with each other. Finalize
+    step is deferred until all dependencies are done, so they can be acquired
+    without blocking once resource is created. Dependencies cannot be cyclic.
+
+        static void AcquireDependencies(ResourceDependencies& dependencies,
+            const PreparedType& prepared, const Params& params);
+
+    Same load steps are used when resource is reloaded after its file changes,
+    except that reloaded resource replaces one that is already in its pool
+    (see ResourcePool::Replace) and failed reload keeps previous resource.
+*/
+
+namespace System
+{
+    class ResourceManager;
+    class ResourceDependencies;
+
+    template<typename Type, typename = void>
+    struct IsResourcePreparable : std::false_type
+    {
+    };
+
+    template<typename Type>
+    struct IsResourcePreparable<Type, std::void_t<typename Type::PrepareResult>> : std::true_type
+    {
+    };
+
+    template<typename Type, typename = void>
+    struct IsResourceDependent : std::false_type
+    {
+    };
+
+    template<typename Type>
+    struct IsResourceDependent<Type, std::void_t<decltype(&Type::AcquireDependencies)>> : std::true_type
+    {
+    };
+
+    template<typename Type, bool Preparable = IsResourcePreparable<Type>::value>
+    struct ResourcePreparedData
+    {
+        using DataType = MemoryFileHandle::BufferPtr;
+    };
+
+    template<typename Type>
+    struct ResourcePreparedData<Type, true>
+    {
+        using DataType = typename Type::PrepareResult::DeductedSuccessType;
+    };
+
+    class ResourceLoadState : private Common::NonCopyable
+    {
+    public:
+        enum class Status
+        {
+            Queued,
+            Prepared,
+            Succeeded,
+            Failed,
+        };
+
+        virtual ~ResourceLoadState() = default;
+
+        Status GetStatus() const
+        {
+            return m_status.load(std::memory_order_acquire);
+        }
+
+        bool IsDone() const
+        {
+            Status status = GetStatus();
+            return status == Status::Succeeded || status == Status::Failed;
+        }
+
+        std::type_index GetType() const
+        {
+            return m_type;
+        }
+
+        const fs::path& GetPath() const
+        {
+            return m_path;
+        }
+
+        bool IsReload() const
+        {
+            return m_reload;
+        }
+
+        bool AreDependenciesDone() const
+        {
+            return std::all_of(m_dependencies.begin(), m_dependencies.end(),
+                [](const auto& dependency)
+                {
+                    return dependency->IsDone();
+                });
+        }
+
+    protected:
+        ResourceLoadState(std::type_index type, fs::path path) :
+            m_type(type),
+            m_path(std::move(path))
+        {
+        }
+
+        // Called on loading thread, unless there are none.
+        virtual void OnPrepare(FileSystem& fileSystem) = 0;
+
+        // Called on main thread after prepare step, before finalize step.
+        virtual void OnAcquireDependencies(ResourceDependencies&)
+        {
+        }
+
+        // Called on main thread, returns whether resource has been created.
+        virtual bool OnFinalize() = 0;
+
+    private:
+        friend ResourceManager;
+        friend ResourceDependencies;
+
+        using DependencyList = std::vector<std::shared_ptr<ResourceLoadState>>;
+        using DependencyResourceList = std::vector<std::shared_ptr<const void>>;
+
+        std::type_index m_type;
+        fs::path m_path;
+        std::atomic<Status> m_status = Status::Queued;
+        bool m_reload = false;
+
+        // Accessed only from main thread.
+        DependencyList m_dependencies;
+        DependencyResourceList m_dependencyResources;
+        bool m_dependenciesAcquired = false;
+    };
+
+    /*
+        Resource Dependencies
+
+        Acquires resources that are needed to finalize resource being loaded.
+        Loaded resources are kept alive until dependent resource is finalized.
+    */
+
+    class ResourceDependencies : private Common::NonCopyable
+    {
+    public:
+        ResourceDependencies(ResourceManager& resourceManager, ResourceLoadState& loadState) :
+            m_resourceManager(resourceManager),
+            m_loadState(loadState)
+        {
+        }
+
+        template<typename Type, typename... Arguments>
+        void Acquire(fs::path path, Arguments... arguments);
+
+    private:
+        ResourceManager& m_resourceManager;
+        ResourceLoadState& m_loadState;
+    };
+
+    template<typename Type>
+    class ResourceLoadResult : public ResourceLoadState
+    {
+    public:
+        using ResourcePtr = std::shared_ptr<Type>;
+
+        const ResourcePtr& GetResource() const
+        {
+            ASSERT(IsDone(), "Resource can only be accessed after loading is done!");
+            return m_resource;
+        }
+
+    protected:
+        ResourceLoadResult(fs::path path) :
+            ResourceLoadState(typeid(Type), std::move(path))
+        {
+        }
+
+        ResourcePtr m_resource;
+    };
+
+    template<typename Type, typename... Arguments>
+    class ResourceLoadTask final : public ResourceLoadResult<Type>
+    {
+    public:
+        using PreparedData = typename ResourcePreparedData<Type>::DataType;
+
+        ResourceLoadTask(ResourcePool<Type>* pool, fs::path path, Arguments... arguments) :
+            ResourceLoadResult<Type>(std::move(path)),
+            m_pool(pool),
+            m_arguments(std::move(arguments)...)
+        {
+            ASSERT(m_pool != nullptr, "Resource load task needs valid resource pool!");
+        }
+
+    private:
+        void OnPrepare(FileSystem& fileSystem) override
+        {
+            std::unique_ptr<FileHandle> file = fileSystem.OpenFile(
+                this->GetPath(), FileHandle::OpenFlags::Read).UnwrapOr(nullptr);
+
+            if(file == nullptr)
+                return;
+
+            if constexpr(IsResourcePreparable<Type>::value)
+            {
+                auto prepareResult = std::apply([&file](const auto&... arguments)
+                {
+                    return Type::Prepare(*file, arguments...);
+                }, m_arguments);
+
+                if(prepareResult)
+                {
+                    m_prepared.emplace(prepareResult.Unwrap());
+                }
+            }
+            else
+            {
+                auto buffer = std::make_shared<MemoryFileHandle::Buffer>(file->ReadAsBinaryArray());
+                if(buffer->size() == file->GetSize())
+                {
+                    m_prepared.emplace(std::move(buffer));
+                }
+            }
+        }
+
+        void OnAcquireDependencies(ResourceDependencies& dependencies) override
+        {
+            if constexpr(IsResourceDependent<Type>::value)
+            {
+                if(!m_prepared.has_value())
+                    return;
+
+                std::apply([this, &dependencies](const auto&... arguments)
+                {
+                    Type::AcquireDependencies(dependencies, *m_prepared, arguments...);
+                }, m_arguments);
+            }
+        }
+
+        bool OnFinalize() override
+        {
+            if(m_prepared.has_value())
+            {
+                PreparedData prepared = std::move(*m_prepared);
+                m_prepared.reset();
+
+                auto createResult = std::apply([this, &prepared](const auto&... arguments)
+                {
+                    if constexpr(IsResourcePreparable<Type>::value)
+                    {
+                        return Type::Create(std::move(prepared), arguments...);
+                    }
+                    else
+                    {
+                        auto file = MemoryFileHandle::Create(std::move(prepared),
+                            this->GetPath(), FileHandle::OpenFlags::Read).Unwrap();
+                        return Type::Create(*file, arguments...);
+                    }
+                }, m_arguments);
+
+                if(createResult)
+                {
+                    std::shared_ptr<Type> resource = createResult.Unwrap();
+                    ASSERT(resource != nullptr, "Successfully created resource is null!");
+
+                    if(this->IsReload())
+                    {
+                        this->m_resource = m_pool->Replace(this->GetPath(), std::move(resource));
+                    }
+                    else
+                    {
+                        this->m_resource = m_pool->Insert(this->GetPath(), std::move(resource));
+                    }
+
+                    return true;
+                }
+            }
+
+            // Previous resource is kept when it fails to be reloaded.
+            if(this->IsReload())
+            {
+                this->m_resource = m_pool->Find(this->GetPath());
+            }
+
+            if(this->m_resource == nullptr)
+            {
+                this->m_resource = m_pool->GetDefault();
+            }
+
+            return false;
+        }
+
+    private:
+        ResourcePool<Type>* m_pool = nullptr;
+        std::tuple<Arguments...> m_arguments;
+        std::optional<PreparedData> m_prepared;
+    };
+
+    /*
+        Resource Future
+
+        Handle to resource that is being loaded asynchronously. Resource can be
+        retrieved once loading is done, or waited for which finishes loading
+        right away. Failed load results in default resource of its type.
+        Must only be accessed from main thread.
+    */
+
+    template<typename Type>
+    class ResourceFuture
+    {
+    public:
+        using ResourcePtr = std::shared_ptr<Type>;
+        using LoadStatePtr = std::shared_ptr<ResourceLoadResult<Type>>;
+
+        ResourceFuture() = default;
+        ResourceFuture(ResourceManager* resourceManager, LoadStatePtr loadState) :
+            m_resourceManager(resourceManager),
+            m_loadState(std::move(loadState))
+        {
+        }
+
+        ResourceFuture(ResourcePtr resource) :
+            m_resource(std::move(resource)),
+            m_ready(true)
+        {
+        }
+
+        bool IsValid() const
+        {
+            return m_ready || m_loadState != nullptr;
+        }
+
+        bool IsReady() const
+        {
+            return m_ready || (m_loadState != nullptr && m_loadState->IsDone());
+        }
+
+        bool IsSuccess() const
+        {
+            if(m_ready)
+                return m_resource != nullptr;
+
+            return m_loadState != nullptr &&
+                m_loadState->GetStatus() == ResourceLoadState::Status::Succeeded;
+        }
+
+        ResourcePtr Get() const
+        {
+            if(m_ready)
+                return m_resource;
+
+            ASSERT(IsReady(), "Resource future is not ready yet!");
+            return m_loadState->GetResource();
+        }
+
+        ResourcePtr Wait();
+
+        const LoadStatePtr& GetLoadState() const
+        {
+            return m_loadState;
+        }
+
+    private:
+        ResourceManager* m_resourceManager = nullptr;
+        LoadStatePtr m_loadState;
+        ResourcePtr m_resource;
+        bool m_ready = false;
+    };
+}
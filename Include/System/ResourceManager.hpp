@@ -5,8 +5,15 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <Core/EngineSystem.hpp>
 #include "System/ResourcePool.hpp"
+#include "System/ResourceLoading.hpp"
 #include "System/FileSystem/FileSystem.hpp"
 
 /*
@@ -15,6 +22,47 @@
     Tracks resource references and releases them when no longer needed.
     Wraps multiple ResourcePool instances that can hold resources of different
     types in a single ResourceManager instance.
+
+    Resources can also be acquired asynchronously, in which case file reading
+    and decoding is done on loading threads, while creation of resources that
+    requires main thread (e.g. GPU uploads) is finalized at the start of each
+    frame within configured time budget. Concurrent acquisitions of resource
+    that is already being loaded share the same load, including synchronous
+    ones which finish it right away. See ResourceLoading for more context.
+
+    Resources that are already loaded can also be acquired by precomputed name
+    of their normalized path, which skips path processing entirely and can be
+    done from any thread without taking locks (e.g. when spawning objects).
+
+    Unused resources are kept cached while they fit within memory budgets of
+    their pools and global memory budget, which are enforced once per frame by
+    releasing least recently used resources first.
+
+    With hot reload enabled, file system watches files that loaded resources
+    came from, and changed resources are reloaded asynchronously in the same
+    way they were loaded, then swapped in place of previous ones once they are
+    finalized (see ResourcePool::Replace). Resources acquired while another
+    resource is being created are recorded as its dependencies, so resources
+    that depend on reloaded one (e.g. sprite animation list on texture atlas)
+    are reloaded after it, while unaffected resources are left untouched.
+
+    void ExampleAcquireAsync(System::ResourceManager& resourceManager)
+    {
+        auto future = resourceManager.AcquireAsync<Graphics::Texture>(
+            "Data/Textures/Example.png", Graphics::Texture::LoadFromFile{ ... });
+
+        if(future.IsReady())
+        {
+            Graphics::TexturePtr texture = future.Get();
+        }
+    }
+
+    void ExampleAcquireCached(System::ResourceManager& resourceManager)
+    {
+        static const Common::Name texturePath = NAME_CONSTEXPR("Data/Textures/Example.png");
+        Graphics::TexturePtr texture = resourceManager.AcquireCached<Graphics::Texture>(
+            texturePath).UnwrapEither();
+    }
 */
 
 namespace System
@@ -26,9 +74,29 @@ namespace System
         REFLECTION_ENABLE(ResourceManager, Core::EngineSystem)
 
     public:
+        static constexpr std::size_t MaxResourceTypes = 64;
+
         using ResourcePoolPtr = std::unique_ptr<ResourcePoolInterface>;
-        using ResourcePoolList = std::unordered_map<std::type_index, ResourcePoolPtr>;
-        using ResourcePoolPair = typename ResourcePoolList::value_type;
+        using ResourcePoolList = std::vector<ResourcePoolPtr>;
+        using ResourcePoolTable = std::array<std::atomic<ResourcePoolInterface*>, MaxResourceTypes>;
+        using LoadStatePtr = std::shared_ptr<ResourceLoadState>;
+        using LoadQueue = std::deque<LoadStatePtr>;
+        using LoadStateMap = std::unordered_map<std::string, LoadStatePtr>;
+        using LoadingResourceMap = std::unordered_map<std::type_index, LoadStateMap>;
+        using LoadingThreadList = std::vector<std::thread>;
+        using ResourceKey = std::pair<std::type_index, std::string>;
+        using ResourceKeyList = std::vector<ResourceKey>;
+        using ReloadFunction = std::function<LoadStatePtr()>;
+
+        struct ReloadEntry
+        {
+            std::type_index type;
+            ReloadFunction createLoad;
+            ResourceKeyList dependents;
+        };
+
+        using ReloadEntryList = std::vector<ReloadEntry>;
+        using ReloadEntryMap = std::unordered_map<std::string, ReloadEntryList>;
 
     public:
         ResourceManager();
@@ -51,6 +119,33 @@ namespace System
         typename ResourcePool<Type>::AcquireResult AcquireRelative(
             fs::path filePath, fs::path relativeFilePath, Arguments... arguments);
 
+        template<typename Type>
+        typename ResourcePool<Type>::AcquireResult AcquireCached(Common::Name path);
+
+        template<typename Type, typename... Arguments>
+        ResourceFuture<Type> AcquireAsync(
+            fs::path filePath, Arguments... arguments);
+
+        template<typename Type, typename... Arguments>
+        ResourceFuture<Type> AcquireRelativeAsync(
+            fs::path filePath, fs::path relativeFilePath, Arguments... arguments);
+
+        void FinalizeAsyncLoads();
+        void WaitForLoad(ResourceLoadState& loadState);
+
+        void ReloadChangedResources();
+        void Reload(const fs::path& path);
+        bool IsHotReloadEnabled() const;
+
+        template<typename Type>
+        void SetMemoryBudget(std::size_t totalBytes);
+
+        template<typename Type>
+        ResourceMemoryUsage GetMemoryUsage();
+
+        void SetMemoryBudget(std::size_t totalBytes);
+        ResourceMemoryUsage GetMemoryUsage() const;
+
         void ReleaseUnused();
         void ReleaseAll();
 
@@ -58,14 +153,60 @@ namespace System
         bool OnAttach(const Core::EngineSystemStorage& engineSystems) override;
 
         template<typename Type>
-        ResourcePool<Type>* CreatePool();
+        ResourcePool<Type>* GetPool();
+
+        template<typename Function>
+        void ForEachPool(Function function) const;
 
         template<typename Type>
-        ResourcePool<Type>* GetPool();
+        static std::size_t GetResourceTypeIndex();
+        static std::size_t AllocateResourceTypeIndex();
+
+        template<typename Type, typename... Arguments>
+        void TrackReload(ResourcePool<Type>* pool, const fs::path& path, const Arguments&... arguments);
+        ReloadEntry* FindReloadEntry(std::type_index type, const std::string& path);
+        void AddReloadDependent(ReloadEntry& entry);
+        void QueueReload(std::type_index type, const std::string& path);
+
+        LoadStatePtr FindLoad(std::type_index type, const fs::path& path) const;
+        LoadStatePtr TakeLoad(ResourceLoadState& loadState);
+        LoadStatePtr TakeWaitingLoad();
+        void QueueLoad(LoadStatePtr loadState);
+        void PrepareLoad(ResourceLoadState& loadState);
+        bool AcquireDependencies(ResourceLoadState& loadState);
+        void FinalizeLoad(ResourceLoadState& loadState);
+        void RunLoadingThread();
+        void StopLoadingThreads();
 
     private:
         FileSystem* m_fileSystem;
+        ResourcePoolTable m_poolTable = {};
+
+        // Pools are owned by list that is accessed only while holding pool
+        // lock, as they can be created from any thread. Use pool table instead.
         ResourcePoolList m_pools;
+        std::mutex m_poolLock;
+        std::size_t m_memoryBudget = ResourcePoolInterface::UnlimitedBudget;
+        uint64_t m_releaseTick = 0;
+
+        std::mutex m_loadingLock;
+        std::condition_variable m_loadingCondition;
+        std::condition_variable m_preparedCondition;
+        LoadQueue m_prepareQueue;
+        LoadQueue m_finalizeQueue;
+        LoadingThreadList m_loadingThreads;
+
+        // Accessed only from main thread.
+        LoadQueue m_waitingQueue;
+        LoadingResourceMap m_loadingResources;
+        bool m_loadingStopped = false;
+        float m_finalizeBudget = 0.004f;
+
+        // Accessed only from main thread.
+        bool m_hotReload = false;
+        ReloadEntryMap m_reloadEntries;
+        LoadingResourceMap m_reloadingResources;
+        ResourceKeyList m_creatingResources;
     };
 
     template<typename Type>
@@ -112,39 +253,215 @@ namespace System
     {
         ResourcePool<Type>* pool = this->GetPool<Type>();
         ASSERT(pool != nullptr, "Could not retrieve resource pool!");
-        return pool->Acquire(relativePath.remove_filename() / path,
+
+        // Return existing resource right away if already loaded.
+        path = (relativePath.remove_filename() / path).lexically_normal();
+        this->TrackReload(pool, path, arguments...);
+
+        if(auto resource = pool->Find(path))
+        {
+            return Common::Success(std::move(resource));
+        }
+
+        // Finish resource load right away if already in progress.
+        if(LoadStatePtr loadState = this->FindLoad(typeid(Type), path))
+        {
+            this->WaitForLoad(*loadState);
+
+            auto resource = static_cast<ResourceLoadResult<Type>&>(*loadState).GetResource();
+            if(loadState->GetStatus() == ResourceLoadState::Status::Succeeded)
+            {
+                return Common::Success(std::move(resource));
+            }
+            else
+            {
+                return Common::Failure(std::move(resource));
+            }
+        }
+
+        // Resources acquired during creation are recorded as its dependencies.
+        if(!m_hotReload)
+            return pool->Acquire(path, std::forward<Arguments>(arguments)...);
+
+        m_creatingResources.emplace_back(typeid(Type), path.generic_string());
+        auto acquireResult = pool->Acquire(path, std::forward<Arguments>(arguments)...);
+        m_creatingResources.pop_back();
+        return acquireResult;
+    }
+
+    template<typename Type>
+    typename ResourcePool<Type>::AcquireResult ResourceManager::AcquireCached(Common::Name path)
+    {
+        // Can be called from any thread, as resource is never loaded here.
+        ResourcePool<Type>* pool = this->GetPool<Type>();
+        ASSERT(pool != nullptr, "Could not retrieve resource pool!");
+
+        if(auto resource = pool->Find(path))
+        {
+            return Common::Success(std::move(resource));
+        }
+
+        return Common::Failure(pool->GetDefault());
+    }
+
+    template<typename Type, typename... Arguments>
+    ResourceFuture<Type> ResourceManager::AcquireAsync(
+        fs::path path, Arguments... arguments)
+    {
+        // Call relative acquisition method with empty relative path.
+        return this->AcquireRelativeAsync<Type>(path, "",
             std::forward<Arguments>(arguments)...);
     }
 
+    template<typename Type, typename... Arguments>
+    ResourceFuture<Type> ResourceManager::AcquireRelativeAsync(
+        fs::path path, fs::path relativePath, Arguments... arguments)
+    {
+        ResourcePool<Type>* pool = this->GetPool<Type>();
+        ASSERT(pool != nullptr, "Could not retrieve resource pool!");
+
+        // Return existing resource right away if already loaded.
+        path = (relativePath.remove_filename() / path).lexically_normal();
+        this->TrackReload(pool, path, arguments...);
+
+        if(auto resource = pool->Find(path))
+        {
+            return ResourceFuture<Type>(std::move(resource));
+        }
+
+        // Share load with previous acquisitions if already in progress.
+        if(LoadStatePtr loadState = this->FindLoad(typeid(Type), path))
+        {
+            return ResourceFuture<Type>(this,
+                std::static_pointer_cast<ResourceLoadResult<Type>>(loadState));
+        }
+
+        // Queue resource for loading on one of loading threads.
+        auto loadTask = std::make_shared<ResourceLoadTask<Type, Arguments...>>(
+            pool, path, std::forward<Arguments>(arguments)...);
+        m_loadingResources[typeid(Type)].emplace(path.generic_string(), loadTask);
+        this->QueueLoad(loadTask);
+
+        return ResourceFuture<Type>(this, std::move(loadTask));
+    }
+
     template<typename Type>
-    ResourcePool<Type>* ResourceManager::CreatePool()
+    void ResourceManager::SetMemoryBudget(std::size_t totalBytes)
     {
-        // Create and add new resource pool.
-        auto pool = std::make_unique<ResourcePool<Type>>(m_fileSystem);
-        auto pair = ResourcePoolPair(typeid(Type), std::move(pool));
-        auto result = m_pools.emplace(std::move(pair));
-        ASSERT(result.second, "Could not emplace new resource pool!");
+        ResourcePool<Type>* pool = this->GetPool<Type>();
+        ASSERT(pool != nullptr, "Could not retrieve resource pool!");
+        pool->SetMemoryBudget(totalBytes);
+    }
 
-        // Return created resource pool.
-        return reinterpret_cast<ResourcePool<Type>*>(result.first->second.get());
+    template<typename Type>
+    ResourceMemoryUsage ResourceManager::GetMemoryUsage()
+    {
+        ResourcePool<Type>* pool = this->GetPool<Type>();
+        ASSERT(pool != nullptr, "Could not retrieve resource pool!");
+        return pool->GetMemoryUsage();
     }
 
     template<typename Type>
     ResourcePool<Type>* ResourceManager::GetPool()
     {
-        // Find pool by resource type.
-        auto it = m_pools.find(typeid(Type));
-        if(it != m_pools.end())
+        // Find pool by index assigned to resource type.
+        const std::size_t index = GetResourceTypeIndex<Type>();
+        ResourcePoolInterface* pool = m_poolTable[index].load(std::memory_order_acquire);
+
+        if(pool == nullptr)
+        {
+            // Create new resource pool unless another thread did it first.
+            std::scoped_lock<std::mutex> lock(m_poolLock);
+
+            pool = m_poolTable[index].load(std::memory_order_relaxed);
+            if(pool == nullptr)
+            {
+                pool = m_pools.emplace_back(std::make_unique<ResourcePool<Type>>(m_fileSystem)).get();
+                m_poolTable[index].store(pool, std::memory_order_release);
+            }
+        }
+
+        // Cast and return the pointer that we already know is a resource pool.
+        return static_cast<ResourcePool<Type>*>(pool);
+    }
+
+    template<typename Function>
+    void ResourceManager::ForEachPool(Function function) const
+    {
+        // Pool table is never reallocated, so it can be iterated
+        // while other threads are creating new pools in it.
+        for(const auto& poolEntry : m_poolTable)
+        {
+            if(ResourcePoolInterface* pool = poolEntry.load(std::memory_order_acquire))
+            {
+                function(*pool);
+            }
+        }
+    }
+
+    template<typename Type>
+    std::size_t ResourceManager::GetResourceTypeIndex()
+    {
+        static const std::size_t index = AllocateResourceTypeIndex();
+        return index;
+    }
+
+    template<typename Type, typename... Arguments>
+    void ResourceManager::TrackReload(ResourcePool<Type>* pool,
+        const fs::path& path, const Arguments&... arguments)
+    {
+        if(!m_hotReload)
+            return;
+
+        // Remember how resource is loaded, so it can be reloaded the same way.
+        // Path is expected to be already normalized.
+        const std::string pathString = path.generic_string();
+        ReloadEntry* entry = this->FindReloadEntry(typeid(Type), pathString);
+
+        if(entry == nullptr)
+        {
+            ReloadFunction createLoad = [pool, path, arguments...]() -> LoadStatePtr
+            {
+                // Resource that has been released since is not reloaded.
+                if(pool->Find(path) == nullptr)
+                    return nullptr;
+
+                return std::make_shared<ResourceLoadTask<Type, Arguments...>>(pool, path, arguments...);
+            };
+
+            entry = &m_reloadEntries[pathString].emplace_back(
+                ReloadEntry{ typeid(Type), std::move(createLoad), {} });
+        }
+
+        this->AddReloadDependent(*entry);
+    }
+
+    template<typename Type, typename... Arguments>
+    void ResourceDependencies::Acquire(fs::path path, Arguments... arguments)
+    {
+        ResourceFuture<Type> future = m_resourceManager.AcquireAsync<Type>(
+            std::move(path), std::forward<Arguments>(arguments)...);
+
+        if(future.GetLoadState() != nullptr)
         {
-            // Cast and return the pointer that we already know is a resource pool.
-            ASSERT(it->second.get() != nullptr, "Retrieved resource pool is null!");
-            return reinterpret_cast<ResourcePool<Type>*>(it->second.get());
+            m_loadState.m_dependencies.push_back(future.GetLoadState());
         }
         else
         {
-            // Create and return new resource pool.
-            return this->CreatePool<Type>();
+            m_loadState.m_dependencyResources.push_back(future.Get());
+        }
+    }
+
+    template<typename Type>
+    typename ResourceFuture<Type>::ResourcePtr ResourceFuture<Type>::Wait()
+    {
+        if(!m_ready)
+        {
+            ASSERT(m_loadState != nullptr, "Cannot wait on invalid resource future!");
+            m_resourceManager->WaitForLoad(*m_loadState);
         }
+
+        return Get();
     }
 };
 
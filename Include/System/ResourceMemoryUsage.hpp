@@ -0,0 +1,67 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+/*
+    Resource Memory Usage
+
+    Approximate memory footprint of resource split between main and GPU memory.
+    Resource type can report its own by implementing GetMemoryUsage() method,
+    otherwise only size of its instance is accounted for.
+*/
+
+namespace System
+{
+    struct ResourceMemoryUsage
+    {
+        std::size_t cpuBytes = 0;
+        std::size_t gpuBytes = 0;
+
+        std::size_t GetTotalBytes() const
+        {
+            return cpuBytes + gpuBytes;
+        }
+
+        ResourceMemoryUsage& operator+=(const ResourceMemoryUsage& other)
+        {
+            cpuBytes += other.cpuBytes;
+            gpuBytes += other.gpuBytes;
+            return *this;
+        }
+
+        ResourceMemoryUsage& operator-=(const ResourceMemoryUsage& other)
+        {
+            ASSERT(cpuBytes >= other.cpuBytes && gpuBytes >= other.gpuBytes);
+            cpuBytes -= other.cpuBytes;
+            gpuBytes -= other.gpuBytes;
+            return *this;
+        }
+    };
+
+    template<typename Type, typename = void>
+    struct HasResourceMemoryUsage : std::false_type
+    {
+    };
+
+    template<typename Type>
+    struct HasResourceMemoryUsage<Type, std::void_t<decltype(
+        std::declval<const Type&>().GetMemoryUsage())>> : std::true_type
+    {
+    };
+
+    template<typename Type>
+    ResourceMemoryUsage GetResourceMemoryUsage(const Type& resource)
+    {
+        if constexpr(HasResourceMemoryUsage<Type>::value)
+        {
+            return resource.GetMemoryUsage();
+        }
+        else
+        {
+            return ResourceMemoryUsage{ sizeof(Type), 0 };
+        }
+    }
+}
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <limits>
+#include "System/ResourceTable.hpp"
+#include "System/ResourceMemoryUsage.hpp"
 #include "System/FileSystem/FileSystem.hpp"
 #include "System/FileSystem/FileHandle.hpp"
 
@@ -13,19 +16,96 @@
 
     Manages an instance pool for a single type of resource.
     See ResourceManager class for more context.
+
+    Resources are keyed by name hashed from their normalized generic path
+    (e.g. "Data/Textures/Example.png"). Loaded resources can be found by
+    precomputed name from any thread without taking locks, while loading
+    and releasing resources is meant to be done on main thread. Paths are
+    compared as well when they are known, as different paths can hash to
+    same name, in which case resources cannot be found by name alone.
+
+    Resources that are no longer referenced outside of pool are kept cached
+    until pool exceeds its memory budget, at which point they are released
+    starting with ones that have been referenced least recently.
+
+    Resources that are reloaded replace their previous instances in pool.
+    Resource types that declare Swap() method exchange their contents with
+    reloaded instances instead, so references that are already held elsewhere
+    see reloaded contents too. Otherwise only later acquisitions see them.
+
+        void Swap(Type& other);
 */
 
 namespace System
 {
+    // Log category for resource pool messages.
+    inline Logger::Category LogResourcePool("System.ResourcePool");
+
+    template<typename Type, typename = void>
+    struct IsResourceSwappable : std::false_type
+    {
+    };
+
+    template<typename Type>
+    struct IsResourceSwappable<Type, std::void_t<decltype(
+        std::declval<Type&>().Swap(std::declval<Type&>()))>> : std::true_type
+    {
+    };
+
     class ResourcePoolInterface
     {
+    public:
+        struct UnusedResource
+        {
+            ResourcePoolInterface* pool = nullptr;
+            Common::Name name;
+            std::string path;
+            uint64_t lastUsedTick = 0;
+            std::size_t totalBytes = 0;
+        };
+
+        using UnusedResourceList = std::vector<UnusedResource>;
+
+        static constexpr std::size_t UnlimitedBudget = std::numeric_limits<std::size_t>::max();
+
     protected:
         ResourcePoolInterface() = default;
 
     public:
         virtual ~ResourcePoolInterface() = default;
-        virtual void ReleaseUnused() = 0;
+        virtual void ReleaseUnused(uint64_t tick) = 0;
         virtual void ReleaseAll() = 0;
+        virtual bool Release(Common::Name name, std::string_view path) = 0;
+        virtual void CollectUnused(UnusedResourceList& unusedResources) = 0;
+
+        virtual void SetMemoryBudget(std::size_t totalBytes) = 0;
+        virtual std::size_t GetMemoryBudget() const = 0;
+        virtual ResourceMemoryUsage GetMemoryUsage() const = 0;
+
+        static std::size_t ReleaseLeastRecentlyUsed(
+            UnusedResourceList& unusedResources, std::size_t bytesToRelease)
+        {
+            // Release unused resources in order they have been last used in.
+            std::sort(unusedResources.begin(), unusedResources.end(),
+                [](const UnusedResource& left, const UnusedResource& right)
+                {
+                    return left.lastUsedTick < right.lastUsedTick;
+                });
+
+            std::size_t releasedBytes = 0;
+            for(const UnusedResource& unusedResource : unusedResources)
+            {
+                if(releasedBytes >= bytesToRelease)
+                    break;
+
+                if(unusedResource.pool->Release(unusedResource.name, unusedResource.path))
+                {
+                    releasedBytes += unusedResource.totalBytes;
+                }
+            }
+
+            return releasedBytes;
+        }
     };
 
     template<typename Type>
@@ -33,10 +113,19 @@ namespace System
     {
     public:
         using ResourcePtr = std::shared_ptr<Type>;
-        using ResourceList = std::unordered_map<std::string, ResourcePtr>;
-        using ResourceListPair = typename ResourceList::value_type;
         using AcquireResult = Common::Result<ResourcePtr, ResourcePtr>;
 
+        struct ResourceEntry
+        {
+            Common::Name name;
+            std::string path;
+            ResourcePtr resource;
+            ResourceMemoryUsage memoryUsage;
+            std::atomic<uint64_t> lastUsedTick = 0;
+        };
+
+        using ResourceList = ResourceTable<ResourceEntry>;
+
     public:
         ResourcePool(FileSystem* fileSystem);
         ~ResourcePool();
@@ -47,13 +136,30 @@ namespace System
         template<typename... Arguments>
         AcquireResult Acquire(fs::path path, Arguments... arguments);
 
-        void ReleaseUnused() override;
+        ResourcePtr Find(Common::Name name);
+        ResourcePtr Find(const fs::path& path);
+        ResourcePtr Insert(const fs::path& path, ResourcePtr resource);
+        ResourcePtr Replace(const fs::path& path, ResourcePtr resource);
+
+        static Common::Name GetPathName(const fs::path& path);
+
+        void ReleaseUnused(uint64_t tick) override;
         void ReleaseAll() override;
+        bool Release(Common::Name name, std::string_view path) override;
+        void CollectUnused(UnusedResourceList& unusedResources) override;
+
+        void SetMemoryBudget(std::size_t totalBytes) override;
+        std::size_t GetMemoryBudget() const override;
+        ResourceMemoryUsage GetMemoryUsage() const override;
 
     private:
         FileSystem* m_fileSystem;
         std::shared_ptr<Type> m_defaultResource;
         ResourceList m_resources;
+
+        ResourceMemoryUsage m_memoryUsage;
+        std::size_t m_memoryBudget = UnlimitedBudget;
+        std::atomic<uint64_t> m_currentTick = 0;
     };
 
     template<typename Type>
@@ -87,14 +193,11 @@ namespace System
         fs::path path, Arguments... arguments)
     {
         path = path.lexically_normal();
-        std::string key = path.generic_string();
 
         // Return existing resource if loaded.
-        auto it = m_resources.find(key);
-        if(it != m_resources.end())
+        if(ResourcePtr resource = this->Find(path))
         {
-            ASSERT(it->second != nullptr, "Found resource is null!");
-            return Common::Success(it->second);
+            return Common::Success(std::move(resource));
         }
 
         std::unique_ptr<FileHandle> fileHandle = m_fileSystem->OpenFile(
@@ -111,35 +214,138 @@ namespace System
         {
             std::shared_ptr<Type> resource = resourceCreateResult.Unwrap();
             ASSERT(resource != nullptr, "Successfully created resource is null!");
+            return Common::Success(this->Insert(path, std::move(resource)));
+        }
+        else
+        {
+            return Common::Failure(m_defaultResource);
+        }
+    }
 
-            auto result = m_resources.emplace(key, std::move(resource));
-            ASSERT(result.second, "Failed to emplace new resource in resource pool!");
+    template<typename Type>
+    typename ResourcePool<Type>::ResourcePtr ResourcePool<Type>::Find(Common::Name name)
+    {
+        // Can be called from any thread.
+        std::shared_ptr<ResourceEntry> entry = m_resources.Find(name);
+        if(entry == nullptr)
+            return nullptr;
+
+        ASSERT(entry->resource != nullptr, "Found resource is null!");
+        entry->lastUsedTick.store(m_currentTick.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return entry->resource;
+    }
+
+    template<typename Type>
+    typename ResourcePool<Type>::ResourcePtr ResourcePool<Type>::Find(const fs::path& path)
+    {
+        // Can be called from any thread. Path is expected to be already normalized.
+        const std::string pathString = path.generic_string();
+        std::shared_ptr<ResourceEntry> entry = m_resources.Find(
+            Common::Name(std::string_view(pathString)), pathString);
+        if(entry == nullptr)
+            return nullptr;
+
+        ASSERT(entry->resource != nullptr, "Found resource is null!");
+        entry->lastUsedTick.store(m_currentTick.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return entry->resource;
+    }
+
+    template<typename Type>
+    typename ResourcePool<Type>::ResourcePtr ResourcePool<Type>::Insert(
+        const fs::path& path, ResourcePtr resource)
+    {
+        ASSERT(resource != nullptr, "Inserted resource is null!");
 
-            return Common::Success(result.first->second);
+        // Path is expected to be already normalized.
+        auto entry = std::make_shared<ResourceEntry>();
+        entry->path = path.generic_string();
+        entry->name = Common::Name(std::string_view(entry->path));
+        entry->resource = std::move(resource);
+        entry->memoryUsage = GetResourceMemoryUsage(*entry->resource);
+        entry->lastUsedTick = m_currentTick.load(std::memory_order_relaxed);
+
+        // Keep existing resource if one has been loaded in the meantime.
+        std::shared_ptr<ResourceEntry> existingEntry = m_resources.Insert(entry);
+        if(existingEntry != entry)
+        {
+            existingEntry->lastUsedTick.store(entry->lastUsedTick, std::memory_order_relaxed);
+            return existingEntry->resource;
+        }
+
+        m_memoryUsage += entry->memoryUsage;
+        return entry->resource;
+    }
+
+    template<typename Type>
+    typename ResourcePool<Type>::ResourcePtr ResourcePool<Type>::Replace(
+        const fs::path& path, ResourcePtr resource)
+    {
+        ASSERT(resource != nullptr, "Replacing resource is null!");
+
+        // Path is expected to be already normalized.
+        const std::string pathString = path.generic_string();
+        std::shared_ptr<ResourceEntry> existingEntry = m_resources.Find(
+            Common::Name(std::string_view(pathString)), pathString);
+        if(existingEntry == nullptr)
+            return this->Insert(path, std::move(resource));
+
+        if constexpr(IsResourceSwappable<Type>::value)
+        {
+            // Exchange contents in place, so existing references see them.
+            existingEntry->resource->Swap(*resource);
+
+            m_memoryUsage -= existingEntry->memoryUsage;
+            existingEntry->memoryUsage = GetResourceMemoryUsage(*existingEntry->resource);
+            m_memoryUsage += existingEntry->memoryUsage;
+            return existingEntry->resource;
         }
         else
         {
-            return Common::Failure(m_defaultResource);
+            // Publish new entry in place of existing one for later acquisitions.
+            auto entry = std::make_shared<ResourceEntry>();
+            entry->path = existingEntry->path;
+            entry->name = existingEntry->name;
+            entry->resource = std::move(resource);
+            entry->memoryUsage = GetResourceMemoryUsage(*entry->resource);
+            entry->lastUsedTick = existingEntry->lastUsedTick.load(std::memory_order_relaxed);
+
+            if(m_resources.Replace(entry) == nullptr)
+                return this->Insert(path, std::move(entry->resource));
+
+            m_memoryUsage -= existingEntry->memoryUsage;
+            m_memoryUsage += entry->memoryUsage;
+            return entry->resource;
         }
     }
 
     template<typename Type>
-    void ResourcePool<Type>::ReleaseUnused()
+    Common::Name ResourcePool<Type>::GetPathName(const fs::path& path)
+    {
+        // Path is expected to be already normalized.
+        return Common::Name(std::string_view(path.generic_string()));
+    }
+
+    template<typename Type>
+    void ResourcePool<Type>::ReleaseUnused(uint64_t tick)
     {
-        // Release unused resources.
-        auto it = m_resources.begin();
-        while(it != m_resources.end())
+        m_currentTick.store(tick, std::memory_order_relaxed);
+
+        // Mark resources that are still referenced as recently used.
+        m_resources.ForEach([tick](ResourceEntry& entry)
         {
-            if(it->second.use_count() == 1)
-            {
-                // Release resource.
-                LOG_INFO("Releasing resource: \"{}\"", it->first);
-                it = m_resources.erase(it);
-            }
-            else
+            if(entry.resource.use_count() != 1)
             {
-                ++it;
+                entry.lastUsedTick.store(tick, std::memory_order_relaxed);
             }
+        });
+
+        // Release least recently used resources that exceed memory budget.
+        std::size_t totalBytes = m_memoryUsage.GetTotalBytes();
+        if(totalBytes > m_memoryBudget)
+        {
+            UnusedResourceList unusedResources;
+            this->CollectUnused(unusedResources);
+            ReleaseLeastRecentlyUsed(unusedResources, totalBytes - m_memoryBudget);
         }
     }
 
@@ -147,14 +353,63 @@ namespace System
     void ResourcePool<Type>::ReleaseAll()
     {
         // Release all resources.
-        auto it = m_resources.begin();
-        while(it != m_resources.end())
+        m_resources.ForEach([](const ResourceEntry& entry)
         {
-            // Release resource.
-            LOG_INFO("Releasing resource: \"{}\"", it->first);
-            it = m_resources.erase(it);
-        }
+            LOG_CATEGORY_INFO(LogResourcePool, "Releasing resource: \"{}\"", entry.path);
+        });
 
-        ASSERT(m_resources.empty(), "Resource pool is not empty after releasing all resources!");
+        m_resources.Clear();
+        m_memoryUsage = ResourceMemoryUsage();
+
+        ASSERT(m_resources.GetSize() == 0, "Resource pool is not empty after releasing all resources!");
+    }
+
+    template<typename Type>
+    bool ResourcePool<Type>::Release(Common::Name name, std::string_view path)
+    {
+        // Release resource only if it is not referenced elsewhere.
+        std::shared_ptr<ResourceEntry> entry = m_resources.Find(name, path);
+        if(entry == nullptr || entry->resource.use_count() != 1)
+            return false;
+
+        LOG_CATEGORY_INFO(LogResourcePool, "Releasing resource: \"{}\"", entry->path);
+        m_memoryUsage -= entry->memoryUsage;
+        m_resources.Remove(name, path);
+        return true;
+    }
+
+    template<typename Type>
+    void ResourcePool<Type>::CollectUnused(UnusedResourceList& unusedResources)
+    {
+        m_resources.ForEach([this, &unusedResources](const ResourceEntry& entry)
+        {
+            if(entry.resource.use_count() == 1)
+            {
+                UnusedResource& unusedResource = unusedResources.emplace_back();
+                unusedResource.pool = this;
+                unusedResource.name = entry.name;
+                unusedResource.path = entry.path;
+                unusedResource.lastUsedTick = entry.lastUsedTick.load(std::memory_order_relaxed);
+                unusedResource.totalBytes = entry.memoryUsage.GetTotalBytes();
+            }
+        });
+    }
+
+    template<typename Type>
+    void ResourcePool<Type>::SetMemoryBudget(std::size_t totalBytes)
+    {
+        m_memoryBudget = totalBytes;
+    }
+
+    template<typename Type>
+    std::size_t ResourcePool<Type>::GetMemoryBudget() const
+    {
+        return m_memoryBudget;
+    }
+
+    template<typename Type>
+    ResourceMemoryUsage ResourcePool<Type>::GetMemoryUsage() const
+    {
+        return m_memoryUsage;
     }
 }
@@ -0,0 +1,419 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <Common/Name.hpp>
+
+/*
+    Resource Table
+
+    Read-mostly hash table of resource entries keyed by hashed resource path.
+    Entries can be found from any thread without taking locks, while insertions
+    and removals are serialized with each other.
+
+    Table uses open addressing with linear probing. Slot hash is published only
+    after its entry is stored, so readers never see half inserted slots. Removed
+    entries leave their slot hash behind as tombstone that keeps probe chains
+    intact, which can then be reused by next inserted entry. Entry type must
+    have "name" member with its hashed path, which lets readers verify that slot
+    has not been reused for different entry while they were reading it.
+
+    Entry type must also have "path" member, as different paths can hash to
+    same name. Entries are matched by their paths, so colliding entries are
+    stored next to each other. Lookup by name alone is only possible when name
+    is not shared by multiple entries, otherwise nothing is found.
+
+    Table is reallocated once half of its slots are in use. Previous tables are
+    retired instead of being freed, as readers may still be probing them. Each
+    reader is counted while probing, and retired tables are released by next
+    write that sees no readers, which has to observe new table already. Until
+    then entries are removed from retired tables as well, so they do not keep
+    resources alive.
+
+    Existing entry can be replaced in its slot with single atomic store, so
+    readers find either previous or new entry but never miss both of them.
+*/
+
+namespace System
+{
+    template<typename EntryType>
+    class ResourceTable : private Common::NonCopyable
+    {
+    public:
+        using HashType = Common::Name::HashType;
+        using EntryPtr = std::shared_ptr<EntryType>;
+
+        static constexpr std::size_t MinimumCapacity = 64;
+
+    public:
+        ResourceTable();
+
+        EntryPtr Find(Common::Name name) const;
+        EntryPtr Find(Common::Name name, std::string_view path) const;
+        EntryPtr Insert(EntryPtr entry);
+        EntryPtr Replace(EntryPtr entry);
+        EntryPtr Remove(Common::Name name, std::string_view path);
+        void Clear();
+
+        template<typename Function>
+        void ForEach(Function function) const;
+
+        std::size_t GetSize() const;
+
+    private:
+        // Hash value reserved for slots that have never been used.
+        static constexpr HashType EmptySlot = 0;
+
+        struct Slot
+        {
+            // Entry is accessed with atomic shared pointer functions.
+            std::atomic<HashType> hash = EmptySlot;
+            EntryPtr entry;
+        };
+
+        struct Table
+        {
+            Table(std::size_t capacity) :
+                slots(std::make_unique<Slot[]>(capacity)),
+                mask(capacity - 1)
+            {
+                ASSERT((capacity & mask) == 0, "Table capacity must be power of two!");
+            }
+
+            std::unique_ptr<Slot[]> slots;
+            std::size_t mask = 0;
+            std::size_t usedSlots = 0;
+        };
+
+        static HashType GetSlotHash(Common::Name name);
+        static EntryPtr FindInTable(const Table& table, HashType hash, const std::string_view* path);
+        void Reallocate(std::size_t capacity);
+        void ReleaseRetired();
+
+    private:
+        std::atomic<Table*> m_table = nullptr;
+        mutable std::atomic<std::size_t> m_readerCount = 0;
+
+        // Accessed only while holding write lock.
+        mutable std::mutex m_writeLock;
+        std::vector<std::unique_ptr<Table>> m_tables;
+        std::size_t m_size = 0;
+    };
+
+    template<typename EntryType>
+    ResourceTable<EntryType>::ResourceTable()
+    {
+        Reallocate(MinimumCapacity);
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::Find(Common::Name name) const
+    {
+        // Reader has to be counted before it loads table that it will probe,
+        // so writer that sees no readers knows that retired tables are unused.
+        m_readerCount.fetch_add(1, std::memory_order_seq_cst);
+        EntryPtr entry = FindInTable(*m_table.load(std::memory_order_seq_cst), GetSlotHash(name), nullptr);
+        m_readerCount.fetch_sub(1, std::memory_order_release);
+        return entry;
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::Find(
+        Common::Name name, std::string_view path) const
+    {
+        m_readerCount.fetch_add(1, std::memory_order_seq_cst);
+        EntryPtr entry = FindInTable(*m_table.load(std::memory_order_seq_cst), GetSlotHash(name), &path);
+        m_readerCount.fetch_sub(1, std::memory_order_release);
+        return entry;
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::FindInTable(
+        const Table& table, HashType hash, const std::string_view* path)
+    {
+        EntryPtr foundEntry;
+
+        for(std::size_t index = hash & table.mask; ; index = (index + 1) & table.mask)
+        {
+            const Slot& slot = table.slots[index];
+            HashType slotHash = slot.hash.load(std::memory_order_acquire);
+
+            if(slotHash == EmptySlot)
+                return foundEntry;
+
+            if(slotHash != hash)
+                continue;
+
+            // Slot could have been reused for another entry since its hash was read.
+            EntryPtr entry = std::atomic_load_explicit(&slot.entry, std::memory_order_acquire);
+            if(entry == nullptr || GetSlotHash(entry->name) != hash)
+                continue;
+
+            if(path != nullptr)
+            {
+                if(entry->path == *path)
+                    return entry;
+            }
+            else
+            {
+                // Name shared by multiple entries does not identify any of them.
+                if(foundEntry != nullptr && foundEntry->path != entry->path)
+                    return nullptr;
+
+                foundEntry = std::move(entry);
+            }
+        }
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::Insert(EntryPtr entry)
+    {
+        ASSERT(entry != nullptr, "Inserted resource table entry is null!");
+
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+
+        Table* table = m_table.load(std::memory_order_relaxed);
+        if((table->usedSlots + 1) * 2 > table->mask + 1)
+        {
+            // Grow only when live entries take up significant part of table,
+            // otherwise reallocate at same capacity to get rid of tombstones.
+            std::size_t capacity = table->mask + 1;
+            if((m_size + 1) * 4 > capacity)
+            {
+                capacity *= 2;
+            }
+
+            Reallocate(capacity);
+            table = m_table.load(std::memory_order_relaxed);
+        }
+
+        // Keep existing entry, or reuse first tombstone on probe chain.
+        const HashType hash = GetSlotHash(entry->name);
+        Slot* tombstone = nullptr;
+
+        for(std::size_t index = hash & table->mask; ; index = (index + 1) & table->mask)
+        {
+            Slot& slot = table->slots[index];
+            HashType slotHash = slot.hash.load(std::memory_order_relaxed);
+
+            if(slotHash == EmptySlot)
+            {
+                if(tombstone == nullptr)
+                {
+                    std::atomic_store_explicit(&slot.entry, entry, std::memory_order_release);
+                    slot.hash.store(hash, std::memory_order_release);
+                    ++table->usedSlots;
+                }
+                else
+                {
+                    tombstone->hash.store(hash, std::memory_order_release);
+                    std::atomic_store_explicit(&tombstone->entry, entry, std::memory_order_release);
+                }
+
+                ++m_size;
+                return entry;
+            }
+
+            if(slot.entry == nullptr)
+            {
+                if(tombstone == nullptr)
+                {
+                    tombstone = &slot;
+                }
+            }
+            else if(slotHash == hash && slot.entry->path == entry->path)
+            {
+                return slot.entry;
+            }
+        }
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::Replace(EntryPtr entry)
+    {
+        ASSERT(entry != nullptr, "Replacing resource table entry is null!");
+
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+        ReleaseRetired();
+
+        const HashType hash = GetSlotHash(entry->name);
+        EntryPtr replacedEntry;
+
+        // Retired tables are updated as well, so they do not keep previous entry alive.
+        for(auto& table : m_tables)
+        {
+            for(std::size_t index = hash & table->mask; ; index = (index + 1) & table->mask)
+            {
+                Slot& slot = table->slots[index];
+                HashType slotHash = slot.hash.load(std::memory_order_relaxed);
+
+                if(slotHash == EmptySlot)
+                    break;
+
+                if(slotHash == hash && slot.entry != nullptr && slot.entry->path == entry->path)
+                {
+                    EntryPtr previousEntry = std::atomic_exchange_explicit(
+                        &slot.entry, entry, std::memory_order_acq_rel);
+
+                    if(table.get() == m_table.load(std::memory_order_relaxed))
+                    {
+                        replacedEntry = std::move(previousEntry);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        return replacedEntry;
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::EntryPtr ResourceTable<EntryType>::Remove(
+        Common::Name name, std::string_view path)
+    {
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+        ReleaseRetired();
+
+        const HashType hash = GetSlotHash(name);
+        EntryPtr removedEntry;
+
+        for(auto& table : m_tables)
+        {
+            for(std::size_t index = hash & table->mask; ; index = (index + 1) & table->mask)
+            {
+                Slot& slot = table->slots[index];
+                HashType slotHash = slot.hash.load(std::memory_order_relaxed);
+
+                if(slotHash == EmptySlot)
+                    break;
+
+                if(slotHash == hash && slot.entry != nullptr && slot.entry->path == path)
+                {
+                    EntryPtr entry = std::atomic_exchange_explicit(
+                        &slot.entry, EntryPtr(), std::memory_order_acq_rel);
+
+                    if(table.get() == m_table.load(std::memory_order_relaxed))
+                    {
+                        removedEntry = std::move(entry);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        if(removedEntry != nullptr)
+        {
+            --m_size;
+        }
+
+        return removedEntry;
+    }
+
+    template<typename EntryType>
+    void ResourceTable<EntryType>::Clear()
+    {
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+        ReleaseRetired();
+
+        for(auto& table : m_tables)
+        {
+            for(std::size_t index = 0; index <= table->mask; ++index)
+            {
+                Slot& slot = table->slots[index];
+                if(slot.entry != nullptr)
+                {
+                    std::atomic_store_explicit(&slot.entry, EntryPtr(), std::memory_order_release);
+                }
+            }
+        }
+
+        m_size = 0;
+    }
+
+    template<typename EntryType>
+    template<typename Function>
+    void ResourceTable<EntryType>::ForEach(Function function) const
+    {
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+
+        const Table* table = m_table.load(std::memory_order_relaxed);
+        for(std::size_t index = 0; index <= table->mask; ++index)
+        {
+            const Slot& slot = table->slots[index];
+            if(slot.entry != nullptr)
+            {
+                function(*slot.entry);
+            }
+        }
+    }
+
+    template<typename EntryType>
+    std::size_t ResourceTable<EntryType>::GetSize() const
+    {
+        std::scoped_lock<std::mutex> lock(m_writeLock);
+        return m_size;
+    }
+
+    template<typename EntryType>
+    typename ResourceTable<EntryType>::HashType ResourceTable<EntryType>::GetSlotHash(Common::Name name)
+    {
+        // Remap hash that collides with empty slot marker.
+        HashType hash = name.GetHash();
+        return hash != EmptySlot ? hash : EmptySlot + 1;
+    }
+
+    template<typename EntryType>
+    void ResourceTable<EntryType>::Reallocate(std::size_t capacity)
+    {
+        // Called with write lock held, or from constructor.
+        auto newTable = std::make_unique<Table>(capacity);
+
+        if(const Table* oldTable = m_table.load(std::memory_order_relaxed))
+        {
+            for(std::size_t oldIndex = 0; oldIndex <= oldTable->mask; ++oldIndex)
+            {
+                const Slot& oldSlot = oldTable->slots[oldIndex];
+                if(oldSlot.entry == nullptr)
+                    continue;
+
+                const HashType hash = oldSlot.hash.load(std::memory_order_relaxed);
+                std::size_t index = hash & newTable->mask;
+                while(newTable->slots[index].hash.load(std::memory_order_relaxed) != EmptySlot)
+                {
+                    index = (index + 1) & newTable->mask;
+                }
+
+                Slot& slot = newTable->slots[index];
+                slot.entry = oldSlot.entry;
+                slot.hash.store(hash, std::memory_order_relaxed);
+                ++newTable->usedSlots;
+            }
+        }
+
+        // Publish new table with all of its slots filled in.
+        m_table.store(newTable.get(), std::memory_order_seq_cst);
+        m_tables.push_back(std::move(newTable));
+        ReleaseRetired();
+    }
+
+    template<typename EntryType>
+    void ResourceTable<EntryType>::ReleaseRetired()
+    {
+        // Called with write lock held. Readers that are counted after
+        // this point can only load current table, which is the last one.
+        if(m_tables.size() > 1 && m_readerCount.load(std::memory_order_seq_cst) == 0)
+        {
+            m_tables.erase(m_tables.begin(), m_tables.end() - 1);
+        }
+    }
+}
@@ -9,7 +9,7 @@
 
 #ifndef __EMSCRIPTEN__
     // Use precise time counters on platforms that support it.
-    // Emscripten does not implement GLFW function for reading high frequency clock.
+    // Emscripten reads fractional seconds from GLFW instead.
     #define USE_PRECISE_TIME_COUNTERS
 #endif
 
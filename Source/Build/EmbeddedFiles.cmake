@@ -0,0 +1,41 @@
+# Convert list of files into C++ source with their contents as byte arrays.
+# File list is passed with "|" separators to survive command line quoting.
+string(REPLACE "|" ";" EMBED_FILES "${EMBED_FILES}")
+
+set(EMBEDDED_DATA "")
+set(EMBEDDED_ENTRIES "")
+set(EMBEDDED_INDEX 0)
+
+foreach(EMBED_FILE ${EMBED_FILES})
+    file(READ "${EMBED_DIR}/${EMBED_FILE}" FILE_HEX HEX)
+    file(SIZE "${EMBED_DIR}/${EMBED_FILE}" FILE_SIZE)
+
+    # Format bytes as hexadecimal literals, sixteen per line.
+    set(FILE_BYTES "")
+    string(LENGTH "${FILE_HEX}" FILE_HEX_LENGTH)
+
+    set(LINE_OFFSET 0)
+    while(LINE_OFFSET LESS FILE_HEX_LENGTH)
+        string(SUBSTRING "${FILE_HEX}" ${LINE_OFFSET} 32 LINE_HEX)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " LINE_BYTES "${LINE_HEX}")
+        string(STRIP "${LINE_BYTES}" LINE_BYTES)
+        string(APPEND FILE_BYTES "${LINE_BYTES}\n        ")
+        math(EXPR LINE_OFFSET "${LINE_OFFSET} + 32")
+    endwhile()
+
+    # Trailing zero allows text files to be used as null terminated strings.
+    string(APPEND EMBEDDED_DATA
+        "    // ${EMBED_FILE}\n"
+        "    const uint8_t File${EMBEDDED_INDEX}[] =\n"
+        "    {\n"
+        "        ${FILE_BYTES}0x00\n"
+        "    };\n\n")
+
+    string(APPEND EMBEDDED_ENTRIES
+        "        { \"${EMBED_FILE}\", File${EMBEDDED_INDEX}, ${FILE_SIZE} },\n")
+
+    math(EXPR EMBEDDED_INDEX "${EMBEDDED_INDEX} + 1")
+endforeach()
+
+# Save embedded files as source file.
+configure_file(${INPUT_FILE} ${OUTPUT_FILE})
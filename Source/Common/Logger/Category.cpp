@@ -0,0 +1,108 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Common/Precompiled.hpp"
+#include "Common/Logger/Category.hpp"
+#include "Common/Debug.hpp"
+using namespace Logger;
+
+namespace
+{
+    // Both are constant initialized, so categories can
+    // register themselves during dynamic initialization.
+    std::mutex GlobalCategoryLock;
+    Category* GlobalCategoryList = nullptr;
+
+    bool CaseInsensitiveEquals(std::string_view a, std::string_view b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char a, char b)
+        {
+            // Characters must be representable as unsigned char to avoid undefined behavior.
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+    }
+}
+
+Severity::Type Logger::ParseSeverity(std::string_view text)
+{
+    const std::pair<const char*, Severity::Type> severityNames[] =
+    {
+        { "Trace", Severity::Trace },
+        { "Debug", Severity::Debug },
+        { "Info", Severity::Info },
+        { "Success", Severity::Success },
+        { "Warning", Severity::Warning },
+        { "Error", Severity::Error },
+        { "Fatal", Severity::Fatal },
+    };
+
+    for(const auto& severityName : severityNames)
+    {
+        if(CaseInsensitiveEquals(text, severityName.first))
+            return severityName.second;
+    }
+
+    return Severity::Invalid;
+}
+
+Category::Category(const char* name, Severity::Type minimumSeverity) :
+    m_name(name),
+    m_minimumSeverity(minimumSeverity)
+{
+    ASSERT(name != nullptr, "Log category must have a name!");
+
+    std::scoped_lock<std::mutex> lock(GlobalCategoryLock);
+    m_next = GlobalCategoryList;
+    GlobalCategoryList = this;
+}
+
+Category::~Category()
+{
+    std::scoped_lock<std::mutex> lock(GlobalCategoryLock);
+
+    Category** link = &GlobalCategoryList;
+    while(*link != nullptr)
+    {
+        if(*link == this)
+        {
+            *link = m_next;
+            break;
+        }
+
+        link = &(*link)->m_next;
+    }
+}
+
+Logger::CategoryList Logger::GetCategories()
+{
+    std::scoped_lock<std::mutex> lock(GlobalCategoryLock);
+
+    CategoryList categories;
+    for(Category* category = GlobalCategoryList; category != nullptr; category = category->m_next)
+    {
+        categories.push_back(category);
+    }
+
+    return categories;
+}
+
+Category* Logger::FindCategory(std::string_view name)
+{
+    for(Category* category : GetCategories())
+    {
+        if(name == category->GetName())
+            return category;
+    }
+
+    return nullptr;
+}
+
+void Logger::SetMinimumSeverity(Severity::Type severity)
+{
+    for(Category* category : GetCategories())
+    {
+        category->SetMinimumSeverity(severity);
+    }
+}
@@ -32,12 +32,12 @@ namespace
     };
 }
 
-std::string DefaultFormat::ComposeSessionStart()
+std::string DefaultFormat::ComposeSessionStart(std::time_t sessionTime)
 {
     std::string sessionText;
 
-    // Retrieve current system time.
-    std::tm time = fmt::localtime(std::time(nullptr));
+    // Convert session time to local time.
+    std::tm time = fmt::localtime(sessionTime);
 
     // Format session start text.
     sessionText += fmt::format("Session started at {:%Y-%m-%d %H:%M:%S}\n\n", time);
@@ -63,25 +63,27 @@ std::string DefaultFormat::ComposeSessionStart()
 
 std::string DefaultFormat::ComposeMessage(const Message& message, const SinkContext& context)
 {
-    std::string messageText;
-    messageText.reserve(256);
+    fmt::memory_buffer messageBuffer;
 
-    // Retrieve current system time.
+    // Format time at which message was created. Converting time to local
+    // calendar time is expensive, so result is cached for current second.
     // fmt::localtime() is a thread safe version of std::localtime().
-    std::tm time = fmt::localtime(std::time(nullptr));
+    thread_local std::time_t cachedTime = -1;
+    thread_local char cachedTimeText[16] = {};
 
-    // Format current time.
-    messageText += fmt::format("[{:%H:%M:%S}]", time);
-
-    // Format frame reference.
-    messageText += fmt::format("[{:03d}]", context.referenceFrame % 1000);
+    if(message.GetTime() != cachedTime)
+    {
+        std::tm time = fmt::localtime(message.GetTime());
+        std::strftime(cachedTimeText, sizeof(cachedTimeText), "[%H:%M:%S]", &time);
+        cachedTime = message.GetTime();
+    }
 
-    // Format message severity.
-    messageText += fmt::format("[{}]", MessageSeverityMarker(message.GetSeverity()));
+    // Format time, frame reference, message severity and message text with indent.
+    fmt::format_to(messageBuffer, "{}[{:03d}][{}] {: >{}}{}",
+        cachedTimeText, context.referenceFrame % 1000,
+        MessageSeverityMarker(message.GetSeverity()),
+        "", context.messageIndent, message.GetText());
 
-    // Format message text with indent.
-    messageText += fmt::format(" {: >{}}{}", "", context.messageIndent, message.GetText());
-        
     // Format message source.
     if(message.GetSource())
     {
@@ -128,22 +130,22 @@ std::string DefaultFormat::ComposeMessage(const Message& message, const SinkCont
         }
 
         // Format source path.
-        messageText += fmt::format(" {{{}:{}}}", sourcePath, message.GetLine());
+        fmt::format_to(messageBuffer, " {{{}:{}}}", sourcePath, message.GetLine());
     }
 
     // Write message suffix.
-    messageText += '\n';
+    messageBuffer.push_back('\n');
 
     // Return composed string.
-    return messageText;
+    return fmt::to_string(messageBuffer);
 }
 
-std::string DefaultFormat::ComposeSessionEnd()
+std::string DefaultFormat::ComposeSessionEnd(std::time_t sessionTime)
 {
     std::string sessionText;
 
-    // Retrieve current system time.
-    std::tm time = fmt::localtime(std::time(nullptr));
+    // Convert session time to local time.
+    std::tm time = fmt::localtime(sessionTime);
 
     // Format session end string.
     sessionText += fmt::format("\nSession ended at {:%Y-%m-%d %H:%M:%S}\n\n", time);
@@ -5,7 +5,6 @@
 
 #include "Common/Precompiled.hpp"
 #include "Common/Logger/History.hpp"
-#include "Common/Logger/Format.hpp"
 using namespace Logger;
 
 namespace
@@ -16,8 +15,10 @@ namespace
 History::History() = default;
 History::~History() = default;
 
-void History::Write(const Logger::Message& message, const Logger::SinkContext& context)
+void History::Write(const Logger::Message& message, const Logger::SinkContext& context, const std::string& text)
 {
+    std::scoped_lock<std::mutex> lock(m_lock);
+
     // Truncate message history.
     if(m_messages.size() == MessageHistorySize)
     {
@@ -27,11 +28,13 @@ void History::Write(const Logger::Message& message, const Logger::SinkContext& c
     // Add new message entry.
     MessageEntry messageEntry;
     messageEntry.severity = message.GetSeverity();
-    messageEntry.text = DefaultFormat::ComposeMessage(message, context);
+    messageEntry.text = text;
     m_messages.emplace_back(std::move(messageEntry));
 }
 
-const History::MessageList& History::GetMessages() const
+History::MessageList History::GetMessages() const
 {
+    std::scoped_lock<std::mutex> lock(m_lock);
+
     return m_messages;
 }
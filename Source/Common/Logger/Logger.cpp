@@ -12,11 +12,15 @@
 
 namespace
 {
-    Logger::Sink GlobalSink;
     Logger::History GlobalHistory;
     Logger::FileOutput GlobalFileOutput;
     Logger::ConsoleOutput GlobalConsoleOutput;
     Logger::DebuggerOutput GlobalDebuggerOutput;
+    Logger::BinaryOutput GlobalBinaryOutput;
+
+    // Sink is declared after outputs so it is destroyed before them,
+    // as it may still have queued messages to write when asynchronous.
+    Logger::Sink GlobalSink;
 
     bool GlobalLoggerInitialized = false;
 
@@ -60,6 +64,20 @@ void Logger::Write(const Logger::Message& message)
     GlobalSink.Write(message);
 }
 
+bool Logger::OpenBinaryOutput(std::string filename)
+{
+    LazyInitialize();
+
+    if(GlobalBinaryOutput.IsOpen())
+        return false;
+
+    if(!GlobalBinaryOutput.Open(filename))
+        return false;
+
+    GlobalSink.AddOutput(&GlobalBinaryOutput);
+    return true;
+}
+
 int Logger::AdvanceFrameReference()
 {
     LazyInitialize();
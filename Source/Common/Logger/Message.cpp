@@ -9,9 +9,17 @@
 using namespace Logger;
 
 Message::Message(Message&& other)
+{
+    *this = std::move(other);
+}
+
+Message& Message::operator=(Message&& other)
 {
     m_text = std::move(other.m_text);
 
+    m_format = other.m_format;
+    other.m_format = nullptr;
+
     m_severity = other.m_severity;
     other.m_severity = Severity::Info;
 
@@ -20,4 +28,8 @@ Message::Message(Message&& other)
 
     m_line = other.m_line;
     other.m_line = 0;
+
+    m_time = other.m_time;
+
+    return *this;
 }
@@ -9,8 +9,36 @@
 #include "Common/Logger/Message.hpp"
 #include "Common/Logger/Format.hpp"
 #include "Common/Logger/Sink.hpp"
+#include "Common/Name.hpp"
+
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
 using namespace Logger;
 
+namespace
+{
+    constexpr std::size_t BinaryHeaderSize = sizeof(BinaryOutput::Magic) + sizeof(uint32_t) + sizeof(int64_t);
+    constexpr std::size_t BinaryStringHeaderSize = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+    constexpr std::size_t BinaryMessageHeaderSize = sizeof(uint8_t) + sizeof(int64_t) +
+        2 * sizeof(int32_t) + sizeof(uint8_t) + 4 * sizeof(uint32_t);
+
+    // Text length of messages whose text is rebuilt from format string.
+    constexpr uint32_t BinaryFormatTextLength = std::numeric_limits<uint32_t>::max();
+
+    template<typename Type>
+    Type ReadValue(const uint8_t*& source)
+    {
+        Type value;
+        std::memcpy(&value, source, sizeof(Type));
+        source += sizeof(Type);
+        return value;
+    }
+}
+
 FileOutput::FileOutput() = default;
 FileOutput::~FileOutput()
 {
@@ -38,32 +66,370 @@ bool FileOutput::Open(std::string filename)
     return true;
 }
 
-void FileOutput::Write(const Message& message, const SinkContext& context)
+void FileOutput::Write(const Message& message, const SinkContext& context, const std::string& text)
 {
     assert(m_file.is_open() && "File stream is not open!");
 
-    m_file << DefaultFormat::ComposeMessage(message, context);
+    m_file.write(text.data(), text.size());
+}
+
+void FileOutput::Flush()
+{
     m_file.flush();
 }
 
 ConsoleOutput::ConsoleOutput() = default;
 ConsoleOutput::~ConsoleOutput() = default;
 
-void ConsoleOutput::Write(const Message& message, const SinkContext& context)
+void ConsoleOutput::Write(const Message& message, const SinkContext& context, const std::string& text)
 {
-    std::cout << DefaultFormat::ComposeMessage(message, context);
+    std::cout.write(text.data(), text.size());
+}
+
+void ConsoleOutput::Flush()
+{
+    std::cout.flush();
 }
 
 DebuggerOutput::DebuggerOutput() = default;
 DebuggerOutput::~DebuggerOutput() = default;
 
-void DebuggerOutput::Write(const Message& message, const SinkContext& context)
+void DebuggerOutput::Write(const Message& message, const SinkContext& context, const std::string& text)
 {
 #ifdef WIN32
     if(!IsDebuggerPresent())
         return;
 
-    std::string output = DefaultFormat::ComposeMessage(message, context);
-    OutputDebugStringA(output.c_str());
+    OutputDebugStringA(text.c_str());
+#endif
+}
+
+BinaryOutput::BinaryOutput() = default;
+BinaryOutput::~BinaryOutput()
+{
+    Close();
+}
+
+bool BinaryOutput::Open(std::string filename)
+{
+    assert(!IsOpen() && "Binary file is already open!");
+
+#ifdef WIN32
+    HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    m_fileHandle = fileHandle;
+#else
+    m_fileDescriptor = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(m_fileDescriptor < 0)
+        return false;
+#endif
+
+    m_writtenSize = 0;
+    m_internedStrings.clear();
+    m_writtenStrings.clear();
+
+    if(!MapFile(MappingGranularity))
+    {
+        Close();
+        return false;
+    }
+
+    // Write file header.
+    uint8_t* destination = Reserve(BinaryHeaderSize);
+    std::memcpy(destination, Magic, sizeof(Magic));
+    destination = WriteValue(destination + sizeof(Magic), Version);
+    WriteValue(destination, static_cast<int64_t>(std::time(nullptr)));
+    return true;
+}
+
+void BinaryOutput::Close()
+{
+    if(!IsOpen())
+        return;
+
+    UnmapFile();
+
+    // Trim unused part of last mapping.
+#ifdef WIN32
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = m_writtenSize;
+    SetFilePointerEx(m_fileHandle, fileSize, nullptr, FILE_BEGIN);
+    SetEndOfFile(m_fileHandle);
+    CloseHandle(m_fileHandle);
+    m_fileHandle = nullptr;
+#else
+    [[maybe_unused]] int result = ftruncate(m_fileDescriptor, m_writtenSize);
+    close(m_fileDescriptor);
+    m_fileDescriptor = -1;
+#endif
+}
+
+void BinaryOutput::Write(const Message& message, const SinkContext& context, const std::string& text)
+{
+    if(m_mappedData == nullptr)
+        return;
+
+    uint32_t sourceIdentifier = InternString(message.GetSource());
+    uint32_t formatIdentifier = InternString(message.GetFormat());
+
+    // Text of messages without arguments is rebuilt from format string.
+    std::string_view messageText = message.GetText();
+    uint32_t messageLength = static_cast<uint32_t>(messageText.size());
+
+    if(formatIdentifier != 0 && messageText == message.GetFormat())
+    {
+        messageText = std::string_view();
+        messageLength = BinaryFormatTextLength;
+    }
+
+    uint8_t* destination = Reserve(BinaryMessageHeaderSize + messageText.size());
+    if(destination == nullptr)
+        return;
+
+    destination = WriteValue(destination, RecordType::Message);
+    destination = WriteValue(destination, static_cast<int64_t>(message.GetTime()));
+    destination = WriteValue(destination, static_cast<int32_t>(context.referenceFrame));
+    destination = WriteValue(destination, static_cast<int32_t>(context.messageIndent));
+    destination = WriteValue(destination, static_cast<uint8_t>(message.GetSeverity()));
+    destination = WriteValue(destination, sourceIdentifier);
+    destination = WriteValue(destination, formatIdentifier);
+    destination = WriteValue(destination, static_cast<uint32_t>(message.GetLine()));
+    destination = WriteValue(destination, messageLength);
+
+    if(!messageText.empty())
+    {
+        std::memcpy(destination, messageText.data(), messageText.size());
+    }
+}
+
+void BinaryOutput::Flush()
+{
+    if(m_mappedData == nullptr)
+        return;
+
+    // Schedule write back without blocking, as mapped
+    // memory persists even if application crashes.
+#ifdef WIN32
+    FlushViewOfFile(m_mappedData, m_writtenSize);
+#else
+    msync(m_mappedData, m_mappedSize, MS_ASYNC);
+#endif
+}
+
+bool BinaryOutput::IsTextOutput() const
+{
+    return false;
+}
+
+bool BinaryOutput::IsOpen() const
+{
+#ifdef WIN32
+    return m_fileHandle != nullptr;
+#else
+    return m_fileDescriptor >= 0;
+#endif
+}
+
+std::size_t BinaryOutput::GetWrittenSize() const
+{
+    return m_writtenSize;
+}
+
+uint32_t BinaryOutput::InternString(const char* string)
+{
+    if(string == nullptr)
+        return 0;
+
+    // Interned strings are static, so their identifiers are cached by address.
+    auto internedIt = m_internedStrings.find(string);
+    if(internedIt != m_internedStrings.end())
+        return internedIt->second;
+
+    // Strings are identified by their name hash and registered in name registry.
+    // Same string can be found under different addresses, but is written once.
+    uint32_t identifier = Common::Name(string).GetHash();
+    if(m_writtenStrings.find(identifier) != m_writtenStrings.end())
+    {
+        m_internedStrings.emplace(string, identifier);
+        return identifier;
+    }
+
+    std::size_t length = std::strlen(string);
+    uint8_t* destination = Reserve(BinaryStringHeaderSize + length);
+    if(destination == nullptr)
+        return 0;
+
+    destination = WriteValue(destination, RecordType::String);
+    destination = WriteValue(destination, identifier);
+    destination = WriteValue(destination, static_cast<uint32_t>(length));
+    std::memcpy(destination, string, length);
+
+    m_internedStrings.emplace(string, identifier);
+    m_writtenStrings.insert(identifier);
+    return identifier;
+}
+
+uint8_t* BinaryOutput::Reserve(std::size_t size)
+{
+    // Grow file and its mapping when there is not enough space left.
+    if(m_writtenSize + size > m_mappedSize)
+    {
+        std::size_t mappingSize = std::max(m_mappedSize * 2, m_writtenSize + size);
+        mappingSize = (mappingSize + MappingGranularity - 1) / MappingGranularity * MappingGranularity;
+
+        if(!MapFile(mappingSize))
+            return nullptr;
+    }
+
+    uint8_t* destination = m_mappedData + m_writtenSize;
+    m_writtenSize += size;
+    return destination;
+}
+
+bool BinaryOutput::MapFile(std::size_t size)
+{
+    UnmapFile();
+
+#ifdef WIN32
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+    if(m_mappingHandle == nullptr)
+        return false;
+
+    m_mappedData = static_cast<uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_WRITE, 0, 0, size));
+    if(m_mappedData == nullptr)
+    {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+        return false;
+    }
+#else
+    if(ftruncate(m_fileDescriptor, size) != 0)
+        return false;
+
+    void* mappedData = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+    if(mappedData == MAP_FAILED)
+        return false;
+
+    m_mappedData = static_cast<uint8_t*>(mappedData);
+#endif
+
+    m_mappedSize = size;
+    return true;
+}
+
+void BinaryOutput::UnmapFile()
+{
+    if(m_mappedData == nullptr)
+        return;
+
+#ifdef WIN32
+    UnmapViewOfFile(m_mappedData);
+    CloseHandle(m_mappingHandle);
+    m_mappingHandle = nullptr;
+#else
+    munmap(m_mappedData, m_mappedSize);
 #endif
+
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+}
+
+BinaryOutput::DecodeResult BinaryOutput::Decode(const uint8_t* data, std::size_t size, const DecodeCallback& callback)
+{
+    if(size < BinaryHeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0)
+        return Common::Failure(DecodeErrors::InvalidHeader);
+
+    const uint8_t* source = data + sizeof(Magic);
+    const uint8_t* end = data + size;
+
+    if(ReadValue<uint32_t>(source) != Version)
+        return Common::Failure(DecodeErrors::UnsupportedVersion);
+
+    std::time_t sessionTime = static_cast<std::time_t>(ReadValue<int64_t>(source));
+    std::unordered_map<uint32_t, std::string> strings;
+
+    // Read records until end of data. File may end with zeroed
+    // mapping space if application has not closed it properly.
+    while(source < end)
+    {
+        RecordType recordType = static_cast<RecordType>(*source);
+        if(recordType == RecordType::End)
+            break;
+
+        if(recordType == RecordType::String)
+        {
+            if(static_cast<std::size_t>(end - source) < BinaryStringHeaderSize)
+                return Common::Failure(DecodeErrors::TruncatedRecord);
+
+            source += sizeof(RecordType);
+            uint32_t identifier = ReadValue<uint32_t>(source);
+            uint32_t length = ReadValue<uint32_t>(source);
+
+            if(static_cast<std::size_t>(end - source) < length)
+                return Common::Failure(DecodeErrors::TruncatedRecord);
+
+            strings[identifier] = std::string(reinterpret_cast<const char*>(source), length);
+            source += length;
+        }
+        else if(recordType == RecordType::Message)
+        {
+            if(static_cast<std::size_t>(end - source) < BinaryMessageHeaderSize)
+                return Common::Failure(DecodeErrors::TruncatedRecord);
+
+            source += sizeof(RecordType);
+            int64_t time = ReadValue<int64_t>(source);
+
+            SinkContext context;
+            context.referenceFrame = ReadValue<int32_t>(source);
+            context.messageIndent = ReadValue<int32_t>(source);
+
+            Message message;
+            message.SetTime(static_cast<std::time_t>(time));
+            message.SetSeverity(static_cast<Severity::Type>(ReadValue<uint8_t>(source)));
+
+            auto sourceIt = strings.find(ReadValue<uint32_t>(source));
+            if(sourceIt != strings.end())
+            {
+                message.SetSource(sourceIt->second.c_str());
+            }
+
+            auto formatIt = strings.find(ReadValue<uint32_t>(source));
+            if(formatIt != strings.end())
+            {
+                message.SetFormat(formatIt->second.c_str());
+            }
+
+            message.SetLine(ReadValue<uint32_t>(source));
+            uint32_t length = ReadValue<uint32_t>(source);
+
+            // Rebuild text of message without arguments from its format.
+            if(length == BinaryFormatTextLength)
+            {
+                if(formatIt == strings.end())
+                    return Common::Failure(DecodeErrors::UnknownString);
+
+                message.SetText(formatIt->second);
+            }
+            else
+            {
+                if(static_cast<std::size_t>(end - source) < length)
+                    return Common::Failure(DecodeErrors::TruncatedRecord);
+
+                message.SetText(std::string(reinterpret_cast<const char*>(source), length));
+                source += length;
+            }
+
+            callback(message, context);
+        }
+        else
+        {
+            return Common::Failure(DecodeErrors::UnknownRecord);
+        }
+    }
+
+    return Common::Success(sessionTime);
 }
@@ -7,10 +7,46 @@
 #include "Common/Logger/Sink.hpp"
 #include "Common/Logger/Output.hpp"
 #include "Common/Logger/Message.hpp"
+#include "Common/Logger/Format.hpp"
+#include "Common/BoundedQueue.hpp"
 using namespace Logger;
 
+namespace
+{
+    // Indents of sinks written by current thread, with
+    // entries removed once their indent drops to zero.
+    thread_local std::vector<std::pair<const Sink*, int>> ThreadIndents;
+
+    int* FindThreadIndent(const Sink* sink)
+    {
+        for(auto& threadIndent : ThreadIndents)
+        {
+            if(threadIndent.first == sink)
+                return &threadIndent.second;
+        }
+
+        return nullptr;
+    }
+
+    int GetThreadIndent(const Sink* sink)
+    {
+        const int* messageIndent = FindThreadIndent(sink);
+        return messageIndent != nullptr ? *messageIndent : 0;
+    }
+}
+
+struct Sink::AsyncRecord
+{
+    Logger::Message message;
+    int referenceFrame = 0;
+    int messageIndent = 0;
+};
+
 Sink::Sink() = default;
-Sink::~Sink() = default;
+Sink::~Sink()
+{
+    DisableAsync();
+}
 
 void Sink::SetName(std::string name)
 {
@@ -27,6 +63,7 @@ void Sink::AddOutput(Logger::Output* output)
 
     // Add output to the list.
     m_outputs.push_back(output);
+    m_textOutputs = m_textOutputs || output->IsTextOutput();
 }
 
 void Sink::RemoveOutput(Logger::Output* output)
@@ -37,60 +74,330 @@ void Sink::RemoveOutput(Logger::Output* output)
 
     // Find and remove an output from the list.
     m_outputs.erase(std::remove(m_outputs.begin(), m_outputs.end(), output), m_outputs.end());
+    m_textOutputs = std::any_of(m_outputs.begin(), m_outputs.end(),
+        [](const Logger::Output* output)
+        {
+            return output->IsTextOutput();
+        });
 }
 
 void Sink::Write(const Logger::Message& message)
 {
-    std::scoped_lock<std::mutex> lock(m_lock);
+    if(IsMessageFiltered(message))
+        return;
 
-    // Do not print messages of severity debug if not in debug configuration.
-#ifdef NDEBUG
-    if(message.GetSeverity() == Severity::Debug)
+    // Make a copy of message that can be queued.
+    if(m_asyncEnabled.load())
+    {
+        Logger::Message messageCopy;
+        messageCopy.SetText(message.GetText());
+        messageCopy.SetFormat(message.GetFormat());
+        messageCopy.SetSeverity(message.GetSeverity());
+        messageCopy.SetSource(message.GetSource());
+        messageCopy.SetLine(message.GetLine());
+        messageCopy.SetTime(message.GetTime());
+
+        PushAsync(std::move(messageCopy));
         return;
-#endif
+    }
 
-    // Write message to all outputs.
-    for(auto output : m_outputs)
+    // Write message to all outputs and flush them right away.
     {
-        output->Write(message, m_context);
+        std::scoped_lock<std::mutex> lock(m_lock);
+        WriteOutputs(message, m_referenceFrame.load(), GetThreadIndent(this));
+        FlushOutputs();
     }
 
-    m_context.messageWritten = true;
+    m_messageWritten.store(true);
 }
 
-int Sink::AdvanceFrameReference()
+void Sink::Write(Logger::Message&& message)
 {
-    std::scoped_lock<std::mutex> lock(m_lock);
+    if(m_asyncEnabled.load() && !IsMessageFiltered(message))
+    {
+        PushAsync(std::move(message));
+        return;
+    }
+
+    Write(static_cast<const Logger::Message&>(message));
+}
+
+void Sink::Flush()
+{
+    if(!m_asyncEnabled.load())
+    {
+        std::scoped_lock<std::mutex> lock(m_lock);
+        FlushOutputs();
+        return;
+    }
 
+    // Wait until background thread writes all messages
+    // that were queued so far and flushes outputs.
+    std::unique_lock<std::mutex> lock(m_asyncLock);
+    uint64_t flushTicket = ++m_flushRequested;
+    m_asyncCondition.notify_one();
+
+    m_flushCondition.wait(lock, [this, flushTicket]()
+    {
+        return m_flushCompleted >= flushTicket;
+    });
+}
+
+int Sink::AdvanceFrameReference()
+{
     // Advance the frame of reference only if a message has
     // been written since the last time counter was incremented.
-    if(m_context.messageWritten)
+    if(m_messageWritten.exchange(false))
     {
-        m_context.referenceFrame++;
-        m_context.messageWritten = false;
+        return ++m_referenceFrame;
     }
 
-    return m_context.referenceFrame;
+    return m_referenceFrame.load();
 }
 
 void Sink::IncreaseIndent()
 {
-    std::scoped_lock<std::mutex> lock(m_lock);
-
-    m_context.messageIndent++;
+    if(int* messageIndent = FindThreadIndent(this))
+    {
+        ++*messageIndent;
+    }
+    else
+    {
+        ThreadIndents.emplace_back(this, 1);
+    }
 }
 
 void Sink::DecreaseIndent()
+{
+    auto it = std::find_if(ThreadIndents.begin(), ThreadIndents.end(),
+        [this](const auto& threadIndent)
+        {
+            return threadIndent.first == this;
+        });
+
+    if(it != ThreadIndents.end() && --it->second <= 0)
+    {
+        ThreadIndents.erase(it);
+    }
+}
+
+void Sink::EnableAsync(std::size_t capacity, std::chrono::milliseconds flushInterval)
+{
+    if(m_asyncEnabled.load())
+        return;
+
+    // Flush messages written synchronously so far.
+    Flush();
+
+    m_asyncQueue = std::make_unique<AsyncQueue>(capacity);
+    m_asyncPending.store(0);
+    m_flushInterval = flushInterval;
+    m_flushRequested = 0;
+    m_flushCompleted = 0;
+    m_asyncStopping = false;
+
+    m_asyncThread = std::thread(&Sink::AsyncWorker, this);
+    m_asyncEnabled.store(true);
+}
+
+void Sink::DisableAsync()
+{
+    if(!m_asyncEnabled.load())
+        return;
+
+    // Stop accepting new messages and let background thread
+    // write all remaining queued messages before it exits.
+    m_asyncEnabled.store(false);
+
+    {
+        std::scoped_lock<std::mutex> lock(m_asyncLock);
+        m_asyncStopping = true;
+    }
+
+    m_asyncCondition.notify_one();
+    m_asyncThread.join();
+    m_asyncQueue.reset();
+}
+
+bool Sink::IsAsync() const
+{
+    return m_asyncEnabled.load();
+}
+
+SinkContext Sink::GetContext() const
 {
     std::scoped_lock<std::mutex> lock(m_lock);
 
-    if(m_context.messageIndent > 0)
+    SinkContext context = m_context;
+    context.referenceFrame = m_referenceFrame.load();
+    context.messageIndent = GetThreadIndent(this);
+    context.messageWritten = m_messageWritten.load();
+    return context;
+}
+
+bool Sink::IsMessageFiltered(const Logger::Message& message) const
+{
+    // Do not print messages of severity debug if not in debug configuration.
+#ifdef NDEBUG
+    if(message.GetSeverity() == Severity::Debug)
+        return true;
+#endif
+
+    return false;
+}
+
+void Sink::WriteOutputs(const Logger::Message& message, int referenceFrame, int messageIndent)
+{
+    // Must be called with sink lock held.
+    if(m_outputs.empty())
+        return;
+
+    m_context.referenceFrame = referenceFrame;
+    m_context.messageIndent = messageIndent;
+
+    // Compose message text once for all outputs, unless none of them writes it.
+    std::string text;
+    if(m_textOutputs)
+    {
+        text = DefaultFormat::ComposeMessage(message, m_context);
+    }
+
+    for(auto output : m_outputs)
     {
-        m_context.messageIndent--;
+        output->Write(message, m_context, text);
     }
 }
 
-const SinkContext& Sink::GetContext() const
+void Sink::FlushOutputs()
 {
-    return m_context;
+    // Must be called with sink lock held.
+    for(auto output : m_outputs)
+    {
+        output->Flush();
+    }
+}
+
+void Sink::PushAsync(Logger::Message&& message)
+{
+    bool fatalMessage = message.GetSeverity() == Severity::Fatal;
+
+    AsyncRecord record;
+    record.message = std::move(message);
+    record.referenceFrame = m_referenceFrame.load();
+    record.messageIndent = GetThreadIndent(this);
+
+    // Wait for background thread to make space if queue is full.
+    // Record is only moved from when it is successfully pushed.
+    while(!m_asyncQueue->TryPush(std::move(record)))
+    {
+        std::this_thread::yield();
+    }
+
+    // Wake up background thread only if it is waiting, as counting pending
+    // messages before checking sleep state ensures that wake up is not missed.
+    m_asyncPending.fetch_add(1);
+
+    if(m_asyncSleeping.load())
+    {
+        std::scoped_lock<std::mutex> lock(m_asyncLock);
+        m_asyncCondition.notify_one();
+    }
+
+    m_messageWritten.store(true);
+
+    // Make sure fatal message reaches outputs before application goes down.
+    if(fatalMessage)
+    {
+        Flush();
+    }
+}
+
+void Sink::AsyncWorker()
+{
+    auto lastFlushTime = std::chrono::steady_clock::now();
+    bool outputsFlushed = true;
+
+    while(true)
+    {
+        // Read pending requests before draining queue, so every
+        // message pushed before them is written by the time they complete.
+        uint64_t flushRequested = 0;
+        bool stopping = false;
+
+        {
+            std::scoped_lock<std::mutex> lock(m_asyncLock);
+            flushRequested = m_flushRequested;
+            stopping = m_asyncStopping;
+        }
+
+        // Drain all pending messages. Queue may report being empty while
+        // other producer is still constructing record ahead of ours.
+        bool fatalWritten = false;
+        AsyncRecord record;
+
+        while(m_asyncPending.load() > 0)
+        {
+            if(!m_asyncQueue->TryPop(record))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            m_asyncPending.fetch_sub(1);
+
+            {
+                std::scoped_lock<std::mutex> lock(m_lock);
+                WriteOutputs(record.message, record.referenceFrame, record.messageIndent);
+            }
+
+            fatalWritten |= record.message.GetSeverity() == Severity::Fatal;
+            outputsFlushed = false;
+        }
+
+        // Flush outputs in batches instead of after every message.
+        auto currentTime = std::chrono::steady_clock::now();
+        bool flushPending = flushRequested != m_flushCompleted;
+        bool flushElapsed = currentTime - lastFlushTime >= m_flushInterval;
+
+        if(flushPending || stopping || fatalWritten || (!outputsFlushed && flushElapsed))
+        {
+            std::scoped_lock<std::mutex> lock(m_lock);
+            FlushOutputs();
+
+            lastFlushTime = currentTime;
+            outputsFlushed = true;
+        }
+
+        // Wait for more messages or requests. Wait is limited by
+        // flush interval only when there are unflushed messages.
+        std::unique_lock<std::mutex> lock(m_asyncLock);
+
+        if(flushPending)
+        {
+            m_flushCompleted = flushRequested;
+            m_flushCondition.notify_all();
+        }
+
+        if(stopping)
+            break;
+
+        auto wakePredicate = [this]()
+        {
+            return m_asyncPending.load() > 0 || m_asyncStopping ||
+                m_flushRequested != m_flushCompleted;
+        };
+
+        m_asyncSleeping.store(true);
+
+        if(outputsFlushed)
+        {
+            m_asyncCondition.wait(lock, wakePredicate);
+        }
+        else
+        {
+            m_asyncCondition.wait_until(lock, lastFlushTime + m_flushInterval, wakePredicate);
+        }
+
+        m_asyncSleeping.store(false);
+    }
 }
@@ -32,6 +32,8 @@ void NameRegistry::Register(std::string_view string)
 
 void NameRegistry::Register(const Name& name, std::string_view string)
 {
+    std::scoped_lock<std::mutex> lock(m_lock);
+
     auto it = m_registry.find(name.GetHash());
     if(it != m_registry.end())
     {
@@ -46,6 +48,8 @@ void NameRegistry::Register(const Name& name, std::string_view string)
 
 std::string_view NameRegistry::Lookup(HashType hash)
 {
+    std::scoped_lock<std::mutex> lock(m_lock);
+
     auto it = m_registry.find(hash);
     if(it == m_registry.end())
         return {};
@@ -60,6 +64,8 @@ bool NameRegistry::IsRegistered(std::string_view string)
 
 bool NameRegistry::IsRegistered(HashType hash)
 {
+    std::scoped_lock<std::mutex> lock(m_lock);
+
     return m_registry.find(hash) != m_registry.end();
 }
 
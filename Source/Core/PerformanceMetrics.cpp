@@ -34,9 +34,28 @@ void PerformanceMetrics::MarkFrameEnd()
         m_frameTimeAverage = m_frameTimeAccumulated / static_cast<float>(m_frameTimeAccumulations);
         m_frameTimeAccumulated = 0;
         m_frameTimeAccumulations = 0;
+
+        // Keep last latency if there was no input since last update.
+        if(m_inputLatencyAccumulations != 0)
+        {
+            m_inputLatencyAverage = m_inputLatencyAccumulated / static_cast<float>(m_inputLatencyAccumulations);
+            m_inputLatencyMaximum = m_inputLatencyAccumulatedMaximum;
+            m_inputLatencyAccumulated = 0.0f;
+            m_inputLatencyAccumulatedMaximum = 0.0f;
+            m_inputLatencyAccumulations = 0;
+        }
     }
 }
 
+void PerformanceMetrics::MarkInputPresented(std::chrono::steady_clock::time_point inputTime)
+{
+    float inputLatency = std::chrono::duration<float>(std::chrono::steady_clock::now() - inputTime).count();
+
+    m_inputLatencyAccumulated += inputLatency;
+    m_inputLatencyAccumulatedMaximum = std::max(m_inputLatencyAccumulatedMaximum, inputLatency);
+    m_inputLatencyAccumulations += 1;
+}
+
 float PerformanceMetrics::GetFrameTime() const
 {
     return m_frameTimeAverage;
@@ -46,3 +65,13 @@ float PerformanceMetrics::GetFrameRate() const
 {
     return 1.0f / GetFrameTime();
 }
+
+float PerformanceMetrics::GetInputLatency() const
+{
+    return m_inputLatencyAverage;
+}
+
+float PerformanceMetrics::GetMaxInputLatency() const
+{
+    return m_inputLatencyMaximum;
+}
@@ -135,8 +135,10 @@ void EditorShell::DisplayFramerate()
 
     if(ImGui::Begin("Framerate Counter Button", 0, flags))
     {
-        if(ImGui::Button(fmt::format("FPS: {:.0f} ({:.5f} ms)",
-            m_performanceMetrics->GetFrameRate(), m_performanceMetrics->GetFrameTime()).c_str()))
+        if(ImGui::Button(fmt::format("FPS: {:.0f} ({:.5f} ms) Poll to present: {:.1f} ms (max {:.1f} ms)",
+            m_performanceMetrics->GetFrameRate(), m_performanceMetrics->GetFrameTime(),
+            m_performanceMetrics->GetInputLatency() * 1000.0f,
+            m_performanceMetrics->GetMaxInputLatency() * 1000.0f).c_str()))
         {
         }
     }
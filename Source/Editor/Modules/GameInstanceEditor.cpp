@@ -138,6 +138,42 @@ void GameInstanceEditor::OnDisplay(float timeDelta)
                 }
                 ImGui::EndGroup();
 
+                // Tick catch up controls.
+                ImGui::BulletText("Max ticks per frame: %u (zero for no limit)",
+                    m_tickTimer->GetMaxFrameTicks());
+                ImGui::SliderInt("##MaxFrameTicksSlider", &m_maxFrameTicksSlider,
+                    0, 32, "%d tick(s) per frame");
+
+                ImGui::SameLine();
+                if(ImGui::Button("Apply##MaxFrameTicksApply"))
+                {
+                    m_tickTimer->SetMaxFrameTicks(static_cast<uint32_t>(m_maxFrameTicksSlider));
+                }
+
+                const char* catchUpPolicyNames[] = { "Delay", "Skip", "Stretch" };
+                int catchUpPolicy = static_cast<int>(m_tickTimer->GetCatchUpPolicy());
+                if(ImGui::Combo("Catch up policy", &catchUpPolicy,
+                    catchUpPolicyNames, IM_ARRAYSIZE(catchUpPolicyNames)))
+                {
+                    m_tickTimer->SetCatchUpPolicy(static_cast<Game::TickTimer::CatchUpPolicy>(catchUpPolicy));
+                }
+
+                // Tick catch up metrics.
+                const Game::TickTimer::Metrics& tickMetrics = m_tickTimer->GetMetrics();
+                ImGui::BulletText("Processed ticks: %llu (max %u per frame)",
+                    (unsigned long long)tickMetrics.processedTicks, tickMetrics.maxFrameTicks);
+                ImGui::BulletText("Throttled frames: %llu",
+                    (unsigned long long)tickMetrics.throttledFrames);
+                ImGui::BulletText("Delayed ticks: %llu, skipped ticks: %llu, stretched ticks: %llu",
+                    (unsigned long long)tickMetrics.delayedTicks,
+                    (unsigned long long)tickMetrics.skippedTicks,
+                    (unsigned long long)tickMetrics.stretchedTicks);
+
+                if(ImGui::Button("Reset##TickMetricsReset"))
+                {
+                    m_tickTimer->ResetMetrics();
+                }
+
                 // Time delay slider.
                 ImGui::BulletText("Update time delay: %0.3fs", m_updateDelayValue);
                 ImGui::SliderFloat("##UpdateDelaySlider", &m_updateDelaySlider,
@@ -214,6 +250,7 @@ void GameInstanceEditor::OnGameStateChanged(const std::shared_ptr<Game::GameStat
     if(m_tickTimer)
     {
         m_tickRateSlider = 1.0f / m_tickTimer->GetTickSeconds();
+        m_maxFrameTicksSlider = static_cast<int>(m_tickTimer->GetMaxFrameTicks());
 
         for(auto& tickTime : m_tickTimeHistogram)
         {
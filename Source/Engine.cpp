@@ -17,6 +17,8 @@
 #include <System/Window.hpp>
 #include <Graphics/RenderContext.hpp>
 #include <Graphics/Texture.hpp>
+#include <Graphics/TextureAtlas.hpp>
+#include <Graphics/Sprite/SpriteAnimationList.hpp>
 #include <Graphics/Sprite/SpriteRenderer.hpp>
 #include <Renderer/GameRenderer.hpp>
 #include <Game/GameFramework.hpp>
@@ -28,6 +30,50 @@ namespace
     const char* CreateEngineError = "Failed to create engine! {}";
     const char* CreateSystemsError = "Failed to create engine systems! {}";
     const char* LoadDefaultResourcesError = "Failed to load default resources! {}";
+
+    void ApplyLogSeverity(Core::Config& config, Logger::Category* category)
+    {
+        // Read minimum severity for all categories or for single one if specified.
+        const std::string variable = category != nullptr ? fmt::format(
+            "logger.minimumSeverity.{}", category->GetName()) : "logger.minimumSeverity";
+
+        auto severityText = config.Get<std::string>(Common::Name(variable));
+        if(!severityText)
+            return;
+
+        Logger::Severity::Type severity = Logger::ParseSeverity(severityText.Unwrap());
+        if(severity == Logger::Severity::Invalid)
+        {
+            LOG_WARNING("Ignoring invalid \"{}={}\" config variable - value must be "
+                "name of message severity!", variable, severityText.Unwrap());
+            return;
+        }
+
+        if(category != nullptr)
+        {
+            category->SetMinimumSeverity(severity);
+        }
+        else
+        {
+            Logger::SetMinimumSeverity(severity);
+        }
+    }
+
+    template<typename Type>
+    void ApplyResourceMemoryBudget(Core::Config& config,
+        System::ResourceManager& resourceManager, const char* poolName)
+    {
+        // Read memory budget in megabytes, with negative value meaning no budget.
+        const std::string variable = fmt::format("resources.memoryBudget.{}", poolName);
+
+        auto memoryBudget = config.Get<int>(Common::Name(variable));
+        if(!memoryBudget)
+            return;
+
+        resourceManager.SetMemoryBudget<Type>(memoryBudget.Unwrap() >= 0 ?
+            static_cast<std::size_t>(memoryBudget.Unwrap()) * 1024 * 1024 :
+            System::ResourcePoolInterface::UnlimitedBudget);
+    }
 }
 
 Root::Root() = default;
@@ -78,6 +124,39 @@ Root::CreateResult Root::Create(const ConfigVariables& configVars)
             config->Set<float>(NAME_CONSTEXPR("engine.maxUpdateDelta"),
                 engine->m_maxUpdateDelta, true);
         }
+
+        // Target frame rate of main loop, with zero meaning no limit.
+        // Headless engine has separate variable, as it has no vsync.
+        const char* frameRateVariable = engine->m_headless ?
+            "engine.headlessFrameRate" : "engine.frameRateLimit";
+
+        float frameRate = config->Get<float>(Common::Name(frameRateVariable)).UnwrapOr(0.0f);
+        if(frameRate >= 0.0f)
+        {
+            engine->m_framePacer.SetTargetFrameRate(frameRate);
+        }
+        else
+        {
+            LOG_WARNING("Ignoring invalid \"{}={}\" config variable - "
+                "value must not be negative!", frameRateVariable, frameRate);
+            config->Set<float>(Common::Name(frameRateVariable), 0.0f, true);
+        }
+
+        // Time in milliseconds spent spinning instead of sleeping before next frame.
+        float frameSpinTime = config->Get<float>(NAME_CONSTEXPR("engine.frameSpinTime"))
+            .UnwrapOr(System::FramePacer::DefaultSpinSeconds * 1000.0f);
+
+        if(frameSpinTime >= 0.0f)
+        {
+            engine->m_framePacer.SetSpinSeconds(frameSpinTime / 1000.0f);
+        }
+        else
+        {
+            LOG_WARNING("Ignoring invalid \"engine.frameSpinTime={}\" "
+                "config variable - value must not be negative!", frameSpinTime);
+            config->Set<float>(NAME_CONSTEXPR("engine.frameSpinTime"),
+                engine->m_framePacer.GetSpinSeconds() * 1000.0f, true);
+        }
     }
 
     LOG_SUCCESS("Created engine instance.");
@@ -90,6 +169,34 @@ Common::Result<void, Root::CreateErrors> Root::CreateEngineSystems(const ConfigV
     if(auto config = std::make_unique<Core::Config>())
     {
         config->Load(configVars);
+
+        // Write log messages from background thread when requested, before
+        // remaining systems are created and start loading resources.
+        if(config->Get<bool>(NAME_CONSTEXPR("logger.asyncMode")).UnwrapOr(false))
+        {
+            Logger::GetGlobalSink().EnableAsync();
+        }
+
+        // Write compact binary log that can be decoded into text later.
+        std::string binaryLogPath = config->Get<std::string>(
+            NAME_CONSTEXPR("logger.binaryOutput")).UnwrapOr("");
+
+        if(!binaryLogPath.empty() && !Logger::OpenBinaryOutput(binaryLogPath))
+        {
+            LOG_WARNING("Could not open \"{}\" binary log output!", binaryLogPath);
+        }
+
+        // Filter log messages by their severity before they are formatted.
+        ApplyLogSeverity(*config, nullptr);
+
+        for(Logger::Category* category : Logger::GetCategories())
+        {
+            ApplyLogSeverity(*config, category);
+        }
+
+        // Headless engine is created without systems that need display or GPU.
+        m_headless = config->Get<bool>(NAME_CONSTEXPR("engine.headless")).UnwrapOr(false);
+
         m_engineSystems.Attach(std::move(config));
     }
     else
@@ -115,22 +222,45 @@ Common::Result<void, Root::CreateErrors> Root::CreateEngineSystems(const ConfigV
         Reflection::GetIdentifier<Editor::EditorSystem>(),
     };
 
-    if(!m_engineSystems.CreateFromTypes(defaultEngineSystemTypes))
+    const std::vector<Reflection::TypeIdentifier> headlessEngineSystemTypes =
+    {
+        Reflection::GetIdentifier<Core::PerformanceMetrics>(),
+        Reflection::GetIdentifier<System::FileSystem>(),
+        Reflection::GetIdentifier<System::ResourceManager>(),
+        Reflection::GetIdentifier<System::Timer>(),
+        Reflection::GetIdentifier<Game::GameFramework>(),
+    };
+
+    if(!m_engineSystems.CreateFromTypes(m_headless ?
+        headlessEngineSystemTypes : defaultEngineSystemTypes))
     {
         LOG_ERROR(CreateSystemsError, "Could not populate system storage.");
         return Common::Failure(CreateErrors::FailedSystemCreation);
     }
 
     // Success!
-    LOG_SUCCESS("Created engine systems.");
+    LOG_SUCCESS("Created {} engine systems.", m_headless ? "headless" : "default");
     return Common::Success();
 }
 
 Common::Result<void, Root::CreateErrors> Root::LoadDefaultResources()
 {
+    auto* config = m_engineSystems.Locate<Core::Config>();
     auto* fileSystem = m_engineSystems.Locate<System::FileSystem>();
     auto* resourceManager = m_engineSystems.Locate<System::ResourceManager>();
 
+    // Memory budgets of resource pools for engine resource types.
+    ApplyResourceMemoryBudget<Graphics::Texture>(*config, *resourceManager, "Texture");
+    ApplyResourceMemoryBudget<Graphics::TextureAtlas>(*config, *resourceManager, "TextureAtlas");
+    ApplyResourceMemoryBudget<Graphics::SpriteAnimationList>(*config, *resourceManager, "SpriteAnimationList");
+
+    // Textures cannot be created without render context.
+    if(m_headless)
+    {
+        LOG_SUCCESS("Loaded default engine resources.");
+        return Common::Success();
+    }
+
     // Default texture placeholder for when requested texture is missing.
     // Texture is made to be easily spotted to indicate potential issues.
     const std::unique_ptr<System::FileHandle> defaultTextureFileResult = fileSystem->OpenFile(
@@ -168,33 +298,69 @@ void Root::ProcessFrame()
     /*
         Single frame execution, running repeatedly in main loop.
         Engine systems are updated here each frame if needed.
+        Window, input and editor systems are missing in headless engine.
+        Frame is paced to target frame rate before it ends, so measured
+        frame time includes waiting for the next one.
     */
 
     Logger::AdvanceFrameReference();
 
     auto* performanceMetrics = m_engineSystems.Locate<Core::PerformanceMetrics>();
     auto* timer = m_engineSystems.Locate<System::Timer>();
-    auto* window = m_engineSystems.Locate<System::Window>();
-    auto* inputManager = m_engineSystems.Locate<System::InputManager>();
     auto* resourceManager = m_engineSystems.Locate<System::ResourceManager>();
     auto* gameFramework = m_engineSystems.Locate<Game::GameFramework>();
-    auto* editorSystem = m_engineSystems.Locate<Editor::EditorSystem>();
+
+    auto* window = !m_headless ? m_engineSystems.Locate<System::Window>() : nullptr;
+    auto* inputManager = !m_headless ? m_engineSystems.Locate<System::InputManager>() : nullptr;
+    auto* editorSystem = !m_headless ? m_engineSystems.Locate<Editor::EditorSystem>() : nullptr;
 
     const float timeDelta = timer->Advance(m_maxUpdateDelta);
 
     performanceMetrics->MarkFrameStart();
+    resourceManager->ReloadChangedResources();
+    resourceManager->FinalizeAsyncLoads();
     resourceManager->ReleaseUnused();
-    window->ProcessEvents();
 
-    editorSystem->BeginInterface(timeDelta);
+    if(window != nullptr)
+    {
+        window->ProcessEvents();
+        inputManager->MarkEventsPolled();
+    }
+
+    if(editorSystem != nullptr)
+    {
+        editorSystem->BeginInterface(timeDelta);
+    }
+
     if(gameFramework->ProcessGameState(timeDelta) ==
         Game::GameFramework::ProcessGameStateResults::TickedAndUpdated)
     {
-        inputManager->UpdateInputState(timeDelta);
+        if(inputManager != nullptr)
+        {
+            inputManager->UpdateInputState(timeDelta);
+        }
+    }
+
+    if(editorSystem != nullptr)
+    {
+        editorSystem->EndInterface();
+    }
+
+    if(window != nullptr)
+    {
+        window->Present();
+    }
+
+    // Measure poll-to-present latency of earliest input reflected in presented frame.
+    if(inputManager != nullptr)
+    {
+        if(auto inputTime = inputManager->TakeEarliestInputTime())
+        {
+            performanceMetrics->MarkInputPresented(*inputTime);
+        }
     }
-    editorSystem->EndInterface();
 
-    window->Present();
+    m_framePacer.WaitForNextFrame();
     performanceMetrics->MarkFrameEnd();
 }
 
@@ -208,16 +374,22 @@ Root::ErrorCode Root::Run()
     */
 
     auto* timer = m_engineSystems.Locate<System::Timer>();
-    auto* window = m_engineSystems.Locate<System::Window>();
     auto* gameFramework = m_engineSystems.Locate<Game::GameFramework>();
+    auto* window = !m_headless ? m_engineSystems.Locate<System::Window>() : nullptr;
+
+    if(window != nullptr)
+    {
+        window->MakeContextCurrent();
+    }
 
-    window->MakeContextCurrent();
     timer->Reset();
 
 #ifndef __EMSCRIPTEN__
+    m_framePacer.Reset();
+
     while(true)
     {
-        if(!window->ShouldClose())
+        if(window != nullptr && !window->ShouldClose())
         {
             LOG_INFO("Exiting main loop because window has been requested to close.");
             break;
@@ -7,12 +7,22 @@
 #include "Game/ComponentSystem.hpp"
 #include "Game/EntitySystem.hpp"
 #include "Game/GameInstance.hpp"
+#include "Game/Components/TransformComponent.hpp"
+#include "Game/Components/CameraComponent.hpp"
+#include "Game/Components/SpriteComponent.hpp"
+#include "Game/Components/SpriteAnimationComponent.hpp"
 using namespace Game;
 
 ComponentSystem::ComponentSystem()
 {
     m_entityCreate.Bind<ComponentSystem, &ComponentSystem::OnEntityCreate>(this);
     m_entityDestroy.Bind<ComponentSystem, &ComponentSystem::OnEntityDestroy>(this);
+
+    // Register built-in component types.
+    RegisterComponentType<TransformComponent>();
+    RegisterComponentType<CameraComponent>();
+    RegisterComponentType<SpriteComponent>();
+    RegisterComponentType<SpriteAnimationComponent>();
 }
 
 ComponentSystem::~ComponentSystem() = default;
@@ -43,6 +53,202 @@ bool ComponentSystem::OnAttach(const GameSystemStorage& gameSystems)
     return true;
 }
 
+void ComponentSystem::OnSaveSnapshot(SnapshotWriter& writer) const
+{
+    for(const ComponentPoolInterface* pool : GetSortedPools())
+    {
+        std::size_t sectionOffset = writer.BeginSection(pool->GetTypeIdentifier());
+        pool->SaveSnapshot(writer);
+        writer.EndSection(sectionOffset);
+    }
+}
+
+bool ComponentSystem::OnRestoreSnapshot(SnapshotReader& reader)
+{
+    // Restore pools saved in snapshot and create missing ones.
+    std::vector<ComponentPoolInterface*> restoredPools;
+    restoredPools.reserve(m_pools.size());
+
+    while(!reader.IsEnd())
+    {
+        Reflection::TypeIdentifier poolType = Reflection::InvalidIdentifier;
+        SnapshotReader poolReader(nullptr, 0);
+        if(!reader.ReadSection(poolType, poolReader))
+        {
+            LOG_ERROR("Could not read component pool from snapshot!");
+            return false;
+        }
+
+        ComponentPoolInterface* pool = FindOrCreatePool(poolType);
+        if(pool == nullptr)
+        {
+            LOG_WARNING("Skipping snapshot of unregistered component type ({})!", poolType);
+            continue;
+        }
+
+        if(!pool->RestoreSnapshot(poolReader))
+        {
+            LOG_ERROR("Could not restore component pool ({}) from snapshot!", poolType);
+            return false;
+        }
+
+        restoredPools.push_back(pool);
+    }
+
+    return FinishRestoringPools(restoredPools);
+}
+
+void ComponentSystem::OnSaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const
+{
+    // Find pool sections in baseline, which was saved by this system.
+    std::vector<std::pair<Reflection::TypeIdentifier, SnapshotReader>> baselinePools;
+    SnapshotReader baselineReader = baseline;
+
+    while(!baselineReader.IsEnd())
+    {
+        Reflection::TypeIdentifier poolType = Reflection::InvalidIdentifier;
+        SnapshotReader poolReader(nullptr, 0);
+        if(!baselineReader.ReadSection(poolType, poolReader))
+        {
+            ASSERT(false, "Could not read component pool from baseline!");
+            break;
+        }
+
+        baselinePools.emplace_back(poolType, poolReader);
+    }
+
+    // Every pool is encoded, as pools missing from delta are cleared.
+    std::vector<const ComponentPoolInterface*> pools = GetSortedPools();
+    writer.WriteVarint(pools.size());
+
+    for(const ComponentPoolInterface* pool : pools)
+    {
+        SnapshotReader poolBaseline(nullptr, 0);
+        for(const auto& baselinePool : baselinePools)
+        {
+            if(baselinePool.first == pool->GetTypeIdentifier())
+            {
+                poolBaseline = baselinePool.second;
+                break;
+            }
+        }
+
+        writer.WriteBits(pool->GetTypeIdentifier(), sizeof(Reflection::TypeIdentifier) * 8);
+        pool->SaveSnapshotDelta(poolBaseline, writer);
+    }
+}
+
+bool ComponentSystem::OnRestoreSnapshotDelta(const SnapshotReader& baseline, Common::BitReader& reader)
+{
+    // Pools have been restored from baseline already, so deltas
+    // are applied directly on top of their current state.
+    uint64_t poolCount = reader.ReadVarint();
+    if(!reader.IsValid())
+    {
+        LOG_ERROR("Could not read component pools from snapshot delta!");
+        return false;
+    }
+
+    std::vector<ComponentPoolInterface*> restoredPools;
+    restoredPools.reserve(m_pools.size());
+
+    for(uint64_t poolIndex = 0; poolIndex < poolCount; ++poolIndex)
+    {
+        auto poolType = static_cast<Reflection::TypeIdentifier>(
+            reader.ReadBits(sizeof(Reflection::TypeIdentifier) * 8));
+
+        // Pool delta cannot be skipped, as its size is not known.
+        ComponentPoolInterface* pool = reader.IsValid() ? FindOrCreatePool(poolType) : nullptr;
+        if(pool == nullptr)
+        {
+            LOG_ERROR("Could not find component pool ({}) from snapshot delta!", poolType);
+            return false;
+        }
+
+        if(!pool->RestoreSnapshotDelta(reader))
+        {
+            LOG_ERROR("Could not restore component pool ({}) from snapshot delta!", poolType);
+            return false;
+        }
+
+        restoredPools.push_back(pool);
+    }
+
+    return FinishRestoringPools(restoredPools);
+}
+
+ComponentPoolInterface* ComponentSystem::FindPool(Reflection::TypeIdentifier identifier) const
+{
+    for(const auto& pair : m_pools)
+    {
+        if(pair.second->GetTypeIdentifier() == identifier)
+            return pair.second.get();
+    }
+
+    return nullptr;
+}
+
+ComponentPoolInterface* ComponentSystem::FindOrCreatePool(Reflection::TypeIdentifier identifier)
+{
+    ComponentPoolInterface* pool = FindPool(identifier);
+    if(pool != nullptr)
+        return pool;
+
+    auto factoryIt = m_poolFactories.find(identifier);
+    if(factoryIt == m_poolFactories.end())
+        return nullptr;
+
+    pool = factoryIt->second(*this);
+    ASSERT(pool != nullptr, "Failed to create component pool!");
+    return pool;
+}
+
+std::vector<const ComponentPoolInterface*> ComponentSystem::GetSortedPools() const
+{
+    // Save pools in order of their type identifiers,
+    // so same world state always results in same snapshot.
+    std::vector<const ComponentPoolInterface*> pools;
+    pools.reserve(m_pools.size());
+
+    for(const auto& pair : m_pools)
+    {
+        pools.push_back(pair.second.get());
+    }
+
+    std::sort(pools.begin(), pools.end(),
+        [](const ComponentPoolInterface* left, const ComponentPoolInterface* right)
+        {
+            return left->GetTypeIdentifier() < right->GetTypeIdentifier();
+        });
+
+    return pools;
+}
+
+bool ComponentSystem::FinishRestoringPools(const std::vector<ComponentPoolInterface*>& restoredPools)
+{
+    // Pools that are not in snapshot did not have any components.
+    for(auto& pair : m_pools)
+    {
+        ComponentPoolInterface* pool = pair.second.get();
+        if(std::find(restoredPools.begin(), restoredPools.end(), pool) == restoredPools.end())
+        {
+            pool->ClearComponents();
+        }
+    }
+
+    // Initialize components once all of them are restored.
+    for(auto& pair : m_pools)
+    {
+        if(!pair.second->InitializeRestoredComponents())
+        {
+            LOG_ERROR("Could not initialize components restored from snapshot!");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ComponentSystem::OnEntityCreate(EntityHandle handle)
 {
     // Initialize all components belonging to this entity.
@@ -9,9 +9,6 @@
 #include "Game/ComponentSystem.hpp"
 using namespace Game;
 
-CameraComponent::CameraComponent() = default;
-CameraComponent::~CameraComponent() = default;
-
 bool CameraComponent::OnInitialize(ComponentSystem* componentSystem, const EntityHandle& entitySelf)
 {
     m_transform = componentSystem->Lookup<TransformComponent>(entitySelf);
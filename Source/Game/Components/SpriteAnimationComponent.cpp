@@ -20,6 +20,13 @@ bool SpriteAnimationComponent::OnInitialize(ComponentSystem* componentSystem,
     if(m_spriteComponent == nullptr)
         return false;
 
+    // Playback restored from snapshot refers to animation by its name hash,
+    // which cannot be resolved without animation list that is not saved.
+    if(m_playingAnimationHash != 0 && GetSpriteAnimation() == nullptr)
+    {
+        Stop();
+    }
+
     return true;
 }
 
@@ -41,7 +48,7 @@ void SpriteAnimationComponent::ResetInterpolation()
         error when animation is looping.
     */
     
-    if(m_playingSpriteAnimation)
+    if(GetSpriteAnimation())
     {
         m_currentAnimationTime = CalculateAnimationTime(1.0f);
         m_previousAnimationTime = m_currentAnimationTime;
@@ -56,14 +63,21 @@ void SpriteAnimationComponent::Tick(float timeDelta)
 
     if(IsPlaying())
     {
-        ASSERT(m_playingSpriteAnimation, "Playing sprite animation without an animation set!");
-        ASSERT(m_playingSpriteAnimation->duration >= 0.0f, "Sprite animation has an invalid duration!");
+        // Playing animation can be removed when its list is reloaded.
+        const SpriteAnimation* spriteAnimation = GetSpriteAnimation();
+        if(spriteAnimation == nullptr)
+        {
+            Stop();
+            return;
+        }
+
+        ASSERT(spriteAnimation->duration >= 0.0f, "Sprite animation has an invalid duration!");
 
         m_currentAnimationTime += timeDelta;
 
         if(!IsLooped())
         {
-            if(m_currentAnimationTime >= m_playingSpriteAnimation->duration)
+            if(m_currentAnimationTime >= spriteAnimation->duration)
             {
                 Pause();
             }
@@ -80,12 +94,10 @@ void SpriteAnimationComponent::Play(std::string animationName, bool loop)
         return;
     }
 
-    if(auto animationIndexResult = m_spriteAnimationList->GetAnimationIndex(animationName))
+    uint64_t animationHash = Graphics::CookedFormat::HashName(animationName);
+    if(m_spriteAnimationList->GetAnimationByHash(animationHash))
     {
-        uint32_t animationIndex = animationIndexResult.Unwrap();
-        m_playingSpriteAnimation = m_spriteAnimationList->GetAnimationByIndex(animationIndex);
-        ASSERT(m_playingSpriteAnimation, "Sprite animation retrieved via its index is null!");
-
+        m_playingAnimationHash = animationHash;
         m_playbackInfo = PlaybackFlags::Playing;
         m_currentAnimationTime = 0.0f;
         m_previousAnimationTime = 0.0f;
@@ -118,7 +130,7 @@ void SpriteAnimationComponent::Pause()
 
 void SpriteAnimationComponent::Resume()
 {
-    if(m_playingSpriteAnimation)
+    if(GetSpriteAnimation())
     {
         m_playbackInfo |= PlaybackFlags::Playing;
     }
@@ -126,7 +138,7 @@ void SpriteAnimationComponent::Resume()
 
 void SpriteAnimationComponent::Stop()
 {
-    m_playingSpriteAnimation = nullptr;
+    m_playingAnimationHash = 0;
     m_playbackInfo = PlaybackFlags::None;
     m_currentAnimationTime = 0.0f;
     m_previousAnimationTime = 0.0f;
@@ -139,18 +151,19 @@ float SpriteAnimationComponent::CalculateAnimationTime(float timeAlpha) const
         looping time in such way that avoid time error from being accumulated.
     */
 
+    const SpriteAnimation* spriteAnimation = GetSpriteAnimation();
     ASSERT(timeAlpha >= 0.0f && timeAlpha <= 1.0f, "Time alpha is not normalized!");
-    ASSERT(m_playingSpriteAnimation, "Cannot calculate animation time without sprite animation set!");
+    ASSERT(spriteAnimation, "Cannot calculate animation time without sprite animation set!");
 
     float animationTime = glm::mix(m_previousAnimationTime, m_currentAnimationTime, timeAlpha);
 
     if(IsLooped())
     {
-        return glm::mod(animationTime, m_playingSpriteAnimation->duration);
+        return glm::mod(animationTime, spriteAnimation->duration);
     }
     else
     {
-        return glm::min(animationTime, m_playingSpriteAnimation->duration);
+        return glm::min(animationTime, spriteAnimation->duration);
     }
 }
 
@@ -163,7 +176,11 @@ const SpriteAnimationComponent::SpriteAnimationListPtr&
 const SpriteAnimationComponent::SpriteAnimation*
     SpriteAnimationComponent::GetSpriteAnimation() const
 {
-    return m_playingSpriteAnimation;
+    // Returned pointer is only valid until animation list is reloaded.
+    if(m_spriteAnimationList == nullptr || m_playingAnimationHash == 0)
+        return nullptr;
+
+    return m_spriteAnimationList->GetAnimationByHash(m_playingAnimationHash);
 }
 
 SpriteComponent* SpriteAnimationComponent::GetSpriteComponent() const
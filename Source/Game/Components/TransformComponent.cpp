@@ -7,9 +7,6 @@
 #include "Game/Components/TransformComponent.hpp"
 using namespace Game;
 
-TransformComponent::TransformComponent() = default;
-TransformComponent::~TransformComponent() = default;
-
 void TransformComponent::ResetInterpolation()
 {
     /*
@@ -5,6 +5,7 @@
 
 #include "Game/Precompiled.hpp"
 #include "Game/EntitySystem.hpp"
+#include "Game/Snapshot.hpp"
 using namespace Game;
 
 EntitySystem::Events::Events() :
@@ -25,6 +26,56 @@ void EntitySystem::OnTick(float timeDelta)
     ProcessCommands();
 }
 
+void EntitySystem::OnSaveSnapshot(SnapshotWriter& writer) const
+{
+    m_entities.Serialize(writer);
+
+    // Save commands that have not been processed yet.
+    CommandList commands = m_commands;
+    writer.Write(static_cast<uint64_t>(commands.size()));
+
+    while(!commands.empty())
+    {
+        const EntityCommand& command = commands.front();
+        writer.Write(command.handle);
+        writer.Write(command.type);
+        commands.pop();
+    }
+}
+
+bool EntitySystem::OnRestoreSnapshot(SnapshotReader& reader)
+{
+    // Entities are replaced without dispatching events, as other
+    // systems restore state of their entities from snapshot as well.
+    CommandList commands;
+    m_commands.swap(commands);
+
+    if(!m_entities.Deserialize(reader))
+    {
+        LOG_ERROR("Could not restore entities from snapshot!");
+        return false;
+    }
+
+    uint64_t commandCount = 0;
+    reader.Read(commandCount);
+
+    for(uint64_t i = 0; i < commandCount && reader.IsValid(); ++i)
+    {
+        EntityCommand command;
+        reader.Read(command.handle);
+        reader.Read(command.type);
+        m_commands.push(command);
+    }
+
+    if(!reader.IsValid())
+    {
+        LOG_ERROR("Could not restore entity commands from snapshot!");
+        return false;
+    }
+
+    return true;
+}
+
 EntityHandle EntitySystem::CreateEntity()
 {
     // Create new entity entry.
@@ -7,7 +7,10 @@
 #include "Game/GameFramework.hpp"
 #include "Game/GameInstance.hpp"
 #include "Game/TickTimer.hpp"
+#include "Game/TickSimulation.hpp"
+#include "Game/GameInstanceHost.hpp"
 #include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
 #include <System/Window.hpp>
 using namespace Game;
 
@@ -24,15 +27,43 @@ bool GameFramework::OnAttach(const Core::EngineSystemStorage& engineSystems)
         return false;
     }
 
+    // Create host for game instances ticked in parallel. Host threads are
+    // an upper limit, workers are only started once instances are hosted.
+#ifdef __EMSCRIPTEN__
+    const int defaultHostThreads = 0;
+#else
+    const int defaultHostThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+#endif
+
+    int hostThreads = defaultHostThreads;
+    if(Core::Config* config = engineSystems.Locate<Core::Config>())
+    {
+        hostThreads = config->Get<int>(NAME_CONSTEXPR("game.hostThreads")).UnwrapOr(defaultHostThreads);
+    }
+
+    GameInstanceHost::CreateFromParams instanceHostParams;
+    instanceHostParams.workerThreads = static_cast<uint32_t>(std::max(0, hostThreads));
+
+    m_instanceHost = GameInstanceHost::Create(instanceHostParams).UnwrapOr(nullptr);
+    if(!m_instanceHost)
+    {
+        LOG_ERROR("Failed to create game instance host!");
+        return false;
+    }
+
     // Success!
     return true;
 }
 
 GameFramework::ProcessGameStateResults GameFramework::ProcessGameState(const float timeDelta)
 {
+    // Tick hosted game instances in parallel.
+    m_instanceHost->Advance(*m_timer);
+
     // Acquire current state and its parts.
     std::shared_ptr<GameState> currentState = m_stateMachine.GetState();
     TickTimer* tickTimer = currentState ? currentState->GetTickTimer() : nullptr;
+    TickSimulation* tickSimulation = currentState ? currentState->GetTickSimulation() : nullptr;
     GameInstance* gameInstance = currentState ? currentState->GetGameInstance() : nullptr;
 
     // Track whether tick was processed.
@@ -50,6 +81,13 @@ GameFramework::ProcessGameStateResults GameFramework::ProcessGameState(const flo
         // Inform about tick being requested.
         events.tickRequested.Dispatch();
 
+        // Simulate again ticks that received late inputs.
+        // This is not visible outside and does not dispatch any tick events.
+        if(tickSimulation && tickSimulation->HasPendingResimulation())
+        {
+            tickSimulation->ResimulatePending();
+        }
+
         // Process game tick.
         // Tick may be processed multiple times if behind the schedule.
         while(!tickTimer || tickTimer->Tick())
@@ -58,7 +96,12 @@ GameFramework::ProcessGameStateResults GameFramework::ProcessGameState(const flo
             float tickTime = tickTimer ? tickTimer->GetLastTickSeconds() : timeDelta;
 
             // Tick game instance.
-            if(gameInstance)
+            if(tickSimulation)
+            {
+                tickTime = tickSimulation->GetTickSeconds();
+                tickSimulation->Advance();
+            }
+            else if(gameInstance)
             {
                 gameInstance->Tick(tickTime);
             }
@@ -123,3 +166,9 @@ bool GameFramework::HasGameState() const
 {
     return m_stateMachine.HasState();
 }
+
+GameInstanceHost& GameFramework::GetInstanceHost()
+{
+    ASSERT(m_instanceHost, "Game instance host has not been created!");
+    return *m_instanceHost;
+}
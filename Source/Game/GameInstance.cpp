@@ -5,6 +5,8 @@
 
 #include "Game/Precompiled.hpp"
 #include "Game/GameInstance.hpp"
+#include "Game/Snapshot.hpp"
+#include "Game/SnapshotDelta.hpp"
 #include "Game/EntitySystem.hpp"
 #include "Game/ComponentSystem.hpp"
 #include "Game/Systems/IdentitySystem.hpp"
@@ -15,6 +17,48 @@ using namespace Game;
 namespace
 {
     const char* CreateSystemsError = "Failed to create game systems! {}";
+    const char* RestoreSnapshotError = "Failed to restore game instance snapshot! {}";
+    const char* RestoreSnapshotDeltaError = "Failed to restore game instance snapshot delta! {}";
+
+    using SnapshotSectionList = std::vector<std::pair<Reflection::TypeIdentifier, SnapshotReader>>;
+
+    bool ReadSnapshotSections(const SnapshotReader& snapshot, SnapshotSectionList& sections)
+    {
+        // Empty snapshot stands for state of new instance without any sections.
+        if(snapshot.GetSize() == 0)
+            return true;
+
+        SnapshotReader reader = snapshot;
+        SnapshotFormat::Header header;
+        if(!reader.Read(header) || header.magic != SnapshotFormat::Magic ||
+            header.version != SnapshotFormat::Version)
+        {
+            return false;
+        }
+
+        while(!reader.IsEnd())
+        {
+            Reflection::TypeIdentifier systemType = Reflection::InvalidIdentifier;
+            SnapshotReader systemReader(nullptr, 0);
+            if(!reader.ReadSection(systemType, systemReader))
+                return false;
+
+            sections.emplace_back(systemType, systemReader);
+        }
+
+        return true;
+    }
+
+    SnapshotReader FindSnapshotSection(const SnapshotSectionList& sections, Reflection::TypeIdentifier systemType)
+    {
+        for(const auto& section : sections)
+        {
+            if(section.first == systemType)
+                return section.second;
+        }
+
+        return SnapshotReader(nullptr, 0);
+    }
 }
 
 GameInstance::GameInstance() = default;
@@ -55,3 +99,161 @@ void GameInstance::Tick(const float timeDelta)
         return true;
     });
 }
+
+void GameInstance::SaveSnapshot(SnapshotWriter& writer)
+{
+    writer.Write(SnapshotFormat::Header());
+
+    m_gameSystems.ForEach([&writer](GameSystem& gameSystem)
+    {
+        std::size_t sectionOffset = writer.BeginSection(Reflection::GetIdentifier(gameSystem));
+        gameSystem.OnSaveSnapshot(writer);
+        writer.EndSection(sectionOffset);
+        return true;
+    });
+}
+
+GameInstance::RestoreSnapshotResult GameInstance::RestoreSnapshot(SnapshotReader& reader)
+{
+    SnapshotFormat::Header header;
+    if(!reader.Read(header) || header.magic != SnapshotFormat::Magic)
+    {
+        LOG_ERROR(RestoreSnapshotError, "Invalid snapshot header.");
+        return Common::Failure(RestoreSnapshotErrors::InvalidHeader);
+    }
+
+    if(header.version != SnapshotFormat::Version)
+    {
+        LOG_ERROR(RestoreSnapshotError, "Unsupported snapshot version.");
+        return Common::Failure(RestoreSnapshotErrors::UnsupportedVersion);
+    }
+
+    // Sections are restored in order they were saved, which
+    // is order of system dependencies (e.g. entities first).
+    while(!reader.IsEnd())
+    {
+        Reflection::TypeIdentifier systemType = Reflection::InvalidIdentifier;
+        SnapshotReader systemReader(nullptr, 0);
+        if(!reader.ReadSection(systemType, systemReader))
+        {
+            LOG_ERROR(RestoreSnapshotError, "Could not read system section.");
+            return Common::Failure(RestoreSnapshotErrors::InvalidSection);
+        }
+
+        // Systems that are missing from this instance are skipped.
+        bool systemRestored = true;
+        m_gameSystems.ForEach([systemType, &systemReader, &systemRestored](GameSystem& gameSystem)
+        {
+            if(Reflection::GetIdentifier(gameSystem) != systemType)
+                return true;
+
+            systemRestored = gameSystem.OnRestoreSnapshot(systemReader);
+            return false;
+        });
+
+        if(!systemRestored)
+        {
+            LOG_ERROR(RestoreSnapshotError, "Could not restore system state.");
+            return Common::Failure(RestoreSnapshotErrors::FailedSystemRestore);
+        }
+    }
+
+    return Common::Success();
+}
+
+void GameInstance::SaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer)
+{
+    SnapshotSectionList baselineSections;
+    bool baselineRead = ReadSnapshotSections(baseline, baselineSections);
+    ASSERT(baselineRead, "Invalid baseline snapshot!");
+
+    // Delta of every system is written, as their sizes are not
+    // stored and systems missing on receiving side cannot be skipped.
+    uint64_t systemCount = 0;
+    m_gameSystems.ForEach([&systemCount](GameSystem& gameSystem)
+    {
+        ++systemCount;
+        return true;
+    });
+
+    writer.WriteVarint(SnapshotFormat::Version);
+    writer.WriteVarint(systemCount);
+
+    m_gameSystems.ForEach([&writer, &baselineSections](GameSystem& gameSystem)
+    {
+        Reflection::TypeIdentifier systemType = Reflection::GetIdentifier(gameSystem);
+        writer.WriteBits(systemType, sizeof(Reflection::TypeIdentifier) * 8);
+        gameSystem.OnSaveSnapshotDelta(FindSnapshotSection(baselineSections, systemType), writer);
+        return true;
+    });
+}
+
+GameInstance::RestoreSnapshotResult GameInstance::RestoreSnapshotDelta(
+    const SnapshotReader& baseline, Common::BitReader& reader)
+{
+    SnapshotSectionList baselineSections;
+    if(!ReadSnapshotSections(baseline, baselineSections))
+    {
+        LOG_ERROR(RestoreSnapshotDeltaError, "Invalid baseline snapshot.");
+        return Common::Failure(RestoreSnapshotErrors::InvalidHeader);
+    }
+
+    if(baseline.GetSize() != 0)
+    {
+        SnapshotReader baselineReader = baseline;
+        RestoreSnapshotResult baselineResult = RestoreSnapshot(baselineReader);
+        if(!baselineResult)
+            return baselineResult;
+    }
+
+    uint64_t version = reader.ReadVarint();
+    uint64_t systemCount = reader.ReadVarint();
+    if(!reader.IsValid())
+    {
+        LOG_ERROR(RestoreSnapshotDeltaError, "Invalid delta header.");
+        return Common::Failure(RestoreSnapshotErrors::InvalidHeader);
+    }
+
+    if(version != SnapshotFormat::Version)
+    {
+        LOG_ERROR(RestoreSnapshotDeltaError, "Unsupported snapshot version.");
+        return Common::Failure(RestoreSnapshotErrors::UnsupportedVersion);
+    }
+
+    for(uint64_t systemIndex = 0; systemIndex < systemCount; ++systemIndex)
+    {
+        auto systemType = static_cast<Reflection::TypeIdentifier>(
+            reader.ReadBits(sizeof(Reflection::TypeIdentifier) * 8));
+
+        bool systemFound = false;
+        bool systemRestored = false;
+
+        if(reader.IsValid())
+        {
+            m_gameSystems.ForEach([&](GameSystem& gameSystem)
+            {
+                if(Reflection::GetIdentifier(gameSystem) != systemType)
+                    return true;
+
+                systemFound = true;
+                systemRestored = gameSystem.OnRestoreSnapshotDelta(
+                    FindSnapshotSection(baselineSections, systemType), reader);
+                return false;
+            });
+        }
+
+        if(!systemFound)
+        {
+            LOG_ERROR(RestoreSnapshotDeltaError, "Could not read system delta.");
+            return Common::Failure(RestoreSnapshotErrors::InvalidSection);
+        }
+
+        if(!systemRestored)
+        {
+            LOG_ERROR(RestoreSnapshotDeltaError, "Could not restore system state.");
+            return Common::Failure(RestoreSnapshotErrors::FailedSystemRestore);
+        }
+    }
+
+    return Common::Success();
+}
@@ -0,0 +1,206 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Game/Precompiled.hpp"
+#include "Game/GameInstanceHost.hpp"
+#include "Game/GameInstance.hpp"
+#include "Game/TickTimer.hpp"
+#include <System/Timer.hpp>
+using namespace Game;
+
+GameInstanceHost::GameInstanceHost() = default;
+GameInstanceHost::~GameInstanceHost()
+{
+    {
+        std::scoped_lock<std::mutex> lock(m_workLock);
+        m_workStopped = true;
+    }
+
+    m_workCondition.notify_all();
+
+    for(std::thread& workerThread : m_workerThreads)
+    {
+        workerThread.join();
+    }
+}
+
+GameInstanceHost::CreateResult GameInstanceHost::Create(const CreateFromParams& params)
+{
+    LOG("Creating game instance host...");
+    LOG_SCOPED_INDENT();
+
+    // Create instance.
+    auto instance = std::unique_ptr<GameInstanceHost>(new GameInstanceHost());
+
+    // Worker threads are started once there are instances for them to tick.
+    instance->m_maxWorkerThreads = params.workerThreads;
+
+    // Success!
+    LOG_SUCCESS("Created game instance host with up to {} worker threads.", params.workerThreads);
+    return Common::Success(std::move(instance));
+}
+
+GameInstanceHost::HostResult GameInstanceHost::Host(
+    std::unique_ptr<GameInstance> gameInstance, std::unique_ptr<TickTimer> tickTimer)
+{
+    CHECK_ARGUMENT_OR_RETURN(gameInstance != nullptr, Common::Failure(HostErrors::InvalidArgument));
+
+    if(tickTimer == nullptr)
+    {
+        tickTimer = TickTimer::Create().UnwrapOr(nullptr);
+        if(tickTimer == nullptr)
+        {
+            LOG_ERROR("Could not create tick timer for hosted game instance!");
+            return Common::Failure(HostErrors::FailedTickTimerCreation);
+        }
+    }
+
+    m_instances.push_back({ std::move(gameInstance), std::move(tickTimer) });
+    StartWorkerThreads();
+    return Common::Success();
+}
+
+void GameInstanceHost::StartWorkerThreads()
+{
+    // Calling thread ticks one of instances, so there is no need for more
+    // workers than remaining instances. Workers are never stopped early,
+    // as instance count usually stays similar during host lifetime.
+    const std::size_t neededWorkers = std::min(m_maxWorkerThreads, m_instances.size() - 1);
+    if(m_workerThreads.size() >= neededWorkers)
+        return;
+
+    // New workers skip advances that happened before they were started.
+    std::scoped_lock<std::mutex> lock(m_workLock);
+    while(m_workerThreads.size() < neededWorkers)
+    {
+        m_workerThreads.emplace_back(&GameInstanceHost::RunWorkerThread, this, m_workGeneration);
+    }
+}
+
+std::unique_ptr<GameInstance> GameInstanceHost::Release(GameInstance* gameInstance)
+{
+    auto it = std::find_if(m_instances.begin(), m_instances.end(),
+        [gameInstance](const HostedInstance& hosted)
+        {
+            return hosted.gameInstance.get() == gameInstance;
+        });
+
+    if(it == m_instances.end())
+        return nullptr;
+
+    std::unique_ptr<GameInstance> releasedInstance = std::move(it->gameInstance);
+    m_instances.erase(it);
+    return releasedInstance;
+}
+
+void GameInstanceHost::Advance(const System::Timer& timer)
+{
+    if(m_instances.empty())
+        return;
+
+    // Advance tick timers on calling thread, so all instances see the same time.
+    for(HostedInstance& hosted : m_instances)
+    {
+        hosted.tickTimer->Advance(timer);
+    }
+
+    m_nextInstance.store(0);
+
+    if(m_workerThreads.empty())
+    {
+        ProcessInstances();
+        return;
+    }
+
+    // Wake up worker threads and help them tick instances. Every worker thread
+    // takes part in each advance, so none of them can still be looking at
+    // instance list after we stop waiting for them below.
+    {
+        std::scoped_lock<std::mutex> lock(m_workLock);
+        m_pendingWorkers = m_workerThreads.size();
+        ++m_workGeneration;
+    }
+
+    m_workCondition.notify_all();
+
+    ProcessInstances();
+
+    std::unique_lock<std::mutex> lock(m_workLock);
+    m_doneCondition.wait(lock, [this]()
+    {
+        return m_pendingWorkers == 0;
+    });
+}
+
+void GameInstanceHost::RunWorkerThread(uint64_t workGeneration)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_workLock);
+            m_workCondition.wait(lock, [this, workGeneration]()
+            {
+                return m_workStopped || m_workGeneration != workGeneration;
+            });
+
+            if(m_workStopped)
+                return;
+
+            workGeneration = m_workGeneration;
+        }
+
+        ProcessInstances();
+
+        bool lastWorker = false;
+        {
+            std::scoped_lock<std::mutex> lock(m_workLock);
+            lastWorker = --m_pendingWorkers == 0;
+        }
+
+        if(lastWorker)
+        {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void GameInstanceHost::ProcessInstances()
+{
+    // Take instances one by one, as some can take longer to tick than others.
+    while(true)
+    {
+        const std::size_t index = m_nextInstance.fetch_add(1);
+        if(index >= m_instances.size())
+            break;
+
+        HostedInstance& hosted = m_instances[index];
+        while(hosted.tickTimer->Tick())
+        {
+            hosted.gameInstance->Tick(hosted.tickTimer->GetLastTickSeconds());
+        }
+    }
+}
+
+GameInstance* GameInstanceHost::GetInstance(std::size_t index) const
+{
+    ASSERT(index < m_instances.size(), "Invalid hosted game instance index!");
+    return m_instances[index].gameInstance.get();
+}
+
+TickTimer* GameInstanceHost::GetTickTimer(std::size_t index) const
+{
+    ASSERT(index < m_instances.size(), "Invalid hosted game instance index!");
+    return m_instances[index].tickTimer.get();
+}
+
+std::size_t GameInstanceHost::GetInstanceCount() const
+{
+    return m_instances.size();
+}
+
+std::size_t GameInstanceHost::GetWorkerThreadCount() const
+{
+    return m_workerThreads.size();
+}
@@ -0,0 +1,41 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Game/Precompiled.hpp"
+#include "Game/GameSystem.hpp"
+#include "Game/Snapshot.hpp"
+#include "Game/SnapshotDelta.hpp"
+using namespace Game;
+
+void GameSystem::OnSaveSnapshotDelta(const SnapshotReader& baseline, Common::BitWriter& writer) const
+{
+    SnapshotWriter currentWriter;
+    OnSaveSnapshot(currentWriter);
+
+    // Most systems do not change every tick, so unchanged state takes single bit.
+    const std::vector<uint8_t>& current = currentWriter.GetData();
+    bool changed = current.size() != baseline.GetSize() ||
+        (!current.empty() && std::memcmp(current.data(), baseline.GetData(), current.size()) != 0);
+
+    writer.WriteBool(changed);
+    if(changed)
+    {
+        SnapshotDelta::WriteBytesDelta(writer, baseline.GetData(), baseline.GetSize(), current);
+    }
+}
+
+bool GameSystem::OnRestoreSnapshotDelta(const SnapshotReader& baseline, Common::BitReader& reader)
+{
+    // State restored from baseline is already current if nothing changed.
+    if(!reader.ReadBool())
+        return reader.IsValid();
+
+    std::vector<uint8_t> current;
+    if(!SnapshotDelta::ReadBytesDelta(reader, baseline.GetData(), baseline.GetSize(), current))
+        return false;
+
+    SnapshotReader currentReader(current);
+    return OnRestoreSnapshot(currentReader);
+}
@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Game/Precompiled.hpp"
+#include "Game/Snapshot.hpp"
+using namespace Game;
+
+namespace
+{
+    using SectionSize = uint64_t;
+}
+
+SnapshotWriter::SnapshotWriter() = default;
+SnapshotWriter::~SnapshotWriter() = default;
+
+void SnapshotWriter::WriteBytes(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    m_data.insert(m_data.end(), bytes, bytes + size);
+}
+
+void SnapshotWriter::WriteString(const std::string& text)
+{
+    Write(static_cast<uint32_t>(text.size()));
+    WriteBytes(text.data(), text.size());
+}
+
+std::size_t SnapshotWriter::BeginSection(Reflection::TypeIdentifier identifier)
+{
+    // Section size is patched once its contents are written.
+    Write(identifier);
+    Write(SectionSize(0));
+    return m_data.size();
+}
+
+void SnapshotWriter::EndSection(std::size_t sectionOffset)
+{
+    ASSERT(sectionOffset >= sizeof(SectionSize) && sectionOffset <= m_data.size(),
+        "Invalid snapshot section offset!");
+
+    const SectionSize sectionSize = m_data.size() - sectionOffset;
+    std::memcpy(m_data.data() + sectionOffset - sizeof(SectionSize),
+        &sectionSize, sizeof(SectionSize));
+}
+
+void SnapshotWriter::Reset()
+{
+    m_data.clear();
+}
+
+SnapshotReader::SnapshotReader(const uint8_t* data, std::size_t size) :
+    m_data(data), m_size(size)
+{
+    ASSERT(data != nullptr || size == 0, "Invalid snapshot data!");
+}
+
+SnapshotReader::SnapshotReader(const std::vector<uint8_t>& data) :
+    m_data(data.data()), m_size(data.size())
+{
+}
+
+SnapshotReader::~SnapshotReader() = default;
+
+bool SnapshotReader::ReadBytes(void* data, std::size_t size)
+{
+    if(!m_valid || size > m_size - m_offset)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    if(size != 0)
+    {
+        std::memcpy(data, m_data + m_offset, size);
+        m_offset += size;
+    }
+
+    return true;
+}
+
+bool SnapshotReader::ReadString(std::string& text)
+{
+    uint32_t length = 0;
+    if(!Read(length) || length > m_size - m_offset)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    text.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+    m_offset += length;
+    return true;
+}
+
+bool SnapshotReader::ReadSection(Reflection::TypeIdentifier& identifier, SnapshotReader& section)
+{
+    SectionSize sectionSize = 0;
+    if(!Read(identifier) || !Read(sectionSize) || sectionSize > m_size - m_offset)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    section = SnapshotReader(m_data + m_offset, static_cast<std::size_t>(sectionSize));
+    m_offset += static_cast<std::size_t>(sectionSize);
+    return true;
+}
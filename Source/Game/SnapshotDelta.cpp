@@ -0,0 +1,97 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Game/Precompiled.hpp"
+#include "Game/SnapshotDelta.hpp"
+using namespace Game;
+
+namespace
+{
+    // Shorter runs of unchanged bytes are cheaper to send than to skip.
+    const std::size_t MinimumSkipLength = 4;
+}
+
+void SnapshotDelta::WriteBytesDelta(Common::BitWriter& writer, const uint8_t* baseline,
+    std::size_t baselineSize, const std::vector<uint8_t>& current)
+{
+    // Delta is a sequence of runs skipped from baseline followed by changed bytes.
+    const std::size_t currentSize = current.size();
+    const std::size_t commonSize = std::min(baselineSize, currentSize);
+    writer.WriteVarint(currentSize);
+
+    auto countEqualBytes = [&](std::size_t offset, std::size_t limit)
+    {
+        std::size_t count = 0;
+        while(offset + count < commonSize && count < limit &&
+            current[offset + count] == baseline[offset + count])
+        {
+            ++count;
+        }
+
+        return count;
+    };
+
+    std::size_t offset = 0;
+    while(offset < currentSize)
+    {
+        std::size_t skipLength = countEqualBytes(offset, currentSize);
+        offset += skipLength;
+
+        std::size_t copyOffset = offset;
+        while(offset < currentSize)
+        {
+            std::size_t equalLength = countEqualBytes(offset, MinimumSkipLength);
+            if(equalLength == 0)
+            {
+                ++offset;
+            }
+            else if(equalLength < MinimumSkipLength && offset + equalLength != currentSize)
+            {
+                offset += equalLength;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        writer.WriteVarint(skipLength);
+        writer.WriteVarint(offset - copyOffset);
+        writer.WriteBytes(current.data() + copyOffset, offset - copyOffset);
+    }
+}
+
+bool SnapshotDelta::ReadBytesDelta(Common::BitReader& reader, const uint8_t* baseline,
+    std::size_t baselineSize, std::vector<uint8_t>& current)
+{
+    // Changed bytes have to be present in stream, so size is limited by it.
+    uint64_t currentSize = reader.ReadVarint();
+    if(!reader.IsValid() || currentSize > baselineSize + reader.GetRemainingBitCount() / 8)
+        return false;
+
+    current.resize(static_cast<std::size_t>(currentSize));
+
+    std::size_t offset = 0;
+    while(offset < current.size())
+    {
+        uint64_t skipLength = reader.ReadVarint();
+        if(!reader.IsValid() || skipLength > std::min(baselineSize, current.size()) - std::min(offset, baselineSize))
+            return false;
+
+        std::memcpy(current.data() + offset, baseline + offset, static_cast<std::size_t>(skipLength));
+        offset += static_cast<std::size_t>(skipLength);
+
+        uint64_t copyLength = reader.ReadVarint();
+        if(!reader.IsValid() || copyLength > current.size() - offset || skipLength + copyLength == 0)
+            return false;
+
+        if(!reader.ReadBytes(current.data() + offset, static_cast<std::size_t>(copyLength)))
+            return false;
+
+        offset += static_cast<std::size_t>(copyLength);
+    }
+
+    return true;
+}
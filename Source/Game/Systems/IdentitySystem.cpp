@@ -7,6 +7,7 @@
 #include "Game/Systems/IdentitySystem.hpp"
 #include "Game/EntitySystem.hpp"
 #include "Game/GameInstance.hpp"
+#include "Game/Snapshot.hpp"
 using namespace Game;
 
 IdentitySystem::IdentitySystem()
@@ -36,6 +37,109 @@ bool IdentitySystem::OnAttach(const GameSystemStorage& gameSystems)
     return true;
 }
 
+void IdentitySystem::OnSaveSnapshot(SnapshotWriter& writer) const
+{
+    // Entries are sorted, so same identities always result in same snapshot.
+    std::vector<const EntityNameLookup::value_type*> namedEntities;
+    namedEntities.reserve(m_entityNameLookup.size());
+
+    for(const auto& entityName : m_entityNameLookup)
+    {
+        namedEntities.push_back(&entityName);
+    }
+
+    std::sort(namedEntities.begin(), namedEntities.end(),
+        [](const auto* left, const auto* right)
+        {
+            return left->first < right->first;
+        });
+
+    writer.Write(static_cast<uint64_t>(namedEntities.size()));
+    for(const auto* entityName : namedEntities)
+    {
+        writer.Write(entityName->first);
+        writer.WriteString(entityName->second);
+    }
+
+    std::vector<const EntityGroupsLookup::value_type*> groupedEntities;
+    groupedEntities.reserve(m_entityGroupsLookup.size());
+
+    for(const auto& entityGroups : m_entityGroupsLookup)
+    {
+        groupedEntities.push_back(&entityGroups);
+    }
+
+    std::sort(groupedEntities.begin(), groupedEntities.end(),
+        [](const auto* left, const auto* right)
+        {
+            return left->first < right->first;
+        });
+
+    writer.Write(static_cast<uint64_t>(groupedEntities.size()));
+    for(const auto* entityGroups : groupedEntities)
+    {
+        std::vector<std::string> groups(entityGroups->second.begin(), entityGroups->second.end());
+        std::sort(groups.begin(), groups.end());
+
+        writer.Write(entityGroups->first);
+        writer.Write(static_cast<uint64_t>(groups.size()));
+
+        for(const std::string& group : groups)
+        {
+            writer.WriteString(group);
+        }
+    }
+}
+
+bool IdentitySystem::OnRestoreSnapshot(SnapshotReader& reader)
+{
+    m_entityNameLookup.clear();
+    m_nameEntityLookup.clear();
+    m_entityGroupsLookup.clear();
+    m_groupEntitiesLookup.clear();
+
+    uint64_t namedCount = 0;
+    reader.Read(namedCount);
+
+    for(uint64_t i = 0; i < namedCount && reader.IsValid(); ++i)
+    {
+        EntityHandle entity;
+        std::string name;
+        if(reader.Read(entity) && reader.ReadString(name))
+        {
+            RegisterNamedEntity(entity, name);
+        }
+    }
+
+    uint64_t groupedCount = 0;
+    reader.Read(groupedCount);
+
+    for(uint64_t i = 0; i < groupedCount && reader.IsValid(); ++i)
+    {
+        EntityHandle entity;
+        uint64_t groupCount = 0;
+        reader.Read(entity);
+        reader.Read(groupCount);
+
+        for(uint64_t j = 0; j < groupCount && reader.IsValid(); ++j)
+        {
+            std::string group;
+            if(reader.ReadString(group))
+            {
+                RegisterGroupedEntity(entity, group);
+            }
+        }
+    }
+
+    if(!reader.IsValid())
+    {
+        LOG_ERROR("Could not restore entity identities from snapshot!");
+        return false;
+    }
+
+    return true;
+}
+
 void IdentitySystem::OnEntityDestroyed(EntityHandle entity)
 {
     UnregisterNamedEntity(entity);
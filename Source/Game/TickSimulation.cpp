@@ -0,0 +1,181 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Game/Precompiled.hpp"
+#include "Game/TickSimulation.hpp"
+#include "Game/GameInstance.hpp"
+using namespace Game;
+
+namespace
+{
+    const char* ResimulateError = "Failed to simulate ticks again! {}";
+
+    const TickSimulation::TickInput EmptyInput;
+}
+
+TickSimulation::TickSimulation() = default;
+TickSimulation::~TickSimulation() = default;
+
+TickSimulation::CreateResult TickSimulation::Create(const CreateFromParams& params)
+{
+    LOG("Creating tick simulation...");
+    LOG_SCOPED_INDENT();
+
+    // Check arguments.
+    CHECK_ARGUMENT_OR_RETURN(params.gameInstance != nullptr, Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(params.tickSeconds > 0.0f, Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(params.historyLength > 0, Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(params.snapshotInterval > 0, Common::Failure(CreateErrors::InvalidArgument));
+
+    // Create instance.
+    auto instance = std::unique_ptr<TickSimulation>(new TickSimulation());
+    instance->m_gameInstance = params.gameInstance;
+    instance->m_tickSeconds = params.tickSeconds;
+    instance->m_historyLength = params.historyLength;
+    instance->m_snapshotInterval = params.snapshotInterval;
+
+    // Keep enough snapshots to cover history rounded down to snapshot interval.
+    instance->m_snapshots.resize(params.historyLength / params.snapshotInterval + 2);
+
+    // Success!
+    return Common::Success(std::move(instance));
+}
+
+TickSimulation::RecordInputResult TickSimulation::RecordInput(TickIndex tick, TickInput input)
+{
+    if(tick < GetOldestResimulatedTick())
+        return Common::Failure(RecordInputErrors::TooOld);
+
+    if(tick >= m_currentTick + m_historyLength)
+        return Common::Failure(RecordInputErrors::TooFarAhead);
+
+    // Inputs of ticks between recorded ones are left empty.
+    while(m_inputsBeginTick + m_inputs.size() <= tick)
+    {
+        m_inputs.emplace_back();
+    }
+
+    m_inputs[static_cast<std::size_t>(tick - m_inputsBeginTick)] = std::move(input);
+
+    // Simulated tick has been using predicted input so far.
+    if(tick < m_currentTick)
+    {
+        m_pendingTick = m_pendingResimulation ? std::min(m_pendingTick, tick) : tick;
+        m_pendingResimulation = true;
+    }
+
+    return Common::Success();
+}
+
+void TickSimulation::Advance()
+{
+    SimulateTick(true);
+
+    // Discard inputs that cannot be simulated again, which starts
+    // from snapshot saved before oldest tick that can be simulated.
+    TickIndex oldestTick = GetOldestResimulatedTick();
+    oldestTick -= oldestTick % m_snapshotInterval;
+
+    while(m_inputsBeginTick < oldestTick && !m_inputs.empty())
+    {
+        m_inputs.pop_front();
+        ++m_inputsBeginTick;
+    }
+
+    m_inputsBeginTick = std::max(m_inputsBeginTick, oldestTick);
+}
+
+TickSimulation::ResimulateResult TickSimulation::Resimulate(TickIndex tick)
+{
+    m_pendingResimulation = false;
+
+    if(tick >= m_currentTick)
+        return Common::Success(0u);
+
+    // Find snapshot saved before given tick.
+    const TickIndex snapshotTick = tick - tick % m_snapshotInterval;
+    const TickSnapshot& snapshot = m_snapshots[(snapshotTick / m_snapshotInterval) % m_snapshots.size()];
+
+    if(tick < GetOldestResimulatedTick() || !snapshot.valid || snapshot.tick != snapshotTick)
+    {
+        LOG_WARNING(ResimulateError, "Tick is too old.");
+        return Common::Failure(ResimulateErrors::TooOld);
+    }
+
+    SnapshotReader snapshotReader(snapshot.writer.GetData());
+    if(!m_gameInstance->RestoreSnapshot(snapshotReader))
+    {
+        LOG_ERROR(ResimulateError, "Could not restore snapshot.");
+        return Common::Failure(ResimulateErrors::FailedRestore);
+    }
+
+    // Simulate ticks again in tight loop, snapshot that
+    // has just been restored does not have to be saved again.
+    const TickIndex targetTick = m_currentTick;
+    m_currentTick = snapshotTick;
+
+    SimulateTick(false);
+    while(m_currentTick < targetTick)
+    {
+        SimulateTick(true);
+    }
+
+    return Common::Success(static_cast<uint32_t>(targetTick - snapshotTick));
+}
+
+TickSimulation::ResimulateResult TickSimulation::ResimulatePending()
+{
+    if(!m_pendingResimulation)
+        return Common::Success(0u);
+
+    return Resimulate(m_pendingTick);
+}
+
+void TickSimulation::SimulateTick(bool saveSnapshot)
+{
+    ASSERT(m_gameInstance != nullptr, "Game instance cannot be null!");
+
+    // Save world state from before tick, so it can be simulated again.
+    if(saveSnapshot && m_currentTick % m_snapshotInterval == 0)
+    {
+        TickSnapshot& snapshot = m_snapshots[(m_currentTick / m_snapshotInterval) % m_snapshots.size()];
+        snapshot.writer.Reset();
+        m_gameInstance->SaveSnapshot(snapshot.writer);
+        snapshot.tick = m_currentTick;
+        snapshot.valid = true;
+    }
+
+    events.applyInput.Dispatch(*m_gameInstance, m_currentTick, GetInput(m_currentTick));
+    m_gameInstance->Tick(m_tickSeconds);
+    ++m_currentTick;
+}
+
+const TickSimulation::TickInput& TickSimulation::GetInput(TickIndex tick) const
+{
+    if(tick < m_inputsBeginTick || tick - m_inputsBeginTick >= m_inputs.size())
+        return EmptyInput;
+
+    return m_inputs[static_cast<std::size_t>(tick - m_inputsBeginTick)];
+}
+
+TickSimulation::TickIndex TickSimulation::GetCurrentTick() const
+{
+    return m_currentTick;
+}
+
+TickSimulation::TickIndex TickSimulation::GetOldestResimulatedTick() const
+{
+    return m_currentTick > m_historyLength ? m_currentTick - m_historyLength : 0;
+}
+
+float TickSimulation::GetTickSeconds() const
+{
+    return m_tickSeconds;
+}
+
+bool TickSimulation::HasPendingResimulation() const
+{
+    return m_pendingResimulation;
+}
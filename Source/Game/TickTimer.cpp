@@ -42,6 +42,9 @@ void TickTimer::Reset()
     m_forwardTickTimeUnits = m_timer->GetCurrentTimeUnits();
     m_totalTickTimeUnits = 0;
     m_lastTickSeconds = 0.0f;
+    m_delayedTickTimeUnits = 0;
+    m_frameTicks = 0;
+    m_frameThrottled = false;
 }
 
 void TickTimer::SetTickSeconds(float tickTime)
@@ -49,9 +52,29 @@ void TickTimer::SetTickSeconds(float tickTime)
     m_tickSeconds = tickTime;
 }
 
+void TickTimer::SetMaxFrameTicks(uint32_t maxFrameTicks)
+{
+    m_maxFrameTicks = maxFrameTicks;
+}
+
+void TickTimer::SetCatchUpPolicy(CatchUpPolicy policy)
+{
+    m_catchUpPolicy = policy;
+}
+
 void TickTimer::Advance(const Timer& timer)
 {
     m_timer->Advance(timer);
+
+    // Ticks are delayed only until frame that is not throttled.
+    if(!m_frameThrottled)
+    {
+        m_delayedTickTimeUnits = 0;
+    }
+
+    // Start counting ticks of new frame.
+    m_frameTicks = 0;
+    m_frameThrottled = false;
 }
 
 bool TickTimer::Tick()
@@ -61,31 +84,85 @@ bool TickTimer::Tick()
 
     // Do not allow forward tick counter to fall behind the previous tick time.
     // This allows timer with capped delta time to prevent a large number of ticks.
-    m_forwardTickTimeUnits = std::max(m_timer->GetPreviousTimeUnits(), m_forwardTickTimeUnits);
+    // Ticks delayed in previous frame are kept, as they are still due.
+    const TimeUnit previousTimeUnits = m_timer->GetPreviousTimeUnits();
+    m_forwardTickTimeUnits = std::max(previousTimeUnits > m_delayedTickTimeUnits ?
+        previousTimeUnits - m_delayedTickTimeUnits : TimeUnit(0), m_forwardTickTimeUnits);
+
+    // Wait until we have enough time accumulated.
+    // Return false to indicate that tick did not occur.
+    if(m_timer->GetCurrentTimeUnits() < m_forwardTickTimeUnits)
+        return false;
 
-    // Check if we should perform a tick.
-    if(m_timer->GetCurrentTimeUnits() >= m_forwardTickTimeUnits)
+    // Apply catch up policy to ticks that exceed limit of ticks per frame.
+    uint64_t tickCount = 1;
+    if(m_maxFrameTicks != 0 && m_frameTicks + 1 >= m_maxFrameTicks)
     {
-        // Move tick counter forward.
-        m_forwardTickTimeUnits += tickUnits;
+        const uint64_t dueTicks = GetDueTicks(tickUnits);
+
+        if(m_frameTicks >= m_maxFrameTicks)
+        {
+            if(!m_frameThrottled)
+            {
+                m_metrics.throttledFrames++;
+                m_frameThrottled = true;
+
+                if(m_catchUpPolicy == CatchUpPolicy::Delay)
+                {
+                    m_delayedTickTimeUnits = m_timer->GetCurrentTimeUnits() - m_forwardTickTimeUnits;
+                    m_metrics.delayedTicks += dueTicks;
+                }
+            }
+
+            if(m_catchUpPolicy == CatchUpPolicy::Skip)
+            {
+                m_forwardTickTimeUnits += tickUnits * static_cast<TimeUnit>(dueTicks);
+                m_metrics.skippedTicks += dueTicks;
+            }
+
+            return false;
+        }
+
+        if(m_catchUpPolicy == CatchUpPolicy::Stretch && dueTicks > 1)
+        {
+            tickCount = dueTicks;
+            m_metrics.stretchedTicks += dueTicks - 1;
+            m_metrics.throttledFrames++;
+            m_frameThrottled = true;
+        }
+    }
 
-        // Track total time of all ticks.
-        m_totalTickTimeUnits += tickUnits;
+    // Move tick counter forward.
+    m_forwardTickTimeUnits += tickUnits * static_cast<TimeUnit>(tickCount);
 
-        // Save last successful tick time.
-        m_lastTickSeconds = m_tickSeconds;
+    // Track total time of all ticks.
+    m_totalTickTimeUnits += tickUnits * static_cast<TimeUnit>(tickCount);
 
-        // Signal successful tick.
-        return true;
-    }
+    // Save last successful tick time.
+    m_lastTickSeconds = m_tickSeconds * static_cast<float>(tickCount);
 
-    // Wait until we have enough time accumulated.
-    // Return false to indicate that tick did not occur.
-    return false;
+    // Track ticks processed in this frame.
+    m_frameTicks++;
+    m_metrics.processedTicks++;
+    m_metrics.maxFrameTicks = std::max(m_metrics.maxFrameTicks, m_frameTicks);
+
+    // Signal successful tick.
+    return true;
+}
+
+uint64_t TickTimer::GetDueTicks(TimeUnit tickUnits) const
+{
+    // Count ticks whose time has already passed, including current one.
+    ASSERT(m_timer->GetCurrentTimeUnits() >= m_forwardTickTimeUnits, "No ticks are due!");
+    return static_cast<uint64_t>((m_timer->GetCurrentTimeUnits() - m_forwardTickTimeUnits) / tickUnits) + 1;
 }
 
 float TickTimer::GetAlphaSeconds() const
 {
+    // Ticks that were delayed to next frame are still due.
+    if(m_forwardTickTimeUnits <= m_timer->GetCurrentTimeUnits())
+        return 1.0f;
+
     // Calculate accumulated time units since the last tick.
     TimeUnit accumulatedTickUnits = m_forwardTickTimeUnits - m_timer->GetCurrentTimeUnits();
     ASSERT(accumulatedTickUnits >= 0, "Accumulated tick units cannot be negative!");
@@ -113,3 +190,23 @@ float TickTimer::GetLastTickSeconds() const
 {
     return m_lastTickSeconds;
 }
+
+uint32_t TickTimer::GetMaxFrameTicks() const
+{
+    return m_maxFrameTicks;
+}
+
+TickTimer::CatchUpPolicy TickTimer::GetCatchUpPolicy() const
+{
+    return m_catchUpPolicy;
+}
+
+const TickTimer::Metrics& TickTimer::GetMetrics() const
+{
+    return m_metrics;
+}
+
+void TickTimer::ResetMetrics()
+{
+    m_metrics = Metrics();
+}
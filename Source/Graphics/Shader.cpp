@@ -277,3 +277,10 @@ GLuint Shader::GetHandle() const
 {
     return m_handle;
 }
+
+void Shader::Swap(Shader& other)
+{
+    // Used to replace program of shader that has been reloaded.
+    ASSERT(m_renderContext == other.m_renderContext, "Swapped shaders belong to different render contexts!");
+    std::swap(m_handle, other.m_handle);
+}
@@ -49,6 +49,18 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create()
 }
 
 SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle& file, const LoadFromFile& params)
+{
+    // Parse resource file and create instance right away.
+    auto prepareResult = Prepare(file, params);
+    if(!prepareResult)
+    {
+        return Common::Failure(prepareResult.UnwrapFailure());
+    }
+
+    return Create(prepareResult.Unwrap(), params);
+}
+
+SpriteAnimationList::PrepareResult SpriteAnimationList::Prepare(System::FileHandle& file, const LoadFromFile& params)
 {
     LOG("Loading sprite animation list from \"{}\" file...", file.GetPath().generic_string());
     LOG_SCOPED_INDENT();
@@ -56,18 +68,73 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
     // Validate arguments.
     CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
 
-    // Acquire engine systems.
-    auto* resourceManager = params.engineSystems->Locate<System::ResourceManager>();
+    // Check whether resource file is cooked or script.
+    uint32_t magic = 0;
+    bool isCooked = file.Read(magic) && magic == CookedFormat::AnimationMagic;
+    file.Seek(0);
 
-    // Create base instance.
-    auto createResult = Create();
-    if(!createResult)
+    return isCooked ? PrepareCooked(file) : PrepareScript(file, params);
+}
+
+SpriteAnimationList::PrepareResult SpriteAnimationList::PrepareCooked(System::FileHandle& file)
+{
+    PreparedData prepared;
+
+    // Read cooked file straight from memory if possible.
+    std::vector<uint8_t> buffer;
+    System::FileHandle::MappedView view = file.MapOrRead(buffer);
+
+    CookedFormat::AnimationHeader header;
+    if(view.size < sizeof(header))
     {
-        LOG_ERROR("Could not create base instance!");
-        return createResult;
+        LOG_ERROR("Cooked sprite animation list header is missing!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
     }
 
-    auto instance = createResult.Unwrap();
+    std::memcpy(&header, view.data, sizeof(header));
+
+    const uint64_t animationsSize = uint64_t(header.animationCount) * sizeof(PreparedAnimation);
+    const uint64_t framesSize = uint64_t(header.frameCount) * sizeof(PreparedFrame);
+    if(header.version != CookedFormat::Version || view.size !=
+        sizeof(header) + animationsSize + framesSize + header.textureAtlasPathLength)
+    {
+        LOG_ERROR("Cooked sprite animation list has invalid version or size!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    // Animations and frames are stored in same layout, so they are copied all at once.
+    const uint8_t* data = view.data + sizeof(header);
+
+    prepared.animations.resize(header.animationCount);
+    std::memcpy(prepared.animations.data(), data, animationsSize);
+    data += animationsSize;
+
+    prepared.frames.resize(header.frameCount);
+    std::memcpy(prepared.frames.data(), data, framesSize);
+    data += framesSize;
+
+    for(const PreparedAnimation& animation : prepared.animations)
+    {
+        if(uint64_t(animation.firstFrame) + animation.frameCount > header.frameCount)
+        {
+            LOG_ERROR("Cooked sprite animation list has invalid frame range!");
+            return Common::Failure(CreateErrors::InvalidResourceContents);
+        }
+    }
+
+    // Resolve texture atlas path relative to resource file.
+    std::string_view textureAtlasPath(reinterpret_cast<const char*>(data), header.textureAtlasPathLength);
+
+    fs::path filePath = file.GetPath();
+    prepared.textureAtlasPath = (filePath.remove_filename() / textureAtlasPath).lexically_normal();
+
+    // Success!
+    return Common::Success(std::move(prepared));
+}
+
+SpriteAnimationList::PrepareResult SpriteAnimationList::PrepareScript(System::FileHandle& file, const LoadFromFile& params)
+{
+    PreparedData prepared;
 
     // Load resource script.
     Script::ScriptState::LoadFromFile resourceParams;
@@ -93,9 +160,7 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
         return Common::Failure(CreateErrors::InvalidResourceContents);
     }
 
-    // Load texture atlas.
-    std::shared_ptr<TextureAtlas> textureAtlas;
-
+    // Read texture atlas path.
     {
         lua_getfield(*resourceScript, -1, "TextureAtlas");
         SCOPE_GUARD([&resourceScript]
@@ -109,19 +174,10 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
             return Common::Failure(CreateErrors::InvalidResourceContents);
         }
 
-        std::filesystem::path textureAtlasPath = lua_tostring(*resourceScript, -1);
-
-        TextureAtlas::LoadFromFile textureAtlasParams;
-        textureAtlasParams.engineSystems = params.engineSystems;
-
-        textureAtlas = resourceManager->AcquireRelative<TextureAtlas>(
-            textureAtlasPath, file.GetPath(), textureAtlasParams).UnwrapOr(nullptr);
-
-        if(textureAtlas == nullptr)
-        {
-            LOG_ERROR("Could not load referenced texture atlas!");
-            return Common::Failure(CreateErrors::FailedResourceLoading);
-        }
+        // Resolve texture atlas path relative to resource file.
+        fs::path filePath = file.GetPath();
+        prepared.textureAtlasPath = (filePath.remove_filename() /
+            lua_tostring(*resourceScript, -1)).lexically_normal();
     }
 
     // Read animation entries.
@@ -149,9 +205,11 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
 
         std::string animationName = lua_tostring(*resourceScript, -2);
 
-        // Read animation frames.
-        Animation animation;
+        PreparedAnimation animation;
+        animation.nameHash = CookedFormat::HashName(animationName);
+        animation.firstFrame = Common::NumericalCast<uint32_t>(prepared.frames.size());
 
+        // Read animation frames.
         for(lua_pushnil(*resourceScript); lua_next(*resourceScript, -2); lua_pop(*resourceScript, 1))
         {
             // Make sure that we have a table.
@@ -162,9 +220,9 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
                 continue;
             }
 
-            // Get sequence frame.
-            TextureView textureView;
+            PreparedFrame frame;
 
+            // Get sequence frame.
             {
                 lua_pushinteger(*resourceScript, 1);
                 lua_gettable(*resourceScript, -2);
@@ -180,12 +238,10 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
                     continue;
                 }
 
-                textureView = textureAtlas->GetRegion(lua_tostring(*resourceScript, -1));
+                frame.regionHash = CookedFormat::HashName(lua_tostring(*resourceScript, -1));
             }
 
             // Get frame duration.
-            float frameDuration = 0.0f;
-
             {
                 lua_pushinteger(*resourceScript, 2);
                 lua_gettable(*resourceScript, -2);
@@ -201,17 +257,132 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
                     continue;
                 }
 
-                frameDuration = (float)lua_tonumber(*resourceScript, -1);
+                frame.duration = (float)lua_tonumber(*resourceScript, -1);
             }
 
             // Add frame to animation.
-            animation.frames.emplace_back(std::move(textureView), frameDuration);
-            animation.duration += frameDuration;
+            prepared.frames.push_back(frame);
+            animation.frameCount++;
         }
 
         // Add animation to list.
+        prepared.animations.push_back(animation);
+    }
+
+    // Sort animations by their name hashes, same as in cooked files.
+    std::sort(prepared.animations.begin(), prepared.animations.end(),
+        [](const PreparedAnimation& left, const PreparedAnimation& right)
+        {
+            return left.nameHash < right.nameHash;
+        });
+
+    auto collisionIt = std::unique(prepared.animations.begin(), prepared.animations.end(),
+        [](const PreparedAnimation& left, const PreparedAnimation& right)
+        {
+            return left.nameHash == right.nameHash;
+        });
+
+    if(collisionIt != prepared.animations.end())
+    {
+        LOG_WARNING("Removing {} animations with colliding name hashes!",
+            std::distance(collisionIt, prepared.animations.end()));
+        prepared.animations.erase(collisionIt, prepared.animations.end());
+    }
+
+    // Success!
+    return Common::Success(std::move(prepared));
+}
+
+void SpriteAnimationList::AcquireDependencies(System::ResourceDependencies& dependencies,
+    const PreparedData& prepared, const LoadFromFile& params)
+{
+    // Start loading texture atlas ahead of creation.
+    TextureAtlas::LoadFromFile textureAtlasParams;
+    textureAtlasParams.engineSystems = params.engineSystems;
+
+    dependencies.Acquire<TextureAtlas>(prepared.textureAtlasPath, textureAtlasParams);
+}
+
+std::vector<uint8_t> SpriteAnimationList::Cook(const PreparedData& prepared, const fs::path& filePath)
+{
+    // Store texture atlas path relative to resource file, same as in script.
+    std::string textureAtlasPath = prepared.textureAtlasPath.lexically_relative(
+        filePath.parent_path()).generic_string();
+
+    CookedFormat::AnimationHeader header;
+    header.animationCount = Common::NumericalCast<uint32_t>(prepared.animations.size());
+    header.frameCount = Common::NumericalCast<uint32_t>(prepared.frames.size());
+    header.textureAtlasPathLength = Common::NumericalCast<uint32_t>(textureAtlasPath.size());
+
+    const std::size_t animationsSize = prepared.animations.size() * sizeof(PreparedAnimation);
+    const std::size_t framesSize = prepared.frames.size() * sizeof(PreparedFrame);
+
+    std::vector<uint8_t> bytes(sizeof(header) + animationsSize + framesSize + textureAtlasPath.size());
+    uint8_t* data = bytes.data();
+
+    std::memcpy(data, &header, sizeof(header));
+    data += sizeof(header);
+
+    std::memcpy(data, prepared.animations.data(), animationsSize);
+    data += animationsSize;
+
+    std::memcpy(data, prepared.frames.data(), framesSize);
+    data += framesSize;
+
+    std::memcpy(data, textureAtlasPath.data(), textureAtlasPath.size());
+    return bytes;
+}
+
+SpriteAnimationList::CreateResult SpriteAnimationList::Create(PreparedData&& prepared, const LoadFromFile& params)
+{
+    // Validate arguments.
+    CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
+
+    // Acquire engine systems.
+    auto* resourceManager = params.engineSystems->Locate<System::ResourceManager>();
+
+    // Create base instance.
+    auto createResult = Create();
+    if(!createResult)
+    {
+        LOG_ERROR("Could not create base instance!");
+        return createResult;
+    }
+
+    auto instance = createResult.Unwrap();
+
+    // Acquire texture atlas, which is already loaded if acquired as dependency.
+    TextureAtlas::LoadFromFile textureAtlasParams;
+    textureAtlasParams.engineSystems = params.engineSystems;
+
+    std::shared_ptr<TextureAtlas> textureAtlas = resourceManager->Acquire<TextureAtlas>(
+        prepared.textureAtlasPath, textureAtlasParams).UnwrapOr(nullptr);
+
+    if(textureAtlas == nullptr)
+    {
+        LOG_ERROR("Could not load referenced texture atlas!");
+        return Common::Failure(CreateErrors::FailedResourceLoading);
+    }
+
+    // Resolve animation frames to texture atlas regions.
+    instance->m_animationList.reserve(prepared.animations.size());
+    instance->m_animationMap.reserve(prepared.animations.size());
+
+    for(const PreparedAnimation& preparedAnimation : prepared.animations)
+    {
+        Animation animation;
+        animation.frames.reserve(preparedAnimation.frameCount);
+
+        for(uint32_t i = 0; i < preparedAnimation.frameCount; ++i)
+        {
+            const PreparedFrame& preparedFrame = prepared.frames[preparedAnimation.firstFrame + i];
+            animation.frames.emplace_back(textureAtlas->GetRegion(
+                preparedFrame.regionHash), preparedFrame.duration);
+            animation.duration += preparedFrame.duration;
+        }
+
         instance->m_animationList.emplace_back(std::move(animation));
-        instance->m_animationMap.emplace(animationName,
+        instance->m_animationMap.emplace(preparedAnimation.nameHash,
             Common::NumericalCast<uint32_t>(instance->m_animationList.size() - 1));
     }
 
@@ -219,9 +390,21 @@ SpriteAnimationList::CreateResult SpriteAnimationList::Create(System::FileHandle
     return Common::Success(std::move(instance));
 }
 
-SpriteAnimationList::AnimationIndexResult SpriteAnimationList::GetAnimationIndex(std::string animationName) const
+bool SpriteAnimationList::AddAnimation(std::string_view animationName, Animation&& animation)
+{
+    // Animation names must be unique.
+    uint64_t nameHash = CookedFormat::HashName(animationName);
+    if(m_animationMap.find(nameHash) != m_animationMap.end())
+        return false;
+
+    m_animationList.emplace_back(std::move(animation));
+    m_animationMap.emplace(nameHash, Common::NumericalCast<uint32_t>(m_animationList.size() - 1));
+    return true;
+}
+
+SpriteAnimationList::AnimationIndexResult SpriteAnimationList::GetAnimationIndex(std::string_view animationName) const
 {
-    auto it = m_animationMap.find(animationName);
+    auto it = m_animationMap.find(CookedFormat::HashName(animationName));
     if(it == m_animationMap.end())
     {
         return Common::Failure();
@@ -239,3 +422,39 @@ const SpriteAnimationList::Animation* SpriteAnimationList::GetAnimationByIndex(s
     // Return animation pointed by index.
     return isIndexValid ? &m_animationList[animationIndex] : nullptr;
 }
+
+const SpriteAnimationList::Animation* SpriteAnimationList::GetAnimationByHash(uint64_t nameHash) const
+{
+    // Animation may no longer exist after list has been reloaded.
+    auto it = m_animationMap.find(nameHash);
+    if(it == m_animationMap.end())
+        return nullptr;
+
+    return &m_animationList[it->second];
+}
+
+void SpriteAnimationList::Swap(SpriteAnimationList& other)
+{
+    // Used to replace contents of animation list that has been reloaded.
+    std::swap(m_animationList, other.m_animationList);
+    std::swap(m_animationMap, other.m_animationMap);
+}
+
+System::ResourceMemoryUsage SpriteAnimationList::GetMemoryUsage() const
+{
+    // Referenced texture atlas is accounted for by its own resource pool.
+    System::ResourceMemoryUsage memoryUsage;
+    memoryUsage.cpuBytes = sizeof(SpriteAnimationList);
+
+    for(const Animation& animation : m_animationList)
+    {
+        memoryUsage.cpuBytes += sizeof(Animation) + animation.frames.capacity() * sizeof(Frame);
+    }
+
+    for(const auto& animationEntry : m_animationMap)
+    {
+        memoryUsage.cpuBytes += sizeof(animationEntry);
+    }
+
+    return memoryUsage;
+}
@@ -5,12 +5,93 @@
 
 #include "Graphics/Precompiled.hpp"
 #include "Graphics/Texture.hpp"
+#include "Graphics/TextureCompression.hpp"
 #include "Graphics/RenderContext.hpp"
 #include <Core/SystemStorage.hpp>
 #include <System/FileSystem/FileHandle.hpp>
 #include <System/Image.hpp>
 using namespace Graphics;
 
+namespace
+{
+    using TextureFormat = CookedFormat::TextureFormat;
+
+    constexpr uint32_t MaxTextureSize = 1 << 16;
+
+    bool IsCompressedFormat(GLenum format)
+    {
+        switch(format)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    std::size_t GetBytesPerPixel(GLenum format)
+    {
+        switch(format)
+        {
+        case GL_RED:
+            return 1;
+
+        case GL_RG:
+            return 2;
+
+        case GL_RGB:
+            return 3;
+
+        case GL_RGBA:
+            return 4;
+
+        default:
+            return 0;
+        }
+    }
+
+    GLenum GetTextureFormat(TextureFormat format)
+    {
+        switch(format)
+        {
+        case TextureFormat::R8:
+            return GL_RED;
+
+        case TextureFormat::RG8:
+            return GL_RG;
+
+        case TextureFormat::RGB8:
+            return GL_RGB;
+
+        case TextureFormat::RGBA8:
+            return GL_RGBA;
+
+        case TextureFormat::BC1:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+
+        case TextureFormat::BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+        case TextureFormat::ETC2RGB8:
+            return GL_COMPRESSED_RGB8_ETC2;
+
+        case TextureFormat::ETC2RGBA8:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+
+        case TextureFormat::ASTC4x4:
+            return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+
+        default:
+            return OpenGL::InvalidEnum;
+        }
+    }
+}
+
 Texture::Texture() = default;
 
 Texture::~Texture()
@@ -31,6 +112,8 @@ Texture::CreateResult Texture::Create(const CreateFromParams& params)
     CHECK_ARGUMENT_OR_RETURN(params.width > 0, Common::Failure(CreateErrors::InvalidArgument));
     CHECK_ARGUMENT_OR_RETURN(params.height > 0, Common::Failure(CreateErrors::InvalidArgument));
     CHECK_ARGUMENT_OR_RETURN(params.format != OpenGL::InvalidEnum, Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(!IsCompressedFormat(params.format) || !params.levels.empty(),
+        Common::Failure(CreateErrors::InvalidArgument));
 
     auto instance = std::unique_ptr<Texture>(new Texture());
 
@@ -52,7 +135,8 @@ Texture::CreateResult Texture::Create(const CreateFromParams& params)
             params.renderContext->GetState().GetTextureBinding(GL_TEXTURE_2D));
     });
 
-    if(params.format == GL_RED)
+    const bool isCompressed = IsCompressedFormat(params.format);
+    if(params.format != GL_RGBA && !isCompressed)
     {
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         OpenGL::CheckErrors();
@@ -64,12 +148,49 @@ Texture::CreateResult Texture::Create(const CreateFromParams& params)
             params.renderContext->GetState().GetPixelStore(GL_UNPACK_ALIGNMENT));
     });
 
-    glTexImage2D(GL_TEXTURE_2D, 0, params.format, params.width, params.height,
-        0, params.format, GL_UNSIGNED_BYTE, params.data);
+    std::size_t gpuBytes = 0;
+    if(params.levels.empty())
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, params.format, params.width, params.height,
+            0, params.format, GL_UNSIGNED_BYTE, params.data);
+        OpenGL::CheckErrors();
+
+        gpuBytes = static_cast<std::size_t>(params.width) * params.height * GetBytesPerPixel(params.format);
 
-    if(params.mipmaps)
+        if(params.mipmaps)
+        {
+            glGenerateMipmap(GL_TEXTURE_2D);
+            OpenGL::CheckErrors();
+
+            // Full mipmap chain adds up to one third of base level size.
+            gpuBytes += gpuBytes / 3;
+        }
+    }
+    else
     {
-        glGenerateMipmap(GL_TEXTURE_2D);
+        // Upload precomputed mip levels, with texture limited to levels provided.
+        for(std::size_t level = 0; level < params.levels.size(); ++level)
+        {
+            const MipLevel& mipLevel = params.levels[level];
+            GLsizei levelWidth = std::max(params.width >> level, 1);
+            GLsizei levelHeight = std::max(params.height >> level, 1);
+
+            if(isCompressed)
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, params.format, levelWidth,
+                    levelHeight, 0, (GLsizei)mipLevel.size, mipLevel.data);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, (GLint)level, params.format, levelWidth,
+                    levelHeight, 0, params.format, GL_UNSIGNED_BYTE, mipLevel.data);
+            }
+
+            OpenGL::CheckErrors();
+            gpuBytes += mipLevel.size;
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)params.levels.size() - 1);
         OpenGL::CheckErrors();
     }
 
@@ -77,17 +198,38 @@ Texture::CreateResult Texture::Create(const CreateFromParams& params)
     instance->m_format = params.format;
     instance->m_width = params.width;
     instance->m_height = params.height;
+    instance->m_gpuBytes = gpuBytes;
 
     return Common::Success(std::move(instance));
 }
 
 Texture::CreateResult Texture::Create(System::FileHandle& file, const LoadFromFile& params)
+{
+    auto prepareResult = Prepare(file, params);
+    if(!prepareResult)
+    {
+        return Common::Failure(prepareResult.UnwrapFailure());
+    }
+
+    return Create(prepareResult.Unwrap(), params);
+}
+
+Texture::PrepareResult Texture::Prepare(System::FileHandle& file, const LoadFromFile& params)
 {
     LOG("Loading texture from \"{}\" file...", file.GetPath().generic_string());
     LOG_SCOPED_INDENT();
 
     CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
-    auto* renderContext = params.engineSystems->Locate<Graphics::RenderContext>();
+
+    // Check whether texture file is cooked or image.
+    uint32_t magic = 0;
+    bool isCooked = file.Read(magic) && magic == CookedFormat::TextureMagic;
+    file.Seek(0);
+
+    if(isCooked)
+    {
+        return PrepareCooked(file);
+    }
 
     auto image = System::Image::Create(file, System::Image::LoadFromFile()).UnwrapOr(nullptr);
     if(image == nullptr)
@@ -95,9 +237,85 @@ Texture::CreateResult Texture::Create(System::FileHandle& file, const LoadFromFi
         LOG_ERROR("Could not create image from file!");
         return Common::Failure(CreateErrors::FailedImageLoad);
     }
-    
+
+    PreparedData prepared;
+    prepared.image = std::move(image);
+    return Common::Success(std::move(prepared));
+}
+
+Texture::PrepareResult Texture::PrepareCooked(System::FileHandle& file)
+{
+    PreparedData prepared;
+    prepared.cookedData = file.ReadAsBinaryArray();
+    const std::vector<uint8_t>& data = prepared.cookedData;
+
+    // Validate header, so level sizes can be checked against texture format.
+    CookedFormat::TextureHeader header;
+    if(data.size() < sizeof(header))
+    {
+        LOG_ERROR("Cooked texture header is missing!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if(header.version != CookedFormat::Version ||
+        header.format == TextureFormat::Unknown || header.format > TextureFormat::ASTC4x4 ||
+        header.width == 0 || header.width > MaxTextureSize ||
+        header.height == 0 || header.height > MaxTextureSize)
+    {
+        LOG_ERROR("Cooked texture has invalid version, format or size!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    prepared.format = header.format;
+    prepared.width = static_cast<int>(header.width);
+    prepared.height = static_cast<int>(header.height);
+
+    if(header.levelCount == 0 ||
+        header.levelCount > (uint32_t)TextureCompression::GetMaxLevelCount(prepared.width, prepared.height) ||
+        data.size() < sizeof(header) + header.levelCount * sizeof(CookedFormat::TextureLevel))
+    {
+        LOG_ERROR("Cooked texture has invalid mip level count!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    // Level table is stored in same layout, so it is copied all at once.
+    prepared.levels.resize(header.levelCount);
+    std::memcpy(prepared.levels.data(), data.data() + sizeof(header),
+        header.levelCount * sizeof(CookedFormat::TextureLevel));
+
+    for(std::size_t level = 0; level < prepared.levels.size(); ++level)
+    {
+        const CookedFormat::TextureLevel& textureLevel = prepared.levels[level];
+        std::size_t expectedSize = TextureCompression::GetLevelSize(prepared.format,
+            prepared.width >> level, prepared.height >> level);
+
+        if(textureLevel.size != expectedSize || textureLevel.offset > data.size() ||
+            textureLevel.size > data.size() - textureLevel.offset)
+        {
+            LOG_ERROR("Cooked texture has invalid mip level {}!", level);
+            return Common::Failure(CreateErrors::InvalidResourceContents);
+        }
+    }
+
+    return Common::Success(std::move(prepared));
+}
+
+Texture::CreateResult Texture::Create(PreparedData&& prepared, const LoadFromFile& params)
+{
+    CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
+
+    if(prepared.image == nullptr)
+    {
+        return CreateCooked(std::move(prepared), params);
+    }
+
+    auto* renderContext = params.engineSystems->Locate<Graphics::RenderContext>();
+    const System::Image& image = *prepared.image;
+
     GLenum textureFormat = GL_NONE;
-    switch(image->GetChannels())
+    switch(image.GetChannels())
     {
     case 1:
         textureFormat = GL_RED;
@@ -122,17 +340,168 @@ Texture::CreateResult Texture::Create(System::FileHandle& file, const LoadFromFi
 
     CreateFromParams createParams;
     createParams.renderContext = renderContext;
-    createParams.width = image->GetWidth();
-    createParams.height = image->GetHeight();
+    createParams.width = image.GetWidth();
+    createParams.height = image.GetHeight();
     createParams.format = textureFormat;
     createParams.mipmaps = params.mipmaps;
-    createParams.data = image->GetData();
+    createParams.data = image.GetData();
+    return Create(createParams);
+}
+
+Texture::CreateResult Texture::CreateCooked(PreparedData&& prepared, const LoadFromFile& params)
+{
+    CHECK_ARGUMENT_OR_RETURN(!prepared.levels.empty(), Common::Failure(CreateErrors::InvalidArgument));
+    auto* renderContext = params.engineSystems->Locate<Graphics::RenderContext>();
+
+    CreateFromParams createParams;
+    createParams.renderContext = renderContext;
+    createParams.width = prepared.width;
+    createParams.height = prepared.height;
+    createParams.format = GetTextureFormat(prepared.format);
+
+    // Use only base level if mipmaps were not requested.
+    const std::size_t levelCount = params.mipmaps ? prepared.levels.size() : 1;
+    for(std::size_t level = 0; level < levelCount; ++level)
+    {
+        MipLevel mipLevel;
+        mipLevel.data = prepared.cookedData.data() + prepared.levels[level].offset;
+        mipLevel.size = prepared.levels[level].size;
+        createParams.levels.push_back(mipLevel);
+    }
+
+    // Decompress blocks on CPU if device does not support them.
+    std::vector<std::vector<uint8_t>> decompressedLevels;
+    if((prepared.format == TextureFormat::BC1 || prepared.format == TextureFormat::BC3) &&
+        !GLAD_GL_EXT_texture_compression_s3tc)
+    {
+        LOG_WARNING("Decompressing texture, as S3TC compression is not supported by device!");
+
+        for(std::size_t level = 0; level < levelCount; ++level)
+        {
+            const uint8_t* blocks = static_cast<const uint8_t*>(createParams.levels[level].data);
+            int levelWidth = std::max(prepared.width >> level, 1);
+            int levelHeight = std::max(prepared.height >> level, 1);
+
+            decompressedLevels.push_back(prepared.format == TextureFormat::BC1 ?
+                TextureCompression::DecompressBC1(blocks, levelWidth, levelHeight) :
+                TextureCompression::DecompressBC3(blocks, levelWidth, levelHeight));
+
+            createParams.levels[level].data = decompressedLevels.back().data();
+            createParams.levels[level].size = decompressedLevels.back().size();
+        }
+
+        createParams.format = GL_RGBA;
+    }
+    else if(prepared.format == TextureFormat::ASTC4x4 && !GLAD_GL_KHR_texture_compression_astc_ldr)
+    {
+        LOG_ERROR("ASTC texture compression is not supported by device!");
+        return Common::Failure(CreateErrors::UnsupportedImageFormat);
+    }
+
     return Create(createParams);
 }
 
+Texture::CookResult Texture::Cook(const System::Image& image, const CookParams& params)
+{
+    // Pick uncompressed format matching image channels if not specified.
+    TextureFormat format = params.format;
+    if(format == TextureFormat::Unknown)
+    {
+        const TextureFormat channelFormats[] = { TextureFormat::R8,
+            TextureFormat::RG8, TextureFormat::RGB8, TextureFormat::RGBA8 };
+
+        if(image.GetChannels() < 1 || image.GetChannels() > 4)
+        {
+            LOG_ERROR("Unsupported number of image channels!");
+            return Common::Failure(CreateErrors::UnsupportedImageFormat);
+        }
+
+        format = channelFormats[image.GetChannels() - 1];
+    }
+
+    const bool isCompressed = TextureCompression::IsBlockCompressed(format);
+    if(isCompressed && format != TextureFormat::BC1 && format != TextureFormat::BC3)
+    {
+        LOG_ERROR("Cooking is not supported for specified texture compression format!");
+        return Common::Failure(CreateErrors::UnsupportedImageFormat);
+    }
+
+    // Block compression encodes RGBA pixels, so RGB images get opaque alpha.
+    const int channels = isCompressed ? 4 : TextureCompression::GetChannelCount(format);
+    const std::size_t pixelCount = std::size_t(image.GetWidth()) * image.GetHeight();
+
+    std::vector<uint8_t> pixels;
+    if(image.GetChannels() == channels)
+    {
+        pixels.assign(image.GetData(), image.GetData() + pixelCount * channels);
+    }
+    else if(isCompressed && image.GetChannels() == 3)
+    {
+        pixels.resize(pixelCount * 4);
+        for(std::size_t i = 0; i < pixelCount; ++i)
+        {
+            std::memcpy(&pixels[i * 4], image.GetData() + i * 3, 3);
+            pixels[i * 4 + 3] = 255;
+        }
+    }
+    else
+    {
+        LOG_ERROR("Image channels do not match texture format!");
+        return Common::Failure(CreateErrors::UnsupportedImageFormat);
+    }
+
+    // Write header and level table, followed by data of each level.
+    CookedFormat::TextureHeader header;
+    header.format = format;
+    header.width = static_cast<uint32_t>(image.GetWidth());
+    header.height = static_cast<uint32_t>(image.GetHeight());
+    header.levelCount = params.mipmaps ? TextureCompression::GetMaxLevelCount(image.GetWidth(), image.GetHeight()) : 1;
+
+    std::vector<CookedFormat::TextureLevel> levels(header.levelCount);
+    std::vector<uint8_t> bytes(sizeof(header) + levels.size() * sizeof(CookedFormat::TextureLevel));
+
+    int levelWidth = image.GetWidth();
+    int levelHeight = image.GetHeight();
+
+    for(std::size_t level = 0; level < levels.size(); ++level)
+    {
+        if(level != 0)
+        {
+            pixels = TextureCompression::GenerateMipLevel(pixels.data(), levelWidth, levelHeight, channels);
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+        }
+
+        std::vector<uint8_t> levelData;
+        switch(format)
+        {
+        case TextureFormat::BC1:
+            levelData = TextureCompression::CompressBC1(pixels.data(), levelWidth, levelHeight);
+            break;
+
+        case TextureFormat::BC3:
+            levelData = TextureCompression::CompressBC3(pixels.data(), levelWidth, levelHeight);
+            break;
+
+        default:
+            levelData = pixels;
+            break;
+        }
+
+        levels[level].offset = bytes.size();
+        levels[level].size = levelData.size();
+        bytes.insert(bytes.end(), levelData.begin(), levelData.end());
+    }
+
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), levels.data(), levels.size() * sizeof(CookedFormat::TextureLevel));
+    return Common::Success(std::move(bytes));
+}
+
 void Texture::Update(const void* data)
 {
     ASSERT_ALWAYS_ARGUMENT(data != nullptr);
+    ASSERT(!IsCompressedFormat(m_format), "Compressed texture cannot be updated!");
 
     glBindTexture(GL_TEXTURE_2D, m_handle);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, m_format, GL_UNSIGNED_BYTE, data);
@@ -154,3 +523,22 @@ int Texture::GetHeight() const
 {
     return m_height;
 }
+
+void Texture::Swap(Texture& other)
+{
+    // Used to replace contents of texture that has been reloaded.
+    ASSERT(m_renderContext == other.m_renderContext, "Swapped textures belong to different render contexts!");
+    std::swap(m_handle, other.m_handle);
+    std::swap(m_format, other.m_format);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    std::swap(m_gpuBytes, other.m_gpuBytes);
+}
+
+System::ResourceMemoryUsage Texture::GetMemoryUsage() const
+{
+    System::ResourceMemoryUsage memoryUsage;
+    memoryUsage.cpuBytes = sizeof(Texture);
+    memoryUsage.gpuBytes = m_gpuBytes;
+    return memoryUsage;
+}
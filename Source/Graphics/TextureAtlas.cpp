@@ -13,6 +13,27 @@
 #include <Script/ScriptState.hpp>
 using namespace Graphics;
 
+namespace
+{
+    struct RegionHashCompare
+    {
+        bool operator()(const TextureAtlas::Region& region, uint64_t nameHash) const
+        {
+            return region.nameHash < nameHash;
+        }
+
+        bool operator()(uint64_t nameHash, const TextureAtlas::Region& region) const
+        {
+            return nameHash < region.nameHash;
+        }
+    };
+
+    bool CompareRegions(const TextureAtlas::Region& left, const TextureAtlas::Region& right)
+    {
+        return left.nameHash < right.nameHash;
+    }
+}
+
 TextureAtlas::TextureAtlas() = default;
 TextureAtlas::~TextureAtlas() = default;
 
@@ -27,6 +48,18 @@ TextureAtlas::CreateResult TextureAtlas::Create()
 }
 
 TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const LoadFromFile& params)
+{
+    // Parse resource file and create instance right away.
+    auto prepareResult = Prepare(file, params);
+    if(!prepareResult)
+    {
+        return Common::Failure(prepareResult.UnwrapFailure());
+    }
+
+    return Create(prepareResult.Unwrap(), params);
+}
+
+TextureAtlas::PrepareResult TextureAtlas::Prepare(System::FileHandle& file, const LoadFromFile& params)
 {
     LOG("Loading texture atlas from \"{}\" file...", file.GetPath().generic_string());
     LOG_SCOPED_INDENT();
@@ -34,18 +67,67 @@ TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const
     // Validate parameters.
     CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
 
-    // Acquire engine systems.
-    auto* resourceManager = params.engineSystems->Locate<System::ResourceManager>();
+    // Check whether resource file is cooked or script.
+    uint32_t magic = 0;
+    bool isCooked = file.Read(magic) && magic == CookedFormat::AtlasMagic;
+    file.Seek(0);
 
-    // Create base instance.
-    auto createResult = Create();
-    if(!createResult)
+    return isCooked ? PrepareCooked(file) : PrepareScript(file, params);
+}
+
+TextureAtlas::PrepareResult TextureAtlas::PrepareCooked(System::FileHandle& file)
+{
+    PreparedData prepared;
+
+    // Read cooked file straight from memory if possible.
+    std::vector<uint8_t> buffer;
+    System::FileHandle::MappedView view = file.MapOrRead(buffer);
+
+    CookedFormat::AtlasHeader header;
+    if(view.size < sizeof(header))
     {
-        LOG_ERROR("Could not create base instance!");
-        return createResult;
+        LOG_ERROR("Cooked texture atlas header is missing!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
     }
 
-    auto instance = createResult.Unwrap();
+    std::memcpy(&header, view.data, sizeof(header));
+
+    const uint64_t regionsSize = uint64_t(header.regionCount) * sizeof(Region);
+    if(header.version != CookedFormat::Version ||
+        view.size != sizeof(header) + regionsSize + header.texturePathLength)
+    {
+        LOG_ERROR("Cooked texture atlas has invalid version or size!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    // Regions are stored in same layout, so they are copied all at once.
+    prepared.regions.resize(header.regionCount);
+    std::memcpy(prepared.regions.data(), view.data + sizeof(header), regionsSize);
+
+    if(std::adjacent_find(prepared.regions.begin(), prepared.regions.end(),
+        [](const Region& left, const Region& right)
+        {
+            return left.nameHash >= right.nameHash;
+        }) != prepared.regions.end())
+    {
+        LOG_ERROR("Cooked texture atlas regions are not sorted!");
+        return Common::Failure(CreateErrors::InvalidResourceContents);
+    }
+
+    // Resolve texture path relative to resource file.
+    std::string_view texturePath(reinterpret_cast<const char*>(
+        view.data + sizeof(header) + regionsSize), header.texturePathLength);
+
+    fs::path filePath = file.GetPath();
+    prepared.texturePath = (filePath.remove_filename() / texturePath).lexically_normal();
+
+    // Success!
+    return Common::Success(std::move(prepared));
+}
+
+TextureAtlas::PrepareResult TextureAtlas::PrepareScript(System::FileHandle& file, const LoadFromFile& params)
+{
+    PreparedData prepared;
 
     // Load resource script.
     Script::ScriptState::LoadFromFile resourceParams;
@@ -71,7 +153,7 @@ TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const
         return Common::Failure(CreateErrors::InvalidResourceContents);
     }
 
-    // Load texture.
+    // Read texture path.
     {
         lua_getfield(*resourceScript, -1, "Texture");
         SCOPE_GUARD([&resourceScript]
@@ -85,14 +167,10 @@ TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const
             return Common::Failure(CreateErrors::InvalidResourceContents);
         }
 
-        std::filesystem::path texturePath = lua_tostring(*resourceScript, -1);
-
-        Texture::LoadFromFile textureParams;
-        textureParams.engineSystems = params.engineSystems;
-        textureParams.mipmaps = true;
-
-        instance->m_texture = resourceManager->AcquireRelative<Graphics::Texture>(
-            texturePath, file.GetPath(), textureParams).UnwrapEither();
+        // Resolve texture path relative to resource file.
+        fs::path filePath = file.GetPath();
+        prepared.texturePath = (filePath.remove_filename() /
+            lua_tostring(*resourceScript, -1)).lexically_normal();
     }
 
     // Read texture regions.
@@ -120,7 +198,9 @@ TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const
         std::string regionName = lua_tostring(*resourceScript, -2);
 
         // Read the region rectangle.
-        glm::ivec4 pixelCoords(0);
+        Region region;
+        region.nameHash = CookedFormat::HashName(regionName);
+        glm::ivec4& pixelCoords = region.pixelCoords;
 
         for(int i = 0; i < 4; ++i)
         {
@@ -138,35 +218,140 @@ TextureAtlas::CreateResult TextureAtlas::Create(System::FileHandle& file, const
         }
 
         // Add a new texture region.
-        if(!instance->AddRegion(regionName, pixelCoords))
+        prepared.regions.push_back(region);
+    }
+
+    // Sort regions by their name hashes, same as in cooked files.
+    std::sort(prepared.regions.begin(), prepared.regions.end(), CompareRegions);
+
+    auto collisionIt = std::unique(prepared.regions.begin(), prepared.regions.end(),
+        [](const Region& left, const Region& right)
         {
-            LOG_WARNING("Could not add region with \"{}\" name!", regionName);
-            continue;
-        }
+            return left.nameHash == right.nameHash;
+        });
+
+    if(collisionIt != prepared.regions.end())
+    {
+        LOG_WARNING("Removing {} regions with colliding name hashes!",
+            std::distance(collisionIt, prepared.regions.end()));
+        prepared.regions.erase(collisionIt, prepared.regions.end());
+    }
+
+    // Success!
+    return Common::Success(std::move(prepared));
+}
+
+void TextureAtlas::AcquireDependencies(System::ResourceDependencies& dependencies,
+    const PreparedData& prepared, const LoadFromFile& params)
+{
+    // Start loading texture ahead of creation.
+    Texture::LoadFromFile textureParams;
+    textureParams.engineSystems = params.engineSystems;
+    textureParams.mipmaps = true;
+
+    dependencies.Acquire<Graphics::Texture>(prepared.texturePath, textureParams);
+}
+
+std::vector<uint8_t> TextureAtlas::Cook(const PreparedData& prepared, const fs::path& filePath)
+{
+    ASSERT(std::is_sorted(prepared.regions.begin(), prepared.regions.end(), CompareRegions),
+        "Prepared texture atlas regions are not sorted!");
+
+    // Store texture path relative to resource file, same as in script.
+    std::string texturePath = prepared.texturePath.lexically_relative(
+        filePath.parent_path()).generic_string();
+
+    CookedFormat::AtlasHeader header;
+    header.regionCount = Common::NumericalCast<uint32_t>(prepared.regions.size());
+    header.texturePathLength = Common::NumericalCast<uint32_t>(texturePath.size());
+
+    const std::size_t regionsSize = prepared.regions.size() * sizeof(Region);
+    std::vector<uint8_t> bytes(sizeof(header) + regionsSize + texturePath.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), prepared.regions.data(), regionsSize);
+    std::memcpy(bytes.data() + sizeof(header) + regionsSize, texturePath.data(), texturePath.size());
+    return bytes;
+}
+
+TextureAtlas::CreateResult TextureAtlas::Create(PreparedData&& prepared, const LoadFromFile& params)
+{
+    // Validate parameters.
+    CHECK_ARGUMENT_OR_RETURN(params.engineSystems, Common::Failure(CreateErrors::InvalidArgument));
+
+    // Acquire engine systems.
+    auto* resourceManager = params.engineSystems->Locate<System::ResourceManager>();
+
+    // Create base instance.
+    auto createResult = Create();
+    if(!createResult)
+    {
+        LOG_ERROR("Could not create base instance!");
+        return createResult;
     }
 
+    auto instance = createResult.Unwrap();
+
+    // Acquire texture, which is already loaded if acquired as dependency.
+    Texture::LoadFromFile textureParams;
+    textureParams.engineSystems = params.engineSystems;
+    textureParams.mipmaps = true;
+
+    instance->m_texture = resourceManager->Acquire<Graphics::Texture>(
+        prepared.texturePath, textureParams).UnwrapEither();
+
+    // Add texture regions.
+    instance->m_regions = std::move(prepared.regions);
+
     // Success!
     return Common::Success(std::move(instance));
 }
 
-bool TextureAtlas::AddRegion(std::string name, glm::ivec4 pixelCoords)
+bool TextureAtlas::AddRegion(std::string_view name, glm::ivec4 pixelCoords)
+{
+    // Insert texture region at its sorted position.
+    Region region;
+    region.nameHash = CookedFormat::HashName(name);
+    region.pixelCoords = pixelCoords;
+
+    auto it = std::lower_bound(m_regions.begin(), m_regions.end(), region.nameHash, RegionHashCompare());
+    if(it != m_regions.end() && it->nameHash == region.nameHash)
+        return false;
+
+    m_regions.insert(it, region);
+    return true;
+}
+
+TextureView TextureAtlas::GetRegion(std::string_view name) const
 {
-    // Add texture region to map.
-    auto result = m_regions.emplace(name, pixelCoords);
-    return result.second;
+    return GetRegion(CookedFormat::HashName(name));
 }
 
-TextureView TextureAtlas::GetRegion(std::string name)
+TextureView TextureAtlas::GetRegion(uint64_t nameHash) const
 {
     // Find and return texture region.
-    auto it = m_regions.find(name);
+    auto it = std::lower_bound(m_regions.begin(), m_regions.end(), nameHash, RegionHashCompare());
 
-    if(it != m_regions.end())
+    if(it != m_regions.end() && it->nameHash == nameHash)
     {
-        return TextureView(m_texture, it->second);
+        return TextureView(m_texture, it->pixelCoords);
     }
     else
     {
         return TextureView();
     }
 }
+
+void TextureAtlas::Swap(TextureAtlas& other)
+{
+    // Used to replace contents of texture atlas that has been reloaded.
+    std::swap(m_texture, other.m_texture);
+    std::swap(m_regions, other.m_regions);
+}
+
+System::ResourceMemoryUsage TextureAtlas::GetMemoryUsage() const
+{
+    // Referenced texture is accounted for by its own resource pool.
+    System::ResourceMemoryUsage memoryUsage;
+    memoryUsage.cpuBytes = sizeof(TextureAtlas) + m_regions.capacity() * sizeof(Region);
+    return memoryUsage;
+}
@@ -0,0 +1,442 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "Graphics/Precompiled.hpp"
+#include "Graphics/TextureCompression.hpp"
+using namespace Graphics;
+
+namespace
+{
+    constexpr int BlockSize = 4;
+    constexpr int BlockPixels = BlockSize * BlockSize;
+
+    using BlockColors = std::array<glm::ivec4, BlockPixels>;
+    using ColorPalette = std::array<glm::ivec4, 4>;
+    using AlphaPalette = std::array<int, 8>;
+
+    int GetBlockCount(int size)
+    {
+        return (std::max(size, 1) + BlockSize - 1) / BlockSize;
+    }
+
+    BlockColors FetchBlock(const uint8_t* pixels, int width, int height, int blockX, int blockY)
+    {
+        // Pixels outside of image repeat its last row and column.
+        BlockColors colors;
+        for(int y = 0; y < BlockSize; ++y)
+        {
+            for(int x = 0; x < BlockSize; ++x)
+            {
+                int pixelX = std::min(blockX * BlockSize + x, width - 1);
+                int pixelY = std::min(blockY * BlockSize + y, height - 1);
+                const uint8_t* pixel = pixels + (std::size_t(pixelY) * width + pixelX) * 4;
+                colors[y * BlockSize + x] = glm::ivec4(pixel[0], pixel[1], pixel[2], pixel[3]);
+            }
+        }
+
+        return colors;
+    }
+
+    void StoreBlock(const BlockColors& colors, uint8_t* pixels, int width, int height, int blockX, int blockY)
+    {
+        for(int y = 0; y < BlockSize; ++y)
+        {
+            for(int x = 0; x < BlockSize; ++x)
+            {
+                int pixelX = blockX * BlockSize + x;
+                int pixelY = blockY * BlockSize + y;
+                if(pixelX >= width || pixelY >= height)
+                    continue;
+
+                uint8_t* pixel = pixels + (std::size_t(pixelY) * width + pixelX) * 4;
+                const glm::ivec4& color = colors[y * BlockSize + x];
+                pixel[0] = static_cast<uint8_t>(color.r);
+                pixel[1] = static_cast<uint8_t>(color.g);
+                pixel[2] = static_cast<uint8_t>(color.b);
+                pixel[3] = static_cast<uint8_t>(color.a);
+            }
+        }
+    }
+
+    uint16_t PackColor565(const glm::ivec4& color)
+    {
+        return static_cast<uint16_t>(((color.r * 31 + 127) / 255) << 11 |
+            ((color.g * 63 + 127) / 255) << 5 | ((color.b * 31 + 127) / 255));
+    }
+
+    glm::ivec4 UnpackColor565(uint16_t packed)
+    {
+        int r = (packed >> 11) & 31;
+        int g = (packed >> 5) & 63;
+        int b = packed & 31;
+        return glm::ivec4((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255);
+    }
+
+    ColorPalette GetColorPalette(uint16_t color0, uint16_t color1, bool forceFourColors)
+    {
+        ColorPalette palette;
+        palette[0] = UnpackColor565(color0);
+        palette[1] = UnpackColor565(color1);
+
+        if(color0 > color1 || forceFourColors)
+        {
+            palette[2] = (palette[0] * 2 + palette[1]) / 3;
+            palette[3] = (palette[0] + palette[1] * 2) / 3;
+        }
+        else
+        {
+            palette[2] = (palette[0] + palette[1]) / 2;
+            palette[3] = glm::ivec4(0);
+        }
+
+        return palette;
+    }
+
+    AlphaPalette GetAlphaPalette(int alpha0, int alpha1)
+    {
+        AlphaPalette palette;
+        palette[0] = alpha0;
+        palette[1] = alpha1;
+
+        if(alpha0 > alpha1)
+        {
+            for(int i = 2; i < 8; ++i)
+                palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+        }
+        else
+        {
+            for(int i = 2; i < 6; ++i)
+                palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        return palette;
+    }
+
+    void EncodeColorBlock(const BlockColors& colors, uint8_t* block)
+    {
+        // Pick endpoints on bounding box diagonal that follows color correlation.
+        glm::ivec4 minColor(255);
+        glm::ivec4 maxColor(0);
+        glm::ivec4 meanColor(0);
+
+        for(const glm::ivec4& color : colors)
+        {
+            minColor = glm::min(minColor, color);
+            maxColor = glm::max(maxColor, color);
+            meanColor += color;
+        }
+
+        meanColor /= BlockPixels;
+
+        int covarianceRG = 0;
+        int covarianceBG = 0;
+        for(const glm::ivec4& color : colors)
+        {
+            covarianceRG += (color.r - meanColor.r) * (color.g - meanColor.g);
+            covarianceBG += (color.b - meanColor.b) * (color.g - meanColor.g);
+        }
+
+        if(covarianceRG < 0)
+            std::swap(minColor.r, maxColor.r);
+
+        if(covarianceBG < 0)
+            std::swap(minColor.b, maxColor.b);
+
+        // Inset endpoints slightly, as they are rarely hit exactly.
+        glm::ivec4 inset = (maxColor - minColor) / 16;
+        maxColor = glm::clamp(maxColor - inset, 0, 255);
+        minColor = glm::clamp(minColor + inset, 0, 255);
+
+        uint16_t color0 = PackColor565(maxColor);
+        uint16_t color1 = PackColor565(minColor);
+        if(color0 < color1)
+        {
+            std::swap(color0, color1);
+        }
+
+        // Endpoints that are equal produce block of single color.
+        uint32_t indices = 0;
+        if(color0 != color1)
+        {
+            ColorPalette palette = GetColorPalette(color0, color1, true);
+            for(int i = 0; i < BlockPixels; ++i)
+            {
+                int bestIndex = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+
+                for(int p = 0; p < 4; ++p)
+                {
+                    glm::ivec3 delta = glm::ivec3(colors[i]) - glm::ivec3(palette[p]);
+                    int distance = delta.r * delta.r + delta.g * delta.g + delta.b * delta.b;
+                    if(distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= static_cast<uint32_t>(bestIndex) << (i * 2);
+            }
+        }
+
+        std::memcpy(block + 0, &color0, sizeof(color0));
+        std::memcpy(block + 2, &color1, sizeof(color1));
+        std::memcpy(block + 4, &indices, sizeof(indices));
+    }
+
+    void DecodeColorBlock(const uint8_t* block, BlockColors& colors, bool forceFourColors)
+    {
+        uint16_t color0 = 0;
+        uint16_t color1 = 0;
+        uint32_t indices = 0;
+
+        std::memcpy(&color0, block + 0, sizeof(color0));
+        std::memcpy(&color1, block + 2, sizeof(color1));
+        std::memcpy(&indices, block + 4, sizeof(indices));
+
+        ColorPalette palette = GetColorPalette(color0, color1, forceFourColors);
+        for(int i = 0; i < BlockPixels; ++i)
+        {
+            colors[i] = palette[(indices >> (i * 2)) & 3];
+        }
+    }
+
+    void EncodeAlphaBlock(const BlockColors& colors, uint8_t* block)
+    {
+        int alpha0 = 0;
+        int alpha1 = 255;
+
+        for(const glm::ivec4& color : colors)
+        {
+            alpha0 = std::max(alpha0, color.a);
+            alpha1 = std::min(alpha1, color.a);
+        }
+
+        uint64_t indices = 0;
+        if(alpha0 != alpha1)
+        {
+            AlphaPalette palette = GetAlphaPalette(alpha0, alpha1);
+            for(int i = 0; i < BlockPixels; ++i)
+            {
+                int bestIndex = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+
+                for(int p = 0; p < 8; ++p)
+                {
+                    int distance = std::abs(colors[i].a - palette[p]);
+                    if(distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= static_cast<uint64_t>(bestIndex) << (i * 3);
+            }
+        }
+
+        block[0] = static_cast<uint8_t>(alpha0);
+        block[1] = static_cast<uint8_t>(alpha1);
+        for(int i = 0; i < 6; ++i)
+        {
+            block[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+        }
+    }
+
+    void DecodeAlphaBlock(const uint8_t* block, BlockColors& colors)
+    {
+        uint64_t indices = 0;
+        for(int i = 0; i < 6; ++i)
+        {
+            indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+        }
+
+        AlphaPalette palette = GetAlphaPalette(block[0], block[1]);
+        for(int i = 0; i < BlockPixels; ++i)
+        {
+            colors[i].a = palette[(indices >> (i * 3)) & 7];
+        }
+    }
+
+    template<typename Function>
+    void ForEachBlock(int width, int height, Function&& function)
+    {
+        const int blocksX = GetBlockCount(width);
+        const int blocksY = GetBlockCount(height);
+
+        for(int blockY = 0; blockY < blocksY; ++blockY)
+        {
+            for(int blockX = 0; blockX < blocksX; ++blockX)
+            {
+                function(blockX, blockY, std::size_t(blockY) * blocksX + blockX);
+            }
+        }
+    }
+}
+
+bool TextureCompression::IsBlockCompressed(TextureFormat format)
+{
+    switch(format)
+    {
+    case TextureFormat::BC1:
+    case TextureFormat::BC3:
+    case TextureFormat::ETC2RGB8:
+    case TextureFormat::ETC2RGBA8:
+    case TextureFormat::ASTC4x4:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+int TextureCompression::GetChannelCount(TextureFormat format)
+{
+    switch(format)
+    {
+    case TextureFormat::R8:
+        return 1;
+
+    case TextureFormat::RG8:
+        return 2;
+
+    case TextureFormat::RGB8:
+        return 3;
+
+    case TextureFormat::RGBA8:
+        return 4;
+
+    default:
+        return 0;
+    }
+}
+
+std::size_t TextureCompression::GetLevelSize(TextureFormat format, int width, int height)
+{
+    const std::size_t blockCount = std::size_t(GetBlockCount(width)) * GetBlockCount(height);
+
+    switch(format)
+    {
+    case TextureFormat::BC1:
+    case TextureFormat::ETC2RGB8:
+        return blockCount * 8;
+
+    case TextureFormat::BC3:
+    case TextureFormat::ETC2RGBA8:
+    case TextureFormat::ASTC4x4:
+        return blockCount * 16;
+
+    default:
+        return std::size_t(std::max(width, 1)) * std::max(height, 1) * GetChannelCount(format);
+    }
+}
+
+int TextureCompression::GetMaxLevelCount(int width, int height)
+{
+    int levelCount = 1;
+    for(int size = std::max(width, height); size > 1; size /= 2)
+    {
+        ++levelCount;
+    }
+
+    return levelCount;
+}
+
+std::vector<uint8_t> TextureCompression::GenerateMipLevel(const uint8_t* pixels, int width, int height, int channels)
+{
+    ASSERT(pixels != nullptr && width > 0 && height > 0 && channels > 0);
+
+    // Average each 2x2 square, with last row or column repeated for odd sizes.
+    const int levelWidth = std::max(width / 2, 1);
+    const int levelHeight = std::max(height / 2, 1);
+    std::vector<uint8_t> level(std::size_t(levelWidth) * levelHeight * channels);
+
+    for(int y = 0; y < levelHeight; ++y)
+    {
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+
+        for(int x = 0; x < levelWidth; ++x)
+        {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+
+            for(int c = 0; c < channels; ++c)
+            {
+                int sum = pixels[(std::size_t(y0) * width + x0) * channels + c] +
+                    pixels[(std::size_t(y0) * width + x1) * channels + c] +
+                    pixels[(std::size_t(y1) * width + x0) * channels + c] +
+                    pixels[(std::size_t(y1) * width + x1) * channels + c];
+
+                level[(std::size_t(y) * levelWidth + x) * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return level;
+}
+
+std::vector<uint8_t> TextureCompression::CompressBC1(const uint8_t* pixels, int width, int height)
+{
+    ASSERT(pixels != nullptr && width > 0 && height > 0);
+
+    std::vector<uint8_t> blocks(GetLevelSize(TextureFormat::BC1, width, height));
+    ForEachBlock(width, height, [&](int blockX, int blockY, std::size_t blockIndex)
+    {
+        BlockColors colors = FetchBlock(pixels, width, height, blockX, blockY);
+        EncodeColorBlock(colors, blocks.data() + blockIndex * 8);
+    });
+
+    return blocks;
+}
+
+std::vector<uint8_t> TextureCompression::CompressBC3(const uint8_t* pixels, int width, int height)
+{
+    ASSERT(pixels != nullptr && width > 0 && height > 0);
+
+    std::vector<uint8_t> blocks(GetLevelSize(TextureFormat::BC3, width, height));
+    ForEachBlock(width, height, [&](int blockX, int blockY, std::size_t blockIndex)
+    {
+        BlockColors colors = FetchBlock(pixels, width, height, blockX, blockY);
+        EncodeAlphaBlock(colors, blocks.data() + blockIndex * 16);
+        EncodeColorBlock(colors, blocks.data() + blockIndex * 16 + 8);
+    });
+
+    return blocks;
+}
+
+std::vector<uint8_t> TextureCompression::DecompressBC1(const uint8_t* blocks, int width, int height)
+{
+    ASSERT(blocks != nullptr && width > 0 && height > 0);
+
+    std::vector<uint8_t> pixels(std::size_t(width) * height * 4);
+    ForEachBlock(width, height, [&](int blockX, int blockY, std::size_t blockIndex)
+    {
+        BlockColors colors;
+        DecodeColorBlock(blocks + blockIndex * 8, colors, false);
+        StoreBlock(colors, pixels.data(), width, height, blockX, blockY);
+    });
+
+    return pixels;
+}
+
+std::vector<uint8_t> TextureCompression::DecompressBC3(const uint8_t* blocks, int width, int height)
+{
+    ASSERT(blocks != nullptr && width > 0 && height > 0);
+
+    std::vector<uint8_t> pixels(std::size_t(width) * height * 4);
+    ForEachBlock(width, height, [&](int blockX, int blockY, std::size_t blockIndex)
+    {
+        BlockColors colors;
+        DecodeColorBlock(blocks + blockIndex * 16 + 8, colors, true);
+        DecodeAlphaBlock(blocks + blockIndex * 16, colors);
+        StoreBlock(colors, pixels.data(), width, height, blockX, blockY);
+    });
+
+    return pixels;
+}
@@ -5,6 +5,7 @@
 
 #include "Precompiled.hpp"
 #include "Reflection/Reflection.hpp"
+#include <mutex>
 
 namespace Reflection
 {
@@ -15,6 +16,12 @@ namespace Reflection
 
     void Initialize()
     {
-        Generated::RegisterExecutable();
+        // Types are registered once, before registry is looked up
+        // from other threads which then only read from it.
+        static std::once_flag registerFlag;
+        std::call_once(registerFlag, []()
+        {
+            Generated::RegisterExecutable();
+        });
     }
 }
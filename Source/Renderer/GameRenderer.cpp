@@ -109,11 +109,14 @@ void GameRenderer::Draw(const DrawParams& drawParams)
             Game::SpriteComponent* spriteComponent =
                 spriteAnimationComponent.GetSpriteComponent();
 
+            // Animation can be missing until next tick if its list has been reloaded.
             auto spriteAnimation = spriteAnimationComponent.GetSpriteAnimation();
+            if(spriteAnimation == nullptr)
+                continue;
+
             float animationTime = spriteAnimationComponent
                 .CalculateAnimationTime(drawParams.timeAlpha);
 
-            ASSERT(spriteAnimation, "Sprite animation is null despite being played!");
             spriteComponent->SetTextureView(
                 spriteAnimation->GetFrameByTime(animationTime).textureView);
         }
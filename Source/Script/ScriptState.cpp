@@ -124,10 +124,13 @@ ScriptState::CreateResult ScriptState::Create(System::FileHandle& file, const Lo
 
     auto instance = createResult.Unwrap();
 
-    // Execute script file.
-    std::string scriptCode = file.ReadAsTextString();
+    // Execute script file, mapped in memory if possible.
+    std::vector<uint8_t> scriptBuffer;
+    std::string_view scriptCode = file.MapOrRead(scriptBuffer).AsString();
+    std::string chunkName = "@" + file.GetPath().generic_string();
 
-    if(luaL_dostring(instance->m_state, scriptCode.c_str()) != 0)
+    if(luaL_loadbuffer(instance->m_state, scriptCode.data(), scriptCode.size(), chunkName.c_str()) != 0 ||
+        lua_pcall(instance->m_state, 0, LUA_MULTRET, 0) != 0)
     {
         LOG_ERROR("Could not execute script file!");
         instance->PrintError();
@@ -2,3 +2,221 @@
     Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
     Software distributed under the permissive MIT License.
 */
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/ArchiveFileDepot.hpp"
+#include "System/FileSystem/MemoryFileHandle.hpp"
+using namespace System;
+
+namespace
+{
+    const char* CreateError = "Failed to create archive file depot! {}";
+
+    struct EntryHashCompare
+    {
+        bool operator()(const ArchiveFormat::Entry& entry, uint64_t pathHash) const
+        {
+            return entry.pathHash < pathHash;
+        }
+
+        bool operator()(uint64_t pathHash, const ArchiveFormat::Entry& entry) const
+        {
+            return pathHash < entry.pathHash;
+        }
+    };
+}
+
+ArchiveFileDepot::ArchiveFileDepot() = default;
+ArchiveFileDepot::~ArchiveFileDepot() = default;
+
+ArchiveFileDepot::CreateResult ArchiveFileDepot::Create(fs::path archivePath)
+{
+    CHECK_ARGUMENT_OR_RETURN(!archivePath.empty(),
+        Common::Failure(CreateErrors::EmptyArchivePathArgument));
+
+    auto instance = std::unique_ptr<ArchiveFileDepot>(new ArchiveFileDepot());
+    instance->m_archivePath = archivePath.lexically_normal();
+    instance->m_archive = std::make_shared<ArchiveFileHandle::ArchiveStream>();
+
+    // Open archive file that is kept open for lifetime of depot.
+    std::ifstream& stream = instance->m_archive->stream;
+    stream.open(archivePath, std::ios::binary);
+    if(!stream.is_open())
+    {
+        LOG_ERROR(CreateError, "Could not open archive file.");
+        return Common::Failure(CreateErrors::FileOpeningFailed);
+    }
+
+    stream.seekg(0, std::ios_base::end);
+    const uint64_t archiveSize = Common::NumericalCast<uint64_t>(stream.tellg());
+    stream.seekg(0, std::ios_base::beg);
+
+    // Read and validate archive header.
+    ArchiveFormat::Header header;
+    if(!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != ArchiveFormat::Magic)
+    {
+        LOG_ERROR(CreateError, "Archive file has invalid header.");
+        return Common::Failure(CreateErrors::InvalidArchiveHeader);
+    }
+
+    if(header.version != ArchiveFormat::Version)
+    {
+        LOG_ERROR(CreateError, "Archive file has unsupported version.");
+        return Common::Failure(CreateErrors::UnsupportedArchiveVersion);
+    }
+
+    const uint64_t entriesSize = uint64_t(header.entryCount) * sizeof(ArchiveFormat::Entry);
+    if(header.tableOffset > archiveSize || header.tableSize > archiveSize - header.tableOffset ||
+        header.tableSize < entriesSize)
+    {
+        LOG_ERROR(CreateError, "Archive file has invalid table of contents range.");
+        return Common::Failure(CreateErrors::InvalidArchiveHeader);
+    }
+
+    // Read entire table of contents at once and verify its integrity.
+    std::vector<uint8_t> table(header.tableSize);
+    stream.seekg(header.tableOffset, std::ios_base::beg);
+    if(!stream.read(reinterpret_cast<char*>(table.data()), table.size()) ||
+        ArchiveFormat::CalculateCrc(table.data(), table.size()) != header.tableCrc)
+    {
+        LOG_ERROR(CreateError, "Archive file has corrupted table of contents.");
+        return Common::Failure(CreateErrors::CorruptedTableOfContents);
+    }
+
+    instance->m_entries.resize(header.entryCount);
+    std::memcpy(instance->m_entries.data(), table.data(), entriesSize);
+    instance->m_paths.assign(reinterpret_cast<const char*>(table.data()) + entriesSize,
+        table.size() - entriesSize);
+
+    // Validate entries, so they can be used without further bounds checks.
+    for(const ArchiveFormat::Entry& entry : instance->m_entries)
+    {
+        bool entryValid = uint64_t(entry.pathOffset) + entry.pathLength <= instance->m_paths.size() &&
+            entry.offset <= header.tableOffset && entry.storedSize <= header.tableOffset - entry.offset &&
+            (entry.compression == ArchiveFormat::Compression::None ? entry.storedSize == entry.size :
+                entry.compression == ArchiveFormat::Compression::Zlib);
+
+        if(!entryValid)
+        {
+            LOG_ERROR(CreateError, "Archive file has invalid entry.");
+            return Common::Failure(CreateErrors::CorruptedTableOfContents);
+        }
+    }
+
+    bool entriesSorted = std::is_sorted(instance->m_entries.begin(), instance->m_entries.end(),
+        [](const ArchiveFormat::Entry& left, const ArchiveFormat::Entry& right)
+        {
+            return left.pathHash < right.pathHash;
+        });
+
+    if(!entriesSorted)
+    {
+        LOG_ERROR(CreateError, "Archive file has unsorted table of contents.");
+        return Common::Failure(CreateErrors::CorruptedTableOfContents);
+    }
+
+    // Map archive file to read its entries straight from memory.
+    if(MappedFileHandle::IsSupported())
+    {
+        if(auto mappingResult = MappedFileHandle::Mapping::Create(archivePath))
+        {
+            instance->m_mapping = mappingResult.Unwrap();
+        }
+    }
+
+    LOG_SUCCESS("Created archive file depot for \"{}\" file with {} entries.",
+        instance->m_archivePath.generic_string(), instance->m_entries.size());
+    return Common::Success(std::move(instance));
+}
+
+FileDepot::OpenFileResult ArchiveFileDepot::OpenFile(const fs::path& depotPath,
+    const fs::path& requestedPath, FileHandle::OpenFlags::Type openFlags)
+{
+    const ArchiveFormat::Entry* entry = FindEntry(depotPath.generic_string());
+    if(entry == nullptr)
+        return Common::Failure(OpenFileErrors::FileNotFound);
+
+    if(openFlags != FileHandle::OpenFlags::Read)
+    {
+        LOG_ERROR("Cannot open \"{}\" file from archive for writing!", depotPath.generic_string());
+        return Common::Failure(OpenFileErrors::AccessDenied);
+    }
+
+    // Uncompressed entries are read directly from archive.
+    if(entry->compression == ArchiveFormat::Compression::None)
+    {
+        if(m_mapping != nullptr)
+        {
+            return MappedFileHandle::Create(m_mapping, entry->offset,
+                entry->size, requestedPath, openFlags);
+        }
+
+        return ArchiveFileHandle::Create(m_archive, entry->offset,
+            entry->size, requestedPath, openFlags);
+    }
+
+    // Compressed entries are decompressed into memory right away.
+    std::vector<uint8_t> compressedBuffer;
+    const uint8_t* compressed = nullptr;
+
+    if(m_mapping != nullptr)
+    {
+        compressed = m_mapping->GetData() + entry->offset;
+    }
+    else
+    {
+        compressedBuffer.resize(entry->storedSize);
+        compressed = compressedBuffer.data();
+
+        std::scoped_lock<std::mutex> lock(m_archive->lock);
+
+        std::ifstream& stream = m_archive->stream;
+        stream.clear();
+        stream.seekg(entry->offset, std::ios_base::beg);
+        if(!stream.read(reinterpret_cast<char*>(compressedBuffer.data()), compressedBuffer.size()))
+        {
+            LOG_ERROR("Could not read \"{}\" file from archive!", depotPath.generic_string());
+            return Common::Failure(OpenFileErrors::UnknownFileOpeningError);
+        }
+    }
+
+    auto buffer = std::make_shared<MemoryFileHandle::Buffer>(entry->size);
+    uLongf decompressedSize = Common::NumericalCast<uLongf>(buffer->size());
+    int result = uncompress(buffer->data(), &decompressedSize,
+        compressed, Common::NumericalCast<uLong>(entry->storedSize));
+
+    if(result != Z_OK || decompressedSize != entry->size ||
+        ArchiveFormat::CalculateCrc(buffer->data(), buffer->size()) != entry->crc)
+    {
+        LOG_ERROR("Archive file \"{}\" is corrupted!", depotPath.generic_string());
+        return Common::Failure(OpenFileErrors::CorruptedFile);
+    }
+
+    return MemoryFileHandle::Create(std::move(buffer), requestedPath, openFlags);
+}
+
+std::size_t ArchiveFileDepot::GetEntryCount() const
+{
+    return m_entries.size();
+}
+
+const ArchiveFormat::Entry* ArchiveFileDepot::FindEntry(std::string_view path) const
+{
+    // Entries are sorted by path hash, with paths compared in case of collision.
+    const uint64_t pathHash = ArchiveFormat::HashPath(path);
+    auto range = std::equal_range(m_entries.begin(), m_entries.end(), pathHash, EntryHashCompare());
+
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        if(GetEntryPath(*it) == path)
+            return &(*it);
+    }
+
+    return nullptr;
+}
+
+std::string_view ArchiveFileDepot::GetEntryPath(const ArchiveFormat::Entry& entry) const
+{
+    return std::string_view(m_paths).substr(entry.pathOffset, entry.pathLength);
+}
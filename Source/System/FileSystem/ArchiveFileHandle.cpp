@@ -2,3 +2,91 @@
     Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
     Software distributed under the permissive MIT License.
 */
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/ArchiveFileHandle.hpp"
+using namespace System;
+
+ArchiveFileHandle::ArchiveFileHandle(const fs::path& path, OpenFlags::Type flags) :
+    FileHandle(path, flags)
+{
+}
+
+ArchiveFileHandle::~ArchiveFileHandle() = default;
+
+FileDepot::OpenFileResult ArchiveFileHandle::Create(ArchiveStreamPtr archive, uint64_t offset,
+    uint64_t size, const fs::path& requestedPath, OpenFlags::Type openFlags)
+{
+    CHECK_ARGUMENT_OR_RETURN(archive != nullptr,
+        Common::Failure(OpenFileErrors::UnknownFileOpeningError));
+    CHECK_ARGUMENT_OR_RETURN(openFlags == OpenFlags::Read,
+        Common::Failure(OpenFileErrors::InvalidOpenFlagsArgument));
+
+    auto instance = std::unique_ptr<ArchiveFileHandle>(
+        new ArchiveFileHandle(requestedPath, openFlags));
+    instance->m_archive = std::move(archive);
+    instance->m_offset = offset;
+    instance->m_size = size;
+
+    return Common::Success(std::move(instance));
+}
+
+uint64_t ArchiveFileHandle::Tell()
+{
+    return m_position;
+}
+
+uint64_t ArchiveFileHandle::Seek(uint64_t offset, SeekMode mode)
+{
+    switch(mode)
+    {
+    case FileHandle::SeekMode::Begin:
+        m_position = offset;
+        break;
+    case FileHandle::SeekMode::Current:
+        m_position += offset;
+        break;
+    case FileHandle::SeekMode::End:
+        m_position = m_size + offset;
+        break;
+    }
+
+    m_position = std::min(m_position, m_size);
+    return m_position;
+}
+
+uint64_t ArchiveFileHandle::Read(uint8_t* data, uint64_t bytes)
+{
+    uint64_t readBytes = std::min(bytes, m_size - m_position);
+    if(readBytes == 0)
+        return 0;
+
+    // Archive stream position is shared between handles.
+    std::scoped_lock<std::mutex> lock(m_archive->lock);
+
+    std::ifstream& stream = m_archive->stream;
+    stream.clear();
+    stream.seekg(m_offset + m_position, std::ios_base::beg);
+    stream.read(reinterpret_cast<char*>(data), readBytes);
+
+    readBytes = Common::NumericalCast<uint64_t>(stream.gcount());
+    m_good = stream.good();
+    m_position += readBytes;
+    return readBytes;
+}
+
+uint64_t ArchiveFileHandle::Write(const uint8_t* data, uint64_t bytes)
+{
+    // Archives are read only.
+    return 0;
+}
+
+bool ArchiveFileHandle::IsGood() const
+{
+    return m_good && m_position <= m_size;
+}
+
+uint64_t ArchiveFileHandle::GetSize() const
+{
+    return m_size;
+}
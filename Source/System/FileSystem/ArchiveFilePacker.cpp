@@ -0,0 +1,151 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/ArchiveFilePacker.hpp"
+using namespace System;
+
+ArchiveFilePacker::ArchiveFilePacker() = default;
+ArchiveFilePacker::~ArchiveFilePacker() = default;
+
+ArchiveFilePacker::AddFileResult ArchiveFilePacker::AddFile(fs::path archivePath,
+    std::vector<uint8_t> data, ArchiveFormat::Compression compression)
+{
+    CHECK_ARGUMENT_OR_RETURN(!archivePath.empty(),
+        Common::Failure(AddFileErrors::EmptyArchivePathArgument));
+
+    // Paths are stored in same form that file system passes to depots.
+    archivePath = archivePath.lexically_normal();
+    if(archivePath.is_absolute() || !archivePath.has_filename() || *archivePath.begin() == "..")
+    {
+        LOG_ERROR("Cannot add \"{}\" file to archive under invalid path!", archivePath.generic_string());
+        return Common::Failure(AddFileErrors::InvalidArchivePathArgument);
+    }
+
+    PackedFile file;
+    file.path = archivePath.generic_string();
+
+    if(file.path.size() > std::numeric_limits<uint16_t>::max())
+    {
+        LOG_ERROR("Cannot add \"{}\" file to archive with path that is too long!", file.path);
+        return Common::Failure(AddFileErrors::InvalidArchivePathArgument);
+    }
+
+    if(m_filePaths.count(file.path) != 0)
+    {
+        LOG_ERROR("Cannot add \"{}\" file to archive more than once!", file.path);
+        return Common::Failure(AddFileErrors::DuplicateArchivePath);
+    }
+
+    file.entry.pathHash = ArchiveFormat::HashPath(file.path);
+    file.entry.pathLength = static_cast<uint16_t>(file.path.size());
+    file.entry.size = data.size();
+    file.entry.crc = ArchiveFormat::CalculateCrc(data.data(), data.size());
+
+    if(compression == ArchiveFormat::Compression::Zlib)
+    {
+        std::vector<uint8_t> compressed(compressBound(Common::NumericalCast<uLong>(data.size())));
+        uLongf compressedSize = Common::NumericalCast<uLongf>(compressed.size());
+
+        if(compress2(compressed.data(), &compressedSize, data.data(),
+            Common::NumericalCast<uLong>(data.size()), Z_BEST_COMPRESSION) != Z_OK)
+        {
+            LOG_ERROR("Failed to compress \"{}\" file for archive!", file.path);
+            return Common::Failure(AddFileErrors::CompressionFailed);
+        }
+
+        if(compressedSize < data.size())
+        {
+            compressed.resize(compressedSize);
+            data = std::move(compressed);
+            file.entry.compression = ArchiveFormat::Compression::Zlib;
+        }
+    }
+
+    file.entry.storedSize = data.size();
+    file.data = std::move(data);
+    m_filePaths.insert(file.path);
+    m_files.push_back(std::move(file));
+
+    return Common::Success();
+}
+
+ArchiveFilePacker::WriteResult ArchiveFilePacker::Write(const fs::path& outputPath) const
+{
+    CHECK_ARGUMENT_OR_RETURN(!outputPath.empty(),
+        Common::Failure(WriteErrors::EmptyOutputPathArgument));
+
+    std::ofstream stream(outputPath, std::ios::binary | std::ios::trunc);
+    if(!stream.is_open())
+    {
+        LOG_ERROR("Could not open \"{}\" archive file for writing!", outputPath.generic_string());
+        return Common::Failure(WriteErrors::FileOpeningFailed);
+    }
+
+    // Table of contents is sorted by path hash for binary search.
+    std::vector<const PackedFile*> sortedFiles;
+    for(const PackedFile& file : m_files)
+    {
+        sortedFiles.push_back(&file);
+    }
+
+    std::sort(sortedFiles.begin(), sortedFiles.end(),
+        [](const PackedFile* left, const PackedFile* right)
+        {
+            return left->entry.pathHash < right->entry.pathHash;
+        });
+
+    // Write file data with each entry aligned to 4K, after space reserved for header.
+    std::vector<ArchiveFormat::Entry> entries;
+    std::string paths;
+    uint64_t offset = ArchiveFormat::Alignment;
+
+    const std::vector<char> padding(ArchiveFormat::Alignment, 0);
+    stream.write(padding.data(), padding.size());
+
+    for(const PackedFile* file : sortedFiles)
+    {
+        ArchiveFormat::Entry& entry = entries.emplace_back(file->entry);
+        entry.offset = offset;
+        entry.pathOffset = Common::NumericalCast<uint32_t>(paths.size());
+        paths += file->path;
+
+        stream.write(reinterpret_cast<const char*>(file->data.data()), file->data.size());
+        offset += file->data.size();
+
+        uint64_t alignedOffset = ArchiveFormat::AlignOffset(offset);
+        stream.write(padding.data(), alignedOffset - offset);
+        offset = alignedOffset;
+    }
+
+    // Write table of contents and then header that references it.
+    std::vector<uint8_t> table(entries.size() * sizeof(ArchiveFormat::Entry) + paths.size());
+    std::memcpy(table.data(), entries.data(), entries.size() * sizeof(ArchiveFormat::Entry));
+    std::memcpy(table.data() + entries.size() * sizeof(ArchiveFormat::Entry), paths.data(), paths.size());
+    stream.write(reinterpret_cast<const char*>(table.data()), table.size());
+
+    ArchiveFormat::Header header;
+    header.entryCount = Common::NumericalCast<uint32_t>(entries.size());
+    header.tableCrc = ArchiveFormat::CalculateCrc(table.data(), table.size());
+    header.tableOffset = offset;
+    header.tableSize = table.size();
+
+    stream.seekp(0, std::ios_base::beg);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if(!stream.good())
+    {
+        LOG_ERROR("Failed to write \"{}\" archive file!", outputPath.generic_string());
+        return Common::Failure(WriteErrors::FileWritingFailed);
+    }
+
+    LOG_SUCCESS("Written \"{}\" archive file with {} entries.", outputPath.generic_string(), entries.size());
+    return Common::Success();
+}
+
+std::size_t ArchiveFilePacker::GetFileCount() const
+{
+    return m_files.size();
+}
@@ -0,0 +1,491 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/AsyncFileReader.hpp"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__) && __has_include(<linux/io_uring.h>)
+    #define IO_URING_SUPPORTED
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+using namespace System;
+
+#ifdef IO_URING_SUPPORTED
+
+/*
+    Native Queue
+
+    Minimal io_uring wrapper that only submits vectored reads, using system
+    calls directly as liburing may not be available. Requests are written to
+    submission ring by calling threads and reaped from completion ring by
+    single completion thread, which also resubmits partial reads. Number of
+    requests in flight is limited by ring size, with remaining ones queued.
+*/
+
+class AsyncFileReader::NativeQueue final : private Common::NonCopyable
+{
+public:
+    static std::unique_ptr<NativeQueue> Create(uint32_t queueDepth)
+    {
+        auto instance = std::unique_ptr<NativeQueue>(new NativeQueue());
+
+        io_uring_params params = {};
+        instance->m_ringDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+        if(instance->m_ringDescriptor < 0)
+            return nullptr;
+
+        // Map submission and completion rings that are shared with kernel.
+        instance->m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        instance->m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        if(params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            instance->m_submissionRingSize = std::max(
+                instance->m_submissionRingSize, instance->m_completionRingSize);
+        }
+
+        instance->m_submissionRing = mmap(nullptr, instance->m_submissionRingSize,
+            PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            instance->m_ringDescriptor, IORING_OFF_SQ_RING);
+        if(instance->m_submissionRing == MAP_FAILED)
+        {
+            instance->m_submissionRing = nullptr;
+            return nullptr;
+        }
+
+        if(params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            instance->m_completionRing = instance->m_submissionRing;
+        }
+        else
+        {
+            instance->m_completionRing = mmap(nullptr, instance->m_completionRingSize,
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                instance->m_ringDescriptor, IORING_OFF_CQ_RING);
+            if(instance->m_completionRing == MAP_FAILED)
+            {
+                instance->m_completionRing = nullptr;
+                return nullptr;
+            }
+        }
+
+        instance->m_submissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* submissionEntries = mmap(nullptr, instance->m_submissionEntriesSize,
+            PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            instance->m_ringDescriptor, IORING_OFF_SQES);
+        if(submissionEntries == MAP_FAILED)
+            return nullptr;
+
+        uint8_t* submissionRing = static_cast<uint8_t*>(instance->m_submissionRing);
+        instance->m_submissionHead = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.head);
+        instance->m_submissionTail = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.tail);
+        instance->m_submissionMask = *reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.ring_mask);
+        instance->m_submissionArray = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.array);
+        instance->m_submissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+        uint8_t* completionRing = static_cast<uint8_t*>(instance->m_completionRing);
+        instance->m_completionHead = reinterpret_cast<uint32_t*>(completionRing + params.cq_off.head);
+        instance->m_completionTail = reinterpret_cast<uint32_t*>(completionRing + params.cq_off.tail);
+        instance->m_completionMask = *reinterpret_cast<uint32_t*>(completionRing + params.cq_off.ring_mask);
+        instance->m_completionEntries = reinterpret_cast<io_uring_cqe*>(completionRing + params.cq_off.cqes);
+
+        // Keep one submission entry free for request that stops completion thread.
+        instance->m_capacity = params.sq_entries - 1;
+        instance->m_completionThread = std::thread(&NativeQueue::RunCompletionThread, instance.get());
+        return instance;
+    }
+
+    ~NativeQueue()
+    {
+        if(m_completionThread.joinable())
+        {
+            // Completion thread exits after all outstanding reads complete.
+            {
+                std::scoped_lock<std::mutex> lock(m_submitLock);
+
+                io_uring_sqe* entry = GetSubmissionEntry();
+                entry->opcode = IORING_OP_NOP;
+                entry->user_data = 0;
+                CommitSubmissionEntry();
+                EnterSubmissions();
+            }
+
+            m_completionThread.join();
+        }
+
+        if(m_submissionEntries != nullptr)
+        {
+            munmap(m_submissionEntries, m_submissionEntriesSize);
+        }
+
+        if(m_completionRing != nullptr && m_completionRing != m_submissionRing)
+        {
+            munmap(m_completionRing, m_completionRingSize);
+        }
+
+        if(m_submissionRing != nullptr)
+        {
+            munmap(m_submissionRing, m_submissionRingSize);
+        }
+
+        if(m_ringDescriptor >= 0)
+        {
+            close(m_ringDescriptor);
+        }
+    }
+
+    void Submit(ReadRequest&& request, const FileHandle::NativeView& native)
+    {
+        auto nativeRequest = std::make_unique<NativeRequest>();
+        nativeRequest->request = std::move(request);
+        nativeRequest->fileDescriptor = native.fileDescriptor;
+        nativeRequest->fileOffset = native.offset + nativeRequest->request.offset;
+
+        std::scoped_lock<std::mutex> lock(m_submitLock);
+        m_pendingRequests.push_back(nativeRequest.release());
+        ++m_outstandingCount;
+        SubmitPendingRequests();
+    }
+
+private:
+    NativeQueue() = default;
+
+    struct NativeRequest
+    {
+        ReadRequest request;
+        int fileDescriptor = -1;
+        uint64_t fileOffset = 0;
+        uint64_t completedBytes = 0;
+        iovec vector = {};
+    };
+
+    // Reads larger than this are split, as request length is 32-bit.
+    static constexpr uint64_t MaxReadChunk = 1ull << 30;
+
+    io_uring_sqe* GetSubmissionEntry()
+    {
+        const uint32_t index = *m_submissionTail & m_submissionMask;
+
+        io_uring_sqe* entry = &m_submissionEntries[index];
+        std::memset(entry, 0, sizeof(io_uring_sqe));
+        return entry;
+    }
+
+    void CommitSubmissionEntry()
+    {
+        // Entry becomes visible to kernel once tail is advanced past it.
+        const uint32_t tail = *m_submissionTail;
+        m_submissionArray[tail & m_submissionMask] = tail & m_submissionMask;
+        __atomic_store_n(m_submissionTail, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    void EnterSubmissions()
+    {
+        const uint32_t unsubmitted = *m_submissionTail - __atomic_load_n(m_submissionHead, __ATOMIC_ACQUIRE);
+        if(unsubmitted != 0)
+        {
+            syscall(__NR_io_uring_enter, m_ringDescriptor, unsubmitted, 0, 0, nullptr, 0);
+        }
+    }
+
+    void SubmitPendingRequests()
+    {
+        bool submitted = false;
+        while(!m_pendingRequests.empty() && m_inFlightCount < m_capacity)
+        {
+            NativeRequest* nativeRequest = m_pendingRequests.front();
+            m_pendingRequests.pop_front();
+
+            const uint64_t remainingBytes = nativeRequest->request.size - nativeRequest->completedBytes;
+            nativeRequest->vector.iov_base = nativeRequest->request.destination + nativeRequest->completedBytes;
+            nativeRequest->vector.iov_len = static_cast<std::size_t>(std::min(remainingBytes, MaxReadChunk));
+
+            io_uring_sqe* entry = GetSubmissionEntry();
+            entry->opcode = IORING_OP_READV;
+            entry->fd = nativeRequest->fileDescriptor;
+            entry->addr = reinterpret_cast<uint64_t>(&nativeRequest->vector);
+            entry->len = 1;
+            entry->off = nativeRequest->fileOffset + nativeRequest->completedBytes;
+            entry->user_data = reinterpret_cast<uint64_t>(nativeRequest);
+            CommitSubmissionEntry();
+
+            ++m_inFlightCount;
+            submitted = true;
+        }
+
+        if(submitted)
+        {
+            EnterSubmissions();
+        }
+    }
+
+    void RunCompletionThread()
+    {
+        bool stopRequested = false;
+
+        while(true)
+        {
+            const uint32_t head = *m_completionHead;
+            if(head == __atomic_load_n(m_completionTail, __ATOMIC_ACQUIRE))
+            {
+                syscall(__NR_io_uring_enter, m_ringDescriptor, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                continue;
+            }
+
+            const io_uring_cqe completion = m_completionEntries[head & m_completionMask];
+            __atomic_store_n(m_completionHead, head + 1, __ATOMIC_RELEASE);
+
+            NativeRequest* nativeRequest = reinterpret_cast<NativeRequest*>(completion.user_data);
+            bool requestDone = false;
+            bool requestFailed = false;
+
+            {
+                std::scoped_lock<std::mutex> lock(m_submitLock);
+
+                if(nativeRequest == nullptr)
+                {
+                    stopRequested = true;
+                }
+                else
+                {
+                    --m_inFlightCount;
+
+                    if(completion.res > 0)
+                    {
+                        nativeRequest->completedBytes += static_cast<uint64_t>(completion.res);
+                        requestDone = nativeRequest->completedBytes >= nativeRequest->request.size;
+                    }
+                    else if(completion.res == 0)
+                    {
+                        // File ended earlier than expected.
+                        requestDone = true;
+                    }
+                    else if(completion.res != -EINTR && completion.res != -EAGAIN)
+                    {
+                        requestDone = true;
+                        requestFailed = true;
+                    }
+
+                    // Partial and interrupted reads are resubmitted for remaining bytes.
+                    if(requestDone)
+                    {
+                        --m_outstandingCount;
+                    }
+                    else
+                    {
+                        m_pendingRequests.push_front(nativeRequest);
+                    }
+
+                    SubmitPendingRequests();
+                }
+            }
+
+            if(requestDone)
+            {
+                std::unique_ptr<NativeRequest> finishedRequest(nativeRequest);
+                ReadRequest& request = finishedRequest->request;
+
+                if(requestFailed)
+                {
+                    request.callback(Common::Failure(ReadErrors::FileReadingFailed));
+                }
+                else
+                {
+                    request.callback(Common::Success(finishedRequest->completedBytes));
+                }
+            }
+
+            if(stopRequested)
+            {
+                std::scoped_lock<std::mutex> lock(m_submitLock);
+                if(m_outstandingCount == 0)
+                    break;
+            }
+        }
+    }
+
+private:
+    int m_ringDescriptor = -1;
+
+    void* m_submissionRing = nullptr;
+    void* m_completionRing = nullptr;
+    std::size_t m_submissionRingSize = 0;
+    std::size_t m_completionRingSize = 0;
+    std::size_t m_submissionEntriesSize = 0;
+
+    uint32_t* m_submissionHead = nullptr;
+    uint32_t* m_submissionTail = nullptr;
+    uint32_t* m_submissionArray = nullptr;
+    uint32_t m_submissionMask = 0;
+    io_uring_sqe* m_submissionEntries = nullptr;
+
+    uint32_t* m_completionHead = nullptr;
+    uint32_t* m_completionTail = nullptr;
+    uint32_t m_completionMask = 0;
+    io_uring_cqe* m_completionEntries = nullptr;
+
+    std::mutex m_submitLock;
+    std::deque<NativeRequest*> m_pendingRequests;
+    uint32_t m_capacity = 0;
+    uint32_t m_inFlightCount = 0;
+    uint32_t m_outstandingCount = 0;
+
+    std::thread m_completionThread;
+};
+
+#else
+
+class AsyncFileReader::NativeQueue final : private Common::NonCopyable
+{
+public:
+    static std::unique_ptr<NativeQueue> Create(uint32_t queueDepth)
+    {
+        return nullptr;
+    }
+
+    void Submit(ReadRequest&& request, const FileHandle::NativeView& native)
+    {
+        ASSERT(false, "Native queue is not supported!");
+    }
+};
+
+#endif
+
+AsyncFileReader::AsyncFileReader() = default;
+
+AsyncFileReader::~AsyncFileReader()
+{
+    // Finish requests that were already made before stopping.
+    {
+        std::scoped_lock<std::mutex> lock(m_requestLock);
+        m_stopping = true;
+    }
+
+    m_requestCondition.notify_all();
+
+    for(std::thread& workerThread : m_workerThreads)
+    {
+        workerThread.join();
+    }
+
+    m_nativeQueue = nullptr;
+}
+
+AsyncFileReader::CreateResult AsyncFileReader::Create(const CreateFromParams& params)
+{
+    CHECK_ARGUMENT_OR_RETURN(params.queueDepth > 1, Common::Failure());
+
+    auto instance = std::unique_ptr<AsyncFileReader>(new AsyncFileReader());
+    instance->m_nativeQueue = NativeQueue::Create(params.queueDepth);
+
+    for(uint32_t i = 0; i < params.workerThreads; ++i)
+    {
+        instance->m_workerThreads.emplace_back(&AsyncFileReader::RunWorkerThread, instance.get());
+    }
+
+    LOG_SUCCESS("Created async file reader with {} worker threads{}.", params.workerThreads,
+        instance->m_nativeQueue != nullptr ? " and io_uring queue" : "");
+    return Common::Success(std::move(instance));
+}
+
+void AsyncFileReader::Read(FileHandlePtr file, uint64_t offset, uint64_t size,
+    uint8_t* destination, CompletionCallback callback)
+{
+    ASSERT(file != nullptr, "Invalid file handle!");
+    ASSERT(destination != nullptr || size == 0, "Invalid read destination!");
+    ASSERT(callback, "Invalid completion callback!");
+
+    ReadRequest request;
+    request.offset = offset;
+    request.size = size;
+    request.destination = destination;
+    request.callback = std::move(callback);
+
+    if(size == 0)
+    {
+        request.callback(Common::Success(uint64_t(0)));
+        return;
+    }
+
+    // Read files backed by native file descriptors through native queue.
+    if(m_nativeQueue != nullptr)
+    {
+        if(auto nativeResult = file->GetNative())
+        {
+            FileHandle::NativeView native = nativeResult.Unwrap();
+            request.file = std::move(file);
+            m_nativeQueue->Submit(std::move(request), native);
+            return;
+        }
+    }
+
+    request.file = std::move(file);
+
+    if(m_workerThreads.empty())
+    {
+        ProcessRequest(request);
+        return;
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock(m_requestLock);
+        m_requests.push(std::move(request));
+    }
+
+    m_requestCondition.notify_one();
+}
+
+bool AsyncFileReader::IsUsingNativeQueue() const
+{
+    return m_nativeQueue != nullptr;
+}
+
+void AsyncFileReader::RunWorkerThread()
+{
+    while(true)
+    {
+        ReadRequest request;
+
+        {
+            std::unique_lock<std::mutex> lock(m_requestLock);
+            m_requestCondition.wait(lock, [this]()
+            {
+                return m_stopping || !m_requests.empty();
+            });
+
+            if(m_requests.empty())
+                return;
+
+            request = std::move(m_requests.front());
+            m_requests.pop();
+        }
+
+        ProcessRequest(request);
+    }
+}
+
+void AsyncFileReader::ProcessRequest(ReadRequest& request)
+{
+    FileHandle& file = *request.file;
+    if(file.Seek(request.offset) != request.offset)
+    {
+        request.callback(Common::Failure(ReadErrors::FileReadingFailed));
+        return;
+    }
+
+    uint64_t readBytes = file.Read(request.destination, request.size);
+    if(readBytes != request.size && !file.IsGood())
+    {
+        request.callback(Common::Failure(ReadErrors::FileReadingFailed));
+        return;
+    }
+
+    request.callback(Common::Success(readBytes));
+}
@@ -29,8 +29,26 @@ bool FileHandle::IsReadOnly() const
     return (m_flags & OpenFlags::Read) && !(m_flags & OpenFlags::Write);
 }
 
+FileHandle::MapResult FileHandle::Map()
+{
+    // Mapping is not supported by default.
+    return Common::Failure();
+}
+
+FileHandle::NativeResult FileHandle::GetNative()
+{
+    // Native file descriptor is not available by default.
+    return Common::Failure();
+}
+
 std::vector<uint8_t> FileHandle::ReadAsBinaryArray()
 {
+    if(auto mapResult = Map())
+    {
+        MappedView view = mapResult.Unwrap();
+        return std::vector<uint8_t>(view.data, view.data + view.size);
+    }
+
     std::vector<uint8_t> binary;
     binary.resize(GetSize());
 
@@ -42,6 +60,11 @@ std::vector<uint8_t> FileHandle::ReadAsBinaryArray()
 
 std::string FileHandle::ReadAsTextString()
 {
+    if(auto mapResult = Map())
+    {
+        return std::string(mapResult.Unwrap().AsString());
+    }
+
     std::string text;
     text.resize(GetSize());
 
@@ -50,3 +73,15 @@ std::string FileHandle::ReadAsTextString()
 
     return text;
 }
+
+FileHandle::MappedView FileHandle::MapOrRead(std::vector<uint8_t>& buffer)
+{
+    // Read file contents into provided buffer only if they cannot be mapped.
+    if(auto mapResult = Map())
+    {
+        return mapResult.Unwrap();
+    }
+
+    buffer = ReadAsBinaryArray();
+    return MappedView{ buffer.data(), buffer.size() };
+}
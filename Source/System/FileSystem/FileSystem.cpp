@@ -6,6 +6,9 @@
 #include "System/Precompiled.hpp"
 #include "System/FileSystem/FileSystem.hpp"
 #include "System/FileSystem/NativeFileDepot.hpp"
+#include "System/FileSystem/MemoryFileDepot.hpp"
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
 #include <Build/Build.hpp>
 using namespace System;
 
@@ -19,6 +22,40 @@ FileSystem::~FileSystem() = default;
 
 bool FileSystem::OnAttach(const Core::EngineSystemStorage& engineSystems)
 {
+    // Retrieve config variables. Reader for asynchronous reads is only
+    // created once first read is made, as most runs never make any.
+#ifdef __EMSCRIPTEN__
+    const int defaultAsyncReadThreads = 0;
+#else
+    const int defaultAsyncReadThreads = 2;
+#endif
+
+    int asyncReadThreads = defaultAsyncReadThreads;
+    if(Core::Config* config = engineSystems.Locate<Core::Config>())
+    {
+        asyncReadThreads = config->Get<int>(NAME_CONSTEXPR("fileSystem.asyncReadThreads"))
+            .UnwrapOr(defaultAsyncReadThreads);
+    }
+
+    m_asyncReadThreads = static_cast<uint32_t>(std::max(0, asyncReadThreads));
+
+    // Mount files embedded in executable first, as depots mounted later
+    // take precedence and native directories can then override them.
+    if(!Build::GetEmbeddedFiles().empty())
+    {
+        auto embeddedDepot = MemoryFileDepot::Create().Unwrap();
+        for(const Build::EmbeddedFile& embeddedFile : Build::GetEmbeddedFiles())
+        {
+            embeddedDepot->AddFile(embeddedFile.path, embeddedFile.data, embeddedFile.size);
+        }
+
+        if(!MountDepot("./", std::move(embeddedDepot)))
+        {
+            LOG_ERROR(CreateError, "Could not mount embedded files.");
+            return false;
+        }
+    }
+
     // Mount native working directory.
     if(auto workingDirectoryDepot = NativeFileDepot::Create("./"))
     {
@@ -87,8 +124,17 @@ FileSystem::MountDepotResult FileSystem::MountDepot(fs::path mountPath, FileDepo
         return Common::Failure(MountDepotErrors::InvalidMountPathArgument);
     }
 
+    // Depots mounted after watching has started are watched too.
+    if(m_watching)
+    {
+        fileDepot->StartWatching();
+    }
+
     m_mountedDepots.push_back({ mountPath.lexically_normal(), std::move(fileDepot) });
 
+    // Newly mounted depot can shadow files that were already resolved.
+    InvalidateResolvedPaths();
+
     return Common::Success();
 }
 
@@ -109,9 +155,48 @@ FileDepot::OpenFileResult FileSystem::OpenFile(
         return Common::Failure(FileDepot::OpenFileErrors::InvalidFilePathArgument);
     }
 
-    for(auto entry = m_mountedDepots.crbegin(); entry != m_mountedDepots.crend(); ++entry)
+    // Open file from depot it was previously resolved to, which avoids
+    // probing each mounted depot in turn for files that they do not have.
+    const std::string resolveKey = filePath.generic_string();
+    const bool readOnly = openFlags == FileHandle::OpenFlags::Read;
+
+    if(readOnly)
     {
-        const fs::path& mountPath = entry->mountPath;
+        std::optional<ResolvedPath> resolvedPath;
+
+        {
+            std::scoped_lock<std::mutex> lock(m_resolvedPathLock);
+            auto it = m_resolvedPaths.find(resolveKey);
+            if(it != m_resolvedPaths.end())
+            {
+                resolvedPath = it->second;
+            }
+        }
+
+        if(resolvedPath)
+        {
+            FileDepot* fileDepot = m_mountedDepots[resolvedPath->depotIndex].fileDepot.get();
+            auto openFileResult = fileDepot->OpenFile(resolvedPath->depotPath, filePath, openFlags);
+            if(openFileResult)
+            {
+                LOG_SUCCESS("Opened \"{}\" file.", resolveKey);
+                return openFileResult;
+            }
+
+            FileDepot::OpenFileErrors openFileError = openFileResult.UnwrapFailure();
+            if(openFileError != FileDepot::OpenFileErrors::FileNotFound)
+                return Common::Failure(openFileError);
+
+            // File is gone from resolved depot, so search all depots again.
+            std::scoped_lock<std::mutex> lock(m_resolvedPathLock);
+            m_resolvedPaths.erase(resolveKey);
+        }
+    }
+
+    for(std::size_t depotIndex = m_mountedDepots.size(); depotIndex-- != 0;)
+    {
+        const MountedDepotEntry& entry = m_mountedDepots[depotIndex];
+        const fs::path& mountPath = entry.mountPath;
 
         auto mountPathIt = mountPath.begin();
         auto filePathIt = filePath.begin();
@@ -123,6 +208,13 @@ FileDepot::OpenFileResult FileSystem::OpenFile(
 
         while(mountPathIt != mountPath.end())
         {
+            // Skip empty element that trails directory paths.
+            if(mountPathIt->empty())
+            {
+                ++mountPathIt;
+                continue;
+            }
+
             if(filePathIt == filePath.end())
                 break;
 
@@ -130,6 +222,7 @@ FileDepot::OpenFileResult FileSystem::OpenFile(
                 break;
 
             ++mountPathIt;
+            ++filePathIt;
         }
 
         if(mountPathIt == mountPath.end())
@@ -137,9 +230,22 @@ FileDepot::OpenFileResult FileSystem::OpenFile(
             fs::path depotFilePath = std::accumulate(
                 filePathIt, filePath.end(), fs::path(), std::divides());
 
-            if(auto openFileResult = entry->fileDepot->OpenFile(depotFilePath, filePath, openFlags))
+            if(auto openFileResult = entry.fileDepot->OpenFile(depotFilePath, filePath, openFlags))
             {
-                LOG_SUCCESS("Opened \"{}\" file.", filePath.generic_string());
+                // Remember depot that provided file, but only for reads as
+                // writing can create file in depot that shadows other ones.
+                std::scoped_lock<std::mutex> lock(m_resolvedPathLock);
+                if(readOnly)
+                {
+                    m_resolvedPaths.insert_or_assign(resolveKey,
+                        ResolvedPath{ depotIndex, std::move(depotFilePath) });
+                }
+                else
+                {
+                    m_resolvedPaths.erase(resolveKey);
+                }
+
+                LOG_SUCCESS("Opened \"{}\" file.", resolveKey);
                 return openFileResult;
             }
             else
@@ -153,6 +259,196 @@ FileDepot::OpenFileResult FileSystem::OpenFile(
         }
     }
 
-    LOG_ERROR("Could not open \"{}\" file!", filePath.generic_string());
+    LOG_ERROR("Could not open \"{}\" file!", resolveKey);
     return Common::Failure(FileDepot::OpenFileErrors::FileNotFound);
 }
+
+std::future<FileSystem::ReadAsyncResult> FileSystem::ReadAsync(fs::path filePath)
+{
+    return ReadAsync(std::move(filePath), ReadRange());
+}
+
+std::future<FileSystem::ReadAsyncResult> FileSystem::ReadAsync(fs::path filePath, ReadRange range)
+{
+    auto promise = std::make_shared<std::promise<ReadAsyncResult>>();
+    std::future<ReadAsyncResult> future = promise->get_future();
+
+    auto openFileResult = OpenFileRange(filePath, range);
+    if(!openFileResult)
+    {
+        promise->set_value(Common::Failure(openFileResult.UnwrapFailure()));
+        return future;
+    }
+
+    AsyncFileReader* asyncReader = GetAsyncReader();
+    if(asyncReader == nullptr)
+    {
+        promise->set_value(Common::Failure(ReadErrors::FileReadingFailed));
+        return future;
+    }
+
+    // Buffer is kept alive by completion callback until read finishes.
+    auto buffer = std::make_shared<std::vector<uint8_t>>(range.size);
+    uint8_t* destination = buffer->data();
+
+    asyncReader->Read(openFileResult.Unwrap(), range.offset, range.size, destination,
+        [promise, buffer](ReadIntoResult result)
+        {
+            if(result)
+            {
+                buffer->resize(result.Unwrap());
+                promise->set_value(Common::Success(std::move(*buffer)));
+            }
+            else
+            {
+                promise->set_value(Common::Failure(result.UnwrapFailure()));
+            }
+        });
+
+    return future;
+}
+
+std::future<FileSystem::ReadIntoResult> FileSystem::ReadAsync(
+    fs::path filePath, ReadRange range, uint8_t* destination)
+{
+    auto promise = std::make_shared<std::promise<ReadIntoResult>>();
+    std::future<ReadIntoResult> future = promise->get_future();
+
+    // Caller has to specify size of memory that read is made into.
+    if(destination == nullptr || range.size == ReadRange::WholeFile)
+    {
+        LOG_ERROR("Cannot read \"{}\" file into unspecified destination!", filePath.generic_string());
+        promise->set_value(Common::Failure(destination == nullptr ?
+            ReadErrors::InvalidDestinationArgument : ReadErrors::InvalidRangeArgument));
+        return future;
+    }
+
+    auto openFileResult = OpenFileRange(filePath, range);
+    if(!openFileResult)
+    {
+        promise->set_value(Common::Failure(openFileResult.UnwrapFailure()));
+        return future;
+    }
+
+    AsyncFileReader* asyncReader = GetAsyncReader();
+    if(asyncReader == nullptr)
+    {
+        promise->set_value(Common::Failure(ReadErrors::FileReadingFailed));
+        return future;
+    }
+
+    asyncReader->Read(openFileResult.Unwrap(), range.offset, range.size, destination,
+        [promise](ReadIntoResult result)
+        {
+            promise->set_value(std::move(result));
+        });
+
+    return future;
+}
+
+Common::Result<std::unique_ptr<FileHandle>, FileSystem::ReadErrors>
+    FileSystem::OpenFileRange(const fs::path& filePath, ReadRange& range)
+{
+    auto openFileResult = OpenFile(filePath, OpenFlags::Read);
+    if(!openFileResult)
+    {
+        return Common::Failure(openFileResult.UnwrapFailure() == FileDepot::OpenFileErrors::FileNotFound ?
+            ReadErrors::FileNotFound : ReadErrors::FileOpeningFailed);
+    }
+
+    // Range is clamped to end of file, but has to start within it.
+    std::unique_ptr<FileHandle> file = openFileResult.Unwrap();
+    const uint64_t fileSize = file->GetSize();
+
+    if(range.offset > fileSize)
+    {
+        LOG_ERROR("Cannot read \"{}\" file at offset {} past its end!",
+            filePath.generic_string(), range.offset);
+        return Common::Failure(ReadErrors::InvalidRangeArgument);
+    }
+
+    range.size = std::min(range.size, fileSize - range.offset);
+    return Common::Success(std::move(file));
+}
+
+AsyncFileReader* FileSystem::GetAsyncReader()
+{
+    // Reads can be made from many threads, which have to wait for reader
+    // to be created. Failed creation is not retried on following reads.
+    std::scoped_lock<std::mutex> lock(m_asyncReaderLock);
+    if(m_asyncReader == nullptr && !m_asyncReaderFailed)
+    {
+        AsyncFileReader::CreateFromParams readerParams;
+        readerParams.workerThreads = m_asyncReadThreads;
+
+        if(auto asyncReaderResult = AsyncFileReader::Create(readerParams))
+        {
+            m_asyncReader = asyncReaderResult.Unwrap();
+        }
+        else
+        {
+            LOG_ERROR("Could not create async file reader!");
+            m_asyncReaderFailed = true;
+        }
+    }
+
+    return m_asyncReader.get();
+}
+
+void FileSystem::InvalidateResolvedPaths()
+{
+    std::scoped_lock<std::mutex> lock(m_resolvedPathLock);
+    m_resolvedPaths.clear();
+}
+
+void FileSystem::InvalidateResolvedPath(fs::path filePath)
+{
+    std::scoped_lock<std::mutex> lock(m_resolvedPathLock);
+    m_resolvedPaths.erase(filePath.lexically_normal().generic_string());
+}
+
+bool FileSystem::StartWatching()
+{
+    // Depots that cannot change (e.g. archives) do not need watching.
+    bool anyWatched = false;
+    for(MountedDepotEntry& entry : m_mountedDepots)
+    {
+        anyWatched |= entry.fileDepot->StartWatching();
+    }
+
+    m_watching = true;
+    return anyWatched;
+}
+
+std::vector<fs::path> FileSystem::CollectChangedFiles()
+{
+    std::vector<fs::path> changedFiles;
+    std::vector<fs::path> depotPaths;
+
+    for(MountedDepotEntry& entry : m_mountedDepots)
+    {
+        depotPaths.clear();
+        entry.fileDepot->CollectChangedFiles(depotPaths);
+
+        for(const fs::path& depotPath : depotPaths)
+        {
+            changedFiles.push_back((entry.mountPath / depotPath).lexically_normal());
+        }
+    }
+
+    // Files are often reported multiple times when saved.
+    std::sort(changedFiles.begin(), changedFiles.end());
+    changedFiles.erase(std::unique(changedFiles.begin(), changedFiles.end()), changedFiles.end());
+
+    for(const fs::path& changedFile : changedFiles)
+    {
+        InvalidateResolvedPath(changedFile);
+    }
+
+    return changedFiles;
+}
+
+bool FileSystem::IsWatching() const
+{
+    return m_watching;
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/FileWatcher.hpp"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+    #define INOTIFY_SUPPORTED
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+using namespace System;
+
+namespace
+{
+    const char* CreateError = "Failed to create file watcher! {}";
+
+#ifdef INOTIFY_SUPPORTED
+    const uint32_t WatchedEvents = IN_CLOSE_WRITE | IN_MOVED_TO;
+#endif
+}
+
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher()
+{
+#ifdef INOTIFY_SUPPORTED
+    if(m_descriptor != -1)
+    {
+        close(m_descriptor);
+    }
+#endif
+}
+
+FileWatcher::CreateResult FileWatcher::Create()
+{
+#ifdef INOTIFY_SUPPORTED
+    int descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(descriptor == -1)
+    {
+        LOG_ERROR(CreateError, "Could not initialize inotify instance.");
+        return Common::Failure();
+    }
+
+    auto instance = std::unique_ptr<FileWatcher>(new FileWatcher());
+    instance->m_descriptor = descriptor;
+
+    LOG_SUCCESS("Created file watcher.");
+    return Common::Success(std::move(instance));
+#else
+    LOG_ERROR(CreateError, "Watching files is not supported on this platform.");
+    return Common::Failure();
+#endif
+}
+
+bool FileWatcher::IsSupported()
+{
+#ifdef INOTIFY_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileWatcher::WatchDirectory(const fs::path& directory)
+{
+    const fs::path normalDirectory = directory.empty() ? fs::path(".") : directory.lexically_normal();
+    std::string directoryKey = normalDirectory.generic_string();
+
+    // Called for every opened file, so directories that are
+    // already watched have to be skipped without system calls.
+    std::scoped_lock<std::mutex> lock(m_lock);
+    if(m_watchedPaths.count(directoryKey) != 0)
+        return true;
+
+#ifdef INOTIFY_SUPPORTED
+    int watchDescriptor = inotify_add_watch(m_descriptor, directoryKey.c_str(), WatchedEvents);
+    if(watchDescriptor == -1)
+    {
+        LOG_WARNING("Could not watch \"{}\" directory for changes!", directoryKey);
+        return false;
+    }
+
+    // Same directory reached through different paths shares its watch.
+    m_watchedDirectories.insert_or_assign(watchDescriptor, normalDirectory);
+    m_watchedPaths.insert(std::move(directoryKey));
+
+    LOG_INFO("Watching \"{}\" directory for changes.", normalDirectory.generic_string());
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileWatcher::CollectChanges(std::vector<fs::path>& changedFiles)
+{
+#ifdef INOTIFY_SUPPORTED
+    std::scoped_lock<std::mutex> lock(m_lock);
+
+    // Read all queued events, as descriptor does not block when none are left.
+    alignas(inotify_event) char buffer[4096];
+
+    while(true)
+    {
+        ssize_t bytesRead = read(m_descriptor, buffer, sizeof(buffer));
+        if(bytesRead <= 0)
+            break;
+
+        for(ssize_t offset = 0; offset < bytesRead;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW)
+            {
+                LOG_WARNING("File watcher event queue has overflown, some changes have been missed!");
+                continue;
+            }
+
+            auto directoryIt = m_watchedDirectories.find(event->wd);
+            if(directoryIt == m_watchedDirectories.end())
+                continue;
+
+            if(event->mask & IN_IGNORED)
+            {
+                // Directory has been removed, so it can be watched again once recreated.
+                m_watchedPaths.erase(directoryIt->second.generic_string());
+                m_watchedDirectories.erase(directoryIt);
+                continue;
+            }
+
+            if(event->len != 0 && (event->mask & WatchedEvents))
+            {
+                changedFiles.push_back(directoryIt->second / event->name);
+            }
+        }
+    }
+#endif
+}
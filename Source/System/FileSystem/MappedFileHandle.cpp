@@ -0,0 +1,211 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/MappedFileHandle.hpp"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    #define MAPPED_FILES_SUPPORTED
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace System;
+
+MappedFileHandle::Mapping::Mapping() = default;
+
+MappedFileHandle::Mapping::~Mapping()
+{
+#ifdef MAPPED_FILES_SUPPORTED
+    if(m_address != nullptr)
+    {
+        munmap(m_address, m_size);
+    }
+
+    if(m_fileDescriptor != -1)
+    {
+        close(m_fileDescriptor);
+    }
+#endif
+}
+
+MappedFileHandle::Mapping::CreateResult MappedFileHandle::Mapping::Create(const fs::path& filePath)
+{
+#ifdef MAPPED_FILES_SUPPORTED
+    errno = 0;
+    int fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    auto GetOpenFileError = []()
+    {
+        switch(errno)
+        {
+        case ENOENT: return OpenFileErrors::FileNotFound;
+        case EACCES: return OpenFileErrors::AccessDenied;
+        case EMFILE: return OpenFileErrors::TooManyHandles;
+        case EFBIG: return OpenFileErrors::FileTooLarge;
+        default: return OpenFileErrors::UnknownFileOpeningError;
+        }
+    };
+
+    if(fileDescriptor == -1)
+        return Common::Failure(GetOpenFileError());
+
+    // File descriptor is kept open for asynchronous reads and closed along with mapping.
+    auto instance = std::shared_ptr<Mapping>(new Mapping());
+    instance->m_fileDescriptor = fileDescriptor;
+
+    struct stat fileStatus;
+    if(fstat(fileDescriptor, &fileStatus) != 0)
+        return Common::Failure(GetOpenFileError());
+
+    if(!S_ISREG(fileStatus.st_mode))
+        return Common::Failure(OpenFileErrors::FileNotFound);
+
+    instance->m_size = Common::NumericalCast<uint64_t>(fileStatus.st_size);
+
+    // Empty files cannot be mapped, but there is nothing to read anyway.
+    if(instance->m_size != 0)
+    {
+        void* address = mmap(nullptr, instance->m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if(address == MAP_FAILED)
+            return Common::Failure(GetOpenFileError());
+
+        instance->m_address = address;
+    }
+
+    return Common::Success(std::move(instance));
+#else
+    return Common::Failure(OpenFileErrors::UnknownFileOpeningError);
+#endif
+}
+
+const uint8_t* MappedFileHandle::Mapping::GetData() const
+{
+    return static_cast<const uint8_t*>(m_address);
+}
+
+uint64_t MappedFileHandle::Mapping::GetSize() const
+{
+    return m_size;
+}
+
+int MappedFileHandle::Mapping::GetFileDescriptor() const
+{
+    return m_fileDescriptor;
+}
+
+MappedFileHandle::MappedFileHandle(const fs::path& path, OpenFlags::Type flags) :
+    FileHandle(path, flags)
+{
+}
+
+MappedFileHandle::~MappedFileHandle() = default;
+
+bool MappedFileHandle::IsSupported()
+{
+#ifdef MAPPED_FILES_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+FileDepot::OpenFileResult MappedFileHandle::Create(const fs::path& filePath,
+    const fs::path& requestedPath, OpenFlags::Type openFlags)
+{
+    CHECK_ARGUMENT_OR_RETURN(openFlags == OpenFlags::Read,
+        Common::Failure(OpenFileErrors::InvalidOpenFlagsArgument));
+
+    auto mappingResult = Mapping::Create(filePath);
+    if(!mappingResult)
+        return Common::Failure(mappingResult.UnwrapFailure());
+
+    MappingPtr mapping = mappingResult.Unwrap();
+    uint64_t size = mapping->GetSize();
+    return Create(std::move(mapping), 0, size, requestedPath, openFlags);
+}
+
+FileDepot::OpenFileResult MappedFileHandle::Create(MappingPtr mapping, uint64_t offset,
+    uint64_t size, const fs::path& requestedPath, OpenFlags::Type openFlags)
+{
+    CHECK_ARGUMENT_OR_RETURN(mapping != nullptr,
+        Common::Failure(OpenFileErrors::UnknownFileOpeningError));
+    CHECK_ARGUMENT_OR_RETURN(offset <= mapping->GetSize() && size <= mapping->GetSize() - offset,
+        Common::Failure(OpenFileErrors::UnknownFileOpeningError));
+    CHECK_ARGUMENT_OR_RETURN(openFlags == OpenFlags::Read,
+        Common::Failure(OpenFileErrors::InvalidOpenFlagsArgument));
+
+    auto instance = std::unique_ptr<MappedFileHandle>(
+        new MappedFileHandle(requestedPath, openFlags));
+    instance->m_data = size != 0 ? mapping->GetData() + offset : nullptr;
+    instance->m_offset = offset;
+    instance->m_size = size;
+    instance->m_mapping = std::move(mapping);
+
+    return Common::Success(std::move(instance));
+}
+
+uint64_t MappedFileHandle::Tell()
+{
+    return m_position;
+}
+
+uint64_t MappedFileHandle::Seek(uint64_t offset, SeekMode mode)
+{
+    switch(mode)
+    {
+    case FileHandle::SeekMode::Begin:
+        m_position = offset;
+        break;
+    case FileHandle::SeekMode::Current:
+        m_position += offset;
+        break;
+    case FileHandle::SeekMode::End:
+        m_position = m_size + offset;
+        break;
+    }
+
+    m_position = std::min(m_position, m_size);
+    return m_position;
+}
+
+uint64_t MappedFileHandle::Read(uint8_t* data, uint64_t bytes)
+{
+    uint64_t readBytes = std::min(bytes, m_size - m_position);
+    if(readBytes == 0)
+        return 0;
+
+    std::memcpy(data, m_data + m_position, readBytes);
+    m_position += readBytes;
+    return readBytes;
+}
+
+uint64_t MappedFileHandle::Write(const uint8_t* data, uint64_t bytes)
+{
+    // Mapped files are read only.
+    return 0;
+}
+
+bool MappedFileHandle::IsGood() const
+{
+    return m_position <= m_size;
+}
+
+uint64_t MappedFileHandle::GetSize() const
+{
+    return m_size;
+}
+
+FileHandle::MapResult MappedFileHandle::Map()
+{
+    return Common::Success(MappedView{ m_data, m_size });
+}
+
+FileHandle::NativeResult MappedFileHandle::GetNative()
+{
+    return Common::Success(NativeView{ m_mapping->GetFileDescriptor(), m_offset, m_size });
+}
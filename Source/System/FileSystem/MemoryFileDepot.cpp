@@ -2,3 +2,111 @@
     Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
     Software distributed under the permissive MIT License.
 */
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/MemoryFileDepot.hpp"
+using namespace System;
+
+namespace
+{
+    std::string NormalizeFilePath(const fs::path& path)
+    {
+        // Paths are stored in same form as depot paths passed by file system.
+        return path.lexically_normal().generic_string();
+    }
+}
+
+MemoryFileDepot::MemoryFileDepot() = default;
+MemoryFileDepot::~MemoryFileDepot() = default;
+
+MemoryFileDepot::CreateResult MemoryFileDepot::Create()
+{
+    auto instance = std::unique_ptr<MemoryFileDepot>(new MemoryFileDepot());
+
+    LOG_SUCCESS("Created memory file depot.");
+    return Common::Success(std::move(instance));
+}
+
+MemoryFileDepot::AddFileResult MemoryFileDepot::AddFile(
+    const fs::path& path, MemoryFileHandle::BufferPtr buffer)
+{
+    CHECK_ARGUMENT_OR_RETURN(buffer != nullptr,
+        Common::Failure(AddFileErrors::InvalidBufferArgument));
+
+    MemoryFile file;
+    file.buffer = std::move(buffer);
+    return AddFile(path, std::move(file));
+}
+
+MemoryFileDepot::AddFileResult MemoryFileDepot::AddFile(
+    const fs::path& path, const uint8_t* data, std::size_t size)
+{
+    CHECK_ARGUMENT_OR_RETURN(data != nullptr || size == 0,
+        Common::Failure(AddFileErrors::InvalidBufferArgument));
+
+    MemoryFile file;
+    file.data = data;
+    file.size = size;
+    return AddFile(path, std::move(file));
+}
+
+MemoryFileDepot::AddFileResult MemoryFileDepot::AddFile(const fs::path& path, MemoryFile file)
+{
+    CHECK_ARGUMENT_OR_RETURN(!path.empty(),
+        Common::Failure(AddFileErrors::EmptyFilePathArgument));
+    CHECK_ARGUMENT_OR_RETURN(path.is_relative() && path.has_filename(),
+        Common::Failure(AddFileErrors::InvalidFilePathArgument));
+
+    std::string filePath = NormalizeFilePath(path);
+    CHECK_ARGUMENT_OR_RETURN(filePath.rfind("..", 0) != 0,
+        Common::Failure(AddFileErrors::InvalidFilePathArgument));
+
+    // Adding file with existing path replaces it, without affecting opened handles.
+    std::scoped_lock<std::mutex> lock(m_fileLock);
+    m_files.insert_or_assign(std::move(filePath), std::move(file));
+    return Common::Success();
+}
+
+bool MemoryFileDepot::RemoveFile(const fs::path& path)
+{
+    std::scoped_lock<std::mutex> lock(m_fileLock);
+    return m_files.erase(NormalizeFilePath(path)) != 0;
+}
+
+FileDepot::OpenFileResult MemoryFileDepot::OpenFile(const fs::path& depotPath,
+    const fs::path& requestedPath, FileHandle::OpenFlags::Type openFlags)
+{
+    std::scoped_lock<std::mutex> lock(m_fileLock);
+
+    auto it = m_files.find(NormalizeFilePath(depotPath));
+    if(it == m_files.end())
+    {
+        if(!(openFlags & FileHandle::OpenFlags::Write))
+            return Common::Failure(OpenFileErrors::FileNotFound);
+
+        // Create new owned file when opening for writing.
+        MemoryFile file;
+        file.buffer = std::make_shared<MemoryFileHandle::Buffer>();
+        it = m_files.emplace(NormalizeFilePath(depotPath), std::move(file)).first;
+    }
+
+    const MemoryFile& file = it->second;
+    if(file.buffer != nullptr)
+    {
+        return MemoryFileHandle::Create(file.buffer, requestedPath, openFlags);
+    }
+
+    if(openFlags != FileHandle::OpenFlags::Read)
+    {
+        LOG_ERROR("Cannot open \"{}\" read only memory file for writing!", depotPath.generic_string());
+        return Common::Failure(OpenFileErrors::AccessDenied);
+    }
+
+    return MemoryFileHandle::Create(file.data, file.size, requestedPath, openFlags);
+}
+
+std::size_t MemoryFileDepot::GetFileCount() const
+{
+    std::scoped_lock<std::mutex> lock(m_fileLock);
+    return m_files.size();
+}
@@ -2,3 +2,128 @@
     Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
     Software distributed under the permissive MIT License.
 */
+
+#include "System/Precompiled.hpp"
+#include "System/FileSystem/MemoryFileHandle.hpp"
+using namespace System;
+
+MemoryFileHandle::MemoryFileHandle(const fs::path& path, OpenFlags::Type flags) :
+    FileHandle(path, flags)
+{
+}
+
+MemoryFileHandle::~MemoryFileHandle() = default;
+
+FileDepot::OpenFileResult MemoryFileHandle::Create(BufferPtr buffer,
+    const fs::path& requestedPath, OpenFlags::Type openFlags)
+{
+    CHECK_ARGUMENT_OR_RETURN(buffer != nullptr,
+        Common::Failure(OpenFileErrors::UnknownFileOpeningError));
+    CHECK_ARGUMENT_OR_RETURN(openFlags & (OpenFlags::Read | OpenFlags::Write),
+        Common::Failure(OpenFileErrors::InvalidOpenFlagsArgument));
+
+    auto instance = std::unique_ptr<MemoryFileHandle>(
+        new MemoryFileHandle(requestedPath, openFlags));
+    instance->m_buffer = std::move(buffer);
+
+    if(openFlags & OpenFlags::Truncate)
+    {
+        instance->m_buffer->clear();
+    }
+
+    if(openFlags & OpenFlags::Append)
+    {
+        instance->m_position = instance->m_buffer->size();
+    }
+
+    return Common::Success(std::move(instance));
+}
+
+FileDepot::OpenFileResult MemoryFileHandle::Create(const uint8_t* data, uint64_t size,
+    const fs::path& requestedPath, OpenFlags::Type openFlags)
+{
+    CHECK_ARGUMENT_OR_RETURN(data != nullptr || size == 0,
+        Common::Failure(OpenFileErrors::UnknownFileOpeningError));
+    CHECK_ARGUMENT_OR_RETURN(openFlags == OpenFlags::Read,
+        Common::Failure(OpenFileErrors::InvalidOpenFlagsArgument));
+
+    auto instance = std::unique_ptr<MemoryFileHandle>(
+        new MemoryFileHandle(requestedPath, openFlags));
+    instance->m_borrowedData = data;
+    instance->m_borrowedSize = size;
+
+    return Common::Success(std::move(instance));
+}
+
+uint64_t MemoryFileHandle::Tell()
+{
+    return m_position;
+}
+
+uint64_t MemoryFileHandle::Seek(uint64_t offset, SeekMode mode)
+{
+    switch(mode)
+    {
+    case FileHandle::SeekMode::Begin:
+        m_position = offset;
+        break;
+    case FileHandle::SeekMode::Current:
+        m_position += offset;
+        break;
+    case FileHandle::SeekMode::End:
+        m_position = GetSize() + offset;
+        break;
+    }
+
+    m_position = std::min<uint64_t>(m_position, GetSize());
+    return m_position;
+}
+
+uint64_t MemoryFileHandle::Read(uint8_t* data, uint64_t bytes)
+{
+    if(!(GetFlags() & OpenFlags::Read))
+        return 0;
+
+    uint64_t readBytes = std::min<uint64_t>(bytes, GetSize() - m_position);
+    if(readBytes == 0)
+        return 0;
+
+    std::memcpy(data, GetData() + m_position, readBytes);
+    m_position += readBytes;
+    return readBytes;
+}
+
+uint64_t MemoryFileHandle::Write(const uint8_t* data, uint64_t bytes)
+{
+    if(!(GetFlags() & OpenFlags::Write) || m_buffer == nullptr)
+        return 0;
+
+    if(m_position + bytes > m_buffer->size())
+    {
+        m_buffer->resize(m_position + bytes);
+    }
+
+    std::memcpy(m_buffer->data() + m_position, data, bytes);
+    m_position += bytes;
+    return bytes;
+}
+
+bool MemoryFileHandle::IsGood() const
+{
+    return m_position <= GetSize();
+}
+
+uint64_t MemoryFileHandle::GetSize() const
+{
+    return m_buffer != nullptr ? m_buffer->size() : m_borrowedSize;
+}
+
+FileHandle::MapResult MemoryFileHandle::Map()
+{
+    return Common::Success(MappedView{ GetData(), GetSize() });
+}
+
+const uint8_t* MemoryFileHandle::GetData() const
+{
+    return m_buffer != nullptr ? m_buffer->data() : m_borrowedData;
+}
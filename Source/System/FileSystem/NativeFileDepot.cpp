@@ -6,6 +6,7 @@
 #include "System/Precompiled.hpp"
 #include "System/FileSystem/NativeFileDepot.hpp"
 #include "System/FileSystem/NativeFileHandle.hpp"
+#include "System/FileSystem/MappedFileHandle.hpp"
 using namespace System;
 
 namespace
@@ -39,5 +40,50 @@ FileDepot::OpenFileResult NativeFileDepot::OpenFile(const fs::path& depotPath,
     const fs::path& requestedPath, FileHandle::OpenFlags::Type openFlags)
 {
     fs::path resolvedPath = m_fileDirectory / depotPath;
-    return NativeFileHandle::Create(resolvedPath, requestedPath, openFlags);
+    const bool readOnly = openFlags == FileHandle::OpenFlags::Read;
+
+    // Map files that are only read, unless mapping is not possible.
+    OpenFileResult openFileResult = Common::Failure(OpenFileErrors::UnknownFileOpeningError);
+    if(readOnly && MappedFileHandle::IsSupported())
+    {
+        openFileResult = MappedFileHandle::Create(resolvedPath, requestedPath, openFlags);
+    }
+
+    if(!openFileResult && openFileResult.UnwrapFailure() != OpenFileErrors::FileNotFound)
+    {
+        openFileResult = NativeFileHandle::Create(resolvedPath, requestedPath, openFlags);
+    }
+
+    // Watch directory of file that has been read, so it can be reloaded when changed.
+    if(openFileResult && readOnly && m_fileWatcher != nullptr)
+    {
+        m_fileWatcher->WatchDirectory(resolvedPath.parent_path());
+    }
+
+    return openFileResult;
+}
+
+bool NativeFileDepot::StartWatching()
+{
+    // Must be started before files are opened from other threads.
+    if(m_fileWatcher == nullptr)
+    {
+        m_fileWatcher = FileWatcher::Create().UnwrapOr(nullptr);
+    }
+
+    return m_fileWatcher != nullptr;
+}
+
+void NativeFileDepot::CollectChangedFiles(std::vector<fs::path>& depotPaths)
+{
+    if(m_fileWatcher == nullptr)
+        return;
+
+    std::vector<fs::path> changedFiles;
+    m_fileWatcher->CollectChanges(changedFiles);
+
+    for(const fs::path& changedFile : changedFiles)
+    {
+        depotPaths.push_back(changedFile.lexically_relative(m_fileDirectory));
+    }
 }
@@ -70,8 +70,10 @@ FileDepot::OpenFileResult NativeFileHandle::Create(const fs::path& filePath,
         return Common::Failure(error);
     }
 
-    instance->m_stream.ignore(std::numeric_limits<std::streamsize>::max());
-    instance->m_size = instance->m_stream.gcount();
+    // Determine file size by seeking to its end instead of reading it whole.
+    instance->m_stream.seekg(0, std::ios_base::end);
+    std::streamoff fileSize = instance->m_stream.tellg();
+    instance->m_size = fileSize > 0 ? Common::NumericalCast<uint64_t>(fileSize) : 0;
     instance->m_stream.clear();
     instance->m_stream.seekg(0, std::ios_base::beg);
 
@@ -0,0 +1,104 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include "System/Precompiled.hpp"
+#include "System/FramePacer.hpp"
+#include <thread>
+using namespace System;
+
+FramePacer::FramePacer()
+{
+    SetSpinSeconds(DefaultSpinSeconds);
+    Reset();
+}
+
+FramePacer::~FramePacer() = default;
+
+void FramePacer::SetTargetFrameRate(float frameRate)
+{
+    ASSERT(frameRate >= 0.0f, "Target frame rate cannot be negative!");
+
+    m_targetFrameRate = std::max(0.0f, frameRate);
+    m_frameDuration = m_targetFrameRate > 0.0f ?
+        std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / m_targetFrameRate)) :
+        Clock::duration::zero();
+}
+
+void FramePacer::SetSpinSeconds(float spinSeconds)
+{
+    m_spinDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(std::max(0.0f, spinSeconds)));
+}
+
+void FramePacer::Reset()
+{
+    m_nextFrameTime = Clock::now();
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if(m_frameDuration == Clock::duration::zero())
+        return;
+
+    // Schedule next frame relative to previous one, so frame times do not drift.
+    m_nextFrameTime += m_frameDuration;
+
+    const Clock::time_point waitStart = Clock::now();
+    if(m_nextFrameTime <= waitStart)
+    {
+        // Frame took too long, continue pacing from now
+        // instead of rushing through missed frames.
+        m_nextFrameTime = waitStart;
+        m_lastWaitSeconds = 0.0f;
+        m_lastWakeErrorSeconds = 0.0f;
+        m_missedFrameCount++;
+        return;
+    }
+
+    // Sleep through most of remaining time, as long as
+    // scheduler has enough time left to wake us up early.
+    const Clock::time_point sleepEnd = m_nextFrameTime - m_spinDuration;
+    if(sleepEnd > waitStart)
+    {
+        std::this_thread::sleep_until(sleepEnd);
+    }
+
+    // Spin for remaining time, unless sleep already overshot.
+    Clock::time_point currentTime = Clock::now();
+    while(currentTime < m_nextFrameTime)
+    {
+        std::this_thread::yield();
+        currentTime = Clock::now();
+    }
+
+    m_lastWaitSeconds = std::chrono::duration<float>(currentTime - waitStart).count();
+    m_lastWakeErrorSeconds = std::chrono::duration<float>(currentTime - m_nextFrameTime).count();
+}
+
+float FramePacer::GetTargetFrameRate() const
+{
+    return m_targetFrameRate;
+}
+
+float FramePacer::GetSpinSeconds() const
+{
+    return std::chrono::duration<float>(m_spinDuration).count();
+}
+
+float FramePacer::GetLastWaitSeconds() const
+{
+    return m_lastWaitSeconds;
+}
+
+float FramePacer::GetLastWakeErrorSeconds() const
+{
+    return m_lastWakeErrorSeconds;
+}
+
+uint64_t FramePacer::GetMissedFrameCount() const
+{
+    return m_missedFrameCount;
+}
@@ -8,47 +8,173 @@
 #include "System/FileSystem/FileHandle.hpp"
 using namespace System;
 
+namespace
+{
+    struct MemoryReader
+    {
+        const uint8_t* data = nullptr;
+        std::size_t size = 0;
+        std::size_t offset = 0;
+    };
+
+    /*
+        QOI format constants, see specification at: https://qoiformat.org/
+    */
+
+    namespace QOI
+    {
+        constexpr uint8_t Magic[4] = { 'q', 'o', 'i', 'f' };
+        constexpr std::size_t HeaderSize = 14;
+        constexpr uint8_t Padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        constexpr uint64_t MaxPixels = 400000000;
+
+        constexpr uint8_t OpIndex = 0x00;
+        constexpr uint8_t OpDiff = 0x40;
+        constexpr uint8_t OpLuma = 0x80;
+        constexpr uint8_t OpRun = 0xc0;
+        constexpr uint8_t OpRGB = 0xfe;
+        constexpr uint8_t OpRGBA = 0xff;
+        constexpr uint8_t OpMask = 0xc0;
+
+        struct Pixel
+        {
+            uint8_t r = 0;
+            uint8_t g = 0;
+            uint8_t b = 0;
+            uint8_t a = 0;
+
+            bool operator==(const Pixel& other) const
+            {
+                return r == other.r && g == other.g && b == other.b && a == other.a;
+            }
+
+            bool operator!=(const Pixel& other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        inline uint8_t Hash(const Pixel& pixel)
+        {
+            return (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        }
+
+        inline uint32_t ReadUint32(const uint8_t* bytes)
+        {
+            return uint32_t(bytes[0]) << 24 | uint32_t(bytes[1]) << 16 |
+                uint32_t(bytes[2]) << 8 | uint32_t(bytes[3]);
+        }
+
+        inline void WriteUint32(Image::Data& bytes, uint32_t value)
+        {
+            bytes.push_back(static_cast<uint8_t>(value >> 24));
+            bytes.push_back(static_cast<uint8_t>(value >> 16));
+            bytes.push_back(static_cast<uint8_t>(value >> 8));
+            bytes.push_back(static_cast<uint8_t>(value));
+        }
+    }
+}
+
 Image::Image() = default;
 Image::~Image() = default;
 
+Image::CreateResult Image::Create(const CreateFromParams& params)
+{
+    CHECK_ARGUMENT_OR_RETURN(params.width > 0 && params.height > 0,
+        Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(params.channels >= 1 && params.channels <= 4,
+        Common::Failure(CreateErrors::InvalidArgument));
+    CHECK_ARGUMENT_OR_RETURN(params.data.size() ==
+        std::size_t(params.width) * params.height * params.channels,
+        Common::Failure(CreateErrors::InvalidArgument));
+
+    auto instance = std::unique_ptr<Image>(new Image());
+    instance->m_data = params.data;
+    instance->m_width = params.width;
+    instance->m_height = params.height;
+    instance->m_channels = params.channels;
+
+    return Common::Success(std::move(instance));
+}
+
 Image::CreateResult Image::Create(FileHandle& file, const LoadFromFile& params)
 {
     LOG("Loading image from \"{}\" file...", file.GetPath().generic_string());
     LOG_SCOPED_INDENT();
 
+    Format format = GetFormatFromExtension(file.GetPath());
+    if(format == Format::Unknown)
+    {
+        return Common::Failure(CreateErrors::UnknownExtension);
+    }
+
+    // Decode from mapped file contents when possible to avoid copies.
+    std::vector<uint8_t> buffer;
+    FileHandle::MappedView view = file.MapOrRead(buffer);
+    if(view.size != file.GetSize())
+    {
+        LOG_ERROR("Could not read image file!");
+        return Common::Failure(CreateErrors::FailedFileRead);
+    }
+
+    LoadFromMemory loadParams;
+    loadParams.data = view.data;
+    loadParams.size = view.size;
+    loadParams.format = format;
+    return Create(loadParams);
+}
+
+Image::CreateResult Image::Create(const LoadFromMemory& params)
+{
+    CHECK_ARGUMENT_OR_RETURN(params.data != nullptr || params.size == 0,
+        Common::Failure(CreateErrors::InvalidArgument));
+
     auto instance = std::unique_ptr<Image>(new Image());
 
-    fs::path extension = file.GetPath().extension();
-    if(extension == ".png")
+    switch(params.format)
     {
-        if(auto failureResult = instance->LoadPNG(file).AsFailure())
+    case Format::PNG:
+        if(auto failureResult = instance->LoadPNG(params.data, params.size).AsFailure())
         {
             return Common::Failure(failureResult.Unwrap());
         }
-    }
-    else
-    {
-        return Common::Failure(CreateErrors::UnknownExtension);
+        break;
+
+    case Format::QOI:
+        if(auto failureResult = instance->LoadQOI(params.data, params.size).AsFailure())
+        {
+            return Common::Failure(failureResult.Unwrap());
+        }
+        break;
+
+    default:
+        return Common::Failure(CreateErrors::InvalidArgument);
     }
 
     return Common::Success(std::move(instance));
 }
 
-Common::FailureResult<Image::CreateErrors> Image::LoadPNG(FileHandle& file)
+Image::Format Image::GetFormatFromExtension(const fs::path& path)
 {
-    LOG("Loading PNG image from \"{}\" file...", file.GetPath().generic_string());
-    LOG_SCOPED_INDENT();
+    fs::path extension = path.extension();
+    if(extension == ".png")
+        return Format::PNG;
+    if(extension == ".qoi")
+        return Format::QOI;
 
-    const size_t png_sig_size = 8;
-    png_byte png_sig[png_sig_size];
+    return Format::Unknown;
+}
 
-    if(file.Read(png_sig, png_sig_size) != png_sig_size)
+Common::FailureResult<Image::CreateErrors> Image::LoadPNG(const uint8_t* data, std::size_t size)
+{
+    const size_t png_sig_size = 8;
+    if(size < png_sig_size)
     {
         LOG_ERROR("Could not read file header!");
         return Common::Failure(CreateErrors::FailedFileRead);
     }
 
-    if(png_sig_cmp(png_sig, 0, png_sig_size) != 0)
+    if(png_sig_cmp(data, 0, png_sig_size) != 0)
     {
         LOG_ERROR("File path does not contain valid PNG file!");
         return Common::Failure(CreateErrors::FailedPngLoad);
@@ -78,13 +204,22 @@ Common::FailureResult<Image::CreateErrors> Image::LoadPNG(FileHandle& file)
         png_destroy_info_struct(png_read_ptr, &png_info_ptr);
     });
 
-    auto png_read_function = [](png_structp png_ptr, png_bytep data, png_size_t length) -> void
+    // Read from memory instead of through file handle for each chunk.
+    MemoryReader png_reader;
+    png_reader.data = data;
+    png_reader.size = size;
+    png_reader.offset = png_sig_size;
+
+    auto png_read_function = [](png_structp png_ptr, png_bytep bytes, png_size_t length) -> void
     {
-        auto* file = (System::FileHandle*)png_get_io_ptr(png_ptr);
-        if(file->Read((uint8_t*)data, length) != length)
+        auto* reader = (MemoryReader*)png_get_io_ptr(png_ptr);
+        if(length > reader->size - reader->offset)
         {
             png_error(png_ptr, "Unexpected end of file!");
         }
+
+        std::memcpy(bytes, reader->data + reader->offset, length);
+        reader->offset += length;
     };
 
     png_bytep* png_row_ptrs = nullptr;
@@ -107,7 +242,7 @@ Common::FailureResult<Image::CreateErrors> Image::LoadPNG(FileHandle& file)
         return Common::Failure(CreateErrors::FailedPngLoad);
     }
 
-    png_set_read_fn(png_read_ptr, (png_voidp)&file, png_read_function);
+    png_set_read_fn(png_read_ptr, (png_voidp)&png_reader, png_read_function);
     png_set_sig_bytes(png_read_ptr, png_sig_size);
     png_read_info(png_read_ptr, png_info_ptr);
 
@@ -193,6 +328,240 @@ Common::FailureResult<Image::CreateErrors> Image::LoadPNG(FileHandle& file)
     return Common::Success();
 }
 
+Common::FailureResult<Image::CreateErrors> Image::LoadQOI(const uint8_t* data, std::size_t size)
+{
+    if(size < QOI::HeaderSize + sizeof(QOI::Padding) ||
+        std::memcmp(data, QOI::Magic, sizeof(QOI::Magic)) != 0)
+    {
+        LOG_ERROR("File does not contain valid QOI image!");
+        return Common::Failure(CreateErrors::FailedQoiLoad);
+    }
+
+    const uint32_t width = QOI::ReadUint32(data + 4);
+    const uint32_t height = QOI::ReadUint32(data + 8);
+    const uint8_t channels = data[12];
+
+    if(width == 0 || height == 0 || (channels != 3 && channels != 4) ||
+        uint64_t(width) * height > QOI::MaxPixels)
+    {
+        LOG_ERROR("Unsupported QOI image header!");
+        return Common::Failure(CreateErrors::FailedQoiLoad);
+    }
+
+    m_data.resize(std::size_t(width) * height * channels);
+
+    QOI::Pixel index[64] = {};
+    QOI::Pixel pixel;
+    pixel.a = 255;
+
+    const std::size_t chunksEnd = size - sizeof(QOI::Padding);
+    std::size_t position = QOI::HeaderSize;
+    uint32_t run = 0;
+
+    for(uint32_t y = 0; y < height; ++y)
+    {
+        // Reverse order of rows to flip image because
+        // OpenGL's texture coordinates are also flipped.
+        uint8_t* row = m_data.data() + std::size_t(height - y - 1) * width * channels;
+
+        for(uint32_t x = 0; x < width; ++x)
+        {
+            if(run > 0)
+            {
+                --run;
+            }
+            else if(position < chunksEnd)
+            {
+                const uint8_t op = data[position++];
+
+                if(op == QOI::OpRGB)
+                {
+                    if(chunksEnd - position < 3)
+                        return Common::Failure(CreateErrors::FailedQoiLoad);
+
+                    pixel.r = data[position++];
+                    pixel.g = data[position++];
+                    pixel.b = data[position++];
+                }
+                else if(op == QOI::OpRGBA)
+                {
+                    if(chunksEnd - position < 4)
+                        return Common::Failure(CreateErrors::FailedQoiLoad);
+
+                    pixel.r = data[position++];
+                    pixel.g = data[position++];
+                    pixel.b = data[position++];
+                    pixel.a = data[position++];
+                }
+                else if((op & QOI::OpMask) == QOI::OpIndex)
+                {
+                    pixel = index[op];
+                }
+                else if((op & QOI::OpMask) == QOI::OpDiff)
+                {
+                    pixel.r += ((op >> 4) & 0x03) - 2;
+                    pixel.g += ((op >> 2) & 0x03) - 2;
+                    pixel.b += (op & 0x03) - 2;
+                }
+                else if((op & QOI::OpMask) == QOI::OpLuma)
+                {
+                    if(chunksEnd - position < 1)
+                        return Common::Failure(CreateErrors::FailedQoiLoad);
+
+                    const uint8_t next = data[position++];
+                    const int greenDiff = (op & 0x3f) - 32;
+                    pixel.r += greenDiff - 8 + ((next >> 4) & 0x0f);
+                    pixel.g += greenDiff;
+                    pixel.b += greenDiff - 8 + (next & 0x0f);
+                }
+                else
+                {
+                    run = op & 0x3f;
+                }
+
+                index[QOI::Hash(pixel)] = pixel;
+            }
+            else
+            {
+                LOG_ERROR("Unexpected end of QOI image data!");
+                return Common::Failure(CreateErrors::FailedQoiLoad);
+            }
+
+            uint8_t* output = row + std::size_t(x) * channels;
+            output[0] = pixel.r;
+            output[1] = pixel.g;
+            output[2] = pixel.b;
+
+            if(channels == 4)
+            {
+                output[3] = pixel.a;
+            }
+        }
+    }
+
+    if(std::memcmp(data + chunksEnd, QOI::Padding, sizeof(QOI::Padding)) != 0)
+    {
+        LOG_ERROR("QOI image data is corrupted!");
+        return Common::Failure(CreateErrors::FailedQoiLoad);
+    }
+
+    m_width = width;
+    m_height = height;
+    m_channels = channels;
+
+    return Common::Success();
+}
+
+Image::EncodeResult Image::EncodeQOI() const
+{
+    // Format supports only RGB and RGBA images.
+    if(m_channels != 3 && m_channels != 4)
+        return Common::Failure();
+
+    Data bytes;
+    bytes.reserve(QOI::HeaderSize + m_data.size() + sizeof(QOI::Padding));
+    bytes.insert(bytes.end(), std::begin(QOI::Magic), std::end(QOI::Magic));
+    QOI::WriteUint32(bytes, static_cast<uint32_t>(m_width));
+    QOI::WriteUint32(bytes, static_cast<uint32_t>(m_height));
+    bytes.push_back(static_cast<uint8_t>(m_channels));
+    bytes.push_back(0);
+
+    QOI::Pixel index[64] = {};
+    QOI::Pixel previous;
+    previous.a = 255;
+
+    uint32_t run = 0;
+    const std::size_t pixelCount = std::size_t(m_width) * m_height;
+    std::size_t pixelIndex = 0;
+
+    for(int y = m_height - 1; y >= 0; --y)
+    {
+        // Rows are stored from top to bottom in file.
+        const uint8_t* row = m_data.data() + std::size_t(y) * m_width * m_channels;
+
+        for(int x = 0; x < m_width; ++x, ++pixelIndex)
+        {
+            const uint8_t* input = row + std::size_t(x) * m_channels;
+
+            QOI::Pixel pixel;
+            pixel.r = input[0];
+            pixel.g = input[1];
+            pixel.b = input[2];
+            pixel.a = m_channels == 4 ? input[3] : previous.a;
+
+            if(pixel == previous)
+            {
+                ++run;
+                if(run == 62 || pixelIndex + 1 == pixelCount)
+                {
+                    bytes.push_back(QOI::OpRun | static_cast<uint8_t>(run - 1));
+                    run = 0;
+                }
+
+                continue;
+            }
+
+            if(run > 0)
+            {
+                bytes.push_back(QOI::OpRun | static_cast<uint8_t>(run - 1));
+                run = 0;
+            }
+
+            const uint8_t hash = QOI::Hash(pixel);
+            if(index[hash] == pixel)
+            {
+                bytes.push_back(QOI::OpIndex | hash);
+            }
+            else
+            {
+                index[hash] = pixel;
+
+                if(pixel.a == previous.a)
+                {
+                    const int8_t redDiff = static_cast<int8_t>(pixel.r - previous.r);
+                    const int8_t greenDiff = static_cast<int8_t>(pixel.g - previous.g);
+                    const int8_t blueDiff = static_cast<int8_t>(pixel.b - previous.b);
+                    const int8_t redGreenDiff = redDiff - greenDiff;
+                    const int8_t blueGreenDiff = blueDiff - greenDiff;
+
+                    if(redDiff >= -2 && redDiff <= 1 && greenDiff >= -2 &&
+                        greenDiff <= 1 && blueDiff >= -2 && blueDiff <= 1)
+                    {
+                        bytes.push_back(QOI::OpDiff | static_cast<uint8_t>(
+                            (redDiff + 2) << 4 | (greenDiff + 2) << 2 | (blueDiff + 2)));
+                    }
+                    else if(redGreenDiff >= -8 && redGreenDiff <= 7 && greenDiff >= -32 &&
+                        greenDiff <= 31 && blueGreenDiff >= -8 && blueGreenDiff <= 7)
+                    {
+                        bytes.push_back(QOI::OpLuma | static_cast<uint8_t>(greenDiff + 32));
+                        bytes.push_back(static_cast<uint8_t>((redGreenDiff + 8) << 4 | (blueGreenDiff + 8)));
+                    }
+                    else
+                    {
+                        bytes.push_back(QOI::OpRGB);
+                        bytes.push_back(pixel.r);
+                        bytes.push_back(pixel.g);
+                        bytes.push_back(pixel.b);
+                    }
+                }
+                else
+                {
+                    bytes.push_back(QOI::OpRGBA);
+                    bytes.push_back(pixel.r);
+                    bytes.push_back(pixel.g);
+                    bytes.push_back(pixel.b);
+                    bytes.push_back(pixel.a);
+                }
+            }
+
+            previous = pixel;
+        }
+    }
+
+    bytes.insert(bytes.end(), std::begin(QOI::Padding), std::end(QOI::Padding));
+    return Common::Success(std::move(bytes));
+}
+
 const uint8_t* Image::GetData() const
 {
     return m_data.data();
@@ -64,6 +64,28 @@ InputState& InputManager::GetInputState()
     return m_inputState;
 }
 
+void InputManager::MarkEventsPolled()
+{
+    m_lastPollTime = std::chrono::steady_clock::now();
+}
+
+std::optional<InputManager::InputTime> InputManager::TakeEarliestInputTime()
+{
+    std::optional<InputTime> earliestInputTime = m_earliestInputTime;
+    m_earliestInputTime.reset();
+    return earliestInputTime;
+}
+
+void InputManager::MarkInputReceived()
+{
+    // Input could have been waiting in queue since previous poll,
+    // including time spent pacing frames after last present.
+    if(!m_earliestInputTime)
+    {
+        m_earliestInputTime = m_lastPollTime.value_or(std::chrono::steady_clock::now());
+    }
+}
+
 InputManager* InputManager::GetInputManagerFromUserData(GLFWwindow* handle)
 {
     ASSERT(handle != nullptr, "Window handle is invalid!");
@@ -78,6 +100,7 @@ InputManager* InputManager::GetInputManagerFromUserData(GLFWwindow* handle)
 void InputManager::TextInputCallback(GLFWwindow* handle, unsigned int character)
 {
     InputManager* inputManager = GetInputManagerFromUserData(handle);
+    inputManager->MarkInputReceived();
 
     InputEvents::TextInput outgoingEvent;
     outgoingEvent.utf32Character = character;
@@ -88,6 +111,7 @@ void InputManager::KeyboardKeyCallback(GLFWwindow* handle,
     int key, int scancode, int action, int mods)
 {
     InputManager* inputManager = GetInputManagerFromUserData(handle);
+    inputManager->MarkInputReceived();
 
     InputEvents::KeyboardKey outgoingEvent;
     outgoingEvent.key = TranslateKeyboardKey(key);
@@ -112,6 +136,7 @@ void InputManager::KeyboardKeyCallback(GLFWwindow* handle,
 void InputManager::MouseButtonCallback(GLFWwindow* handle, int button, int action, int mods)
 {
     InputManager* inputManager = GetInputManagerFromUserData(handle);
+    inputManager->MarkInputReceived();
 
     InputEvents::MouseButton outgoingEvent;
     outgoingEvent.button = TranslateMouseButton(button);
@@ -130,6 +155,7 @@ void InputManager::MouseButtonCallback(GLFWwindow* handle, int button, int actio
 void InputManager::MouseScrollCallback(GLFWwindow* handle, double offsetx, double offsety)
 {
     InputManager* inputManager = GetInputManagerFromUserData(handle);
+    inputManager->MarkInputReceived();
 
     InputEvents::MouseScroll outgoingEvent;
     outgoingEvent.offset = offsety;
@@ -139,6 +165,7 @@ void InputManager::MouseScrollCallback(GLFWwindow* handle, double offsetx, doubl
 void InputManager::CursorPositionCallback(GLFWwindow* handle, double x, double y)
 {
     InputManager* inputManager = GetInputManagerFromUserData(handle);
+    inputManager->MarkInputReceived();
 
     InputEvents::CursorPosition outgoingEvent;
     outgoingEvent.x = x;
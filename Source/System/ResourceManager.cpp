@@ -6,10 +6,16 @@
 #include "System/Precompiled.hpp"
 #include "System/ResourceManager.hpp"
 #include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include "System/FileSystem/FileWatcher.hpp"
 using namespace System;
 
 ResourceManager::ResourceManager() = default;
-ResourceManager::~ResourceManager() = default;
+
+ResourceManager::~ResourceManager()
+{
+    StopLoadingThreads();
+}
 
 bool ResourceManager::OnAttach(const Core::EngineSystemStorage& engineSystems)
 {
@@ -21,28 +27,529 @@ bool ResourceManager::OnAttach(const Core::EngineSystemStorage& engineSystems)
         return false;
     }
 
+    // Retrieve config variables.
+    Core::Config* config = engineSystems.Locate<Core::Config>();
+
+#ifdef __EMSCRIPTEN__
+    const int defaultLoadingThreads = 0;
+#else
+    const int defaultLoadingThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+#endif
+
+#ifndef NDEBUG
+    const bool defaultHotReload = FileWatcher::IsSupported();
+#else
+    const bool defaultHotReload = false;
+#endif
+
+    int loadingThreads = defaultLoadingThreads;
+    m_hotReload = defaultHotReload;
+
+    if(config != nullptr)
+    {
+        loadingThreads = config->Get<int>(NAME_CONSTEXPR("resources.loadingThreads")).UnwrapOr(defaultLoadingThreads);
+        m_finalizeBudget = config->Get<float>(NAME_CONSTEXPR("resources.finalizeBudget")).UnwrapOr(4.0f) / 1000.0f;
+
+        // Memory budget is specified in megabytes, with negative value meaning no budget.
+        int memoryBudget = config->Get<int>(NAME_CONSTEXPR("resources.memoryBudget")).UnwrapOr(256);
+        m_memoryBudget = memoryBudget >= 0 ? static_cast<std::size_t>(memoryBudget) * 1024 * 1024
+            : ResourcePoolInterface::UnlimitedBudget;
+
+        m_hotReload = config->Get<bool>(NAME_CONSTEXPR("resources.hotReload")).UnwrapOr(defaultHotReload);
+    }
+
+    // Start watching files before any are opened by loading threads.
+    if(m_hotReload && !m_fileSystem->StartWatching())
+    {
+        LOG_WARNING("Could not watch files for changes, resources will not be reloaded!");
+        m_hotReload = false;
+    }
+
+    // Start loading threads for asynchronous acquisitions. Without any, resources
+    // are both prepared and finalized on main thread when finalizing loads.
+    for(int i = 0; i < loadingThreads; ++i)
+    {
+        m_loadingThreads.emplace_back(&ResourceManager::RunLoadingThread, this);
+    }
+
     // Success!
     return true;
 }
 
+std::size_t ResourceManager::AllocateResourceTypeIndex()
+{
+    static std::atomic<std::size_t> nextIndex = 0;
+
+    std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    ASSERT(index < MaxResourceTypes, "Exceeded maximum number of resource types!");
+    return index;
+}
+
+void ResourceManager::SetMemoryBudget(std::size_t totalBytes)
+{
+    m_memoryBudget = totalBytes;
+}
+
+ResourceMemoryUsage ResourceManager::GetMemoryUsage() const
+{
+    ResourceMemoryUsage memoryUsage;
+    ForEachPool([&memoryUsage](ResourcePoolInterface& pool)
+    {
+        memoryUsage += pool.GetMemoryUsage();
+    });
+
+    return memoryUsage;
+}
+
 void ResourceManager::ReleaseUnused()
 {
-    // Release all unused resources from all pools.
-    for(auto& pair : m_pools)
+    // Release unused resources exceeding budgets of their pools.
+    ++m_releaseTick;
+
+    ForEachPool([this](ResourcePoolInterface& pool)
+    {
+        pool.ReleaseUnused(m_releaseTick);
+    });
+
+    // Release unused resources exceeding global budget, across all pools.
+    std::size_t totalBytes = GetMemoryUsage().GetTotalBytes();
+    if(totalBytes > m_memoryBudget)
     {
-        ASSERT(pair.second != nullptr, "Resource pool is null!");
-        auto& pool = pair.second;
-        pool->ReleaseUnused();
+        ResourcePoolInterface::UnusedResourceList unusedResources;
+        ForEachPool([&unusedResources](ResourcePoolInterface& pool)
+        {
+            pool.CollectUnused(unusedResources);
+        });
+
+        ResourcePoolInterface::ReleaseLeastRecentlyUsed(
+            unusedResources, totalBytes - m_memoryBudget);
     }
 }
 
 void ResourceManager::ReleaseAll()
 {
     // Release all resources from all pools.
-    for(auto& pair : m_pools)
+    ForEachPool([](ResourcePoolInterface& pool)
     {
-        ASSERT(pair.second != nullptr, "Resource pool is null!");
-        auto& pool = pair.second;
-        pool->ReleaseAll();
+        pool.ReleaseAll();
+    });
+}
+
+void ResourceManager::FinalizeAsyncLoads()
+{
+    /*
+        Finalize loads that have been prepared on loading threads until time
+        budget runs out. At least one load is always processed, so queue keeps
+        moving even if single resource takes longer than entire budget. Loads
+        with dependencies that are not done yet are put aside until they are.
+    */
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while(true)
+    {
+        LoadStatePtr loadState = TakeWaitingLoad();
+        bool prepareRequired = false;
+
+        if(loadState == nullptr)
+        {
+            std::scoped_lock<std::mutex> lock(m_loadingLock);
+
+            if(!m_finalizeQueue.empty())
+            {
+                loadState = std::move(m_finalizeQueue.front());
+                m_finalizeQueue.pop_front();
+            }
+            else if(m_loadingThreads.empty() && !m_prepareQueue.empty())
+            {
+                loadState = std::move(m_prepareQueue.front());
+                m_prepareQueue.pop_front();
+                prepareRequired = true;
+            }
+        }
+
+        if(loadState == nullptr)
+            break;
+
+        if(prepareRequired)
+        {
+            PrepareLoad(*loadState);
+        }
+
+        if(AcquireDependencies(*loadState))
+        {
+            FinalizeLoad(*loadState);
+        }
+        else
+        {
+            m_waitingQueue.push_back(std::move(loadState));
+        }
+
+        std::chrono::duration<float> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        if(elapsedTime.count() >= m_finalizeBudget)
+            break;
     }
 }
+
+void ResourceManager::WaitForLoad(ResourceLoadState& loadState)
+{
+    if(loadState.IsDone())
+        return;
+
+    // Dependencies are waited for first, as their
+    // loads may not have even been prepared yet.
+    LoadStatePtr takenState = TakeLoad(loadState);
+
+    if(!AcquireDependencies(*takenState))
+    {
+        ResourceLoadState::DependencyList dependencies = takenState->m_dependencies;
+        for(const LoadStatePtr& dependency : dependencies)
+        {
+            WaitForLoad(*dependency);
+        }
+    }
+
+    FinalizeLoad(*takenState);
+}
+
+void ResourceManager::ReloadChangedResources()
+{
+    if(!m_hotReload)
+        return;
+
+    for(const fs::path& path : m_fileSystem->CollectChangedFiles())
+    {
+        Reload(path);
+    }
+}
+
+void ResourceManager::Reload(const fs::path& path)
+{
+    // Resources of different types can be loaded from same file.
+    const std::string pathString = path.lexically_normal().generic_string();
+    auto entriesIt = m_reloadEntries.find(pathString);
+    if(entriesIt == m_reloadEntries.end())
+        return;
+
+    std::vector<std::type_index> types;
+    for(const ReloadEntry& entry : entriesIt->second)
+    {
+        types.push_back(entry.type);
+    }
+
+    for(std::type_index type : types)
+    {
+        QueueReload(type, pathString);
+    }
+}
+
+bool ResourceManager::IsHotReloadEnabled() const
+{
+    return m_hotReload;
+}
+
+ResourceManager::ReloadEntry* ResourceManager::FindReloadEntry(std::type_index type, const std::string& path)
+{
+    auto entriesIt = m_reloadEntries.find(path);
+    if(entriesIt == m_reloadEntries.end())
+        return nullptr;
+
+    for(ReloadEntry& entry : entriesIt->second)
+    {
+        if(entry.type == type)
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+void ResourceManager::AddReloadDependent(ReloadEntry& entry)
+{
+    // Resource acquired while another one is being created is its dependency.
+    if(m_creatingResources.empty())
+        return;
+
+    const ResourceKey& dependent = m_creatingResources.back();
+    if(std::find(entry.dependents.begin(), entry.dependents.end(), dependent) == entry.dependents.end())
+    {
+        entry.dependents.push_back(dependent);
+    }
+}
+
+void ResourceManager::QueueReload(std::type_index type, const std::string& path)
+{
+    auto entriesIt = m_reloadEntries.find(path);
+    if(entriesIt == m_reloadEntries.end())
+        return;
+
+    auto& entries = entriesIt->second;
+    auto entryIt = std::find_if(entries.begin(), entries.end(),
+        [type](const ReloadEntry& entry)
+        {
+            return entry.type == type;
+        });
+
+    if(entryIt == entries.end())
+        return;
+
+    // Resource that is still being loaded for the first time is left alone.
+    if(FindLoad(type, path) != nullptr)
+        return;
+
+    // Reload that has not been prepared yet will read latest file anyway.
+    auto& reloads = m_reloadingResources[type];
+    auto reloadIt = reloads.find(path);
+    if(reloadIt != reloads.end() && reloadIt->second->GetStatus() == ResourceLoadState::Status::Queued)
+        return;
+
+    LoadStatePtr loadState = entryIt->createLoad();
+    if(loadState == nullptr)
+    {
+        // Forget resources that have been released, along with their dependents.
+        entries.erase(entryIt);
+        if(entries.empty())
+        {
+            m_reloadEntries.erase(entriesIt);
+        }
+
+        return;
+    }
+
+    LOG_CATEGORY_INFO(LogResourcePool, "Reloading resource: \"{}\"", path);
+    loadState->m_reload = true;
+    reloads.insert_or_assign(path, loadState);
+    QueueLoad(std::move(loadState));
+}
+
+ResourceManager::LoadStatePtr ResourceManager::FindLoad(std::type_index type, const fs::path& path) const
+{
+    auto typeIt = m_loadingResources.find(type);
+    if(typeIt == m_loadingResources.end())
+        return nullptr;
+
+    auto loadIt = typeIt->second.find(path.generic_string());
+    if(loadIt == typeIt->second.end())
+        return nullptr;
+
+    return loadIt->second;
+}
+
+ResourceManager::LoadStatePtr ResourceManager::TakeLoad(ResourceLoadState& loadState)
+{
+    auto findLoadState = [&loadState](const LoadStatePtr& element)
+    {
+        return element.get() == &loadState;
+    };
+
+    // Take load that has been waiting for its dependencies.
+    auto waitingIt = std::find_if(m_waitingQueue.begin(), m_waitingQueue.end(), findLoadState);
+    if(waitingIt != m_waitingQueue.end())
+    {
+        LoadStatePtr waitingState = std::move(*waitingIt);
+        m_waitingQueue.erase(waitingIt);
+        return waitingState;
+    }
+
+    // Take load that has not been picked up by loading threads
+    // yet and prepare it on main thread instead of waiting.
+    std::unique_lock<std::mutex> lock(m_loadingLock);
+
+    auto queuedIt = std::find_if(m_prepareQueue.begin(), m_prepareQueue.end(), findLoadState);
+    if(queuedIt != m_prepareQueue.end())
+    {
+        LoadStatePtr queuedState = std::move(*queuedIt);
+        m_prepareQueue.erase(queuedIt);
+        lock.unlock();
+
+        PrepareLoad(*queuedState);
+        return queuedState;
+    }
+
+    // Wait for load to be prepared by one of loading threads.
+    auto preparedIt = m_finalizeQueue.end();
+    m_preparedCondition.wait(lock, [this, &findLoadState, &preparedIt]()
+    {
+        preparedIt = std::find_if(m_finalizeQueue.begin(), m_finalizeQueue.end(), findLoadState);
+        return preparedIt != m_finalizeQueue.end();
+    });
+
+    LoadStatePtr preparedState = std::move(*preparedIt);
+    m_finalizeQueue.erase(preparedIt);
+    return preparedState;
+}
+
+ResourceManager::LoadStatePtr ResourceManager::TakeWaitingLoad()
+{
+    auto waitingIt = std::find_if(m_waitingQueue.begin(), m_waitingQueue.end(),
+        [](const LoadStatePtr& loadState)
+        {
+            return loadState->AreDependenciesDone();
+        });
+
+    if(waitingIt == m_waitingQueue.end())
+        return nullptr;
+
+    LoadStatePtr loadState = std::move(*waitingIt);
+    m_waitingQueue.erase(waitingIt);
+    return loadState;
+}
+
+void ResourceManager::QueueLoad(LoadStatePtr loadState)
+{
+    ASSERT(loadState != nullptr, "Queued resource load is null!");
+
+    {
+        std::scoped_lock<std::mutex> lock(m_loadingLock);
+        m_prepareQueue.push_back(std::move(loadState));
+    }
+
+    m_loadingCondition.notify_one();
+}
+
+void ResourceManager::PrepareLoad(ResourceLoadState& loadState)
+{
+    ASSERT(loadState.GetStatus() == ResourceLoadState::Status::Queued);
+    loadState.OnPrepare(*m_fileSystem);
+    loadState.m_status.store(ResourceLoadState::Status::Prepared, std::memory_order_release);
+}
+
+bool ResourceManager::AcquireDependencies(ResourceLoadState& loadState)
+{
+    ASSERT(loadState.GetStatus() == ResourceLoadState::Status::Prepared);
+
+    if(!loadState.m_dependenciesAcquired)
+    {
+        if(m_hotReload)
+        {
+            m_creatingResources.emplace_back(loadState.GetType(), loadState.GetPath().generic_string());
+        }
+
+        ResourceDependencies dependencies(*this, loadState);
+        loadState.OnAcquireDependencies(dependencies);
+        loadState.m_dependenciesAcquired = true;
+
+        if(m_hotReload)
+        {
+            m_creatingResources.pop_back();
+        }
+    }
+
+    return loadState.AreDependenciesDone();
+}
+
+void ResourceManager::FinalizeLoad(ResourceLoadState& loadState)
+{
+    ASSERT(loadState.GetStatus() == ResourceLoadState::Status::Prepared);
+    ASSERT(loadState.AreDependenciesDone(), "Finalizing load with pending dependencies!");
+
+    // Remove load from those in progress before resource is created, so any
+    // acquisition made during its creation does not end up waiting for it.
+    const std::string pathString = loadState.GetPath().generic_string();
+    LoadingResourceMap& loadingResources = loadState.m_reload ? m_reloadingResources : m_loadingResources;
+
+    auto typeIt = loadingResources.find(loadState.GetType());
+    if(typeIt != loadingResources.end())
+    {
+        auto loadIt = typeIt->second.find(pathString);
+        if(loadIt != typeIt->second.end() && loadIt->second.get() == &loadState)
+        {
+            typeIt->second.erase(loadIt);
+        }
+    }
+
+    if(m_hotReload)
+    {
+        m_creatingResources.emplace_back(loadState.GetType(), pathString);
+    }
+
+    const bool created = loadState.OnFinalize();
+
+    if(m_hotReload)
+    {
+        m_creatingResources.pop_back();
+    }
+
+    if(created)
+    {
+        LOG_CATEGORY_INFO(LogResourcePool, "{} resource asynchronously: \"{}\"",
+            loadState.m_reload ? "Reloaded" : "Loaded", pathString);
+        loadState.m_status.store(ResourceLoadState::Status::Succeeded, std::memory_order_release);
+    }
+    else
+    {
+        LOG_CATEGORY_ERROR(LogResourcePool, "Failed to {} resource asynchronously: \"{}\"",
+            loadState.m_reload ? "reload" : "load", pathString);
+        loadState.m_status.store(ResourceLoadState::Status::Failed, std::memory_order_release);
+    }
+
+    // Resources that depend on reloaded one are reloaded after it, so they are
+    // created again from its new contents. Failed reload keeps previous resource.
+    if(loadState.m_reload && created)
+    {
+        if(ReloadEntry* entry = FindReloadEntry(loadState.GetType(), pathString))
+        {
+            ResourceKeyList dependents = entry->dependents;
+            for(const ResourceKey& dependent : dependents)
+            {
+                QueueReload(dependent.first, dependent.second);
+            }
+        }
+    }
+
+    // Dependencies are now referenced by created resource if needed.
+    loadState.m_dependencies.clear();
+    loadState.m_dependencyResources.clear();
+}
+
+void ResourceManager::RunLoadingThread()
+{
+    while(true)
+    {
+        LoadStatePtr loadState;
+
+        {
+            std::unique_lock<std::mutex> lock(m_loadingLock);
+            m_loadingCondition.wait(lock, [this]()
+            {
+                return m_loadingStopped || !m_prepareQueue.empty();
+            });
+
+            if(m_loadingStopped)
+                return;
+
+            loadState = std::move(m_prepareQueue.front());
+            m_prepareQueue.pop_front();
+        }
+
+        PrepareLoad(*loadState);
+
+        {
+            std::scoped_lock<std::mutex> lock(m_loadingLock);
+            m_finalizeQueue.push_back(std::move(loadState));
+        }
+
+        m_preparedCondition.notify_all();
+    }
+}
+
+void ResourceManager::StopLoadingThreads()
+{
+    {
+        std::scoped_lock<std::mutex> lock(m_loadingLock);
+        m_loadingStopped = true;
+    }
+
+    m_loadingCondition.notify_all();
+
+    for(std::thread& loadingThread : m_loadingThreads)
+    {
+        loadingThread.join();
+    }
+
+    m_loadingThreads.clear();
+    m_prepareQueue.clear();
+    m_finalizeQueue.clear();
+    m_waitingQueue.clear();
+    m_loadingResources.clear();
+    m_reloadingResources.clear();
+}
@@ -5,8 +5,16 @@
 
 #include "System/Precompiled.hpp"
 #include "System/Timer.hpp"
+#include <chrono>
 using namespace System;
 
+namespace
+{
+    // Steady clock does not need platform system to be initialized,
+    // so timer can also be used by headless engine without windowing.
+    using Clock = std::chrono::steady_clock;
+}
+
 Timer::Timer()
 {
     this->Reset();
@@ -19,13 +27,11 @@ Timer::TimeUnit Timer::ReadClockUnits()
     TimeUnit units;
 
 #ifdef USE_PRECISE_TIME_COUNTERS
-    units = glfwGetTimerValue();
+    units = static_cast<TimeUnit>(Clock::now().time_since_epoch().count());
 #else
     units = glfwGetTime();
 #endif
 
-    ASSERT(units != 0, "Detected zero timer value! Most likely platform system has not been initialized yet.");
-
     return units;
 }
 
@@ -34,20 +40,18 @@ Timer::TimeUnit Timer::ReadClockFrequency()
     TimeUnit frequency;
 
 #ifdef USE_PRECISE_TIME_COUNTERS
-    frequency = glfwGetTimerFrequency();
+    frequency = static_cast<TimeUnit>(Clock::period::den / Clock::period::num);
 #else
     frequency = 1.0;
 #endif
 
-    ASSERT(frequency != 0, "Detected zero timer frequency! Most likely platform system has not been initialized yet.");
-
     return frequency;
 }
 
 Timer::TimeUnit System::Timer::ConvertToUnits(double seconds)
 {
 #ifdef USE_PRECISE_TIME_COUNTERS
-    return (TimeUnit)(seconds * glfwGetTimerFrequency() + 0.5);
+    return (TimeUnit)(seconds * ReadClockFrequency() + 0.5);
 #else
     return seconds;
 #endif
@@ -56,7 +60,7 @@ Timer::TimeUnit System::Timer::ConvertToUnits(double seconds)
 double Timer::ConvertToSeconds(TimeUnit units)
 {
 #ifdef USE_PRECISE_TIME_COUNTERS
-    return (double)units / glfwGetTimerFrequency();
+    return (double)units / ReadClockFrequency();
 #else
     return units;
 #endif
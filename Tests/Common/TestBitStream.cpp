@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <limits>
+#include <doctest/doctest.h>
+#include <Common/BitStream.hpp>
+
+TEST_CASE("Bit Stream")
+{
+    Common::BitWriter writer;
+
+    SUBCASE("Bits")
+    {
+        writer.WriteBool(true);
+        writer.WriteBits(0x5, 3);
+        writer.WriteBits(0xABCD, 16);
+        writer.WriteBits(0xFFFFFFFFFFFFFFFF, 64);
+        writer.WriteBool(false);
+        CHECK_EQ(writer.GetBitCount(), 85);
+        CHECK_EQ(writer.GetData().size(), 11);
+
+        Common::BitReader reader(writer.GetData());
+        CHECK(reader.ReadBool());
+        CHECK_EQ(reader.ReadBits(3), 0x5);
+        CHECK_EQ(reader.ReadBits(16), 0xABCD);
+        CHECK_EQ(reader.ReadBits(64), 0xFFFFFFFFFFFFFFFF);
+        CHECK_FALSE(reader.ReadBool());
+        CHECK(reader.IsValid());
+        CHECK_EQ(reader.GetRemainingBitCount(), 3);
+
+        CHECK_EQ(reader.ReadBits(4), 0);
+        CHECK_FALSE(reader.IsValid());
+        CHECK_FALSE(reader.ReadBool());
+    }
+
+    SUBCASE("Integers")
+    {
+        const uint64_t unsignedValues[] = { 0, 1, 15, 16, 1000, std::numeric_limits<uint64_t>::max() };
+        const int64_t signedValues[] = { 0, -1, 1, -8, 8, -1000,
+            std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() };
+
+        for(uint64_t value : unsignedValues)
+        {
+            writer.WriteVarint(value);
+        }
+
+        for(int64_t value : signedValues)
+        {
+            writer.WriteSigned(value);
+        }
+
+        Common::BitReader reader(writer.GetData());
+        for(uint64_t value : unsignedValues)
+        {
+            CHECK_EQ(reader.ReadVarint(), value);
+        }
+
+        for(int64_t value : signedValues)
+        {
+            CHECK_EQ(reader.ReadSigned(), value);
+        }
+
+        CHECK(reader.IsValid());
+
+        // Small values of either sign take single group.
+        Common::BitWriter smallWriter;
+        smallWriter.WriteSigned(-7);
+        smallWriter.WriteSigned(7);
+        CHECK_EQ(smallWriter.GetBitCount(), 10);
+    }
+
+    SUBCASE("Bytes")
+    {
+        const char text[] = "Bit stream";
+
+        writer.WriteBytes(text, sizeof(text));
+        writer.WriteBits(0x3, 2);
+        writer.WriteBytes(text, sizeof(text));
+
+        Common::BitReader reader(writer.GetData());
+        char aligned[sizeof(text)] = {};
+        char unaligned[sizeof(text)] = {};
+        CHECK(reader.ReadBytes(aligned, sizeof(aligned)));
+        CHECK_EQ(reader.ReadBits(2), 0x3);
+        CHECK(reader.ReadBytes(unaligned, sizeof(unaligned)));
+        CHECK_EQ(std::string(aligned), text);
+        CHECK_EQ(std::string(unaligned), text);
+
+        CHECK_FALSE(reader.ReadBytes(aligned, 1));
+        CHECK_FALSE(reader.IsValid());
+    }
+
+    SUBCASE("Reset")
+    {
+        writer.WriteBits(0x7, 3);
+        writer.Reset();
+        writer.WriteBits(0x1, 1);
+
+        CHECK_EQ(writer.GetBitCount(), 1);
+        REQUIRE_EQ(writer.GetData().size(), 1);
+        CHECK_EQ(writer.GetData()[0], 0x1);
+    }
+}
@@ -10,6 +10,9 @@
 #include <Common/Event/Dispatcher.hpp>
 #include <Common/Event/Receiver.hpp>
 #include <Common/Event/Broker.hpp>
+#include <Common/Event/Queue.hpp>
+#include <Common/Event/ConcurrentQueue.hpp>
+#include <thread>
 
 static const char* Text = "0123456789";
 
@@ -635,6 +638,114 @@ TEST_CASE("Event Dispatcher")
         CHECK_EQ(value, 0);
     }
 
+    SUBCASE("Subscription priority")
+    {
+        std::string order;
+
+        Event::Dispatcher<void(std::string&)> dispatcher;
+
+        Event::Receiver<void(std::string&)> receiverA;
+        receiverA.Bind([](std::string& order) { order += "A"; });
+
+        Event::Receiver<void(std::string&)> receiverB;
+        receiverB.Bind([](std::string& order) { order += "B"; });
+
+        Event::Receiver<void(std::string&)> receiverC;
+        receiverC.Bind([](std::string& order) { order += "C"; });
+
+        Event::Receiver<void(std::string&)> receiverFront;
+        receiverFront.Bind([&dispatcher, &receiverC](std::string& order)
+        {
+            dispatcher.Subscribe(receiverC, Event::SubscriptionPolicy::RetainSubscription,
+                Event::PriorityPolicy::InsertFront);
+            order += "F";
+        });
+
+        CHECK(dispatcher.Subscribe(receiverA));
+        CHECK(dispatcher.Subscribe(receiverB, Event::SubscriptionPolicy::RetainSubscription,
+            Event::PriorityPolicy::InsertFront));
+        CHECK(dispatcher.Subscribe(receiverFront));
+
+        dispatcher.Dispatch(order);
+        CHECK_EQ(order, "BAF");
+
+        order.clear();
+        dispatcher.Dispatch(order);
+        CHECK_EQ(order, "CBAF");
+
+        order.clear();
+        CHECK(receiverB.Unsubscribe());
+        CHECK(dispatcher.Subscribe(receiverB));
+        dispatcher.Dispatch(order);
+        CHECK_EQ(order, "CAFB");
+    }
+
+    SUBCASE("Receiver binding and move")
+    {
+        int value = 0;
+
+        Event::Dispatcher<void(int&)> dispatcher;
+
+        Event::Receiver<void(int&)> receiver;
+        CHECK(receiver.Subscribe(dispatcher));
+        dispatcher.Dispatch(value);
+        CHECK_EQ(value, 0);
+
+        receiver.Bind([](int& value) { value += 1; });
+        dispatcher.Dispatch(value);
+        CHECK_EQ(value, 1);
+
+        Event::Receiver<void(int&)> receiverMoved;
+        receiverMoved.Bind([](int& value) { value += 10; });
+        receiverMoved = std::move(receiver);
+        CHECK_FALSE(receiver.IsSubscribed());
+        CHECK(receiverMoved.IsSubscribed());
+
+        dispatcher.Dispatch(value);
+        CHECK_EQ(value, 11);
+
+        receiverMoved.Bind(nullptr);
+        dispatcher.Dispatch(value);
+        CHECK_EQ(value, 11);
+        CHECK(dispatcher.HasSubscribers());
+
+        CHECK(receiverMoved.Unsubscribe());
+        CHECK_FALSE(dispatcher.HasSubscribers());
+    }
+
+    SUBCASE("Repeated subscription churn")
+    {
+        int value = 0;
+
+        Event::Dispatcher<void(int&)> dispatcher;
+        std::vector<Event::Receiver<void(int&)>> receivers(16);
+
+        for(auto& receiver : receivers)
+        {
+            receiver.Bind([](int& value) { value += 1; });
+        }
+
+        for(int iteration = 0; iteration < 8; ++iteration)
+        {
+            for(auto& receiver : receivers)
+            {
+                CHECK(dispatcher.Subscribe(receiver));
+            }
+
+            for(std::size_t i = 0; i < receivers.size(); i += 2)
+            {
+                CHECK(receivers[i].Unsubscribe());
+            }
+
+            value = 0;
+            dispatcher.Dispatch(value);
+            CHECK_EQ(value, 8);
+
+            dispatcher.UnsubscribeAll();
+            CHECK_FALSE(dispatcher.HasSubscribers());
+        }
+    }
+
     SUBCASE("Invoking unbound receivers")
     {
         Event::Dispatcher<int(int&)> dispatcher(0);
@@ -845,3 +956,196 @@ TEST_CASE("Event Broker")
         }
     }
 }
+
+struct EventCounter : public Event::EventBase
+{
+    REFLECTION_ENABLE(EventCounter, Event::EventBase)
+
+public:
+    EventCounter(const Test::InstanceCounter<>& counter) :
+        counter(counter)
+    {
+    }
+
+    Test::InstanceCounter<> counter;
+};
+
+REFLECTION_TYPE(EventCounter, Event::EventBase)
+
+TEST_CASE("Event Queue")
+{
+    std::string receivedOrder;
+
+    Event::Receiver<void(const EventInteger&)> receiverInteger;
+    receiverInteger.Bind([&receivedOrder](const EventInteger& event)
+    {
+        receivedOrder += std::to_string(event.integer);
+    });
+
+    Event::Receiver<bool(const EventString&)> receiverString;
+    receiverString.Bind([&receivedOrder](const EventString& event)
+    {
+        receivedOrder += event.string;
+        return true;
+    });
+
+    Event::Broker broker;
+    CHECK(broker.Register<void, EventInteger>());
+    CHECK(broker.Register<bool, EventString>(std::make_unique<Event::CollectWhileTrue>()));
+    CHECK(broker.Register<void, EventCounter>());
+    broker.Finalize();
+
+    CHECK(broker.Subscribe(receiverInteger).IsSuccess());
+    CHECK(broker.Subscribe(receiverString).IsSuccess());
+
+    SUBCASE("Dispatch in order")
+    {
+        Event::Queue queue(64);
+        CHECK(queue.IsEmpty());
+
+        queue.Push(EventInteger{ 1 });
+        queue.Push(EventString{ "Jelly" });
+        queue.Emplace<EventInteger>(2);
+        queue.Push(EventString{ "A string that is long enough to not fit into small buffer" });
+        queue.Push(EventInteger{ 3 });
+        CHECK_EQ(queue.GetEventCount(), 5);
+
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK_EQ(receivedOrder, "1Jelly2A string that is long enough to not fit into small buffer3");
+        CHECK(queue.IsEmpty());
+
+        receivedOrder.clear();
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK(receivedOrder.empty());
+    }
+
+    SUBCASE("Push during dispatch")
+    {
+        Event::Queue queue;
+
+        Event::Receiver<void(const EventCounter&)> receiverCounter;
+        receiverCounter.Bind([&queue](const EventCounter& event)
+        {
+            queue.Push(EventInteger{ 7 });
+        });
+
+        CHECK(broker.Subscribe(receiverCounter).IsSuccess());
+
+        Test::InstanceCounter<> counter;
+        queue.Push(EventCounter{ counter });
+        queue.Push(EventInteger{ 5 });
+
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK_EQ(receivedOrder, "57");
+        CHECK(queue.IsEmpty());
+    }
+
+    SUBCASE("Event lifetime")
+    {
+        Test::InstanceCounter<> counter;
+
+        {
+            Event::Queue queue;
+            queue.Emplace<EventCounter>(counter);
+            queue.Emplace<EventCounter>(counter);
+            CHECK_EQ(counter.GetStats().instances, 3);
+
+            CHECK(broker.Dispatch(queue).IsSuccess());
+            CHECK_EQ(counter.GetStats().instances, 1);
+
+            queue.Emplace<EventCounter>(counter);
+            CHECK_EQ(counter.GetStats().instances, 2);
+        }
+
+        CHECK_EQ(counter.GetStats().instances, 1);
+        CHECK_EQ(counter.GetStats().copies, 3);
+    }
+
+    SUBCASE("Dispatch unregistered")
+    {
+        Event::Queue queue;
+        queue.Push(EventInteger{ 1 });
+        queue.Push(EventBoolean{ true });
+        queue.Push(EventInteger{ 2 });
+
+        CHECK(broker.Dispatch(queue).IsFailure());
+        CHECK_EQ(receivedOrder, "12");
+        CHECK(queue.IsEmpty());
+    }
+
+    SUBCASE("Concurrent push")
+    {
+        const int threadCount = 4;
+        const int eventCount = 1000;
+
+        Event::ConcurrentQueue queue(1024);
+        CHECK(queue.Push(EventVector{ std::vector<int>(4) }));
+        CHECK(broker.Dispatch(queue).IsFailure());
+        CHECK(queue.IsEmpty());
+
+        int receivedSum = 0;
+        int receivedCount = 0;
+
+        receiverInteger.Bind([&receivedSum, &receivedCount](const EventInteger& event)
+        {
+            receivedSum += event.integer;
+            receivedCount += 1;
+        });
+
+        std::atomic<int> finishedThreads = 0;
+        std::vector<std::thread> threads;
+
+        for(int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&queue, &finishedThreads]()
+            {
+                for(int i = 1; i <= eventCount; ++i)
+                {
+                    while(!queue.Push(EventInteger{ i }))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                finishedThreads += 1;
+            });
+        }
+
+        while(finishedThreads != threadCount)
+        {
+            broker.Dispatch(queue);
+        }
+
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK(queue.IsEmpty());
+        CHECK_EQ(receivedCount, threadCount * eventCount);
+        CHECK_EQ(receivedSum, threadCount * eventCount * (eventCount + 1) / 2);
+    }
+
+    SUBCASE("Concurrent queue wrap around")
+    {
+        // Leave single granule at the end of ring buffer for padding.
+        const std::size_t recordGranules = Event::ConcurrentQueue::RecordGranules<EventInteger>();
+        Event::ConcurrentQueue queue((recordGranules * 2 + 1) * Event::ConcurrentQueue::GranuleSize);
+
+        CHECK(queue.Push(EventInteger{ 1 }));
+        CHECK(queue.Push(EventInteger{ 2 }));
+        CHECK_FALSE(queue.Push(EventInteger{ 3 }));
+
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK_EQ(receivedOrder, "12");
+
+        CHECK(queue.Push(EventInteger{ 4 }));
+        CHECK(queue.Push(EventInteger{ 5 }));
+        CHECK_FALSE(queue.Push(EventInteger{ 6 }));
+
+        CHECK(broker.Dispatch(queue).IsSuccess());
+        CHECK_EQ(receivedOrder, "1245");
+        CHECK(queue.IsEmpty());
+    }
+}
@@ -268,3 +268,83 @@ TEST_CASE("Handle Map Iterators")
     CHECK_EQ(entities.LookupHandle(constValid[3]).UnwrapOr(invalid).GetHandle().GetIdentifier(), 8);
     CHECK_EQ(entities.LookupHandle(constValid[4]).UnwrapOr(invalid).GetHandle().GetIdentifier(), 9);
 }
+
+namespace
+{
+    struct Stream
+    {
+        template<typename Type>
+        void Write(const Type& value)
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(Type));
+        }
+
+        template<typename Type>
+        bool Read(Type& value)
+        {
+            if(offset + sizeof(Type) > data.size())
+                return false;
+
+            std::memcpy(&value, data.data() + offset, sizeof(Type));
+            offset += sizeof(Type);
+            return true;
+        }
+
+        std::vector<uint8_t> data;
+        std::size_t offset = 0;
+    };
+}
+
+TEST_CASE("Handle Map Serialization")
+{
+    struct Entity
+    {
+        int counter = 0;
+    };
+
+    std::vector<Common::Handle<Entity>> entityHandles;
+
+    Common::HandleMap<Entity> entities(2);
+    for(int i = 0; i < 6; ++i)
+    {
+        auto entityEntry = entities.CreateHandle().Unwrap();
+        entityEntry.GetStorage()->counter = i;
+        entityHandles.push_back(entityEntry.GetHandle());
+    }
+
+    CHECK(entities.DestroyHandle(entityHandles[1]));
+    CHECK(entities.DestroyHandle(entityHandles[4]));
+
+    Stream stream;
+    entities.Serialize(stream);
+
+    Common::HandleMap<Entity> restored(2);
+    restored.CreateHandle().Unwrap();
+    REQUIRE(restored.Deserialize(stream));
+    CHECK_EQ(restored.GetValidHandleCount(), entities.GetValidHandleCount());
+    CHECK_EQ(restored.GetUnusedHandleCount(), entities.GetUnusedHandleCount());
+
+    for(int i : { 0, 2, 3, 5 })
+    {
+        auto entityEntry = restored.LookupHandle(entityHandles[i]).Unwrap();
+        CHECK_EQ(entityEntry.GetStorage()->counter, i);
+    }
+
+    CHECK_FALSE(restored.LookupHandle(entityHandles[1]).IsSuccess());
+    CHECK_FALSE(restored.LookupHandle(entityHandles[4]).IsSuccess());
+
+    // Restored map hands out same handles as original one.
+    for(int i = 0; i < 4; ++i)
+    {
+        CHECK_EQ(restored.CreateHandle().Unwrap().GetHandle(),
+            entities.CreateHandle().Unwrap().GetHandle());
+    }
+
+    // Truncated data leaves map empty.
+    stream.data.pop_back();
+    stream.offset = 0;
+    CHECK_FALSE(restored.Deserialize(stream));
+    CHECK_EQ(restored.GetValidHandleCount(), 0);
+    CHECK_EQ(restored.GetUnusedHandleCount(), 0);
+}
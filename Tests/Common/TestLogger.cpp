@@ -0,0 +1,350 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include <Common/BoundedQueue.hpp>
+#include <Common/Logger/Logger.hpp>
+#include <Common/Logger/Message.hpp>
+#include <Common/Logger/Output.hpp>
+#include <Common/Logger/Sink.hpp>
+
+class MemoryOutput final : public Logger::Output
+{
+public:
+    MemoryOutput(bool textOutput = true) :
+        textOutput(textOutput)
+    {
+    }
+
+    void Write(const Logger::Message& message, const Logger::SinkContext& context,
+        const std::string& text) override
+    {
+        writtenMessages.push_back(message.GetText());
+        writtenTexts.push_back(text);
+        writtenIndents.push_back(context.messageIndent);
+        unflushedCount++;
+    }
+
+    void Flush() override
+    {
+        flushedCount += unflushedCount;
+        unflushedCount = 0;
+    }
+
+    bool IsTextOutput() const override
+    {
+        return textOutput;
+    }
+
+    const bool textOutput;
+    std::vector<std::string> writtenMessages;
+    std::vector<std::string> writtenTexts;
+    std::vector<int> writtenIndents;
+    int unflushedCount = 0;
+    int flushedCount = 0;
+};
+
+TEST_CASE("Bounded Queue")
+{
+    Common::BoundedQueue<int> queue(5);
+    CHECK_EQ(queue.GetCapacity(), 8);
+
+    SUBCASE("Push and pop in order")
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            CHECK(queue.TryPush(i));
+        }
+
+        CHECK_FALSE(queue.TryPush(8));
+
+        int value = -1;
+        for(int i = 0; i < 8; ++i)
+        {
+            CHECK(queue.TryPop(value));
+            CHECK_EQ(value, i);
+        }
+
+        CHECK_FALSE(queue.TryPop(value));
+    }
+
+    SUBCASE("Concurrent producers")
+    {
+        const int threadCount = 4;
+        const int pushCount = 1000;
+
+        std::vector<std::thread> producers;
+        for(int thread = 0; thread < threadCount; ++thread)
+        {
+            producers.emplace_back([&queue, thread]()
+            {
+                for(int i = 0; i < pushCount; ++i)
+                {
+                    while(!queue.TryPush(thread * pushCount + i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<int> lastValues(threadCount, -1);
+        int poppedCount = 0;
+        int value = 0;
+
+        while(poppedCount < threadCount * pushCount)
+        {
+            if(!queue.TryPop(value))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            int thread = value / pushCount;
+            CHECK_LT(lastValues[thread], value);
+            lastValues[thread] = value;
+            poppedCount++;
+        }
+
+        for(auto& producer : producers)
+        {
+            producer.join();
+        }
+    }
+}
+
+TEST_CASE("Logger Sink")
+{
+    MemoryOutput output;
+    Logger::Sink sink;
+    sink.AddOutput(&output);
+
+    SUBCASE("Synchronous write")
+    {
+        Logger::Message message;
+        message.SetText("Hello world!");
+        sink.Write(message);
+
+        REQUIRE_EQ(output.writtenMessages.size(), 1);
+        CHECK_EQ(output.writtenMessages[0], "Hello world!");
+        CHECK_EQ(output.flushedCount, 1);
+    }
+
+    SUBCASE("Text is composed only for text outputs")
+    {
+        MemoryOutput messageOutput(false);
+        sink.RemoveOutput(&output);
+        sink.AddOutput(&messageOutput);
+
+        Logger::ScopedMessage(sink).Format("First {}", 1);
+
+        sink.AddOutput(&output);
+        Logger::ScopedMessage(sink).Format("Second {}", 2);
+
+        REQUIRE_EQ(messageOutput.writtenTexts.size(), 2);
+        CHECK(messageOutput.writtenTexts[0].empty());
+        CHECK_NE(messageOutput.writtenTexts[1].find("Second 2"), std::string::npos);
+        CHECK_EQ(messageOutput.writtenMessages[0], "First 1");
+    }
+
+    SUBCASE("Asynchronous write")
+    {
+        sink.EnableAsync(16);
+        CHECK(sink.IsAsync());
+
+        const int threadCount = 4;
+        const int messageCount = 500;
+
+        std::vector<std::thread> writers;
+        for(int thread = 0; thread < threadCount; ++thread)
+        {
+            writers.emplace_back([&sink, thread]()
+            {
+                for(int i = 0; i < messageCount; ++i)
+                {
+                    Logger::ScopedMessage(sink).Format("{} {}", thread, i);
+                }
+            });
+        }
+
+        for(auto& writer : writers)
+        {
+            writer.join();
+        }
+
+        sink.Flush();
+        REQUIRE_EQ(output.writtenMessages.size(), threadCount * messageCount);
+        CHECK_EQ(output.flushedCount, threadCount * messageCount);
+
+        std::vector<int> lastIndices(threadCount, -1);
+        for(const std::string& text : output.writtenMessages)
+        {
+            int thread = std::stoi(text.substr(0, text.find(' ')));
+            int index = std::stoi(text.substr(text.find(' ') + 1));
+            CHECK_EQ(lastIndices[thread] + 1, index);
+            lastIndices[thread] = index;
+        }
+
+        sink.DisableAsync();
+        CHECK_FALSE(sink.IsAsync());
+    }
+
+    SUBCASE("Asynchronous drain on disable")
+    {
+        sink.EnableAsync();
+
+        for(int i = 0; i < 100; ++i)
+        {
+            Logger::ScopedMessage(sink).Format("{}", i);
+        }
+
+        sink.DisableAsync();
+        CHECK_EQ(output.writtenMessages.size(), 100);
+        CHECK_EQ(output.flushedCount, 100);
+    }
+
+    SUBCASE("Indent per thread")
+    {
+        const int threadCount = 4;
+        const int messageCount = 100;
+
+        std::vector<std::thread> writers;
+        for(int thread = 0; thread < threadCount; ++thread)
+        {
+            writers.emplace_back([&sink, thread]()
+            {
+                std::vector<std::unique_ptr<Logger::ScopedIndent>> indents;
+                for(int indent = 0; indent < thread; ++indent)
+                {
+                    indents.push_back(std::make_unique<Logger::ScopedIndent>(sink));
+                }
+
+                for(int i = 0; i < messageCount; ++i)
+                {
+                    Logger::ScopedMessage(sink).Format("{}", thread);
+                }
+            });
+        }
+
+        for(auto& writer : writers)
+        {
+            writer.join();
+        }
+
+        REQUIRE_EQ(output.writtenMessages.size(), threadCount * messageCount);
+        for(std::size_t i = 0; i < output.writtenMessages.size(); ++i)
+        {
+            CHECK_EQ(output.writtenIndents[i], std::stoi(output.writtenMessages[i]));
+        }
+
+        CHECK_EQ(sink.GetContext().messageIndent, 0);
+    }
+
+    SUBCASE("Asynchronous fatal flush")
+    {
+        sink.EnableAsync();
+
+        Logger::ScopedMessage(sink).Format("Fatal").SetSeverity(Logger::Severity::Fatal);
+        CHECK_EQ(output.flushedCount, 1);
+
+        sink.DisableAsync();
+    }
+}
+
+TEST_CASE("Logger Category")
+{
+    Logger::Category category("Test.Category");
+    CHECK_EQ(Logger::FindCategory("Test.Category"), &category);
+    CHECK_EQ(Logger::FindCategory("Test.Unknown"), nullptr);
+    CHECK_EQ(category.GetMinimumSeverity(), Logger::Severity::Trace);
+
+    SUBCASE("Parse severity")
+    {
+        CHECK_EQ(Logger::ParseSeverity("Warning"), Logger::Severity::Warning);
+        CHECK_EQ(Logger::ParseSeverity("error"), Logger::Severity::Error);
+        CHECK_EQ(Logger::ParseSeverity("Loud"), Logger::Severity::Invalid);
+    }
+
+    SUBCASE("Filtered messages are not formatted")
+    {
+        int formatCount = 0;
+        category.SetMinimumSeverity(Logger::Severity::Warning);
+
+        LOG_CATEGORY_INFO(category, "Formatted {} times", ++formatCount);
+        CHECK_EQ(formatCount, 0);
+
+        LOG_CATEGORY_WARNING(category, "Formatted {} times", ++formatCount);
+        CHECK_EQ(formatCount, 1);
+    }
+
+    SUBCASE("Compile time severity")
+    {
+        static_assert(Logger::IsSeverityCompiled(Logger::Severity::Fatal));
+        static_assert(!Logger::IsSeverityCompiled(Logger::Severity::Invalid));
+    }
+}
+
+TEST_CASE("Logger Binary Output")
+{
+    const std::string filename = "TestBinaryOutput.bin";
+
+    {
+        Logger::BinaryOutput binaryOutput;
+        REQUIRE(binaryOutput.Open(filename));
+
+        Logger::Sink sink;
+        sink.AddOutput(&binaryOutput);
+
+        // Messages without arguments are decoded from their format.
+        for(int i = 0; i < 100000; ++i)
+        {
+            Logger::ScopedMessage message(sink);
+            message.SetSource("Source/File.cpp").SetLine(i).SetSeverity(Logger::Severity::Warning);
+
+            if(i % 2 == 0)
+            {
+                message.Format("Message {}", i);
+            }
+            else
+            {
+                message.Format("Message");
+            }
+        }
+
+        CHECK_GT(binaryOutput.GetWrittenSize(), Logger::BinaryOutput::MappingGranularity);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(filename.c_str());
+
+    int decodedCount = 0;
+    auto decodeResult = Logger::BinaryOutput::Decode(data.data(), data.size(),
+        [&decodedCount](const Logger::Message& message, const Logger::SinkContext& context)
+        {
+            const bool formatted = decodedCount % 2 == 0;
+            CHECK_EQ(message.GetText(), formatted ? fmt::format("Message {}", decodedCount) : "Message");
+            CHECK_EQ(std::string(message.GetFormat()), formatted ? "Message {}" : "Message");
+            CHECK_EQ(message.GetSeverity(), Logger::Severity::Warning);
+            CHECK_EQ(std::string(message.GetSource()), "Source/File.cpp");
+            CHECK_EQ(message.GetLine(), decodedCount);
+            decodedCount++;
+        });
+
+    CHECK(decodeResult.IsSuccess());
+    CHECK_EQ(decodedCount, 100000);
+
+    data.resize(data.size() - 1);
+    CHECK_EQ(Logger::BinaryOutput::Decode(data.data(), data.size(),
+        [](const Logger::Message&, const Logger::SinkContext&) {}).UnwrapFailure(),
+        Logger::BinaryOutput::DecodeErrors::TruncatedRecord);
+}
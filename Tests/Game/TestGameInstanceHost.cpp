@@ -0,0 +1,108 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <chrono>
+#include <thread>
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <System/Timer.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/GameInstanceHost.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/TickTimer.hpp>
+#include <Game/Components/TransformComponent.hpp>
+
+TEST_CASE("Game Instance Host")
+{
+    const std::size_t instanceCount = 8;
+
+    for(uint32_t workerThreads : { 0u, 3u })
+    {
+        Game::GameInstanceHost::CreateFromParams params;
+        params.workerThreads = workerThreads;
+
+        auto host = Game::GameInstanceHost::Create(params).UnwrapOr(nullptr);
+        REQUIRE(host);
+        CHECK_EQ(host->GetWorkerThreadCount(), 0);
+
+        // Entities are created by commands processed on first tick of each instance.
+        for(std::size_t i = 0; i < instanceCount; ++i)
+        {
+            auto gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+            REQUIRE(gameInstance);
+
+            auto* entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+            auto* componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+            for(std::size_t j = 0; j <= i; ++j)
+            {
+                Game::EntityHandle entity = entitySystem->CreateEntity();
+                REQUIRE(componentSystem->Create<Game::TransformComponent>(entity));
+            }
+
+            auto tickTimer = Game::TickTimer::Create().UnwrapOr(nullptr);
+            REQUIRE(tickTimer);
+            tickTimer->SetTickSeconds(1.0f / 100.0f);
+
+            REQUIRE(host->Host(std::move(gameInstance), std::move(tickTimer)));
+
+            // Workers are started lazily, as calling thread ticks one instance.
+            CHECK_EQ(host->GetWorkerThreadCount(), std::min<std::size_t>(workerThreads, i));
+        }
+
+        REQUIRE_EQ(host->GetInstanceCount(), instanceCount);
+
+        System::Timer timer;
+        for(int frame = 0; frame < 5; ++frame)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            timer.Advance();
+            host->Advance(timer);
+        }
+
+        // All instances use the same time, so they processed the same ticks.
+        const double totalTickSeconds = host->GetTickTimer(0)->GetTotalTickSeconds();
+        CHECK_GT(totalTickSeconds, 0.0);
+
+        for(std::size_t i = 0; i < instanceCount; ++i)
+        {
+            CHECK_EQ(host->GetTickTimer(i)->GetTotalTickSeconds(), totalTickSeconds);
+
+            auto* entitySystem = host->GetInstance(i)->GetSystems().Locate<Game::EntitySystem>();
+            CHECK_EQ(entitySystem->GetEntityCount(), i + 1);
+        }
+
+        // Released instances are not ticked anymore.
+        Game::GameInstance* releasedInstance = host->GetInstance(2);
+        std::unique_ptr<Game::GameInstance> gameInstance = host->Release(releasedInstance);
+        CHECK_EQ(gameInstance.get(), releasedInstance);
+        CHECK_EQ(host->GetInstanceCount(), instanceCount - 1);
+        CHECK_FALSE(host->Release(releasedInstance));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        timer.Advance();
+        host->Advance(timer);
+    }
+
+    // Workers started between advances only join the following ones.
+    Game::GameInstanceHost::CreateFromParams params;
+    params.workerThreads = 3;
+
+    auto host = Game::GameInstanceHost::Create(params).UnwrapOr(nullptr);
+    REQUIRE(host);
+
+    System::Timer timer;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(host->Host(Game::GameInstance::Create().UnwrapOr(nullptr)));
+        CHECK_EQ(host->GetWorkerThreadCount(), i);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        timer.Advance();
+        host->Advance(timer);
+    }
+}
@@ -0,0 +1,204 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/Snapshot.hpp>
+#include <Game/Systems/IdentitySystem.hpp>
+#include <Game/Components/TransformComponent.hpp>
+#include <Game/Components/CameraComponent.hpp>
+#include <Game/Components/SpriteComponent.hpp>
+#include <Game/Components/SpriteAnimationComponent.hpp>
+
+namespace
+{
+    struct GameWorld
+    {
+        GameWorld()
+        {
+            gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+            REQUIRE(gameInstance);
+
+            entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+            componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+            identitySystem = gameInstance->GetSystems().Locate<Game::IdentitySystem>();
+            REQUIRE(entitySystem);
+            REQUIRE(componentSystem);
+            REQUIRE(identitySystem);
+        }
+
+        std::unique_ptr<Game::GameInstance> gameInstance;
+        Game::EntitySystem* entitySystem = nullptr;
+        Game::ComponentSystem* componentSystem = nullptr;
+        Game::IdentitySystem* identitySystem = nullptr;
+    };
+}
+
+TEST_CASE("Snapshot")
+{
+    static_assert(std::is_trivially_copyable<Game::EntityHandle>::value);
+    static_assert(std::is_trivially_copyable<Game::TransformComponent>::value);
+    static_assert(std::is_trivially_copyable<Game::CameraComponent>::value);
+
+    // Animation list is not saved, only reference to playing animation.
+    std::shared_ptr<Graphics::SpriteAnimationList> spriteAnimationList =
+        Graphics::SpriteAnimationList::Create().Unwrap();
+
+    Graphics::SpriteAnimationList::Animation spinAnimation;
+    spinAnimation.frames.resize(2);
+    spinAnimation.duration = 1.0f;
+    REQUIRE(spriteAnimationList->AddAnimation("spin", std::move(spinAnimation)));
+
+    auto populateWorld = [&spriteAnimationList](GameWorld& world)
+    {
+        std::vector<Game::EntityHandle> entities;
+
+        for(int i = 0; i < 8; ++i)
+        {
+            Game::EntityHandle entity = world.entitySystem->CreateEntity();
+            auto* transform = world.componentSystem->Create<Game::TransformComponent>(entity);
+            REQUIRE(transform);
+            transform->SetPosition(glm::vec3(float(i), 0.0f, 0.0f));
+
+            auto* sprite = world.componentSystem->Create<Game::SpriteComponent>(entity);
+            REQUIRE(sprite);
+            sprite->SetColor(glm::vec4(0.0f, float(i), 0.0f, 1.0f));
+
+            entities.push_back(entity);
+        }
+
+        REQUIRE(world.componentSystem->Create<Game::CameraComponent>(entities[0]));
+        REQUIRE(world.identitySystem->SetEntityName(entities[0], "Camera"));
+        REQUIRE(world.identitySystem->SetEntityGroup(entities[1], "Enemies"));
+        REQUIRE(world.identitySystem->SetEntityGroup(entities[2], "Enemies"));
+
+        auto* spriteAnimation = world.componentSystem->Create<Game::SpriteAnimationComponent>(entities[4]);
+        REQUIRE(spriteAnimation);
+        spriteAnimation->SetSpriteAnimationList(spriteAnimationList);
+        spriteAnimation->Play("spin", true);
+        spriteAnimation->Tick(0.25f);
+
+        world.entitySystem->DestroyEntity(entities[3]);
+        world.entitySystem->ProcessCommands();
+        return entities;
+    };
+
+    GameWorld world;
+    std::vector<Game::EntityHandle> entities = populateWorld(world);
+
+    Game::SnapshotWriter writer;
+    world.gameInstance->SaveSnapshot(writer);
+    const std::vector<uint8_t> snapshot = writer.GetData();
+
+    auto checkWorld = [&entities](GameWorld& world)
+    {
+        CHECK_EQ(world.entitySystem->GetEntityCount(), 7);
+        CHECK_FALSE(world.entitySystem->IsEntityValid(entities[3]));
+
+        for(int i : { 0, 1, 2, 4, 5, 6, 7 })
+        {
+            CHECK(world.entitySystem->IsEntityCreated(entities[i]));
+
+            auto* transform = world.componentSystem->Lookup<Game::TransformComponent>(entities[i]);
+            REQUIRE(transform);
+            CHECK_EQ(transform->GetPosition(), glm::vec3(float(i), 0.0f, 0.0f));
+
+            auto* sprite = world.componentSystem->Lookup<Game::SpriteComponent>(entities[i]);
+            REQUIRE(sprite);
+            CHECK_EQ(sprite->GetColor(), glm::vec4(0.0f, float(i), 0.0f, 1.0f));
+            CHECK_EQ(sprite->GetTransformComponent(), transform);
+        }
+
+        auto* camera = world.componentSystem->Lookup<Game::CameraComponent>(entities[0]);
+        REQUIRE(camera);
+        CHECK_EQ(camera->GetTransformComponent(),
+            world.componentSystem->Lookup<Game::TransformComponent>(entities[0]));
+
+        CHECK_EQ(world.identitySystem->GetEntityByName("Camera").UnwrapOr(Game::EntityHandle()), entities[0]);
+        CHECK_EQ(world.identitySystem->GetEntitiesByGroup("Enemies").Unwrap().size(), 2);
+        CHECK(world.identitySystem->IsEntityInGroup(entities[2], "Enemies"));
+    };
+
+    SUBCASE("Restore modified world")
+    {
+        world.componentSystem->Lookup<Game::TransformComponent>(entities[0])->SetPosition(glm::vec3(9.0f));
+        world.componentSystem->Lookup<Game::SpriteComponent>(entities[1])->SetColor(glm::vec4(9.0f));
+        world.componentSystem->Lookup<Game::SpriteAnimationComponent>(entities[4])->Stop();
+        world.identitySystem->SetEntityName(entities[0], "Renamed");
+        world.entitySystem->DestroyEntity(entities[2]);
+        world.entitySystem->ProcessCommands();
+
+        Game::EntityHandle createdEntity = world.entitySystem->CreateEntity();
+        REQUIRE(world.componentSystem->Create<Game::TransformComponent>(createdEntity));
+        world.entitySystem->ProcessCommands();
+
+        Game::SnapshotReader reader(snapshot);
+        REQUIRE(world.gameInstance->RestoreSnapshot(reader));
+        checkWorld(world);
+
+        auto* spriteAnimation = world.componentSystem->Lookup<Game::SpriteAnimationComponent>(entities[4]);
+        REQUIRE(spriteAnimation);
+        CHECK(spriteAnimation->IsPlaying());
+        CHECK_EQ(spriteAnimation->GetSpriteAnimation(), spriteAnimationList->GetAnimationByHash(
+            Graphics::CookedFormat::HashName("spin")));
+        CHECK_EQ(spriteAnimation->CalculateAnimationTime(1.0f), 0.25f);
+
+        CHECK_EQ(world.componentSystem->Lookup<Game::TransformComponent>(createdEntity), nullptr);
+        CHECK_FALSE(world.identitySystem->GetEntityByName("Renamed"));
+
+        // Restored world saves same snapshot and creates same entities.
+        Game::SnapshotWriter restoredWriter;
+        world.gameInstance->SaveSnapshot(restoredWriter);
+        CHECK(restoredWriter.GetData() == snapshot);
+        CHECK_EQ(world.entitySystem->CreateEntity(), createdEntity);
+    }
+
+    SUBCASE("Restore into new game instance")
+    {
+        GameWorld restoredWorld;
+
+        Game::SnapshotReader reader(snapshot);
+        REQUIRE(restoredWorld.gameInstance->RestoreSnapshot(reader));
+        checkWorld(restoredWorld);
+
+        // Playing animation cannot be resolved without animation list.
+        auto* restoredAnimation = restoredWorld.componentSystem->Lookup<Game::SpriteAnimationComponent>(entities[4]);
+        REQUIRE(restoredAnimation);
+        CHECK_EQ(restoredAnimation->GetSpriteAnimationList(), nullptr);
+        CHECK_EQ(restoredAnimation->GetSpriteAnimation(), nullptr);
+        CHECK_FALSE(restoredAnimation->IsPlaying());
+    }
+
+    SUBCASE("Save identical snapshots of identical worlds")
+    {
+        // Pointers resolved on initialization differ between instances.
+        GameWorld identicalWorld;
+        CHECK(populateWorld(identicalWorld) == entities);
+
+        Game::SnapshotWriter identicalWriter;
+        identicalWorld.gameInstance->SaveSnapshot(identicalWriter);
+        CHECK(identicalWriter.GetData() == snapshot);
+    }
+
+    SUBCASE("Reject invalid snapshots")
+    {
+        std::vector<uint8_t> invalidSnapshot = snapshot;
+        invalidSnapshot[0] ^= 0xFF;
+
+        Game::SnapshotReader invalidReader(invalidSnapshot);
+        CHECK_EQ(world.gameInstance->RestoreSnapshot(invalidReader).UnwrapFailure(),
+            Game::GameInstance::RestoreSnapshotErrors::InvalidHeader);
+
+        std::vector<uint8_t> truncatedSnapshot(snapshot.begin(), snapshot.end() - 1);
+        Game::SnapshotReader truncatedReader(truncatedSnapshot);
+        CHECK_EQ(world.gameInstance->RestoreSnapshot(truncatedReader).UnwrapFailure(),
+            Game::GameInstance::RestoreSnapshotErrors::InvalidSection);
+    }
+}
@@ -0,0 +1,273 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <map>
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/Snapshot.hpp>
+#include <Game/SnapshotDelta.hpp>
+#include <Game/Systems/IdentitySystem.hpp>
+#include <Game/Components/TransformComponent.hpp>
+#include <Game/Components/SpriteComponent.hpp>
+
+namespace
+{
+    struct GameWorld
+    {
+        GameWorld()
+        {
+            gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+            REQUIRE(gameInstance);
+
+            entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+            componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+            identitySystem = gameInstance->GetSystems().Locate<Game::IdentitySystem>();
+            REQUIRE(entitySystem);
+            REQUIRE(componentSystem);
+            REQUIRE(identitySystem);
+        }
+
+        std::unique_ptr<Game::GameInstance> gameInstance;
+        Game::EntitySystem* entitySystem = nullptr;
+        Game::ComponentSystem* componentSystem = nullptr;
+        Game::IdentitySystem* identitySystem = nullptr;
+    };
+
+    // Local loopback between server and client instances, with baselines
+    // kept on both sides as they would be over lossy connection.
+    struct LoopbackReplication
+    {
+        std::size_t Replicate(uint32_t tick, bool delivered)
+        {
+            Game::SnapshotWriter serverWriter;
+            server.gameInstance->SaveSnapshot(serverWriter);
+            serverSnapshots[tick] = serverWriter.GetData();
+            fullSnapshotSize = serverWriter.GetData().size();
+
+            // Encode against last baseline acknowledged by client.
+            const std::vector<uint8_t> emptySnapshot;
+            const std::vector<uint8_t>& serverBaseline =
+                acknowledged ? serverSnapshots.at(acknowledgedTick) : emptySnapshot;
+
+            Common::BitWriter deltaWriter;
+            server.gameInstance->SaveSnapshotDelta(Game::SnapshotReader(serverBaseline), deltaWriter);
+
+            if(delivered)
+            {
+                const std::vector<uint8_t>& clientBaseline =
+                    acknowledged ? clientSnapshots.at(acknowledgedTick) : emptySnapshot;
+
+                Common::BitReader deltaReader(deltaWriter.GetData());
+                REQUIRE(client.gameInstance->RestoreSnapshotDelta(
+                    Game::SnapshotReader(clientBaseline), deltaReader));
+
+                Game::SnapshotWriter clientWriter;
+                client.gameInstance->SaveSnapshot(clientWriter);
+                clientSnapshots[tick] = clientWriter.GetData();
+
+                // Baselines older than acknowledged one are not needed anymore.
+                acknowledged = true;
+                acknowledgedTick = tick;
+                serverSnapshots.erase(serverSnapshots.begin(), serverSnapshots.find(tick));
+                clientSnapshots.erase(clientSnapshots.begin(), clientSnapshots.find(tick));
+            }
+
+            return deltaWriter.GetData().size();
+        }
+
+        GameWorld server;
+        GameWorld client;
+
+        std::map<uint32_t, std::vector<uint8_t>> serverSnapshots;
+        std::map<uint32_t, std::vector<uint8_t>> clientSnapshots;
+        std::size_t fullSnapshotSize = 0;
+        uint32_t acknowledgedTick = 0;
+        bool acknowledged = false;
+    };
+}
+
+TEST_CASE("Snapshot Delta")
+{
+    static_assert(Game::SnapshotDelta::IsFieldSupported<uint64_t>());
+    static_assert(!Game::SnapshotDelta::IsFieldSupported<const Game::TransformComponent*>());
+
+    SUBCASE("Byte runs")
+    {
+        const std::vector<uint8_t> baseline = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        const std::vector<std::vector<uint8_t>> currentList =
+        {
+            {},
+            baseline,
+            { 1, 2, 3, 4, 5, 0, 7, 8, 9, 10, 11, 12 },
+            { 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 13, 14 },
+            { 1, 2, 3 },
+        };
+
+        for(const std::vector<uint8_t>& current : currentList)
+        {
+            Common::BitWriter writer;
+            Game::SnapshotDelta::WriteBytesDelta(writer, baseline.data(), baseline.size(), current);
+
+            std::vector<uint8_t> restored;
+            Common::BitReader reader(writer.GetData());
+            CHECK(Game::SnapshotDelta::ReadBytesDelta(reader, baseline.data(), baseline.size(), restored));
+            CHECK(restored == current);
+        }
+
+        Common::BitWriter writer;
+        Game::SnapshotDelta::WriteBytesDelta(writer, baseline.data(), baseline.size(), currentList[2]);
+        CHECK_LT(writer.GetData().size(), baseline.size() / 2);
+
+        std::vector<uint8_t> truncated(writer.GetData().begin(), writer.GetData().end() - 1);
+        std::vector<uint8_t> restored;
+        Common::BitReader reader(truncated);
+        CHECK_FALSE(Game::SnapshotDelta::ReadBytesDelta(reader, baseline.data(), baseline.size(), restored));
+    }
+
+    SUBCASE("Quantized fields")
+    {
+        const float precision = 1.0f / 1024.0f;
+        const glm::vec3 baseline(1.0f, -2.0f, 100.0f);
+        const glm::vec3 current(1.01f, -2.0f, 99.5f);
+
+        CHECK_FALSE(Game::SnapshotDelta::IsFieldChanged(baseline + glm::vec3(0.0001f), baseline, precision));
+        CHECK(Game::SnapshotDelta::IsFieldChanged(current, baseline, precision));
+        CHECK(Game::SnapshotDelta::IsFieldChanged(current, baseline, 0.0f));
+
+        Common::BitWriter writer;
+        Game::SnapshotDelta::WriteField(writer, current, baseline, precision);
+        CHECK_LT(writer.GetBitCount(), 32);
+
+        glm::vec3 restored = baseline;
+        Common::BitReader reader(writer.GetData());
+        CHECK(Game::SnapshotDelta::ReadField(reader, restored, precision));
+        CHECK_LE(glm::length(restored - current), precision);
+    }
+
+    SUBCASE("Loopback replication")
+    {
+        LoopbackReplication replication;
+        GameWorld& server = replication.server;
+        GameWorld& client = replication.client;
+
+        std::vector<Game::EntityHandle> entities;
+        for(int i = 0; i < 64; ++i)
+        {
+            Game::EntityHandle entity = server.entitySystem->CreateEntity();
+            auto* transform = server.componentSystem->Create<Game::TransformComponent>(entity);
+            REQUIRE(transform);
+            transform->SetPosition(glm::vec3(float(i), 0.0f, 0.0f));
+
+            if(i % 2 == 0)
+            {
+                auto* sprite = server.componentSystem->Create<Game::SpriteComponent>(entity);
+                REQUIRE(sprite);
+                sprite->SetColor(glm::vec4(0.0f, float(i), 0.0f, 1.0f));
+            }
+
+            entities.push_back(entity);
+        }
+
+        REQUIRE(server.identitySystem->SetEntityName(entities[0], "Player"));
+        server.entitySystem->ProcessCommands();
+
+        auto checkClient = [&server, &client]()
+        {
+            REQUIRE_EQ(client.entitySystem->GetEntityCount(), server.entitySystem->GetEntityCount());
+            CHECK_EQ(client.identitySystem->GetEntityByName("Player").UnwrapOr(Game::EntityHandle()),
+                server.identitySystem->GetEntityByName("Player").UnwrapOr(Game::EntityHandle()));
+            CHECK_EQ(client.identitySystem->GetNamedEntityCount(), server.identitySystem->GetNamedEntityCount());
+
+            // Pools have the same layout, so components are iterated in the same order.
+            auto clientIt = client.componentSystem->Begin<Game::TransformComponent>();
+            for(auto& serverTransform : server.componentSystem->GetPool<Game::TransformComponent>())
+            {
+                REQUIRE(clientIt != client.componentSystem->End<Game::TransformComponent>());
+                CHECK_LE(glm::length((*clientIt).GetPosition() - serverTransform.GetPosition()), 1.0f / 1024.0f);
+                CHECK_GE(glm::dot((*clientIt).GetRotation(), serverTransform.GetRotation()), 0.9999f);
+                ++clientIt;
+            }
+
+            CHECK(clientIt == client.componentSystem->End<Game::TransformComponent>());
+        };
+
+        // First delta is encoded against empty baseline of new instance.
+        replication.Replicate(0, true);
+        checkClient();
+
+        std::size_t largestDeltaSize = 0;
+        for(uint32_t tick = 1; tick <= 60; ++tick)
+        {
+            server.gameInstance->Tick(1.0f / 60.0f);
+
+            // Move only part of entities every tick.
+            for(int i = 0; i < 16; ++i)
+            {
+                Game::EntityHandle entity = entities[(tick + i * 4) % entities.size()];
+                if(auto* transform = server.componentSystem->Lookup<Game::TransformComponent>(entity))
+                {
+                    transform->SetPosition(transform->GetPosition() + glm::vec3(0.05f, -0.02f, 0.0f));
+                    transform->SetRotation(glm::angleAxis(float(tick) * 0.01f, glm::vec3(0.0f, 0.0f, 1.0f)));
+                }
+            }
+
+            // Occasionally replace entities, which changes entity and component layout.
+            if(tick % 20 == 0)
+            {
+                server.entitySystem->DestroyEntity(entities[tick % entities.size()]);
+                entities[tick % entities.size()] = server.entitySystem->CreateEntity();
+                REQUIRE(server.componentSystem->Create<Game::TransformComponent>(entities[tick % entities.size()]));
+                REQUIRE(server.identitySystem->SetEntityName(entities[1], "Player" + std::to_string(tick)));
+                server.entitySystem->ProcessCommands();
+            }
+
+            // Lose every fourth delta, so next one is encoded against older baseline.
+            bool delivered = tick % 4 != 0;
+            std::size_t deltaSize = replication.Replicate(tick, delivered);
+
+            if(tick % 20 != 0)
+            {
+                largestDeltaSize = std::max(largestDeltaSize, deltaSize);
+            }
+
+            if(delivered)
+            {
+                checkClient();
+            }
+        }
+
+        // Deltas of entities that move are fraction of full snapshot.
+        CHECK_LT(largestDeltaSize * 8, replication.fullSnapshotSize);
+        MESSAGE("Full snapshot: ", replication.fullSnapshotSize, " bytes, largest delta: ", largestDeltaSize, " bytes");
+    }
+
+    SUBCASE("Reject invalid deltas")
+    {
+        LoopbackReplication replication;
+        Game::EntityHandle entity = replication.server.entitySystem->CreateEntity();
+        REQUIRE(replication.server.componentSystem->Create<Game::TransformComponent>(entity));
+        replication.server.entitySystem->ProcessCommands();
+
+        const std::vector<uint8_t> emptySnapshot;
+        Common::BitWriter deltaWriter;
+        replication.server.gameInstance->SaveSnapshotDelta(Game::SnapshotReader(emptySnapshot), deltaWriter);
+
+        std::vector<uint8_t> truncatedDelta(deltaWriter.GetData().begin(), deltaWriter.GetData().end() - 8);
+        Common::BitReader truncatedReader(truncatedDelta);
+        CHECK_FALSE(replication.client.gameInstance->RestoreSnapshotDelta(
+            Game::SnapshotReader(emptySnapshot), truncatedReader));
+
+        std::vector<uint8_t> invalidBaseline = { 1, 2, 3 };
+        Common::BitReader deltaReader(deltaWriter.GetData());
+        CHECK_EQ(replication.client.gameInstance->RestoreSnapshotDelta(
+            Game::SnapshotReader(invalidBaseline), deltaReader).UnwrapFailure(),
+            Game::GameInstance::RestoreSnapshotErrors::InvalidHeader);
+    }
+}
@@ -0,0 +1,162 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/Config.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/MemoryFileDepot.hpp>
+#include <System/ResourceManager.hpp>
+#include <Graphics/TextureAtlas.hpp>
+#include <Graphics/Sprite/SpriteAnimationList.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/Components/TransformComponent.hpp>
+#include <Game/Components/SpriteComponent.hpp>
+#include <Game/Components/SpriteAnimationComponent.hpp>
+
+namespace
+{
+    const char* AtlasPath = "Data/Checker.atlas";
+    const char* AnimationPath = "Data/Checker.animation";
+
+    using SpriteAnimationList = Graphics::SpriteAnimationList;
+    using AnimationFrames = std::vector<std::pair<const char*, std::vector<float>>>;
+
+    // Texture cannot be created without render context, so frames
+    // refer to regions that resolve to empty texture views.
+    std::vector<uint8_t> CookAtlas()
+    {
+        Graphics::TextureAtlas::PreparedData prepared;
+        prepared.texturePath = "Data/Checker.png";
+        return Graphics::TextureAtlas::Cook(prepared, AtlasPath);
+    }
+
+    std::vector<uint8_t> CookAnimationList(const AnimationFrames& animations)
+    {
+        SpriteAnimationList::PreparedData prepared;
+        prepared.textureAtlasPath = AtlasPath;
+
+        for(const auto& [animationName, frameDurations] : animations)
+        {
+            SpriteAnimationList::PreparedAnimation& animation = prepared.animations.emplace_back();
+            animation.nameHash = Graphics::CookedFormat::HashName(animationName);
+            animation.firstFrame = static_cast<uint32_t>(prepared.frames.size());
+            animation.frameCount = static_cast<uint32_t>(frameDurations.size());
+
+            for(float frameDuration : frameDurations)
+            {
+                SpriteAnimationList::PreparedFrame& frame = prepared.frames.emplace_back();
+                frame.regionHash = Graphics::CookedFormat::HashName("full");
+                frame.duration = frameDuration;
+            }
+        }
+
+        return SpriteAnimationList::Cook(prepared, AnimationPath);
+    }
+
+    void AddFile(System::MemoryFileDepot& memoryDepot, const char* path, const std::vector<uint8_t>& contents)
+    {
+        REQUIRE(memoryDepot.AddFile(path, std::make_shared<std::vector<uint8_t>>(contents)));
+    }
+}
+
+TEST_CASE("Sprite Animation")
+{
+    Core::EngineSystemStorage engineSystems;
+
+    auto config = std::make_unique<Core::Config>();
+    config->Set<int>(NAME_CONSTEXPR("resources.loadingThreads"), 0);
+    config->Set<bool>(NAME_CONSTEXPR("resources.hotReload"), true);
+
+    auto memoryDepot = System::MemoryFileDepot::Create().Unwrap();
+    System::MemoryFileDepot* memoryFiles = memoryDepot.get();
+    AddFile(*memoryFiles, AtlasPath, CookAtlas());
+    AddFile(*memoryFiles, AnimationPath, CookAnimationList({
+        { "idle", { 1.0f } }, { "spin", { 0.5f, 0.5f } } }));
+
+    auto fileSystem = std::make_unique<System::FileSystem>();
+    REQUIRE(fileSystem->MountDepot("./", std::move(memoryDepot)));
+
+    REQUIRE(engineSystems.Attach(std::move(config)));
+    REQUIRE(engineSystems.Attach(std::move(fileSystem)));
+    REQUIRE(engineSystems.Attach(std::make_unique<System::ResourceManager>()));
+
+    auto* resourceManager = engineSystems.Locate<System::ResourceManager>();
+    if(!resourceManager->IsHotReloadEnabled())
+        return;
+
+    SpriteAnimationList::LoadFromFile params;
+    params.engineSystems = &engineSystems;
+
+    std::shared_ptr<SpriteAnimationList> spriteAnimationList =
+        resourceManager->Acquire<SpriteAnimationList>(AnimationPath, params).UnwrapOr(nullptr);
+    REQUIRE(spriteAnimationList);
+
+    auto gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+    REQUIRE(gameInstance);
+
+    auto* entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+    auto* componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+
+    Game::EntityHandle entity = entitySystem->CreateEntity();
+    REQUIRE(componentSystem->Create<Game::TransformComponent>(entity));
+    REQUIRE(componentSystem->Create<Game::SpriteComponent>(entity));
+    auto* spriteAnimation = componentSystem->Create<Game::SpriteAnimationComponent>(entity);
+    REQUIRE(spriteAnimation);
+    entitySystem->ProcessCommands();
+
+    spriteAnimation->SetSpriteAnimationList(spriteAnimationList);
+    spriteAnimation->Play("spin", true);
+    spriteAnimation->Tick(0.25f);
+    REQUIRE(spriteAnimation->IsPlaying());
+    CHECK_EQ(spriteAnimation->GetSpriteAnimation()->duration, 1.0f);
+
+    auto reloadAnimationList = [&](const AnimationFrames& animations)
+    {
+        const uint64_t spinHash = Graphics::CookedFormat::HashName("spin");
+        const SpriteAnimationList::Animation* previousSpin = spriteAnimationList->GetAnimationByHash(spinHash);
+        const float previousDuration = previousSpin ? previousSpin->duration : 0.0f;
+
+        AddFile(*memoryFiles, AnimationPath, CookAnimationList(animations));
+        resourceManager->Reload(AnimationPath);
+
+        for(int i = 0; i < 10; ++i)
+        {
+            resourceManager->FinalizeAsyncLoads();
+        }
+
+        const SpriteAnimationList::Animation* spin = spriteAnimationList->GetAnimationByHash(spinHash);
+        CHECK_NE(spin ? spin->duration : 0.0f, previousDuration);
+    };
+
+    SUBCASE("Reload animation list while playing")
+    {
+        // Animations are laid out differently and old storage is released.
+        reloadAnimationList({ { "walk", { 0.25f } }, { "spin", { 1.0f, 1.0f } }, { "idle", { 1.0f } } });
+        CHECK_EQ(resourceManager->Acquire<SpriteAnimationList>(AnimationPath, params).Unwrap(), spriteAnimationList);
+
+        spriteAnimation->Tick(0.25f);
+        CHECK(spriteAnimation->IsPlaying());
+        CHECK_EQ(spriteAnimation->GetSpriteAnimation(),
+            spriteAnimationList->GetAnimationByHash(Graphics::CookedFormat::HashName("spin")));
+        CHECK_EQ(spriteAnimation->GetSpriteAnimation()->duration, 2.0f);
+        CHECK_EQ(spriteAnimation->CalculateAnimationTime(1.0f), 0.5f);
+    }
+
+    SUBCASE("Reload animation list without playing animation")
+    {
+        // Playback stops when animation is no longer present.
+        reloadAnimationList({ { "idle", { 1.0f } } });
+        CHECK_EQ(spriteAnimation->GetSpriteAnimation(), nullptr);
+
+        spriteAnimation->Tick(0.25f);
+        CHECK_FALSE(spriteAnimation->IsPlaying());
+    }
+}
@@ -0,0 +1,159 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <Common/Event/Receiver.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/Snapshot.hpp>
+#include <Game/TickSimulation.hpp>
+#include <Game/Components/TransformComponent.hpp>
+
+namespace
+{
+    // Moves player by direction stored in input of every tick.
+    struct SimulatedWorld
+    {
+        SimulatedWorld(uint32_t snapshotInterval)
+        {
+            gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+            REQUIRE(gameInstance);
+
+            auto* entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+            componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+            REQUIRE(entitySystem);
+            REQUIRE(componentSystem);
+
+            player = entitySystem->CreateEntity();
+            REQUIRE(componentSystem->Create<Game::TransformComponent>(player));
+            entitySystem->ProcessCommands();
+
+            Game::TickSimulation::CreateFromParams params;
+            params.gameInstance = gameInstance.get();
+            params.historyLength = 16;
+            params.snapshotInterval = snapshotInterval;
+
+            simulation = Game::TickSimulation::Create(params).UnwrapOr(nullptr);
+            REQUIRE(simulation);
+
+            applyInput.Bind([this](Game::GameInstance& gameInstance,
+                Game::TickSimulation::TickIndex tick, const Game::TickSimulation::TickInput& input)
+            {
+                auto* transform = componentSystem->Lookup<Game::TransformComponent>(player);
+                REQUIRE(transform);
+
+                float direction = input.empty() ? 0.0f : static_cast<int8_t>(input[0]);
+                transform->SetPosition(transform->GetPosition() +
+                    glm::vec3(direction * 0.37f, float(tick % 3) * 0.01f, 0.0f));
+            });
+
+            REQUIRE(applyInput.Subscribe(simulation->events.applyInput));
+        }
+
+        std::vector<uint8_t> SaveSnapshot() const
+        {
+            Game::SnapshotWriter writer;
+            gameInstance->SaveSnapshot(writer);
+            return writer.GetData();
+        }
+
+        std::unique_ptr<Game::GameInstance> gameInstance;
+        std::unique_ptr<Game::TickSimulation> simulation;
+        Game::ComponentSystem* componentSystem = nullptr;
+        Game::EntityHandle player;
+
+        Event::Receiver<void(Game::GameInstance&, Game::TickSimulation::TickIndex,
+            const Game::TickSimulation::TickInput&)> applyInput;
+    };
+
+    Game::TickSimulation::TickInput MakeInput(Game::TickSimulation::TickIndex tick)
+    {
+        return { static_cast<uint8_t>(static_cast<int8_t>(int(tick % 5) - 2)) };
+    }
+}
+
+TEST_CASE("Tick Simulation")
+{
+    const uint32_t tickCount = 40;
+    const uint32_t inputDelay = 5;
+
+    SUBCASE("Late inputs are simulated again")
+    {
+        for(uint32_t snapshotInterval : { 1u, 4u })
+        {
+            // Reference world receives every input on time.
+            SimulatedWorld reference(snapshotInterval);
+            for(Game::TickSimulation::TickIndex tick = 0; tick < tickCount; ++tick)
+            {
+                REQUIRE(reference.simulation->RecordInput(tick, MakeInput(tick)));
+                reference.simulation->Advance();
+            }
+
+            CHECK_EQ(reference.simulation->GetCurrentTick(), tickCount);
+            CHECK_FALSE(reference.simulation->HasPendingResimulation());
+
+            // Delayed world receives inputs few ticks late and predicts them meanwhile.
+            SimulatedWorld delayed(snapshotInterval);
+            for(Game::TickSimulation::TickIndex tick = 0; tick < tickCount; ++tick)
+            {
+                if(tick >= inputDelay)
+                {
+                    REQUIRE(delayed.simulation->RecordInput(tick - inputDelay, MakeInput(tick - inputDelay)));
+                    CHECK(delayed.simulation->HasPendingResimulation());
+
+                    auto resimulated = delayed.simulation->ResimulatePending();
+                    REQUIRE(resimulated);
+                    CHECK_GE(resimulated.Unwrap(), inputDelay);
+                    CHECK_LT(resimulated.Unwrap(), inputDelay + snapshotInterval);
+                }
+
+                delayed.simulation->Advance();
+            }
+
+            for(Game::TickSimulation::TickIndex tick = tickCount - inputDelay; tick < tickCount; ++tick)
+            {
+                REQUIRE(delayed.simulation->RecordInput(tick, MakeInput(tick)));
+            }
+
+            REQUIRE(delayed.simulation->ResimulatePending());
+            CHECK_EQ(delayed.simulation->GetCurrentTick(), tickCount);
+
+            // Simulation is deterministic, so world states match exactly.
+            CHECK_EQ(delayed.componentSystem->Lookup<Game::TransformComponent>(delayed.player)->GetPosition(),
+                reference.componentSystem->Lookup<Game::TransformComponent>(reference.player)->GetPosition());
+            CHECK(delayed.SaveSnapshot() == reference.SaveSnapshot());
+        }
+    }
+
+    SUBCASE("History is limited")
+    {
+        SimulatedWorld world(1);
+        for(uint32_t tick = 0; tick < tickCount; ++tick)
+        {
+            world.simulation->Advance();
+        }
+
+        CHECK_EQ(world.simulation->GetOldestResimulatedTick(), tickCount - 16);
+        CHECK_EQ(world.simulation->RecordInput(tickCount - 17, {}).UnwrapFailure(),
+            Game::TickSimulation::RecordInputErrors::TooOld);
+        CHECK_EQ(world.simulation->RecordInput(tickCount + 16, {}).UnwrapFailure(),
+            Game::TickSimulation::RecordInputErrors::TooFarAhead);
+        CHECK_EQ(world.simulation->Resimulate(tickCount - 17).UnwrapFailure(),
+            Game::TickSimulation::ResimulateErrors::TooOld);
+
+        // Future input does not need simulating again.
+        REQUIRE(world.simulation->RecordInput(tickCount + 2, MakeInput(0)));
+        CHECK_FALSE(world.simulation->HasPendingResimulation());
+
+        auto resimulated = world.simulation->Resimulate(tickCount - 16);
+        REQUIRE(resimulated);
+        CHECK_EQ(resimulated.Unwrap(), 16);
+        CHECK_EQ(world.simulation->GetCurrentTick(), tickCount);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <chrono>
+#include <thread>
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <System/Timer.hpp>
+#include <Game/TickTimer.hpp>
+
+namespace
+{
+    // Stalls for many ticks and returns number of ticks processed in next frame.
+    uint32_t ProcessStalledFrame(Game::TickTimer& tickTimer, System::Timer& timer)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        timer.Advance(1.0f);
+        tickTimer.Advance(timer);
+
+        uint32_t tickCount = 0;
+        while(tickTimer.Tick())
+        {
+            ++tickCount;
+        }
+
+        return tickCount;
+    }
+}
+
+TEST_CASE("Tick Timer")
+{
+    System::Timer timer;
+    auto tickTimer = Game::TickTimer::Create().UnwrapOr(nullptr);
+    REQUIRE(tickTimer);
+    tickTimer->SetTickSeconds(1.0f / 1000.0f);
+
+    SUBCASE("Unlimited ticks per frame")
+    {
+        CHECK_GE(ProcessStalledFrame(*tickTimer, timer), 20);
+        CHECK_EQ(tickTimer->GetMetrics().throttledFrames, 0);
+        CHECK_GE(tickTimer->GetMetrics().maxFrameTicks, 20);
+    }
+
+    SUBCASE("Delayed ticks")
+    {
+        tickTimer->SetMaxFrameTicks(3);
+        tickTimer->SetCatchUpPolicy(Game::TickTimer::CatchUpPolicy::Delay);
+
+        CHECK_EQ(ProcessStalledFrame(*tickTimer, timer), 3);
+        CHECK_EQ(tickTimer->GetMetrics().processedTicks, 3);
+        CHECK_EQ(tickTimer->GetMetrics().throttledFrames, 1);
+        CHECK_GE(tickTimer->GetMetrics().delayedTicks, 17);
+        CHECK_EQ(tickTimer->GetMetrics().skippedTicks, 0);
+        CHECK_EQ(tickTimer->GetAlphaSeconds(), 1.0f);
+
+        // Delayed ticks are still processed in following frames.
+        tickTimer->SetMaxFrameTicks(0);
+        CHECK_GE(ProcessStalledFrame(*tickTimer, timer), 37);
+    }
+
+    SUBCASE("Skipped ticks")
+    {
+        tickTimer->SetMaxFrameTicks(3);
+        tickTimer->SetCatchUpPolicy(Game::TickTimer::CatchUpPolicy::Skip);
+
+        CHECK_EQ(ProcessStalledFrame(*tickTimer, timer), 3);
+        CHECK_EQ(tickTimer->GetMetrics().throttledFrames, 1);
+        CHECK_GE(tickTimer->GetMetrics().skippedTicks, 17);
+        CHECK_EQ(tickTimer->GetMetrics().delayedTicks, 0);
+        CHECK_LE(tickTimer->GetAlphaSeconds(), 1.0f);
+
+        // Skipped time is never simulated.
+        CHECK_EQ(tickTimer->GetTotalTickSeconds(), doctest::Approx(3.0 / 1000.0));
+        CHECK_FALSE(tickTimer->Tick());
+    }
+
+    SUBCASE("Stretched ticks")
+    {
+        tickTimer->SetMaxFrameTicks(3);
+        tickTimer->SetCatchUpPolicy(Game::TickTimer::CatchUpPolicy::Stretch);
+
+        CHECK_EQ(ProcessStalledFrame(*tickTimer, timer), 3);
+        CHECK_EQ(tickTimer->GetMetrics().throttledFrames, 1);
+        CHECK_GE(tickTimer->GetMetrics().stretchedTicks, 17);
+        CHECK_GT(tickTimer->GetLastTickSeconds(), tickTimer->GetTickSeconds());
+
+        // Stretched tick covers all time that has passed.
+        CHECK_GE(tickTimer->GetTotalTickSeconds(), 20.0 / 1000.0);
+        CHECK_FALSE(tickTimer->Tick());
+    }
+
+    tickTimer->ResetMetrics();
+    CHECK_EQ(tickTimer->GetMetrics().processedTicks, 0);
+}
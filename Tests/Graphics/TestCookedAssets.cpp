@@ -0,0 +1,154 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <System/FileSystem/MemoryFileHandle.hpp>
+#include <Graphics/TextureAtlas.hpp>
+#include <Graphics/Sprite/SpriteAnimationList.hpp>
+
+namespace
+{
+    std::unique_ptr<System::FileHandle> OpenMemoryFile(std::string_view contents, const fs::path& path)
+    {
+        auto buffer = std::make_shared<std::vector<uint8_t>>(contents.begin(), contents.end());
+        return System::MemoryFileHandle::Create(buffer, path, System::FileHandle::OpenFlags::Read).Unwrap();
+    }
+
+    std::unique_ptr<System::FileHandle> OpenMemoryFile(const std::vector<uint8_t>& contents, const fs::path& path)
+    {
+        auto buffer = std::make_shared<std::vector<uint8_t>>(contents);
+        return System::MemoryFileHandle::Create(buffer, path, System::FileHandle::OpenFlags::Read).Unwrap();
+    }
+
+    const char* AtlasScript = R"(
+        TextureAtlas =
+        {
+            Texture = "Checker.png",
+            Regions =
+            {
+                ["full"] = { 0, 0, 128, 128 },
+                ["center"] = { 16, 16, 112, 112 },
+                ["flipped"] = { 0, 128, 128, 0 },
+            },
+        }
+    )";
+
+    const char* AnimationScript = R"(
+        SpriteAnimationList =
+        {
+            TextureAtlas = "Checker.atlas",
+            Animations =
+            {
+                ["idle"] = { { "full", 1.0 } },
+                ["spin"] = { { "full", 0.5 }, { "flipped", 0.25 }, { "center", 0.25 } },
+            },
+        }
+    )";
+}
+
+TEST_CASE("Cooked Assets")
+{
+    Core::EngineSystemStorage engineSystems;
+
+    SUBCASE("Cook and load texture atlas")
+    {
+        using TextureAtlas = Graphics::TextureAtlas;
+        const fs::path filePath = "Data/Textures/Checker.atlas";
+
+        TextureAtlas::LoadFromFile params;
+        params.engineSystems = &engineSystems;
+
+        auto scriptFile = OpenMemoryFile(AtlasScript, filePath);
+        auto scriptPrepared = TextureAtlas::Prepare(*scriptFile, params).Unwrap();
+        CHECK_EQ(scriptPrepared.texturePath, fs::path("Data/Textures/Checker.png"));
+        REQUIRE_EQ(scriptPrepared.regions.size(), 3);
+
+        auto cooked = TextureAtlas::Cook(scriptPrepared, filePath);
+        CHECK_EQ(cooked.size(), sizeof(Graphics::CookedFormat::AtlasHeader) +
+            3 * sizeof(TextureAtlas::Region) + std::string_view("Checker.png").size());
+
+        auto cookedFile = OpenMemoryFile(cooked, filePath);
+        auto cookedPrepared = TextureAtlas::Prepare(*cookedFile, params).Unwrap();
+        CHECK_EQ(cookedPrepared.texturePath, scriptPrepared.texturePath);
+        REQUIRE_EQ(cookedPrepared.regions.size(), scriptPrepared.regions.size());
+
+        for(std::size_t i = 0; i < cookedPrepared.regions.size(); ++i)
+        {
+            CHECK_EQ(cookedPrepared.regions[i].nameHash, scriptPrepared.regions[i].nameHash);
+            CHECK_EQ(cookedPrepared.regions[i].pixelCoords, scriptPrepared.regions[i].pixelCoords);
+        }
+
+        auto centerIt = std::find_if(cookedPrepared.regions.begin(), cookedPrepared.regions.end(),
+            [](const TextureAtlas::Region& region)
+            {
+                return region.nameHash == Graphics::CookedFormat::HashName("center");
+            });
+
+        REQUIRE(centerIt != cookedPrepared.regions.end());
+        CHECK_EQ(centerIt->pixelCoords, glm::ivec4(16, 16, 112, 112));
+
+        // Truncated and corrupted files are rejected.
+        auto truncated = cooked;
+        truncated.pop_back();
+        auto truncatedFile = OpenMemoryFile(truncated, filePath);
+        CHECK_EQ(TextureAtlas::Prepare(*truncatedFile, params).UnwrapFailure(),
+            TextureAtlas::CreateErrors::InvalidResourceContents);
+
+        auto unsorted = cooked;
+        auto regionsIt = unsorted.begin() + sizeof(Graphics::CookedFormat::AtlasHeader);
+        std::swap_ranges(regionsIt, regionsIt + sizeof(TextureAtlas::Region),
+            regionsIt + sizeof(TextureAtlas::Region));
+        auto unsortedFile = OpenMemoryFile(unsorted, filePath);
+        CHECK(TextureAtlas::Prepare(*unsortedFile, params).IsFailure());
+    }
+
+    SUBCASE("Cook and load sprite animation list")
+    {
+        using SpriteAnimationList = Graphics::SpriteAnimationList;
+        const fs::path filePath = "Data/Textures/Checker.animation";
+
+        SpriteAnimationList::LoadFromFile params;
+        params.engineSystems = &engineSystems;
+
+        auto scriptFile = OpenMemoryFile(AnimationScript, filePath);
+        auto scriptPrepared = SpriteAnimationList::Prepare(*scriptFile, params).Unwrap();
+        CHECK_EQ(scriptPrepared.textureAtlasPath, fs::path("Data/Textures/Checker.atlas"));
+        REQUIRE_EQ(scriptPrepared.animations.size(), 2);
+        REQUIRE_EQ(scriptPrepared.frames.size(), 4);
+
+        auto cooked = SpriteAnimationList::Cook(scriptPrepared, filePath);
+        auto cookedFile = OpenMemoryFile(cooked, filePath);
+        auto cookedPrepared = SpriteAnimationList::Prepare(*cookedFile, params).Unwrap();
+        CHECK_EQ(cookedPrepared.textureAtlasPath, scriptPrepared.textureAtlasPath);
+        REQUIRE_EQ(cookedPrepared.animations.size(), 2);
+        REQUIRE_EQ(cookedPrepared.frames.size(), 4);
+
+        auto spinIt = std::find_if(cookedPrepared.animations.begin(), cookedPrepared.animations.end(),
+            [](const SpriteAnimationList::PreparedAnimation& animation)
+            {
+                return animation.nameHash == Graphics::CookedFormat::HashName("spin");
+            });
+
+        REQUIRE(spinIt != cookedPrepared.animations.end());
+        REQUIRE_EQ(spinIt->frameCount, 3);
+
+        const auto& spinFrames = cookedPrepared.frames;
+        CHECK_EQ(spinFrames[spinIt->firstFrame + 0].regionHash, Graphics::CookedFormat::HashName("full"));
+        CHECK_EQ(spinFrames[spinIt->firstFrame + 1].regionHash, Graphics::CookedFormat::HashName("flipped"));
+        CHECK_EQ(spinFrames[spinIt->firstFrame + 2].regionHash, Graphics::CookedFormat::HashName("center"));
+        CHECK_EQ(spinFrames[spinIt->firstFrame + 1].duration, 0.25f);
+
+        // Frame ranges outside of frame array are rejected.
+        auto invalidRange = cooked;
+        uint32_t frameCount = 5;
+        std::memcpy(invalidRange.data() + sizeof(Graphics::CookedFormat::AnimationHeader) + 12,
+            &frameCount, sizeof(frameCount));
+        auto invalidRangeFile = OpenMemoryFile(invalidRange, filePath);
+        CHECK_EQ(SpriteAnimationList::Prepare(*invalidRangeFile, params).UnwrapFailure(),
+            SpriteAnimationList::CreateErrors::InvalidResourceContents);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <System/FileSystem/MemoryFileHandle.hpp>
+#include <System/Image.hpp>
+#include <Graphics/Texture.hpp>
+#include <Graphics/TextureCompression.hpp>
+
+namespace
+{
+    std::unique_ptr<System::Image> CreateImage(int width, int height, int channels, bool opaque)
+    {
+        System::Image::CreateFromParams params;
+        params.width = width;
+        params.height = height;
+        params.channels = channels;
+        params.data.resize(std::size_t(width) * height * channels);
+
+        // Smooth gradients are what block compression handles well.
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                uint8_t* pixel = params.data.data() + (std::size_t(y) * width + x) * channels;
+                for(int c = 0; c < channels; ++c)
+                {
+                    pixel[c] = static_cast<uint8_t>((x + y) * 200 / (width + height) + c * 15);
+                }
+
+                if(channels == 4 && opaque)
+                {
+                    pixel[3] = 255;
+                }
+            }
+        }
+
+        return System::Image::Create(params).Unwrap();
+    }
+
+    int GetMaxError(const uint8_t* expected, const uint8_t* actual, std::size_t size)
+    {
+        int maxError = 0;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            maxError = std::max(maxError, std::abs(int(expected[i]) - int(actual[i])));
+        }
+
+        return maxError;
+    }
+
+    Graphics::Texture::PrepareResult PrepareTexture(const std::vector<uint8_t>& cooked)
+    {
+        Core::EngineSystemStorage engineSystems;
+        Graphics::Texture::LoadFromFile params;
+        params.engineSystems = &engineSystems;
+
+        auto buffer = std::make_shared<std::vector<uint8_t>>(cooked);
+        auto file = System::MemoryFileHandle::Create(buffer, "Texture.png",
+            System::FileHandle::OpenFlags::Read).Unwrap();
+        return Graphics::Texture::Prepare(*file, params);
+    }
+}
+
+TEST_CASE("Texture Compression")
+{
+    using TextureFormat = Graphics::CookedFormat::TextureFormat;
+    namespace TextureCompression = Graphics::TextureCompression;
+
+    SUBCASE("Compress and decompress BC blocks")
+    {
+        auto image = CreateImage(30, 18, 4, false);
+        const std::size_t size = std::size_t(30) * 18 * 4;
+
+        auto bc1 = TextureCompression::CompressBC1(image->GetData(), 30, 18);
+        CHECK_EQ(bc1.size(), 8 * 5 * 8);
+        CHECK_EQ(bc1.size(), TextureCompression::GetLevelSize(TextureFormat::BC1, 30, 18));
+
+        auto bc1Pixels = TextureCompression::DecompressBC1(bc1.data(), 30, 18);
+        REQUIRE_EQ(bc1Pixels.size(), size);
+
+        for(std::size_t i = 0; i < size; i += 4)
+        {
+            CHECK_LE(GetMaxError(image->GetData() + i, bc1Pixels.data() + i, 3), 16);
+            CHECK_EQ(bc1Pixels[i + 3], 255);
+        }
+
+        auto bc3 = TextureCompression::CompressBC3(image->GetData(), 30, 18);
+        CHECK_EQ(bc3.size(), 8 * 5 * 16);
+
+        auto bc3Pixels = TextureCompression::DecompressBC3(bc3.data(), 30, 18);
+        REQUIRE_EQ(bc3Pixels.size(), size);
+        CHECK_LE(GetMaxError(image->GetData(), bc3Pixels.data(), size), 16);
+    }
+
+    SUBCASE("Generate mip levels")
+    {
+        const uint8_t pixels[] = { 0, 10, 20, 30, 40, 50 };
+        auto level = TextureCompression::GenerateMipLevel(pixels, 3, 2, 1);
+        REQUIRE_EQ(level.size(), 1);
+        CHECK_EQ(level[0], 20);
+
+        CHECK_EQ(TextureCompression::GetMaxLevelCount(1, 1), 1);
+        CHECK_EQ(TextureCompression::GetMaxLevelCount(256, 64), 9);
+        CHECK_EQ(TextureCompression::GetMaxLevelCount(5, 3), 3);
+    }
+
+    SUBCASE("Cook and prepare textures")
+    {
+        auto image = CreateImage(20, 12, 4, true);
+
+        for(TextureFormat format : { TextureFormat::Unknown, TextureFormat::BC1, TextureFormat::BC3 })
+        {
+            Graphics::Texture::CookParams cookParams;
+            cookParams.format = format;
+
+            auto cooked = Graphics::Texture::Cook(*image, cookParams).Unwrap();
+            auto prepared = PrepareTexture(cooked).Unwrap();
+            CHECK_EQ(prepared.image, nullptr);
+            CHECK_EQ(prepared.format, format == TextureFormat::Unknown ? TextureFormat::RGBA8 : format);
+            CHECK_EQ(prepared.width, 20);
+            CHECK_EQ(prepared.height, 12);
+            REQUIRE_EQ(prepared.levels.size(), 5);
+
+            for(std::size_t level = 0; level < prepared.levels.size(); ++level)
+            {
+                CHECK_EQ(prepared.levels[level].size, TextureCompression::GetLevelSize(
+                    prepared.format, 20 >> level, 12 >> level));
+            }
+
+            // Base level of uncompressed texture is stored unchanged.
+            if(format == TextureFormat::Unknown)
+            {
+                CHECK(std::equal(image->GetData(), image->GetData() + prepared.levels[0].size,
+                    prepared.cookedData.data() + prepared.levels[0].offset));
+            }
+
+            // Truncated level data is rejected.
+            cooked.pop_back();
+            CHECK_EQ(PrepareTexture(cooked).UnwrapFailure(),
+                Graphics::Texture::CreateErrors::InvalidResourceContents);
+        }
+
+        Graphics::Texture::CookParams cookParams;
+        cookParams.mipmaps = false;
+        cookParams.format = TextureFormat::BC1;
+
+        auto rgbImage = CreateImage(7, 5, 3, true);
+        auto prepared = PrepareTexture(Graphics::Texture::Cook(*rgbImage, cookParams).Unwrap()).Unwrap();
+        CHECK_EQ(prepared.levels.size(), 1);
+
+        cookParams.format = TextureFormat::ETC2RGB8;
+        CHECK(Graphics::Texture::Cook(*rgbImage, cookParams).IsFailure());
+
+        auto grayImage = CreateImage(4, 4, 1, true);
+        cookParams.format = TextureFormat::BC3;
+        CHECK(Graphics::Texture::Cook(*grayImage, cookParams).IsFailure());
+    }
+
+    SUBCASE("Prepare image textures")
+    {
+        auto image = CreateImage(4, 4, 3, true);
+        auto encoded = image->EncodeQOI().Unwrap();
+
+        Core::EngineSystemStorage engineSystems;
+        Graphics::Texture::LoadFromFile params;
+        params.engineSystems = &engineSystems;
+
+        auto buffer = std::make_shared<std::vector<uint8_t>>(encoded);
+        auto file = System::MemoryFileHandle::Create(buffer, "Texture.qoi",
+            System::FileHandle::OpenFlags::Read).Unwrap();
+
+        auto prepared = Graphics::Texture::Prepare(*file, params).Unwrap();
+        REQUIRE_NE(prepared.image, nullptr);
+        CHECK(prepared.levels.empty());
+    }
+}
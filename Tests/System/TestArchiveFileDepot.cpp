@@ -0,0 +1,125 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <fstream>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/ArchiveFileDepot.hpp>
+#include <System/FileSystem/ArchiveFilePacker.hpp>
+
+namespace
+{
+    const char* TestArchivePath = "TestArchiveFileDepot.pak";
+
+    std::vector<uint8_t> MakeData(const std::string& text)
+    {
+        return std::vector<uint8_t>(text.begin(), text.end());
+    }
+}
+
+TEST_CASE("Archive File Depot")
+{
+    const std::string storedText = "Stored file contents.";
+    const std::string compressedText(10000, 'c');
+
+    System::ArchiveFilePacker packer;
+    CHECK(packer.AddFile("Stored.txt", MakeData(storedText)));
+    CHECK(packer.AddFile("Directory/../Nested/Compressed.txt", MakeData(compressedText),
+        System::ArchiveFormat::Compression::Zlib));
+    CHECK(packer.AddFile("Empty.txt", {}));
+    CHECK_EQ(packer.GetFileCount(), 3);
+
+    CHECK_EQ(packer.AddFile("Stored.txt", {}).UnwrapFailure(),
+        System::ArchiveFilePacker::AddFileErrors::DuplicateArchivePath);
+    CHECK_EQ(packer.AddFile("../Outside.txt", {}).UnwrapFailure(),
+        System::ArchiveFilePacker::AddFileErrors::InvalidArchivePathArgument);
+
+    REQUIRE(packer.Write(TestArchivePath));
+
+    SUBCASE("Entries are aligned and compressed")
+    {
+        std::ifstream archive(TestArchivePath, std::ios::binary);
+        System::ArchiveFormat::Header header;
+        REQUIRE(archive.read(reinterpret_cast<char*>(&header), sizeof(header)));
+        CHECK_EQ(header.entryCount, 3);
+        CHECK_EQ(header.tableOffset % System::ArchiveFormat::Alignment, 0);
+
+        std::vector<System::ArchiveFormat::Entry> entries(header.entryCount);
+        archive.seekg(header.tableOffset);
+        REQUIRE(archive.read(reinterpret_cast<char*>(entries.data()),
+            entries.size() * sizeof(System::ArchiveFormat::Entry)));
+
+        for(const auto& entry : entries)
+        {
+            CHECK_EQ(entry.offset % System::ArchiveFormat::Alignment, 0);
+
+            if(entry.compression == System::ArchiveFormat::Compression::Zlib)
+            {
+                CHECK_EQ(entry.size, compressedText.size());
+                CHECK_LT(entry.storedSize, entry.size);
+            }
+        }
+    }
+
+    SUBCASE("Files are opened through mounted depot")
+    {
+        Core::EngineSystemStorage engineSystems;
+        REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+        REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+        auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+        auto depot = System::ArchiveFileDepot::Create(TestArchivePath).Unwrap();
+        CHECK_EQ(depot->GetEntryCount(), 3);
+        REQUIRE(fileSystem->MountDepot("Archive/", std::move(depot)));
+
+        auto storedFile = fileSystem->OpenFile("Archive/Stored.txt").Unwrap();
+        CHECK_EQ(storedFile->GetSize(), storedText.size());
+        CHECK_EQ(storedFile->ReadAsTextString(), storedText);
+
+        char partial[6] = {};
+        CHECK_EQ(storedFile->Seek(7), 7);
+        CHECK_EQ(storedFile->Read(reinterpret_cast<uint8_t*>(partial), 4), 4);
+        CHECK_EQ(std::string(partial), "file");
+        CHECK_EQ(storedFile->Seek(0, System::FileHandle::SeekMode::End), storedText.size());
+        CHECK_EQ(storedFile->Read(reinterpret_cast<uint8_t*>(partial), 4), 0);
+        CHECK(storedFile->IsGood());
+
+        if(System::MappedFileHandle::IsSupported())
+        {
+            CHECK_EQ(storedFile->Map().Unwrap().AsString(), storedText);
+        }
+
+        auto compressedFile = fileSystem->OpenFile("Archive/Nested/Compressed.txt").Unwrap();
+        CHECK_EQ(compressedFile->ReadAsTextString(), compressedText);
+
+        auto emptyFile = fileSystem->OpenFile("Archive/Empty.txt").Unwrap();
+        CHECK_EQ(emptyFile->GetSize(), 0);
+
+        CHECK_EQ(fileSystem->OpenFile("Archive/Missing.txt").UnwrapFailure(),
+            System::FileDepot::OpenFileErrors::FileNotFound);
+        CHECK_EQ(fileSystem->OpenFile("Archive/Stored.txt", System::FileHandle::OpenFlags::Write).UnwrapFailure(),
+            System::FileDepot::OpenFileErrors::AccessDenied);
+    }
+
+    SUBCASE("Corrupted table of contents is detected")
+    {
+        {
+            std::fstream archive(TestArchivePath, std::ios::binary | std::ios::in | std::ios::out);
+            System::ArchiveFormat::Header header;
+            REQUIRE(archive.read(reinterpret_cast<char*>(&header), sizeof(header)));
+
+            archive.seekp(header.tableOffset + header.tableSize - 1);
+            archive.put('x');
+        }
+
+        CHECK_EQ(System::ArchiveFileDepot::Create(TestArchivePath).UnwrapFailure(),
+            System::ArchiveFileDepot::CreateErrors::CorruptedTableOfContents);
+    }
+
+    std::remove(TestArchivePath);
+}
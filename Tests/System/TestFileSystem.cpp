@@ -0,0 +1,195 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <fstream>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/MemoryFileDepot.hpp>
+
+namespace
+{
+    class CountingFileDepot final : public System::FileDepot
+    {
+    public:
+        CountingFileDepot() :
+            m_memoryDepot(System::MemoryFileDepot::Create().Unwrap())
+        {
+        }
+
+        OpenFileResult OpenFile(const fs::path& depotPath, const fs::path& requestedPath,
+            System::FileHandle::OpenFlags::Type openFlags) override
+        {
+            ++openCount;
+            return m_memoryDepot->OpenFile(depotPath, requestedPath, openFlags);
+        }
+
+        System::MemoryFileDepot& GetMemoryDepot()
+        {
+            return *m_memoryDepot;
+        }
+
+        int openCount = 0;
+
+    private:
+        std::unique_ptr<System::MemoryFileDepot> m_memoryDepot;
+    };
+
+    const char* TestFilePath = "TestFileSystemAsync.bin";
+    const char* LowerFileText = "Lower depot file.";
+    const char* UpperFileText = "Upper depot file.";
+
+    System::MemoryFileHandle::BufferPtr CreateBuffer(const char* text)
+    {
+        return std::make_shared<System::MemoryFileHandle::Buffer>(text, text + std::strlen(text));
+    }
+}
+
+TEST_CASE("File System")
+{
+    Core::EngineSystemStorage engineSystems;
+    REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+    REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+    auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+    auto lowerDepot = std::make_unique<CountingFileDepot>();
+    auto upperDepot = std::make_unique<CountingFileDepot>();
+    auto* lower = lowerDepot.get();
+    auto* upper = upperDepot.get();
+
+    lower->GetMemoryDepot().AddFile("Lower.txt", CreateBuffer(LowerFileText));
+    lower->GetMemoryDepot().AddFile("Shared.txt", CreateBuffer(LowerFileText));
+    upper->GetMemoryDepot().AddFile("Upper.txt", CreateBuffer(UpperFileText));
+
+    REQUIRE(fileSystem->MountDepot("Test/", std::move(lowerDepot)));
+    REQUIRE(fileSystem->MountDepot("Test/", std::move(upperDepot)));
+
+    SUBCASE("Resolved paths open file from single depot")
+    {
+        CHECK_EQ(fileSystem->OpenFile("Test/Lower.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+        CHECK_EQ(upper->openCount, 1);
+        CHECK_EQ(lower->openCount, 1);
+
+        CHECK_EQ(fileSystem->OpenFile("Test/./Lower.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+        CHECK_EQ(upper->openCount, 1);
+        CHECK_EQ(lower->openCount, 2);
+    }
+
+    SUBCASE("Resolved paths are invalidated")
+    {
+        CHECK_EQ(fileSystem->OpenFile("Test/Shared.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+
+        // Changes in depots that shadow resolved file need explicit invalidation.
+        upper->GetMemoryDepot().AddFile("Shared.txt", CreateBuffer(UpperFileText));
+        CHECK_EQ(fileSystem->OpenFile("Test/Shared.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+
+        fileSystem->InvalidateResolvedPath("Test/Shared.txt");
+        CHECK_EQ(fileSystem->OpenFile("Test/Shared.txt").Unwrap()->ReadAsTextString(), UpperFileText);
+
+        // Files missing from resolved depot are searched for again.
+        CHECK(upper->GetMemoryDepot().RemoveFile("Shared.txt"));
+        CHECK_EQ(fileSystem->OpenFile("Test/Shared.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+
+        CHECK(lower->GetMemoryDepot().RemoveFile("Shared.txt"));
+        CHECK_EQ(fileSystem->OpenFile("Test/Shared.txt").UnwrapFailure(),
+            System::FileDepot::OpenFileErrors::FileNotFound);
+    }
+
+    SUBCASE("Mounting depot invalidates resolved paths")
+    {
+        CHECK_EQ(fileSystem->OpenFile("Test/Lower.txt").Unwrap()->ReadAsTextString(), LowerFileText);
+
+        auto overrideDepot = System::MemoryFileDepot::Create().Unwrap();
+        overrideDepot->AddFile("Lower.txt", CreateBuffer(UpperFileText));
+        REQUIRE(fileSystem->MountDepot("Test/", std::move(overrideDepot)));
+
+        CHECK_EQ(fileSystem->OpenFile("Test/Lower.txt").Unwrap()->ReadAsTextString(), UpperFileText);
+    }
+}
+
+TEST_CASE("File System Async Reads")
+{
+    using ReadErrors = System::FileSystem::ReadErrors;
+
+    // Write native file with contents that identify their offsets.
+    std::vector<uint8_t> testData(256 * 1024);
+    for(std::size_t i = 0; i < testData.size(); ++i)
+    {
+        testData[i] = static_cast<uint8_t>(i * 7 + i / 256);
+    }
+
+    {
+        std::ofstream testFile(TestFilePath, std::ios::binary | std::ios::trunc);
+        testFile.write(reinterpret_cast<const char*>(testData.data()), testData.size());
+    }
+
+    Core::EngineSystemStorage engineSystems;
+    REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+    REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+    auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+    auto memoryDepot = System::MemoryFileDepot::Create().Unwrap();
+    memoryDepot->AddFile("Memory.txt", CreateBuffer(LowerFileText));
+    REQUIRE(fileSystem->MountDepot("Test/", std::move(memoryDepot)));
+
+    SUBCASE("Read whole files and ranges")
+    {
+        auto wholeFuture = fileSystem->ReadAsync(TestFilePath);
+        auto rangeFuture = fileSystem->ReadAsync(TestFilePath, { 1000, 5000 });
+        auto tailFuture = fileSystem->ReadAsync(TestFilePath, { testData.size() - 10, 100 });
+        auto memoryFuture = fileSystem->ReadAsync("Test/Memory.txt", { 6, 5 });
+
+        CHECK(wholeFuture.get().Unwrap() == testData);
+        CHECK(rangeFuture.get().Unwrap() == std::vector<uint8_t>(
+            testData.begin() + 1000, testData.begin() + 6000));
+        CHECK(tailFuture.get().Unwrap() == std::vector<uint8_t>(
+            testData.end() - 10, testData.end()));
+
+        std::vector<uint8_t> memoryData = memoryFuture.get().Unwrap();
+        CHECK_EQ(std::string(memoryData.begin(), memoryData.end()), "depot");
+    }
+
+    SUBCASE("Read many ranges into provided memory")
+    {
+        const std::size_t chunkSize = 1024;
+        const std::size_t chunkCount = testData.size() / chunkSize;
+
+        std::vector<uint8_t> destination(testData.size());
+        std::vector<std::future<System::FileSystem::ReadIntoResult>> futures;
+
+        for(std::size_t i = 0; i < chunkCount; ++i)
+        {
+            // Issue chunks in reverse order to not read file sequentially.
+            std::size_t offset = (chunkCount - i - 1) * chunkSize;
+            futures.push_back(fileSystem->ReadAsync(TestFilePath,
+                { offset, chunkSize }, destination.data() + offset));
+        }
+
+        for(auto& future : futures)
+        {
+            CHECK_EQ(future.get().Unwrap(), chunkSize);
+        }
+
+        CHECK(destination == testData);
+    }
+
+    SUBCASE("Invalid reads fail")
+    {
+        uint8_t destination[16] = {};
+
+        CHECK_EQ(fileSystem->ReadAsync("TestFileSystemMissing.bin").get().UnwrapFailure(),
+            ReadErrors::FileNotFound);
+        CHECK_EQ(fileSystem->ReadAsync(TestFilePath, { testData.size() + 1, 1 }).get().UnwrapFailure(),
+            ReadErrors::InvalidRangeArgument);
+        CHECK_EQ(fileSystem->ReadAsync(TestFilePath, {}, destination).get().UnwrapFailure(),
+            ReadErrors::InvalidRangeArgument);
+        CHECK_EQ(fileSystem->ReadAsync(TestFilePath, { 0, 16 }, nullptr).get().UnwrapFailure(),
+            ReadErrors::InvalidDestinationArgument);
+    }
+
+    std::remove(TestFilePath);
+}
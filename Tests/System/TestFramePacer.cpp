@@ -0,0 +1,66 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <thread>
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <System/FramePacer.hpp>
+
+TEST_CASE("Frame Pacer")
+{
+    using Clock = System::FramePacer::Clock;
+
+    System::FramePacer framePacer;
+
+    SUBCASE("Disabled pacing")
+    {
+        CHECK_EQ(framePacer.GetTargetFrameRate(), 0.0f);
+
+        const Clock::time_point start = Clock::now();
+        for(int i = 0; i < 100; ++i)
+        {
+            framePacer.WaitForNextFrame();
+        }
+
+        CHECK_LT(std::chrono::duration<float>(Clock::now() - start).count(), 0.01f);
+    }
+
+    SUBCASE("Target frame rate")
+    {
+        framePacer.SetTargetFrameRate(200.0f);
+        framePacer.Reset();
+
+        const Clock::time_point start = Clock::now();
+        for(int i = 0; i < 20; ++i)
+        {
+            framePacer.WaitForNextFrame();
+            CHECK_GE(framePacer.GetLastWakeErrorSeconds(), 0.0f);
+        }
+
+        // Frames are scheduled relative to each other, so they do not drift.
+        // Thread can still be preempted past single frame on busy machine.
+        const float elapsedSeconds = std::chrono::duration<float>(Clock::now() - start).count();
+        CHECK_GE(elapsedSeconds, 0.1f);
+        CHECK_LT(elapsedSeconds, 0.2f);
+        CHECK_LE(framePacer.GetMissedFrameCount(), 2);
+    }
+
+    SUBCASE("Missed frames are not caught up")
+    {
+        framePacer.SetTargetFrameRate(200.0f);
+        framePacer.Reset();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        framePacer.WaitForNextFrame();
+        CHECK_EQ(framePacer.GetMissedFrameCount(), 1);
+        CHECK_EQ(framePacer.GetLastWaitSeconds(), 0.0f);
+
+        // Next frame waits full frame time again.
+        const Clock::time_point start = Clock::now();
+        framePacer.WaitForNextFrame();
+        CHECK_GE(std::chrono::duration<float>(Clock::now() - start).count(), 0.004f);
+        CHECK_EQ(framePacer.GetMissedFrameCount(), 1);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/Image.hpp>
+
+namespace
+{
+    System::Image::CreateFromParams CreateGradient(int width, int height, int channels)
+    {
+        System::Image::CreateFromParams params;
+        params.width = width;
+        params.height = height;
+        params.channels = channels;
+        params.data.resize(std::size_t(width) * height * channels);
+
+        // Mix of smooth gradients, repeated colors and noise exercises all encoder operations.
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                uint8_t* pixel = params.data.data() + (std::size_t(y) * width + x) * channels;
+                for(int c = 0; c < channels; ++c)
+                {
+                    if(x < width / 4)
+                        pixel[c] = static_cast<uint8_t>(x + y * c);
+                    else if(x < width / 2)
+                        pixel[c] = static_cast<uint8_t>(c * 64);
+                    else
+                        pixel[c] = static_cast<uint8_t>((x * 31 + y * 17) ^ (c * 97));
+                }
+            }
+        }
+
+        return params;
+    }
+}
+
+TEST_CASE("Image")
+{
+    using CreateErrors = System::Image::CreateErrors;
+
+    SUBCASE("Encode and decode QOI images")
+    {
+        for(int channels : { 3, 4 })
+        {
+            auto params = CreateGradient(67, 31, channels);
+            auto image = System::Image::Create(params).Unwrap();
+
+            auto encoded = image->EncodeQOI().Unwrap();
+            CHECK_LT(encoded.size(), params.data.size());
+
+            System::Image::LoadFromMemory loadParams;
+            loadParams.data = encoded.data();
+            loadParams.size = encoded.size();
+            loadParams.format = System::Image::Format::QOI;
+
+            auto decoded = System::Image::Create(loadParams).Unwrap();
+            CHECK_EQ(decoded->GetWidth(), 67);
+            CHECK_EQ(decoded->GetHeight(), 31);
+            CHECK_EQ(decoded->GetChannels(), channels);
+            CHECK(std::equal(params.data.begin(), params.data.end(), decoded->GetData()));
+
+            // Truncated and corrupted data is rejected.
+            loadParams.size = encoded.size() - 12;
+            CHECK_EQ(System::Image::Create(loadParams).UnwrapFailure(), CreateErrors::FailedQoiLoad);
+
+            encoded[0] = 'x';
+            loadParams.size = encoded.size();
+            CHECK_EQ(System::Image::Create(loadParams).UnwrapFailure(), CreateErrors::FailedQoiLoad);
+        }
+
+        auto grayImage = System::Image::Create(CreateGradient(4, 4, 1)).Unwrap();
+        CHECK(grayImage->EncodeQOI().IsFailure());
+    }
+
+    SUBCASE("Decode PNG image and convert it to QOI")
+    {
+        Core::EngineSystemStorage engineSystems;
+        REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+        REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+        auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+        auto file = fileSystem->OpenFile("Data/Engine/Default/Texture.png").Unwrap();
+        CHECK_EQ(System::Image::GetFormatFromExtension(file->GetPath()), System::Image::Format::PNG);
+
+        auto image = System::Image::Create(*file, System::Image::LoadFromFile()).Unwrap();
+        CHECK_GT(image->GetWidth(), 0);
+        CHECK_GT(image->GetHeight(), 0);
+
+        auto encoded = image->EncodeQOI().Unwrap();
+
+        System::Image::LoadFromMemory loadParams;
+        loadParams.data = encoded.data();
+        loadParams.size = encoded.size();
+        loadParams.format = System::Image::Format::QOI;
+
+        auto decoded = System::Image::Create(loadParams).Unwrap();
+        std::size_t dataSize = std::size_t(image->GetWidth()) * image->GetHeight() * image->GetChannels();
+        CHECK(std::equal(image->GetData(), image->GetData() + dataSize, decoded->GetData()));
+
+        loadParams.format = System::Image::Format::PNG;
+        CHECK_EQ(System::Image::Create(loadParams).UnwrapFailure(), CreateErrors::FailedPngLoad);
+    }
+}
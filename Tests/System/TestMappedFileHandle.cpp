@@ -0,0 +1,77 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <fstream>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/MappedFileHandle.hpp>
+
+namespace
+{
+    const char* TestFilePath = "TestMappedFileHandle.txt";
+    const char* TestEmptyFilePath = "TestMappedFileHandleEmpty.txt";
+    const char* TestFileText = "Mapped file contents.";
+}
+
+TEST_CASE("Mapped File Handle")
+{
+    std::ofstream(TestFilePath, std::ios::binary | std::ios::trunc) << TestFileText;
+    std::ofstream(TestEmptyFilePath, std::ios::binary | std::ios::trunc);
+
+    Core::EngineSystemStorage engineSystems;
+    REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+    REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+    auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+    SUBCASE("Read only files are mapped")
+    {
+        auto file = fileSystem->OpenFile(TestFilePath).Unwrap();
+        CHECK_EQ(file->GetSize(), std::strlen(TestFileText));
+
+        auto mapResult = file->Map();
+        CHECK_EQ(mapResult.IsSuccess(), System::MappedFileHandle::IsSupported());
+
+        if(mapResult)
+        {
+            CHECK_EQ(mapResult.Unwrap().AsString(), TestFileText);
+        }
+
+        std::vector<uint8_t> buffer;
+        CHECK_EQ(file->MapOrRead(buffer).AsString(), TestFileText);
+        CHECK_EQ(buffer.empty(), System::MappedFileHandle::IsSupported());
+
+        char partial[7] = {};
+        CHECK_EQ(file->Seek(7), 7);
+        CHECK_EQ(file->Read(reinterpret_cast<uint8_t*>(partial), 4), 4);
+        CHECK_EQ(std::string(partial), "file");
+        CHECK_EQ(file->Seek(file->GetSize() - 3), file->GetSize() - 3);
+        CHECK_EQ(file->Read(reinterpret_cast<uint8_t*>(partial), 6), 3);
+        CHECK(file->IsGood());
+
+        auto emptyFile = fileSystem->OpenFile(TestEmptyFilePath).Unwrap();
+        CHECK_EQ(emptyFile->GetSize(), 0);
+        CHECK(emptyFile->ReadAsTextString().empty());
+    }
+
+    SUBCASE("Writable files are not mapped")
+    {
+        auto file = fileSystem->OpenFile(TestFilePath, System::FileHandle::OpenFlags::ReadWrite).Unwrap();
+        CHECK_EQ(file->GetSize(), std::strlen(TestFileText));
+        CHECK(file->Map().IsFailure());
+        CHECK_EQ(file->ReadAsTextString(), TestFileText);
+    }
+
+    SUBCASE("Missing files are not found")
+    {
+        CHECK_EQ(fileSystem->OpenFile("TestMappedFileHandleMissing.txt").UnwrapFailure(),
+            System::FileDepot::OpenFileErrors::FileNotFound);
+    }
+
+    std::remove(TestFilePath);
+    std::remove(TestEmptyFilePath);
+}
@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <Core/Config.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/MemoryFileDepot.hpp>
+
+namespace
+{
+    const char BorrowedFileText[] = "Borrowed file contents.";
+    const char* OwnedFileText = "Owned file contents.";
+}
+
+TEST_CASE("Memory File Depot")
+{
+    using OpenFlags = System::FileHandle::OpenFlags;
+    using OpenFileErrors = System::FileDepot::OpenFileErrors;
+
+    Core::EngineSystemStorage engineSystems;
+    REQUIRE(engineSystems.Attach(std::make_unique<Core::Config>()));
+    REQUIRE(engineSystems.Attach(std::make_unique<System::FileSystem>()));
+    auto* fileSystem = engineSystems.Locate<System::FileSystem>();
+
+    auto ownedBuffer = std::make_shared<System::MemoryFileHandle::Buffer>(
+        OwnedFileText, OwnedFileText + std::strlen(OwnedFileText));
+
+    auto memoryDepot = System::MemoryFileDepot::Create().Unwrap();
+    auto* memoryDepotPtr = memoryDepot.get();
+
+    CHECK(memoryDepot->AddFile("Memory/Owned.txt", ownedBuffer));
+    CHECK(memoryDepot->AddFile("Memory/./Nested/../Borrowed.txt",
+        reinterpret_cast<const uint8_t*>(BorrowedFileText), sizeof(BorrowedFileText) - 1));
+    CHECK_EQ(memoryDepot->GetFileCount(), 2);
+
+    CHECK_EQ(memoryDepot->AddFile("", ownedBuffer).UnwrapFailure(),
+        System::MemoryFileDepot::AddFileErrors::EmptyFilePathArgument);
+    CHECK_EQ(memoryDepot->AddFile("../Outside.txt", ownedBuffer).UnwrapFailure(),
+        System::MemoryFileDepot::AddFileErrors::InvalidFilePathArgument);
+    CHECK_EQ(memoryDepot->AddFile("Memory/Null.txt", nullptr).UnwrapFailure(),
+        System::MemoryFileDepot::AddFileErrors::InvalidBufferArgument);
+
+    REQUIRE(fileSystem->MountDepot("Test/", std::move(memoryDepot)));
+
+    SUBCASE("Read owned and borrowed files")
+    {
+        auto ownedFile = fileSystem->OpenFile("Test/Memory/Owned.txt").Unwrap();
+        CHECK_EQ(ownedFile->ReadAsTextString(), OwnedFileText);
+
+        auto borrowedFile = fileSystem->OpenFile("Test/Memory/Borrowed.txt").Unwrap();
+        CHECK_EQ(borrowedFile->GetSize(), sizeof(BorrowedFileText) - 1);
+
+        auto mapResult = borrowedFile->Map();
+        REQUIRE(mapResult);
+        CHECK_EQ(mapResult.Unwrap().data, reinterpret_cast<const uint8_t*>(BorrowedFileText));
+        CHECK_EQ(borrowedFile->ReadAsTextString(), BorrowedFileText);
+
+        char partial[9] = {};
+        CHECK_EQ(borrowedFile->Seek(9), 9);
+        CHECK_EQ(borrowedFile->Read(reinterpret_cast<uint8_t*>(partial), 8), 8);
+        CHECK_EQ(std::string(partial), "file con");
+        CHECK(borrowedFile->IsGood());
+    }
+
+    SUBCASE("Write owned and new files")
+    {
+        auto ownedFile = fileSystem->OpenFile("Test/Memory/Owned.txt",
+            OpenFlags::Write | OpenFlags::Truncate).Unwrap();
+        CHECK_EQ(ownedFile->Write(reinterpret_cast<const uint8_t*>("Changed"), 7), 7);
+        CHECK_EQ(std::string(ownedBuffer->begin(), ownedBuffer->end()), "Changed");
+
+        CHECK_EQ(fileSystem->OpenFile("Test/Memory/New.txt").UnwrapFailure(),
+            OpenFileErrors::FileNotFound);
+
+        auto newFile = fileSystem->OpenFile("Test/Memory/New.txt", OpenFlags::Write).Unwrap();
+        CHECK_EQ(newFile->Write(reinterpret_cast<const uint8_t*>("New"), 3), 3);
+        CHECK_EQ(memoryDepotPtr->GetFileCount(), 3);
+        CHECK_EQ(fileSystem->OpenFile("Test/Memory/New.txt").Unwrap()->ReadAsTextString(), "New");
+    }
+
+    SUBCASE("Borrowed files are read only")
+    {
+        CHECK_EQ(fileSystem->OpenFile("Test/Memory/Borrowed.txt", OpenFlags::ReadWrite).UnwrapFailure(),
+            OpenFileErrors::AccessDenied);
+    }
+
+    SUBCASE("Removed files are not found")
+    {
+        CHECK(memoryDepotPtr->RemoveFile("Memory/Owned.txt"));
+        CHECK_FALSE(memoryDepotPtr->RemoveFile("Memory/Owned.txt"));
+        CHECK_EQ(fileSystem->OpenFile("Test/Memory/Owned.txt").UnwrapFailure(),
+            OpenFileErrors::FileNotFound);
+    }
+}
@@ -0,0 +1,585 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <doctest/doctest.h>
+#include <fstream>
+#include <thread>
+#include <Core/Core.hpp>
+#include <Core/Config.hpp>
+#include <Core/SystemStorage.hpp>
+#include <System/FileSystem/FileSystem.hpp>
+#include <System/FileSystem/FileWatcher.hpp>
+#include <System/ResourceManager.hpp>
+
+namespace
+{
+    const char* TestFilePath = "TestResourceManager.txt";
+    const char* TestFileText = "Jelly";
+    const char* TestDependentFilePath = "TestResourceManagerDependent.txt";
+
+    class TextResource
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<TextResource>, void>;
+
+        static CreateResult Create(System::FileHandle& file)
+        {
+            auto instance = std::make_unique<TextResource>();
+            instance->text = file.ReadAsTextString();
+            instance->createThread = std::this_thread::get_id();
+            return Common::Success(std::move(instance));
+        }
+
+        std::string text;
+        std::thread::id createThread;
+    };
+
+    class PreparedTextResource
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<PreparedTextResource>, void>;
+        using PrepareResult = Common::Result<std::pair<std::string, std::thread::id>, void>;
+
+        static PrepareResult Prepare(System::FileHandle& file)
+        {
+            return Common::Success(std::make_pair(
+                file.ReadAsTextString(), std::this_thread::get_id()));
+        }
+
+        static CreateResult Create(System::FileHandle& file)
+        {
+            return Create(Prepare(file).Unwrap());
+        }
+
+        static CreateResult Create(std::pair<std::string, std::thread::id>&& prepared)
+        {
+            auto instance = std::make_unique<PreparedTextResource>();
+            instance->text = std::move(prepared.first);
+            instance->prepareThread = prepared.second;
+            instance->createThread = std::this_thread::get_id();
+            return Common::Success(std::move(instance));
+        }
+
+        std::string text;
+        std::thread::id prepareThread;
+        std::thread::id createThread;
+    };
+
+    class DependentTextResource
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<DependentTextResource>, void>;
+        using PrepareResult = Common::Result<std::string, void>;
+
+        static PrepareResult Prepare(System::FileHandle& file, System::ResourceManager*)
+        {
+            return Common::Success(file.ReadAsTextString());
+        }
+
+        static void AcquireDependencies(System::ResourceDependencies& dependencies,
+            const std::string& prepared, System::ResourceManager*)
+        {
+            dependencies.Acquire<PreparedTextResource>(prepared);
+        }
+
+        static CreateResult Create(std::string&& prepared, System::ResourceManager* resourceManager)
+        {
+            auto instance = std::make_unique<DependentTextResource>();
+            instance->dependency = resourceManager->Acquire<PreparedTextResource>(prepared).UnwrapOr(nullptr);
+            return Common::Success(std::move(instance));
+        }
+
+        std::shared_ptr<PreparedTextResource> dependency;
+    };
+
+    class SwappableTextResource
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<SwappableTextResource>, void>;
+
+        static CreateResult Create(System::FileHandle& file)
+        {
+            auto instance = std::make_unique<SwappableTextResource>();
+            instance->text = file.ReadAsTextString();
+            return Common::Success(std::move(instance));
+        }
+
+        void Swap(SwappableTextResource& other)
+        {
+            std::swap(text, other.text);
+        }
+
+        std::string text;
+    };
+
+    class SizedTextResource
+    {
+    public:
+        using CreateResult = Common::Result<std::unique_ptr<SizedTextResource>, void>;
+
+        static CreateResult Create(System::FileHandle& file)
+        {
+            auto instance = std::make_unique<SizedTextResource>();
+            instance->text = file.ReadAsTextString();
+            return Common::Success(std::move(instance));
+        }
+
+        System::ResourceMemoryUsage GetMemoryUsage() const
+        {
+            return System::ResourceMemoryUsage{ 0, text.size() };
+        }
+
+        std::string text;
+    };
+
+    std::unique_ptr<Core::EngineSystemStorage> CreateEngineSystems(int loadingThreads, bool hotReload = false)
+    {
+        auto engineSystems = std::make_unique<Core::EngineSystemStorage>();
+
+        auto config = std::make_unique<Core::Config>();
+        config->Set<int>(NAME_CONSTEXPR("resources.loadingThreads"), loadingThreads);
+        config->Set<bool>(NAME_CONSTEXPR("resources.hotReload"), hotReload);
+
+        if(!engineSystems->Attach(std::move(config)) ||
+            !engineSystems->Attach(std::make_unique<System::FileSystem>()) ||
+            !engineSystems->Attach(std::make_unique<System::ResourceManager>()))
+            return nullptr;
+
+        return engineSystems;
+    }
+}
+
+TEST_CASE("Resource Manager")
+{
+    {
+        std::ofstream file(TestFilePath, std::ios::binary | std::ios::trunc);
+        file << TestFileText;
+    }
+
+    const std::thread::id mainThread = std::this_thread::get_id();
+
+    SUBCASE("Acquire asynchronously")
+    {
+        auto engineSystems = CreateEngineSystems(2);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        // Resource is created only once waited for or finalized on main thread.
+        auto future = resourceManager->AcquireAsync<TextResource>(TestFilePath);
+        CHECK(future.IsValid());
+        CHECK_FALSE(future.IsReady());
+
+        auto resource = future.Wait();
+        REQUIRE(resource);
+        CHECK(future.IsReady());
+        CHECK(future.IsSuccess());
+        CHECK_EQ(resource->text, TestFileText);
+        CHECK_EQ(resource->createThread, mainThread);
+
+        // Already loaded resource is returned right away.
+        auto loadedFuture = resourceManager->AcquireAsync<TextResource>(TestFilePath);
+        CHECK(loadedFuture.IsReady());
+        CHECK_EQ(loadedFuture.Get(), resource);
+        CHECK_EQ(resourceManager->Acquire<TextResource>(TestFilePath).Unwrap(), resource);
+
+        // Prepare step is performed on loading thread.
+        auto preparedFuture = resourceManager->AcquireAsync<PreparedTextResource>(TestFilePath);
+        while(!preparedFuture.IsReady())
+        {
+            resourceManager->FinalizeAsyncLoads();
+            std::this_thread::yield();
+        }
+
+        auto preparedResource = preparedFuture.Get();
+        REQUIRE(preparedResource);
+        CHECK_EQ(preparedResource->text, TestFileText);
+        CHECK_NE(preparedResource->prepareThread, mainThread);
+        CHECK_EQ(preparedResource->createThread, mainThread);
+
+        // Missing resource results in default one.
+        auto defaultResource = std::make_shared<TextResource>();
+        resourceManager->SetDefault<TextResource>(defaultResource);
+
+        auto missingFuture = resourceManager->AcquireAsync<TextResource>("Missing.txt");
+        CHECK_EQ(missingFuture.Wait(), defaultResource);
+        CHECK_FALSE(missingFuture.IsSuccess());
+    }
+
+    SUBCASE("Acquire asynchronously without loading threads")
+    {
+        auto engineSystems = CreateEngineSystems(0);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        std::vector<System::ResourceFuture<PreparedTextResource>> futures;
+        futures.push_back(resourceManager->AcquireAsync<PreparedTextResource>(TestFilePath));
+        futures.push_back(resourceManager->AcquireRelativeAsync<PreparedTextResource>(
+            TestFilePath, "Directory/../Other.txt"));
+
+        CHECK_FALSE(futures[0].IsReady());
+        CHECK_FALSE(futures[1].IsReady());
+
+        while(!futures[0].IsReady() || !futures[1].IsReady())
+        {
+            resourceManager->FinalizeAsyncLoads();
+        }
+
+        CHECK_EQ(futures[0].Get(), futures[1].Get());
+        CHECK_EQ(futures[0].Get()->prepareThread, mainThread);
+    }
+
+    SUBCASE("Acquire asynchronously with dependencies")
+    {
+        auto engineSystems = CreateEngineSystems(2);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        {
+            std::ofstream file(TestDependentFilePath, std::ios::binary | std::ios::trunc);
+            file << TestFilePath;
+        }
+
+        // Dependency is loaded on loading thread before dependent resource is created.
+        auto future = resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager);
+
+        while(!future.IsReady())
+        {
+            resourceManager->FinalizeAsyncLoads();
+            std::this_thread::yield();
+        }
+
+        auto resource = future.Get();
+        REQUIRE(resource);
+        REQUIRE(resource->dependency);
+        CHECK_EQ(resource->dependency->text, TestFileText);
+        CHECK_NE(resource->dependency->prepareThread, mainThread);
+
+        // Waiting also waits for dependencies.
+        resource = nullptr;
+        future = System::ResourceFuture<DependentTextResource>();
+        resourceManager->ReleaseAll();
+
+        resource = resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager).Wait();
+
+        REQUIRE(resource);
+        REQUIRE(resource->dependency);
+        CHECK_EQ(resource->dependency->text, TestFileText);
+
+        std::remove(TestDependentFilePath);
+    }
+
+    SUBCASE("Share loads in progress")
+    {
+        auto engineSystems = CreateEngineSystems(1);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        auto firstFuture = resourceManager->AcquireAsync<PreparedTextResource>(TestFilePath);
+        auto secondFuture = resourceManager->AcquireRelativeAsync<PreparedTextResource>(
+            TestFilePath, "Directory/../Other.txt");
+
+        REQUIRE(firstFuture.GetLoadState());
+        CHECK_EQ(firstFuture.GetLoadState(), secondFuture.GetLoadState());
+
+        // Synchronous acquisition finishes shared load right away.
+        auto resource = resourceManager->Acquire<PreparedTextResource>(TestFilePath).Unwrap();
+        CHECK(firstFuture.IsReady());
+        CHECK(secondFuture.IsReady());
+        CHECK_EQ(firstFuture.Get(), resource);
+        CHECK_EQ(secondFuture.Get(), resource);
+    }
+
+    SUBCASE("Release least recently used resources over memory budget")
+    {
+        auto engineSystems = CreateEngineSystems(0);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        const char* filePaths[] =
+        {
+            "TestResourceManagerA.txt",
+            "TestResourceManagerB.txt",
+            "TestResourceManagerC.txt",
+        };
+
+        for(const char* filePath : filePaths)
+        {
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            file << std::string(100, 'x');
+        }
+
+        resourceManager->SetMemoryBudget(System::ResourcePoolInterface::UnlimitedBudget);
+        resourceManager->SetMemoryBudget<SizedTextResource>(250);
+
+        auto resourceA = resourceManager->Acquire<SizedTextResource>(filePaths[0]).Unwrap();
+        auto resourceB = resourceManager->Acquire<SizedTextResource>(filePaths[1]).Unwrap();
+        auto resourceC = resourceManager->Acquire<SizedTextResource>(filePaths[2]).Unwrap();
+        CHECK_EQ(resourceManager->GetMemoryUsage<SizedTextResource>().gpuBytes, 300);
+        CHECK_EQ(resourceManager->GetMemoryUsage().gpuBytes, 300);
+
+        std::weak_ptr<SizedTextResource> weakA = resourceA;
+        std::weak_ptr<SizedTextResource> weakB = resourceB;
+        std::weak_ptr<SizedTextResource> weakC = resourceC;
+
+        // Referenced resources are never released.
+        resourceManager->ReleaseUnused();
+        CHECK_EQ(resourceManager->GetMemoryUsage<SizedTextResource>().gpuBytes, 300);
+
+        // Unused resource is released when budget is exceeded.
+        resourceB = nullptr;
+        resourceManager->ReleaseUnused();
+        CHECK(weakB.expired());
+        CHECK_EQ(resourceManager->GetMemoryUsage<SizedTextResource>().gpuBytes, 200);
+
+        // Unused resources are kept cached while within budget.
+        resourceA = nullptr;
+        resourceC = nullptr;
+        resourceManager->ReleaseUnused();
+        CHECK_FALSE(weakA.expired());
+        CHECK_FALSE(weakC.expired());
+
+        resourceA = resourceManager->Acquire<SizedTextResource>(filePaths[0]).Unwrap();
+        CHECK_EQ(resourceA, weakA.lock());
+        resourceA = nullptr;
+
+        // Least recently used resource is released when global budget is exceeded.
+        resourceManager->SetMemoryBudget(150);
+        resourceManager->ReleaseUnused();
+        CHECK_FALSE(weakA.expired());
+        CHECK(weakC.expired());
+        CHECK_EQ(resourceManager->GetMemoryUsage().gpuBytes, 100);
+
+        for(const char* filePath : filePaths)
+        {
+            std::remove(filePath);
+        }
+    }
+
+    SUBCASE("Acquire cached resources by name from multiple threads")
+    {
+        auto engineSystems = CreateEngineSystems(0);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        auto defaultResource = std::make_shared<TextResource>();
+        resourceManager->SetDefault<TextResource>(defaultResource);
+
+        // Resource that has not been loaded yet results in default one.
+        const Common::Name testFileName = NAME_CONSTEXPR("TestResourceManager.txt");
+        auto missingResult = resourceManager->AcquireCached<TextResource>(testFileName);
+        CHECK(missingResult.IsFailure());
+        CHECK_EQ(missingResult.UnwrapFailure(), defaultResource);
+
+        auto resource = resourceManager->Acquire<TextResource>(TestFilePath).Unwrap();
+        CHECK_EQ(resourceManager->AcquireCached<TextResource>(testFileName).Unwrap(), resource);
+
+        // Cached resources are found by readers while others are being loaded.
+        const int fileCount = 100;
+        std::vector<std::string> filePaths;
+        std::vector<Common::Name> fileNames;
+
+        for(int i = 0; i < fileCount; ++i)
+        {
+            filePaths.push_back(fmt::format("TestResourceManager{}.txt", i));
+            fileNames.emplace_back(std::string_view(filePaths.back()));
+
+            std::ofstream file(filePaths.back(), std::ios::binary | std::ios::trunc);
+            file << i;
+        }
+
+        std::atomic<bool> loadingDone = false;
+        std::atomic<int> mismatchCount = 0;
+        std::atomic<int> foundCount = 0;
+        std::vector<std::thread> readerThreads;
+
+        for(int thread = 0; thread < 4; ++thread)
+        {
+            readerThreads.emplace_back([&]()
+            {
+                bool finalPass = false;
+                while(!finalPass)
+                {
+                    finalPass = loadingDone.load();
+                    for(int i = 0; i < fileCount; ++i)
+                    {
+                        auto result = resourceManager->AcquireCached<TextResource>(fileNames[i]);
+                        if(result.IsSuccess())
+                        {
+                            if(result.Unwrap()->text != std::to_string(i))
+                            {
+                                ++mismatchCount;
+                            }
+
+                            if(finalPass)
+                            {
+                                ++foundCount;
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        for(int i = 0; i < fileCount; ++i)
+        {
+            CHECK(resourceManager->Acquire<TextResource>(filePaths[i]).IsSuccess());
+        }
+
+        loadingDone = true;
+        for(std::thread& readerThread : readerThreads)
+        {
+            readerThread.join();
+        }
+
+        CHECK_EQ(mismatchCount.load(), 0);
+        CHECK_EQ(foundCount.load(), fileCount * 4);
+
+        // Released resources are no longer found.
+        resource = nullptr;
+        resourceManager->ReleaseAll();
+        CHECK(resourceManager->AcquireCached<TextResource>(testFileName).IsFailure());
+        CHECK(resourceManager->AcquireCached<TextResource>(fileNames[0]).IsFailure());
+
+        for(const std::string& filePath : filePaths)
+        {
+            std::remove(filePath.c_str());
+        }
+    }
+
+#ifndef NAME_REGISTRY_ENABLED
+    // Name registry rejects colliding names, so this can only happen without it.
+    SUBCASE("Acquire resources with colliding path names")
+    {
+        auto engineSystems = CreateEngineSystems(0);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+
+        const char* firstFilePath = "TestResourceManagerEz.txt";
+        const char* secondFilePath = "TestResourceManagerFY.txt";
+        REQUIRE_EQ(Common::Name(firstFilePath), Common::Name(secondFilePath));
+
+        {
+            std::ofstream firstFile(firstFilePath, std::ios::binary | std::ios::trunc);
+            firstFile << "Jelly";
+
+            std::ofstream secondFile(secondFilePath, std::ios::binary | std::ios::trunc);
+            secondFile << "Bean";
+        }
+
+        // Resources are told apart by their paths.
+        auto first = resourceManager->Acquire<TextResource>(firstFilePath).Unwrap();
+        auto second = resourceManager->Acquire<TextResource>(secondFilePath).Unwrap();
+        CHECK_EQ(first->text, "Jelly");
+        CHECK_EQ(second->text, "Bean");
+        CHECK_EQ(resourceManager->Acquire<TextResource>(firstFilePath).Unwrap(), first);
+        CHECK_EQ(resourceManager->Acquire<TextResource>(secondFilePath).Unwrap(), second);
+
+        // Name alone is ambiguous and does not find either of them.
+        CHECK(resourceManager->AcquireCached<TextResource>(Common::Name(firstFilePath)).IsFailure());
+
+        std::remove(firstFilePath);
+        std::remove(secondFilePath);
+    }
+#endif
+
+    SUBCASE("Reload changed resources with their dependents")
+    {
+        if(!System::FileWatcher::IsSupported())
+            return;
+
+        auto engineSystems = CreateEngineSystems(0, true);
+        REQUIRE(engineSystems);
+
+        auto* resourceManager = engineSystems->Locate<System::ResourceManager>();
+        REQUIRE(resourceManager);
+        REQUIRE(resourceManager->IsHotReloadEnabled());
+
+        const char* unchangedFilePath = "TestResourceManagerUnchanged.txt";
+
+        {
+            std::ofstream dependentFile(TestDependentFilePath, std::ios::binary | std::ios::trunc);
+            dependentFile << TestFilePath;
+
+            std::ofstream unchangedFile(unchangedFilePath, std::ios::binary | std::ios::trunc);
+            unchangedFile << TestFileText;
+        }
+
+        auto dependent = resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager).Wait();
+        auto swappable = resourceManager->Acquire<SwappableTextResource>(TestFilePath).Unwrap();
+        auto unchanged = resourceManager->Acquire<TextResource>(unchangedFilePath).Unwrap();
+
+        REQUIRE(dependent);
+        REQUIRE(dependent->dependency);
+        CHECK_EQ(dependent->dependency->text, TestFileText);
+
+        {
+            std::ofstream file(TestFilePath, std::ios::binary | std::ios::trunc);
+            file << "Bean";
+        }
+
+        // Changed file is reloaded for each resource type, followed by its dependents.
+        auto reloaded = [&]()
+        {
+            auto reloadedDependent = resourceManager->AcquireAsync<DependentTextResource>(
+                TestDependentFilePath, resourceManager).Wait();
+            return reloadedDependent->dependency->text == "Bean" && swappable->text == "Bean";
+        };
+
+        const auto startTime = std::chrono::steady_clock::now();
+        while(!reloaded() && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(5))
+        {
+            resourceManager->ReloadChangedResources();
+            resourceManager->FinalizeAsyncLoads();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        REQUIRE(reloaded());
+
+        // Swappable resources are updated in place, others are replaced in pool.
+        CHECK_EQ(resourceManager->Acquire<SwappableTextResource>(TestFilePath).Unwrap(), swappable);
+        CHECK_EQ(dependent->dependency->text, TestFileText);
+        CHECK_NE(resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager).Wait(), dependent);
+
+        // Unaffected resources are not reloaded.
+        CHECK_EQ(resourceManager->Acquire<TextResource>(unchangedFilePath).Unwrap(), unchanged);
+
+        // Failed reload keeps previous resource.
+        auto reloadedDependent = resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager).Wait();
+
+        std::remove(TestDependentFilePath);
+        resourceManager->Reload(TestDependentFilePath);
+
+        for(int i = 0; i < 10; ++i)
+        {
+            resourceManager->FinalizeAsyncLoads();
+        }
+
+        CHECK_EQ(resourceManager->AcquireAsync<DependentTextResource>(
+            TestDependentFilePath, resourceManager).Wait(), reloadedDependent);
+
+        std::remove(unchangedFilePath);
+    }
+
+    std::remove(TestFilePath);
+}
@@ -0,0 +1,90 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+#include <Core/Core.hpp>
+#include <System/FileSystem/ArchiveFilePacker.hpp>
+
+/*
+    Archive Packer
+
+    Packs all files found in input directory into archive that can be mounted
+    with ArchiveFileDepot. Paths of packed files are relative to input directory.
+    Files are compressed with zlib if --compress is specified, except for those
+    that would not get any smaller (e.g. PNG images).
+
+    Usage: ArchivePacker [--compress] <input directory> <output archive>
+*/
+
+int main(const int argc, const char* argv[])
+{
+    int argumentIndex = 1;
+    auto compression = System::ArchiveFormat::Compression::None;
+
+    if(argumentIndex < argc && std::string_view(argv[argumentIndex]) == "--compress")
+    {
+        compression = System::ArchiveFormat::Compression::Zlib;
+        ++argumentIndex;
+    }
+
+    if(argc - argumentIndex != 2)
+    {
+        std::cerr << "ArchivePacker: Usage: ArchivePacker [--compress] <input directory> <output archive>\n";
+        return 1;
+    }
+
+    const fs::path inputDirectory = argv[argumentIndex];
+    const fs::path outputPath = argv[argumentIndex + 1];
+
+    if(!fs::is_directory(inputDirectory))
+    {
+        std::cerr << "ArchivePacker: Input \"" << inputDirectory.generic_string() << "\" is not a directory!\n";
+        return 1;
+    }
+
+    // Collect files in sorted order, so archives are reproducible.
+    std::vector<fs::path> filePaths;
+    for(const auto& directoryEntry : fs::recursive_directory_iterator(inputDirectory))
+    {
+        std::error_code error;
+        if(directoryEntry.is_regular_file() && !fs::equivalent(directoryEntry.path(), outputPath, error))
+        {
+            filePaths.push_back(directoryEntry.path());
+        }
+    }
+
+    std::sort(filePaths.begin(), filePaths.end());
+
+    System::ArchiveFilePacker packer;
+    for(const fs::path& filePath : filePaths)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        if(!file.is_open())
+        {
+            std::cerr << "ArchivePacker: Could not open \"" << filePath.generic_string() << "\" file!\n";
+            return 1;
+        }
+
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if(!packer.AddFile(filePath.lexically_relative(inputDirectory), std::move(data), compression))
+        {
+            std::cerr << "ArchivePacker: Could not add \"" << filePath.generic_string() << "\" file!\n";
+            return 1;
+        }
+    }
+
+    if(!packer.Write(outputPath))
+    {
+        std::cerr << "ArchivePacker: Could not write \"" << outputPath.generic_string() << "\" archive!\n";
+        return 1;
+    }
+
+    std::cout << "ArchivePacker: Packed " << packer.GetFileCount() << " files into \""
+        << outputPath.generic_string() << "\" archive.\n";
+    return 0;
+}
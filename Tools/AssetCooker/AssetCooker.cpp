@@ -0,0 +1,193 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <Core/Core.hpp>
+#include <Core/SystemStorage.hpp>
+#include <System/FileSystem/NativeFileHandle.hpp>
+#include <System/Image.hpp>
+#include <Graphics/Texture.hpp>
+#include <Graphics/TextureAtlas.hpp>
+#include <Graphics/Sprite/SpriteAnimationList.hpp>
+
+/*
+    Asset Cooker
+
+    Cooks resources found in input directory into binary files that are loaded
+    without running scripts or decoding images (see Graphics::CookedFormat).
+    Cooked files are written under same relative paths in output directory,
+    so resources keep referencing each other by their original paths.
+    Remaining files are copied without changes.
+
+    Supported resources: textures (.png), texture atlases (.atlas),
+    sprite animation lists (.animation). Textures are cooked with their full
+    mip chains, and are block compressed with BC1 (opaque) or BC3 (with alpha)
+    formats if --compress-textures is specified.
+
+    Usage: AssetCooker [--compress-textures] <input directory> <output directory>
+*/
+
+namespace
+{
+    template<typename Type>
+    bool CookResource(const fs::path& filePath, const fs::path& requestedPath,
+        const Core::EngineSystemStorage& engineSystems, std::vector<uint8_t>& cooked)
+    {
+        auto file = System::NativeFileHandle::Create(filePath, requestedPath,
+            System::FileHandle::OpenFlags::Read).UnwrapOr(nullptr);
+        if(file == nullptr)
+            return false;
+
+        typename Type::LoadFromFile params;
+        params.engineSystems = &engineSystems;
+
+        auto prepareResult = Type::Prepare(*file, params);
+        if(!prepareResult)
+            return false;
+
+        cooked = Type::Cook(prepareResult.Unwrap(), requestedPath);
+        return true;
+    }
+
+    bool CookTexture(const fs::path& filePath, const fs::path& requestedPath,
+        bool compress, std::vector<uint8_t>& cooked)
+    {
+        auto file = System::NativeFileHandle::Create(filePath, requestedPath,
+            System::FileHandle::OpenFlags::Read).UnwrapOr(nullptr);
+        if(file == nullptr)
+            return false;
+
+        auto image = System::Image::Create(*file, System::Image::LoadFromFile()).UnwrapOr(nullptr);
+        if(image == nullptr)
+            return false;
+
+        // Images with fully opaque alpha do not need separate alpha blocks.
+        Graphics::Texture::CookParams params;
+        if(compress && image->GetChannels() >= 3)
+        {
+            bool isOpaque = true;
+            if(image->GetChannels() == 4)
+            {
+                std::size_t pixelCount = std::size_t(image->GetWidth()) * image->GetHeight();
+                for(std::size_t i = 0; i < pixelCount && isOpaque; ++i)
+                {
+                    isOpaque = image->GetData()[i * 4 + 3] == 255;
+                }
+            }
+
+            params.format = isOpaque ? Graphics::CookedFormat::TextureFormat::BC1 :
+                Graphics::CookedFormat::TextureFormat::BC3;
+        }
+
+        auto cookResult = Graphics::Texture::Cook(*image, params);
+        if(!cookResult)
+            return false;
+
+        cooked = cookResult.Unwrap();
+        return true;
+    }
+}
+
+int main(const int argc, const char* argv[])
+{
+    int argumentIndex = 1;
+    bool compressTextures = false;
+
+    if(argumentIndex < argc && std::string_view(argv[argumentIndex]) == "--compress-textures")
+    {
+        compressTextures = true;
+        ++argumentIndex;
+    }
+
+    if(argc - argumentIndex != 2)
+    {
+        std::cerr << "AssetCooker: Usage: AssetCooker [--compress-textures] <input directory> <output directory>\n";
+        return 1;
+    }
+
+    const fs::path inputDirectory = argv[argumentIndex];
+    const fs::path outputDirectory = argv[argumentIndex + 1];
+
+    if(!fs::is_directory(inputDirectory))
+    {
+        std::cerr << "AssetCooker: Input \"" << inputDirectory.generic_string() << "\" is not a directory!\n";
+        return 1;
+    }
+
+    // Collect files in sorted order, so output is reproducible.
+    std::vector<fs::path> filePaths;
+    for(const auto& directoryEntry : fs::recursive_directory_iterator(inputDirectory))
+    {
+        if(directoryEntry.is_regular_file())
+        {
+            filePaths.push_back(directoryEntry.path());
+        }
+    }
+
+    std::sort(filePaths.begin(), filePaths.end());
+
+    // Resource scripts only need engine systems for validation.
+    Core::EngineSystemStorage engineSystems;
+
+    std::size_t cookedCount = 0;
+    std::size_t copiedCount = 0;
+
+    for(const fs::path& filePath : filePaths)
+    {
+        const fs::path relativePath = filePath.lexically_relative(inputDirectory);
+        const fs::path outputPath = outputDirectory / relativePath;
+
+        std::error_code error;
+        fs::create_directories(outputPath.parent_path(), error);
+
+        std::vector<uint8_t> cooked;
+        bool isCooked = false;
+
+        if(filePath.extension() == ".png")
+        {
+            isCooked = CookTexture(filePath, relativePath, compressTextures, cooked);
+        }
+        else if(filePath.extension() == ".atlas")
+        {
+            isCooked = CookResource<Graphics::TextureAtlas>(filePath, relativePath, engineSystems, cooked);
+        }
+        else if(filePath.extension() == ".animation")
+        {
+            isCooked = CookResource<Graphics::SpriteAnimationList>(filePath, relativePath, engineSystems, cooked);
+        }
+        else
+        {
+            if(!fs::copy_file(filePath, outputPath, fs::copy_options::overwrite_existing, error))
+            {
+                std::cerr << "AssetCooker: Could not copy \"" << filePath.generic_string() << "\" file!\n";
+                return 1;
+            }
+
+            ++copiedCount;
+            continue;
+        }
+
+        if(!isCooked)
+        {
+            std::cerr << "AssetCooker: Could not cook \"" << filePath.generic_string() << "\" file!\n";
+            return 1;
+        }
+
+        std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(cooked.data()), cooked.size());
+        if(!file.good())
+        {
+            std::cerr << "AssetCooker: Could not write \"" << outputPath.generic_string() << "\" file!\n";
+            return 1;
+        }
+
+        ++cookedCount;
+    }
+
+    std::cout << "AssetCooker: Cooked " << cookedCount << " and copied " << copiedCount
+        << " files into \"" << outputDirectory.generic_string() << "\" directory.\n";
+    return 0;
+}
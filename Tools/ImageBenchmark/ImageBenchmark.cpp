@@ -0,0 +1,204 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <Core/Core.hpp>
+#include <System/Image.hpp>
+
+/*
+    Image Benchmark
+
+    Measures decoding speed of all PNG images found in corpus directory (e.g.
+    directory with texture atlases), compared to same images encoded as QOI.
+    Images are decoded from memory, so file reads are not measured. Decoding
+    is measured on single thread and then on multiple threads in parallel.
+
+    Usage: ImageBenchmark <corpus directory> [iterations] [threads]
+*/
+
+namespace
+{
+    struct CorpusImage
+    {
+        fs::path path;
+        std::vector<uint8_t> png;
+        std::vector<uint8_t> qoi;
+        std::size_t decodedSize = 0;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    double MeasureSeconds(Function&& function)
+    {
+        auto start = Clock::now();
+        function();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    bool DecodeImage(const std::vector<uint8_t>& data, System::Image::Format format)
+    {
+        System::Image::LoadFromMemory params;
+        params.data = data.data();
+        params.size = data.size();
+        params.format = format;
+        return System::Image::Create(params).IsSuccess();
+    }
+
+    void PrintResult(const char* name, double seconds, std::size_t images,
+        std::size_t encodedBytes, std::size_t decodedBytes)
+    {
+        std::cout << "ImageBenchmark: " << name << ": "
+            << seconds * 1000.0 << " ms, "
+            << seconds * 1000000.0 / images << " us per image, "
+            << decodedBytes / seconds / (1024.0 * 1024.0) << " MB/s decoded, "
+            << encodedBytes / 1024 << " KB encoded\n";
+    }
+}
+
+int main(const int argc, const char* argv[])
+{
+    if(argc < 2 || argc > 4)
+    {
+        std::cerr << "ImageBenchmark: Usage: ImageBenchmark <corpus directory> [iterations] [threads]\n";
+        return 1;
+    }
+
+    const fs::path corpusDirectory = argv[1];
+    const int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+    const int threadCount = argc > 3 ? std::max(1, std::atoi(argv[3])) :
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    if(!fs::is_directory(corpusDirectory))
+    {
+        std::cerr << "ImageBenchmark: Corpus \"" << corpusDirectory.generic_string() << "\" is not a directory!\n";
+        return 1;
+    }
+
+    // Load corpus and convert its images to QOI format.
+    std::vector<CorpusImage> corpus;
+    for(const auto& directoryEntry : fs::recursive_directory_iterator(corpusDirectory))
+    {
+        if(!directoryEntry.is_regular_file() || directoryEntry.path().extension() != ".png")
+            continue;
+
+        CorpusImage corpusImage;
+        corpusImage.path = directoryEntry.path();
+
+        std::ifstream file(corpusImage.path, std::ios::binary);
+        corpusImage.png.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        System::Image::LoadFromMemory params;
+        params.data = corpusImage.png.data();
+        params.size = corpusImage.png.size();
+        params.format = System::Image::Format::PNG;
+
+        auto image = System::Image::Create(params).UnwrapOr(nullptr);
+        if(image == nullptr)
+        {
+            std::cerr << "ImageBenchmark: Could not decode \"" << corpusImage.path.generic_string() << "\" image!\n";
+            continue;
+        }
+
+        corpusImage.decodedSize = std::size_t(image->GetWidth()) * image->GetHeight() * image->GetChannels();
+        corpusImage.qoi = image->EncodeQOI().UnwrapOr(std::vector<uint8_t>());
+        corpus.push_back(std::move(corpusImage));
+    }
+
+    if(corpus.empty())
+    {
+        std::cerr << "ImageBenchmark: No PNG images found in corpus!\n";
+        return 1;
+    }
+
+    std::size_t pngBytes = 0;
+    std::size_t qoiBytes = 0;
+    std::size_t decodedBytes = 0;
+    std::size_t qoiImages = 0;
+    std::size_t qoiDecodedBytes = 0;
+
+    for(const CorpusImage& corpusImage : corpus)
+    {
+        pngBytes += corpusImage.png.size();
+        decodedBytes += corpusImage.decodedSize;
+
+        // Images with less than three channels cannot be encoded as QOI.
+        if(!corpusImage.qoi.empty())
+        {
+            qoiBytes += corpusImage.qoi.size();
+            qoiDecodedBytes += corpusImage.decodedSize;
+            ++qoiImages;
+        }
+    }
+
+    std::cout << "ImageBenchmark: Decoding " << corpus.size() << " images " << iterations
+        << " times with " << threadCount << " threads in parallel mode.\n";
+
+    // Decode all images on single thread.
+    auto DecodeCorpus = [&corpus](System::Image::Format format, std::size_t first, std::size_t step)
+    {
+        for(std::size_t i = first; i < corpus.size(); i += step)
+        {
+            const auto& data = format == System::Image::Format::PNG ? corpus[i].png : corpus[i].qoi;
+            if(!data.empty())
+            {
+                DecodeImage(data, format);
+            }
+        }
+    };
+
+    double pngSeconds = MeasureSeconds([&]()
+    {
+        for(int i = 0; i < iterations; ++i)
+            DecodeCorpus(System::Image::Format::PNG, 0, 1);
+    });
+
+    double qoiSeconds = MeasureSeconds([&]()
+    {
+        for(int i = 0; i < iterations; ++i)
+            DecodeCorpus(System::Image::Format::QOI, 0, 1);
+    });
+
+    PrintResult("PNG", pngSeconds, corpus.size() * iterations, pngBytes, decodedBytes * iterations);
+    PrintResult("QOI", qoiSeconds, qoiImages * iterations, qoiBytes, qoiDecodedBytes * iterations);
+
+    // Decode images spread over multiple threads.
+    auto DecodeParallel = [&](System::Image::Format format)
+    {
+        std::vector<std::thread> threads;
+        for(int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for(int i = 0; i < iterations; ++i)
+                    DecodeCorpus(format, t, threadCount);
+            });
+        }
+
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    double pngParallelSeconds = MeasureSeconds([&]()
+    {
+        DecodeParallel(System::Image::Format::PNG);
+    });
+
+    double qoiParallelSeconds = MeasureSeconds([&]()
+    {
+        DecodeParallel(System::Image::Format::QOI);
+    });
+
+    PrintResult("PNG parallel", pngParallelSeconds, corpus.size() * iterations, pngBytes, decodedBytes * iterations);
+    PrintResult("QOI parallel", qoiParallelSeconds, qoiImages * iterations, qoiBytes, qoiDecodedBytes * iterations);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <Common/Logger/Logger.hpp>
+#include <Common/Logger/Format.hpp>
+#include <Common/Logger/Output.hpp>
+
+/*
+    Log Decoder
+
+    Decodes binary log written by Logger::BinaryOutput into text log
+    in default format. Text of messages written without arguments is
+    rebuilt from their interned format strings while decoding.
+    Writes to standard output if output path is omitted.
+
+    Usage: LogDecoder <input.bin> [output.txt]
+*/
+
+const char* GetDecodeErrorText(Logger::BinaryOutput::DecodeErrors error)
+{
+    switch(error)
+    {
+        case Logger::BinaryOutput::DecodeErrors::InvalidHeader: return "Invalid file header";
+        case Logger::BinaryOutput::DecodeErrors::UnsupportedVersion: return "Unsupported file version";
+        case Logger::BinaryOutput::DecodeErrors::TruncatedRecord: return "Truncated record";
+        case Logger::BinaryOutput::DecodeErrors::UnknownRecord: return "Unknown record type";
+        case Logger::BinaryOutput::DecodeErrors::UnknownString: return "Unknown string identifier";
+        default: return "Unknown error";
+    }
+}
+
+int main(const int argc, const char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "LogDecoder: Usage: LogDecoder <input.bin> [output.txt]\n";
+        return 1;
+    }
+
+    std::ifstream inputFile(argv[1], std::ios::binary);
+    if(!inputFile.is_open())
+    {
+        std::cerr << "LogDecoder: Could not open \"" << argv[1] << "\" input file!\n";
+        return 1;
+    }
+
+    std::vector<uint8_t> inputData((std::istreambuf_iterator<char>(inputFile)),
+        std::istreambuf_iterator<char>());
+
+    std::ofstream outputFile;
+    if(argc == 3)
+    {
+        outputFile.open(argv[2]);
+        if(!outputFile.is_open())
+        {
+            std::cerr << "LogDecoder: Could not open \"" << argv[2] << "\" output file!\n";
+            return 1;
+        }
+    }
+
+    std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+    std::string messagesText;
+    std::time_t lastMessageTime = 0;
+
+    auto decodeResult = Logger::BinaryOutput::Decode(inputData.data(), inputData.size(),
+        [&messagesText, &lastMessageTime](const Logger::Message& message, const Logger::SinkContext& context)
+        {
+            messagesText += Logger::DefaultFormat::ComposeMessage(message, context);
+            lastMessageTime = message.GetTime();
+        });
+
+    if(!decodeResult)
+    {
+        std::cerr << "LogDecoder: Failed to decode \"" << argv[1] << "\" input file! "
+            << GetDecodeErrorText(decodeResult.UnwrapFailure()) << ".\n";
+        return 1;
+    }
+
+    std::time_t sessionTime = decodeResult.Unwrap();
+    output << Logger::DefaultFormat::ComposeSessionStart(sessionTime);
+    output << messagesText;
+    output << Logger::DefaultFormat::ComposeSessionEnd(std::max(sessionTime, lastMessageTime));
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+    Copyright (c) 2018-2021 Piotr Doan. All rights reserved.
+    Software distributed under the permissive MIT License.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <Core/Core.hpp>
+#include <Core/ReflectionGenerated.hpp>
+#include <Game/ReflectionGenerated.hpp>
+#include <Common/Event/Receiver.hpp>
+#include <Game/GameInstance.hpp>
+#include <Game/EntitySystem.hpp>
+#include <Game/ComponentSystem.hpp>
+#include <Game/Snapshot.hpp>
+#include <Game/TickSimulation.hpp>
+#include <Game/Components/TransformComponent.hpp>
+#include <Game/Components/SpriteComponent.hpp>
+
+/*
+    Rollback Benchmark
+
+    Measures how many ticks per second can be simulated again after rollback
+    for reference scene. Scene consists of entities with transforms moving
+    with input of every tick, with half of them also having sprites. Every
+    iteration records late input for tick that is given number of ticks old,
+    which restores snapshot and simulates following ticks again.
+
+    Usage: RollbackBenchmark [entities] [rollback ticks] [snapshot interval] [iterations]
+*/
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    double MeasureSeconds(Function&& function)
+    {
+        auto start = Clock::now();
+        function();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void PrintResult(const char* name, double seconds, std::size_t ticks)
+    {
+        std::cout << "RollbackBenchmark: " << name << ": "
+            << seconds * 1000.0 << " ms, "
+            << seconds * 1000000.0 / ticks << " us per tick, "
+            << ticks / seconds << " ticks per second\n";
+    }
+}
+
+int main(const int argc, const char* argv[])
+{
+    if(argc > 5)
+    {
+        std::cerr << "RollbackBenchmark: Usage: RollbackBenchmark "
+            "[entities] [rollback ticks] [snapshot interval] [iterations]\n";
+        return 1;
+    }
+
+    const int entityCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000;
+    const int rollbackTicks = argc > 2 ? std::max(1, std::atoi(argv[2])) : 8;
+    const int snapshotInterval = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+    const int iterations = argc > 4 ? std::max(1, std::atoi(argv[4])) : 1000;
+
+    Reflection::Initialize();
+
+    // Create reference scene.
+    auto gameInstance = Game::GameInstance::Create().UnwrapOr(nullptr);
+    if(gameInstance == nullptr)
+    {
+        std::cerr << "RollbackBenchmark: Could not create game instance!\n";
+        return 1;
+    }
+
+    auto* entitySystem = gameInstance->GetSystems().Locate<Game::EntitySystem>();
+    auto* componentSystem = gameInstance->GetSystems().Locate<Game::ComponentSystem>();
+
+    for(int i = 0; i < entityCount; ++i)
+    {
+        Game::EntityHandle entity = entitySystem->CreateEntity();
+        auto* transform = componentSystem->Create<Game::TransformComponent>(entity);
+        transform->SetPosition(glm::vec3(float(i % 100), float(i / 100), 0.0f));
+
+        if(i % 2 == 0)
+        {
+            componentSystem->Create<Game::SpriteComponent>(entity);
+        }
+    }
+
+    entitySystem->ProcessCommands();
+
+    Game::TickSimulation::CreateFromParams params;
+    params.gameInstance = gameInstance.get();
+    params.historyLength = static_cast<uint32_t>(rollbackTicks + snapshotInterval);
+    params.snapshotInterval = static_cast<uint32_t>(snapshotInterval);
+
+    auto simulation = Game::TickSimulation::Create(params).UnwrapOr(nullptr);
+    if(simulation == nullptr)
+    {
+        std::cerr << "RollbackBenchmark: Could not create tick simulation!\n";
+        return 1;
+    }
+
+    // Move all entities by direction from input.
+    Event::Receiver<void(Game::GameInstance&, Game::TickSimulation::TickIndex,
+        const Game::TickSimulation::TickInput&)> applyInput;
+    applyInput.Bind([componentSystem](Game::GameInstance& gameInstance,
+        Game::TickSimulation::TickIndex tick, const Game::TickSimulation::TickInput& input)
+    {
+        float direction = input.empty() ? 0.0f : static_cast<int8_t>(input[0]);
+        for(auto& transform : componentSystem->GetPool<Game::TransformComponent>())
+        {
+            transform.SetPosition(transform.GetPosition() + glm::vec3(direction * 0.01f, 0.0f, 0.0f));
+            transform.SetRotation(glm::angleAxis(float(tick) * 0.01f, glm::vec3(0.0f, 0.0f, 1.0f)));
+        }
+    });
+
+    applyInput.Subscribe(simulation->events.applyInput);
+
+    Game::SnapshotWriter snapshotWriter;
+    gameInstance->SaveSnapshot(snapshotWriter);
+
+    std::cout << "RollbackBenchmark: Scene with " << entityCount << " entities, snapshot of "
+        << snapshotWriter.GetData().size() / 1024 << " KB, rolling back " << rollbackTicks
+        << " ticks with snapshot every " << snapshotInterval << " ticks "
+        << iterations << " times.\n";
+
+    // Fill history before measuring.
+    for(int i = 0; i < rollbackTicks + snapshotInterval; ++i)
+    {
+        simulation->Advance();
+    }
+
+    // Measure regular ticks that save snapshots.
+    double advanceSeconds = MeasureSeconds([&]()
+    {
+        for(int i = 0; i < iterations; ++i)
+        {
+            simulation->Advance();
+        }
+    });
+
+    PrintResult("Advance", advanceSeconds, iterations);
+
+    // Measure snapshot restore alone.
+    double restoreSeconds = MeasureSeconds([&]()
+    {
+        for(int i = 0; i < iterations; ++i)
+        {
+            Game::SnapshotReader snapshotReader(snapshotWriter.GetData());
+            gameInstance->RestoreSnapshot(snapshotReader);
+        }
+    });
+
+    std::cout << "RollbackBenchmark: Restore: " << restoreSeconds * 1000000.0 / iterations << " us per snapshot\n";
+
+    // Measure rollback with late input followed by new tick.
+    std::size_t resimulatedTicks = 0;
+    bool resimulationFailed = false;
+
+    double resimulateSeconds = MeasureSeconds([&]()
+    {
+        for(int i = 0; i < iterations; ++i)
+        {
+            Game::TickSimulation::TickIndex lateTick = simulation->GetCurrentTick() - rollbackTicks;
+            simulation->RecordInput(lateTick, { static_cast<uint8_t>(i % 3) });
+
+            auto result = simulation->ResimulatePending();
+            if(!result)
+            {
+                resimulationFailed = true;
+                break;
+            }
+
+            resimulatedTicks += result.Unwrap();
+            simulation->Advance();
+        }
+    });
+
+    if(resimulationFailed)
+    {
+        std::cerr << "RollbackBenchmark: Could not simulate ticks again!\n";
+        return 1;
+    }
+
+    PrintResult("Resimulate", resimulateSeconds, resimulatedTicks + iterations);
+    return 0;
+}